@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "ACLoader.h"
 #include "Common/Importer.h"
+#include "Common/ParallelFor.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/Subdivision.h>
@@ -135,6 +136,7 @@ AC3DImporter::AC3DImporter() :
         buffer(),
         configSplitBFCull(),
         configEvalSubdivision(),
+        configNumThreads(1),
         mNumMeshes(),
         mLights(),
         mLightsCounter(0),
@@ -625,6 +627,7 @@ aiNode *AC3DImporter::ConvertObjectSection(Object &object,
             if (object.subDiv) {
                 if (configEvalSubdivision) {
                     std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+                    div->SetNumThreads(configNumThreads);
                     ASSIMP_LOG_INFO("AC3D: Evaluating subdivision surface: " + object.name);
 
                     std::vector<aiMesh *> cpy(meshes.size() - oldm, NULL);
@@ -687,6 +690,7 @@ aiNode *AC3DImporter::ConvertObjectSection(Object &object,
 void AC3DImporter::SetupProperties(const Importer *pImp) {
     configSplitBFCull = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_SEPARATE_BFCULL, 1) ? true : false;
     configEvalSubdivision = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_EVAL_SUBDIVISION, 1) ? true : false;
+    configNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "AssetLib/Assbin/AssbinLoader.h"
 #include "Common/assbin_chunks.h"
+#include "Material/MaterialSystem.h"
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/anim.h>
 #include <assimp/importerdesc.h>
@@ -459,6 +460,7 @@ void AssbinImporter::ReadBinaryMaterial(IOStream *stream, aiMaterial *mat) {
             ReadBinaryMaterialProperty(stream, mat->mProperties[i]);
         }
     }
+    UpdateMaterialIndex(mat);
 }
 
 // -----------------------------------------------------------------------------------
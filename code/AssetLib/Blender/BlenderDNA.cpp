@@ -161,6 +161,7 @@ void DNAParser::Parse() {
 
             f.type = types[j].name;
             f.size = types[j].size;
+            f.type_index = SIZE_MAX;
 
             j = stream.GetI2();
             if (j >= names.size()) {
@@ -214,6 +215,7 @@ void DNAParser::Parse() {
 #endif
 
     dna.AddPrimitiveStructures();
+    dna.ResolveFieldTypes();
     dna.RegisterConverters();
 }
 
@@ -270,7 +272,7 @@ void DNA ::DumpToFile() {
 std::shared_ptr<ElemBase> DNA ::ConvertBlobToStructure(
         const Structure &structure,
         const FileDatabase &db) const {
-    std::map<std::string, FactoryPair>::const_iterator it = converters.find(structure.name);
+    std::unordered_map<std::string, FactoryPair>::const_iterator it = converters.find(structure.name);
     if (it == converters.end()) {
         return std::shared_ptr<ElemBase>();
     }
@@ -286,7 +288,7 @@ DNA::FactoryPair DNA ::GetBlobToStructureConverter(
         const Structure &structure,
         const FileDatabase & /*db*/
 ) const {
-    std::map<std::string, FactoryPair>::const_iterator it = converters.find(structure.name);
+    std::unordered_map<std::string, FactoryPair>::const_iterator it = converters.find(structure.name);
     return it == converters.end() ? FactoryPair() : (*it).second;
 }
 
@@ -329,6 +331,18 @@ void DNA ::AddPrimitiveStructures() {
     // no long, seemingly.
 }
 
+// ------------------------------------------------------------------------------------------------
+void DNA ::ResolveFieldTypes() {
+    // Every ReadField() needs the Structure of the field's type. Doing the
+    // name lookup here once per field saves one per field read.
+    for (Structure &s : structures) {
+        for (Field &f : s.fields) {
+            std::unordered_map<std::string, size_t>::const_iterator it = indices.find(f.type);
+            f.type_index = it == indices.end() ? SIZE_MAX : (*it).second;
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void SectionParser ::Next() {
     stream.SetCurrentPos(current.start + current.size);
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 // enable verbose log output. really verbose, so be careful.
 #ifdef ASSIMP_BUILD_DEBUG
@@ -177,6 +178,11 @@ struct Field {
     size_t size;
     size_t offset;
 
+    /** Index of the Structure describing `type` in DNA::structures,
+     *  or SIZE_MAX if the DNA has no such record. Resolved once per
+     *  file by DNAParser::Parse() after all structures are known. */
+    size_t type_index;
+
     /** Size of each array dimension. For flat arrays,
      *  the second dimension is set to 1. */
     size_t array_sizes[2];
@@ -224,7 +230,7 @@ public:
     // publicly accessible members
     std::string name;
     vector<Field> fields;
-    std::map<std::string, size_t> indices;
+    std::unordered_map<std::string, size_t> indices;
 
     size_t size;
 
@@ -327,6 +333,15 @@ public:
     bool ReadCustomDataPtr(std::shared_ptr<ElemBase> &out, int cdtype, const char *name, const FileDatabase &db) const;
 
 private:
+    // --------------------------------------------------------
+    /** Field lookup used by the ReadFieldXXX family. Field names
+     *  passed there are string literals from the (generated)
+     *  converters, so the literal's address is a stable key and
+     *  after the first lookup each field is found without
+     *  hashing or comparing the name. Missing fields are
+     *  remembered as well. Throws #Error if there is no such field. */
+    inline const Field &LookupField(const char *name) const;
+
     // --------------------------------------------------------
     template <template <typename> class TOUT, typename T>
     bool ResolvePointer(TOUT<T> &out, const Pointer &ptrval,
@@ -390,6 +405,7 @@ private:
 
 private:
     mutable size_t cache_idx;
+    mutable std::unordered_map<const char *, size_t> field_cache;
 };
 
 // --------------------------------------------------------
@@ -442,9 +458,9 @@ public:
     typedef std::pair<AllocProcPtr, ConvertProcPtr> FactoryPair;
 
 public:
-    std::map<std::string, FactoryPair> converters;
+    std::unordered_map<std::string, FactoryPair> converters;
     vector<Structure> structures;
-    std::map<std::string, size_t> indices;
+    std::unordered_map<std::string, size_t> indices;
 
 public:
     // --------------------------------------------------------
@@ -457,12 +473,22 @@ public:
     /** Access a structure by its index */
     inline const Structure &operator[](const size_t i) const;
 
+    // --------------------------------------------------------
+    /** Access the structure describing the type of a field. This
+     *  uses the precomputed Field::type_index, no name lookup. */
+    inline const Structure &operator[](const Field &f) const;
+
 public:
     // --------------------------------------------------------
     /** Add structure definitions for all the primitive types,
      *  i.e. integer, short, char, float */
     void AddPrimitiveStructures();
 
+    // --------------------------------------------------------
+    /** Resolve Field::type_index for all fields of all structures.
+     *  Must be called after the last structure has been added. */
+    void ResolveFieldTypes();
+
     // --------------------------------------------------------
     /** Fill the @c converters member with converters for all
      *  known data types. The implementation of this method is
@@ -55,7 +55,7 @@ namespace Blender {
 //--------------------------------------------------------------------------------
 const Field& Structure :: operator [] (const std::string& ss) const
 {
-    std::map<std::string, size_t>::const_iterator it = indices.find(ss);
+    std::unordered_map<std::string, size_t>::const_iterator it = indices.find(ss);
     if (it == indices.end()) {
         throw Error((Formatter::format(),
             "BlendDNA: Did not find a field named `",ss,"` in structure `",name,"`"
@@ -65,10 +65,28 @@ const Field& Structure :: operator [] (const std::string& ss) const
     return fields[(*it).second];
 }
 
+//--------------------------------------------------------------------------------
+const Field& Structure :: LookupField (const char* ss) const
+{
+    std::unordered_map<const char*, size_t>::const_iterator it = field_cache.find(ss);
+    if (it == field_cache.end()) {
+        std::unordered_map<std::string, size_t>::const_iterator fit = indices.find(ss);
+        const size_t idx = fit == indices.end() ? SIZE_MAX : (*fit).second;
+        it = field_cache.insert(std::make_pair(ss, idx)).first;
+    }
+
+    if ((*it).second == SIZE_MAX) {
+        throw Error((Formatter::format(),
+            "BlendDNA: Did not find a field named `",ss,"` in structure `",name,"`"
+            ));
+    }
+    return fields[(*it).second];
+}
+
 //--------------------------------------------------------------------------------
 const Field* Structure :: Get (const std::string& ss) const
 {
-    std::map<std::string, size_t>::const_iterator it = indices.find(ss);
+    std::unordered_map<std::string, size_t>::const_iterator it = indices.find(ss);
     return it == indices.end() ? NULL : &fields[(*it).second];
 }
 
@@ -104,8 +122,8 @@ void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatab
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = db.dna[f];
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -143,8 +161,8 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = db.dna[f];
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -191,7 +209,7 @@ bool Structure :: ReadFieldPtr(TOUT<T>& out, const char* name, const FileDatabas
     Pointer ptrval;
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
         // sanity check, should never happen if the genblenddna script is right
         if (!(f->flags & FieldFlag_Pointer)) {
@@ -236,7 +254,7 @@ bool Structure :: ReadFieldPtr(TOUT<T> (&out)[N], const char* name,
     Pointer ptrval[N];
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
 #ifdef _DEBUG
         // sanity check, should never happen if the genblenddna script is right
@@ -288,9 +306,9 @@ void Structure :: ReadField(T& out, const char* name, const FileDatabase& db) co
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
+        const Field& f = LookupField(name);
         // find the structure definition pertaining to this field
-        const Structure& s = db.dna[f.type];
+        const Structure& s = db.dna[f];
 
         db.reader->IncPtr(f.offset);
         s.Convert(out,db);
@@ -318,7 +336,7 @@ bool Structure::ReadCustomDataPtr(std::shared_ptr<ElemBase>&out, int cdtype, con
 	Pointer ptrval;
 	const Field* f;
 	try	{
-		f = &(*this)[name];
+		f = &LookupField(name);
 
 		// sanity check, should never happen if the genblenddna script is right
 		if (!(f->flags & FieldFlag_Pointer)) {
@@ -365,7 +383,7 @@ bool Structure::ReadFieldPtrVector(vector<TOUT<T>>&out, const char* name, const
 	Pointer ptrval;
 	const Field* f;
 	try	{
-		f = &(*this)[name];
+		f = &LookupField(name);
 
 		// sanity check, should never happen if the genblenddna script is right
 		if (!(f->flags & FieldFlag_Pointer)) {
@@ -392,7 +410,7 @@ bool Structure::ReadFieldPtrVector(vector<TOUT<T>>&out, const char* name, const
 		// FIXME: basically, this could cause problems with 64 bit pointers on 32 bit systems.
 		// I really ought to improve StreamReader to work with 64 bit indices exclusively.
 
-		const Structure& s = db.dna[f->type];
+		const Structure& s = db.dna[*f];
 		for (size_t i = 0; i < block->num; ++i)	{
 			TOUT<T> p(new T);
 			s.Convert(*p, db);
@@ -420,7 +438,7 @@ bool Structure :: ResolvePointer(TOUT<T>& out, const Pointer & ptrval, const Fil
     if (!ptrval.val) {
         return false;
     }
-    const Structure& s = db.dna[f.type];
+    const Structure& s = db.dna[f];
     // find the file block the pointer is pointing to
     const FileBlockHead* block = LocateFileBlockForAddress(ptrval,db);
 
@@ -782,7 +800,7 @@ template <> inline void Structure :: Convert<Pointer> (Pointer& dest,const FileD
 //--------------------------------------------------------------------------------
 const Structure& DNA :: operator [] (const std::string& ss) const
 {
-    std::map<std::string, size_t>::const_iterator it = indices.find(ss);
+    std::unordered_map<std::string, size_t>::const_iterator it = indices.find(ss);
     if (it == indices.end()) {
         throw Error((Formatter::format(),
             "BlendDNA: Did not find a structure named `",ss,"`"
@@ -795,7 +813,7 @@ const Structure& DNA :: operator [] (const std::string& ss) const
 //--------------------------------------------------------------------------------
 const Structure* DNA :: Get (const std::string& ss) const
 {
-    std::map<std::string, size_t>::const_iterator it = indices.find(ss);
+    std::unordered_map<std::string, size_t>::const_iterator it = indices.find(ss);
     return it == indices.end() ? nullptr : &structures[(*it).second];
 }
 
@@ -811,6 +829,18 @@ const Structure& DNA :: operator [] (const size_t i) const
     return structures[i];
 }
 
+//--------------------------------------------------------------------------------
+const Structure& DNA :: operator [] (const Field& f) const
+{
+    if (f.type_index == SIZE_MAX) {
+        throw Error((Formatter::format(),
+            "BlendDNA: Did not find a structure named `",f.type,"`"
+            ));
+    }
+
+    return structures[f.type_index];
+}
+
 //--------------------------------------------------------------------------------
 template <template <typename> class TOUT> template <typename T> void ObjectCache<TOUT> :: get (
     const Structure& s,
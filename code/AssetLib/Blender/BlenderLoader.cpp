@@ -55,7 +55,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderModifier.h"
 #include "BlenderBMesh.h"
 #include "BlenderCustomData.h"
+#include "Common/ParallelFor.h"
 #include <assimp/StringUtils.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 #include <assimp/scene.h>
 #include <assimp/importerdesc.h>
 
@@ -68,11 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // zlib is needed for compressed blend files
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-#   ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#       include <zlib.h>
-#   else
-#       include "../contrib/zlib/zlib.h"
-#   endif
+#   include "Common/Compression.h"
 #endif
 
 namespace Assimp {
@@ -104,7 +103,8 @@ static const aiImporterDesc blenderDesc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter()
-: modifier_cache(new BlenderModifierShowcase()) {
+: modifier_cache(new BlenderModifierShowcase())
+, num_threads(1) {
     // empty
 }
 
@@ -150,9 +150,9 @@ const aiImporterDesc* BlenderImporter::GetInfo () const
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
+void BlenderImporter::SetupProperties(const Importer* pImp)
 {
-    // nothing to be done for the moment
+    num_threads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 }
 
 
@@ -161,11 +161,6 @@ void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
 void BlenderImporter::InternReadFile( const std::string& pFile,
     aiScene* pScene, IOSystem* pIOHandler)
 {
-#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-    std::vector<Bytef> uncompressed;
-#endif
-
-
     FileDatabase file;
     std::shared_ptr<IOStream> stream(pIOHandler->Open(pFile,"rb"));
     if (!stream) {
@@ -192,49 +187,15 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
         }
 
         // http://www.gzip.org/zlib/rfc-gzip.html#header-trailer
+        // The trailer tells the size of the uncompressed data modulo 2^32. It comes
+        // from the file, so cap it to what the compressed data can inflate to.
         stream->Seek(0L,aiOrigin_SET);
-        std::shared_ptr<StreamReaderLE> reader = std::shared_ptr<StreamReaderLE>(new StreamReaderLE(stream));
-
-        // build a zlib stream
-        z_stream zstream;
-        zstream.opaque = Z_NULL;
-        zstream.zalloc = Z_NULL;
-        zstream.zfree  = Z_NULL;
-        zstream.data_type = Z_BINARY;
-
-        // http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-        inflateInit2(&zstream, 16+MAX_WBITS);
-
-        zstream.next_in   = reinterpret_cast<Bytef*>( reader->GetPtr() );
-        zstream.avail_in  = (uInt) reader->GetRemainingSize();
-
-        size_t total = 0l;
-
-        // TODO: be smarter about this, decompress directly into heap buffer
-        // and decompress the data .... do 1k chunks in the hope that we won't kill the stack
-#define MYBLOCK 1024
-        Bytef block[MYBLOCK];
-        int ret;
-        do {
-            zstream.avail_out = MYBLOCK;
-            zstream.next_out = block;
-            ret = inflate(&zstream, Z_NO_FLUSH);
-
-            if (ret != Z_STREAM_END && ret != Z_OK) {
-                ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
-            }
-            const size_t have = MYBLOCK - zstream.avail_out;
-            total += have;
-            uncompressed.resize(total);
-            memcpy(uncompressed.data() + total - have,block,have);
-        }
-        while (ret != Z_STREAM_END);
-
-        // terminate zlib
-        inflateEnd(&zstream);
+        const size_t size = std::min(InflateIOStream::GetGzipSize(*stream),
+                InflateIOStream::GetMaxInflatedSize(stream->FileSize()));
 
-        // replace the input stream with a memory stream
-        stream.reset(new MemoryIOStream(reinterpret_cast<uint8_t*>(uncompressed.data()),total));
+        // replace the input stream with one inflating on the fly, the StreamReader
+        // built by ParseBlendFile() then decompresses straight into its buffer
+        stream.reset(new InflateIOStream(stream, Inflater::Format_Gzip, size));
 
         // .. and retry
         stream->Read(magic,7,1);
@@ -301,22 +262,46 @@ void BlenderImporter::ParseBlendFile(FileDatabase& out, std::shared_ptr<IOStream
 void BlenderImporter::ExtractScene(Scene& out, const FileDatabase& file)
 {
     const FileBlockHead* block = NULL;
-    std::map<std::string,size_t>::const_iterator it = file.dna.indices.find("Scene");
+    std::unordered_map<std::string,size_t>::const_iterator it = file.dna.indices.find("Scene");
     if (it == file.dna.indices.end()) {
         ThrowException("There is no `Scene` structure record");
     }
 
     const Structure& ss = file.dna.structures[(*it).second];
 
-    // we need a scene somewhere to start with.
-    for(const FileBlockHead& bl :file.entries) {
+    // Conversion is driven by pointers, starting at the scene, so only
+    // the objects reachable from it are ever read. Prefer the scene that
+    // was active when the file was saved - it is referenced from the
+    // global file block - over the first one stored in the file.
+    const Structure* glob = file.dna.Get("FileGlobal");
+    const Field* curscene = glob ? glob->Get("*curscene") : NULL;
+    if (curscene) {
+        for(const FileBlockHead& bl :file.entries) {
+            if (bl.id != "GLOB") {
+                continue;
+            }
+
+            Pointer ptr;
+            file.reader->SetCurrentPos(bl.start + curscene->offset);
+            glob->Convert(ptr,file);
+
+            vector<FileBlockHead>::const_iterator sc = std::lower_bound(file.entries.begin(),file.entries.end(),ptr);
+            if (sc != file.entries.end() && (*sc).address.val == ptr.val && (*sc).dna_index == (*it).second) {
+                block = &*sc;
+            }
+            break;
+        }
+    }
+
+    // otherwise, we need a scene somewhere to start with.
+    for(size_t i = 0; !block && i < file.entries.size(); ++i) {
+        const FileBlockHead& bl = file.entries[i];
 
         // Fix: using the DNA index is more reliable to locate scenes
         //if (bl.id == "SC") {
 
         if (bl.dna_index == (*it).second) {
             block = &bl;
-            break;
         }
     }
 
@@ -341,6 +326,7 @@ void BlenderImporter::ExtractScene(Scene& out, const FileDatabase& file)
 void BlenderImporter::ConvertBlendFile(aiScene* out, const Scene& in,const FileDatabase& file)
 {
     ConversionData conv(file);
+    conv.numThreads = num_threads;
 
     // FIXME it must be possible to take the hierarchy directly from
     // the file. This is terrible. Here, we're first looking for
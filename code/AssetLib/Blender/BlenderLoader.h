@@ -233,6 +233,7 @@ private: // static stuff, mostly logging and error reporting.
 private:
 
     Blender::BlenderModifierShowcase* modifier_cache;
+    unsigned int num_threads;
 
 }; // !class BlenderImporter
 
@@ -283,6 +283,7 @@ void BlenderModifier_Subdivision ::DoIt(aiNode &out, ConversionData &conv_data,
 
     std::unique_ptr<Subdivider> subd(Subdivider::Create(algo));
     ai_assert(subd);
+    subd->SetNumThreads(conv_data.numThreads);
     if (conv_data.meshes->empty()) {
         return;
     }
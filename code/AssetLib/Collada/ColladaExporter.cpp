@@ -73,18 +73,12 @@ void ExportSceneCollada(const char *pFile, IOSystem *pIOSystem, const aiScene *p
     // invoke the exporter
     ColladaExporter iDoTheExportThing(pScene, pIOSystem, path, file);
 
-    if (iDoTheExportThing.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
     // we're still here - export successfully completed. Write result to the given IOSYstem
     std::unique_ptr<IOStream> outfile(pIOSystem->Open(pFile, "wt"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .dae file: " + std::string(pFile));
     }
-
-    // XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-    outfile->Write(iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()), 1);
+    iDoTheExportThing.mOutput.WriteTo(outfile.get());
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -139,15 +133,12 @@ inline std::string MakeUniqueId(const std::unordered_set<std::string> &idSet, co
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
 ColladaExporter::ColladaExporter(const aiScene *pScene, IOSystem *pIOSystem, const std::string &path, const std::string &file) :
+        mOutput(),
         mIOSystem(pIOSystem),
         mPath(path),
         mFile(file),
         mScene(pScene),
         endstr("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    mOutput.imbue(std::locale("C"));
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
     // start writing the file
     WriteFile();
 }
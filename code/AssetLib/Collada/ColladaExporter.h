@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_COLLADAEXPORTER_H_INC
 #define AI_COLLADAEXPORTER_H_INC
 
+#include "Common/TextWriter.h"
+
 #include <assimp/ai_assert.h>
 #include <assimp/material.h>
 
@@ -183,8 +185,8 @@ private:
     std::array<IndexIdMap, static_cast<size_t>(AiObjectType::Count)> mObjectNameMap; // Cache of encoded names
 
 public:
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
+    /// Writer to write all output into
+    TextWriter mOutput;
 
     /// The IOSystem for output
     IOSystem *mIOSystem;
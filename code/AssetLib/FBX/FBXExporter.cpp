@@ -68,6 +68,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <array>
 #include <unordered_set>
 #include <numeric>
+#include <algorithm>
 
 // RESOURCES:
 // https://code.blender.org/2013/08/fbx-binary-file-format-specification/
@@ -1836,6 +1837,15 @@ void FBXExporter::WriteObjects ()
         aiNode* mesh_node = get_node_for_mesh((unsigned int)mi, mScene->mRootNode);
         aiMatrix4x4 mesh_xform = get_world_transform(mesh_node, mScene);
 
+        // for each exported vertex the last subdeformer that weighted it,
+        // flat instead of a set of weighted vertices per subdeformer
+        int32_t num_exported_vertices = 0;
+        for (int32_t vi : vertex_indices) {
+            num_exported_vertices = std::max(num_exported_vertices, vi + 1);
+        }
+        std::vector<size_t> weighted_by(num_exported_vertices, 0);
+        size_t subdeformer_count = 0;
+
         // now make a subdeformer for each bone in the skeleton
         const std::set<const aiNode*, SortNodeByName> skeleton= skeleton_by_mesh[mi];
         for (const aiNode* bone_node : skeleton) {
@@ -1862,15 +1872,17 @@ void FBXExporter::WriteObjects ()
             sdnode.AddChild("Version", int32_t(100));
             sdnode.AddChild("UserData", "", "");
 
-            std::set<int32_t> setWeightedVertex;
+            ++subdeformer_count;
             // add indices and weights, if any
             if (b) {
                 std::vector<int32_t> subdef_indices;
                 std::vector<double> subdef_weights;
+                subdef_indices.reserve(b->mNumWeights);
+                subdef_weights.reserve(b->mNumWeights);
                 int32_t last_index = -1;
                 for (size_t wi = 0; wi < b->mNumWeights; ++wi) {
                     int32_t vi = vertex_indices[b->mWeights[wi].mVertexId];
-                    bool bIsWeightedAlready = (setWeightedVertex.find(vi) != setWeightedVertex.end());
+                    bool bIsWeightedAlready = (weighted_by[vi] == subdeformer_count);
                     if (vi == last_index || bIsWeightedAlready) {
                         // only for vertices we exported to fbx
                         // TODO, FIXME: this assumes identically-located vertices
@@ -1881,7 +1893,7 @@ void FBXExporter::WriteObjects ()
                         // identical vertex.
                         continue;
                     }
-                    setWeightedVertex.insert(vi);
+                    weighted_by[vi] = subdeformer_count;
                     subdef_indices.push_back(vi);
                     subdef_weights.push_back(b->mWeights[wi].mWeight);
                     last_index = vi;
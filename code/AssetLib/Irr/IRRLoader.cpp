@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssetLib/Irr/IRRLoader.h"
 #include "Common/Importer.h"
+#include "Material/MaterialSystem.h"
 
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
@@ -646,6 +647,7 @@ void SetupMapping (aiMaterial* mat, aiTextureMapping mode, const aiVector3D& axi
     }
     mat->mNumProperties = (unsigned int)p.size();
     ::memcpy(mat->mProperties,&p[0],sizeof(void*)*mat->mNumProperties);
+    UpdateMaterialIndex(mat);
 }
 
 // ------------------------------------------------------------------------------------------------
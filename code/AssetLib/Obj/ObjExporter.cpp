@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/version.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include <assimp/material.h>
 #include <assimp/scene.h>
 #include <memory>
@@ -57,15 +58,26 @@ using namespace Assimp;
 
 namespace Assimp {
 
+static const std::string MaterialExt = ".mtl";
+
+// ------------------------------------------------------------------------------------------------
+// Remove existing .obj file extension so that the final material file name will be fileName.mtl and not fileName.obj.mtl
+static std::string MaterialLibFileName(const std::string& filename) {
+    size_t lastdot = filename.find_last_of('.');
+    if ( lastdot != std::string::npos ) {
+        return filename.substr( 0, lastdot ) + MaterialExt;
+    }
+
+    return filename + MaterialExt;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
-void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/) {
-    // invoke the exporter
-    ObjExporter exporter(pFile, pScene);
+void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties) {
+    const unsigned int numThreads = GetNumWorkerThreads(pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
+    // invoke the exporter
+    ObjExporter exporter(pFile, pScene, false, numThreads);
 
     // we're still here - export successfully completed. Write both the main OBJ file and the material script
     {
@@ -73,47 +85,43 @@ void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
         if(outfile == NULL) {
             throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
         }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+        exporter.mOutput.WriteTo(outfile.get());
     }
     {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
+        const std::string mtlFile = MaterialLibFileName(pFile);
+        std::unique_ptr<IOStream> outfile (pIOSystem->Open(mtlFile,"wt"));
         if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
+            throw DeadlyExportError("could not open output .mtl file: " + mtlFile);
         }
-        outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+        exporter.mOutputMat.WriteTo(outfile.get());
     }
 }
 
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ without the material file. Prototyped and registered in Exporter.cpp
-void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* ) {
+void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties) {
+    const unsigned int numThreads = GetNumWorkerThreads(pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+
     // invoke the exporter
-    ObjExporter exporter(pFile, pScene, true);
+    ObjExporter exporter(pFile, pScene, true, numThreads);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    // we're still here - export successfully completed. Write the main OBJ file
+    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+    if(outfile == NULL) {
+        throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
     }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-        if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-        }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
-    }
-
-
+    exporter.mOutput.WriteTo(outfile.get());
 }
 
 } // end of namespace Assimp
 
-static const std::string MaterialExt = ".mtl";
-
 // ------------------------------------------------------------------------------------------------
-ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMtl)
-: filename(_filename)
+ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMtl, unsigned int _numThreads)
+: mOutput()
+, mOutputMat()
+, filename(_filename)
 , pScene(pScene)
+, numThreads(_numThreads)
 , vn()
 , vt()
 , vp()
@@ -123,13 +131,6 @@ ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMt
 , mVpMap()
 , mMeshes()
 , endl("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-    mOutputMat.imbue(l);
-    mOutputMat.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
     WriteGeometryFile(noMtl);
     if ( !noMtl ) {
         WriteMaterialFile();
@@ -155,17 +156,11 @@ std::string ObjExporter::GetMaterialLibName() {
 
 // ------------------------------------------------------------------------------------------------
 std::string ObjExporter::GetMaterialLibFileName() {
-    // Remove existing .obj file extension so that the final material file name will be fileName.mtl and not fileName.obj.mtl
-    size_t lastdot = filename.find_last_of('.');
-    if ( lastdot != std::string::npos ) {
-        return filename.substr( 0, lastdot ) + MaterialExt;
-    }
-
-    return filename + MaterialExt;
+    return MaterialLibFileName(filename);
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteHeader(std::ostringstream& out) {
+void ObjExporter::WriteHeader(TextWriter& out) {
     out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
     out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.'
         << aiGetVersionRevision() << ")" << endl  << endl;
@@ -270,31 +265,35 @@ void ObjExporter::WriteGeometryFile(bool noMtl) {
     mVpMap.getKeys( vp );
     if ( !useVc ) {
         mOutput << "# " << vp.size() << " vertex positions" << endl;
-        for ( const vertexData& v : vp ) {
-            mOutput << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << endl;
-        }
+        FormatParallel(mOutput, numThreads, vp.size(), [&](TextWriter& out, size_t i) {
+            const vertexData& v = vp[i];
+            out << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << endl;
+        });
     } else {
         mOutput << "# " << vp.size() << " vertex positions and colors" << endl;
-        for ( const vertexData& v : vp ) {
-            mOutput << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << " " << v.vc.r << " " << v.vc.g << " " << v.vc.b << endl;
-        }
+        FormatParallel(mOutput, numThreads, vp.size(), [&](TextWriter& out, size_t i) {
+            const vertexData& v = vp[i];
+            out << "v  " << v.vp.x << " " << v.vp.y << " " << v.vp.z << " " << v.vc.r << " " << v.vc.g << " " << v.vc.b << endl;
+        });
     }
     mOutput << endl;
 
     // write uv coordinates
     mVtMap.getKeys(vt);
     mOutput << "# " << vt.size() << " UV coordinates" << endl;
-    for(const aiVector3D& v : vt) {
-        mOutput << "vt " << v.x << " " << v.y << " " << v.z << endl;
-    }
+    FormatParallel(mOutput, numThreads, vt.size(), [&](TextWriter& out, size_t i) {
+        const aiVector3D& v = vt[i];
+        out << "vt " << v.x << " " << v.y << " " << v.z << endl;
+    });
     mOutput << endl;
 
     // write vertex normals
     mVnMap.getKeys(vn);
     mOutput << "# " << vn.size() << " vertex normals" << endl;
-    for(const aiVector3D& v : vn) {
-        mOutput << "vn " << v.x << " " << v.y << " " << v.z << endl;
-    }
+    FormatParallel(mOutput, numThreads, vn.size(), [&](TextWriter& out, size_t i) {
+        const aiVector3D& v = vn[i];
+        out << "vn " << v.x << " " << v.y << " " << v.z << endl;
+    });
     mOutput << endl;
 
     // now write all mesh instances
@@ -307,26 +306,27 @@ void ObjExporter::WriteGeometryFile(bool noMtl) {
             mOutput << "usemtl " << m.matname << endl;
         }
 
-        for(const Face& f : m.faces) {
-            mOutput << f.kind << ' ';
+        FormatParallel(mOutput, numThreads, m.faces.size(), [&](TextWriter& out, size_t i) {
+            const Face& f = m.faces[i];
+            out << f.kind << ' ';
             for(const FaceVertex& fv : f.indices) {
-                mOutput << ' ' << fv.vp;
+                out << ' ' << fv.vp;
 
                 if (f.kind != 'p') {
                     if (fv.vt || f.kind == 'f') {
-                        mOutput << '/';
+                        out << '/';
                     }
                     if (fv.vt) {
-                        mOutput << fv.vt;
+                        out << fv.vt;
                     }
                     if (f.kind == 'f' && fv.vn) {
-                        mOutput << '/' << fv.vn;
+                        out << '/' << fv.vn;
                     }
                 }
             }
 
-            mOutput << endl;
-        }
+            out << endl;
+        });
         mOutput << endl;
     }
 }
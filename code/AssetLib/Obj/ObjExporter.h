@@ -47,7 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_OBJEXPORTER_H_INC
 
 #include <assimp/types.h>
-#include <sstream>
+#include "Common/TextWriter.h"
+
+#include <string>
 #include <vector>
 #include <map>
 
@@ -62,14 +64,15 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 class ObjExporter {
 public:
-    /// Constructor for a specific scene to export
-    ObjExporter(const char* filename, const aiScene* pScene, bool noMtl=false);
+    /// Constructor for a specific scene to export. The output is kept in mOutput and
+    /// mOutputMat. Vertex data and faces are formatted by up to numThreads threads.
+    ObjExporter(const char* filename, const aiScene* pScene, bool noMtl=false, unsigned int numThreads = 1);
     ~ObjExporter();
     std::string GetMaterialLibName();
     std::string GetMaterialLibFileName();
     
-    /// public string-streams to write all output into
-    std::ostringstream mOutput, mOutputMat;
+    /// public writers to write all output into
+    TextWriter mOutput, mOutputMat;
 
 private:
     // intermediate data structures
@@ -95,7 +98,7 @@ private:
         std::vector<Face> faces;
     };
 
-    void WriteHeader(std::ostringstream& out);
+    void WriteHeader(TextWriter& out);
     void WriteMaterialFile();
     void WriteGeometryFile(bool noMtl=false);
     std::string GetMaterialName(unsigned int index);
@@ -105,6 +108,7 @@ private:
 private:
     std::string filename;
     const aiScene* const pScene;
+    const unsigned int numThreads;
 
     struct vertexData {
         aiVector3D vp;
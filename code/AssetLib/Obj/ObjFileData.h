@@ -52,36 +52,30 @@ namespace Assimp {
 namespace ObjFile {
 
 struct Object;
-struct Face;
 struct Material;
 
 // ------------------------------------------------------------------------------------------------
-//! \struct Face
-//! \brief  Data structure for a simple obj-face, describes discredit,l.ation and materials
+//! \struct FaceVertex
+//! \brief  Indices of the position, texture coordinate and normal of one face corner
 // ------------------------------------------------------------------------------------------------
-struct Face {
-    typedef std::vector<unsigned int> IndexArray;
-
-    //! Primitive type
-    aiPrimitiveType m_PrimitiveType;
-    //! Vertex indices
-    IndexArray m_vertices;
-    //! Normal indices
-    IndexArray m_normals;
-    //! Texture coordinates indices
-    IndexArray m_texturCoords;
-    //! Pointer to assigned material
-    Material *m_pMaterial;
-
-    //! \brief  Default constructor
-    Face(aiPrimitiveType pt = aiPrimitiveType_POLYGON) :
-            m_PrimitiveType(pt), m_vertices(), m_normals(), m_texturCoords(), m_pMaterial(0L) {
+struct FaceVertex {
+    //! Marks a missing texture coordinate or normal
+    static const unsigned int NoIndex = ~0u;
+
+    //! Vertex index
+    unsigned int m_vertex;
+    //! Texture coordinate index
+    unsigned int m_texturCoord;
+    //! Normal index
+    unsigned int m_normal;
+
+    explicit FaceVertex(unsigned int vertex = 0) :
+            m_vertex(vertex), m_texturCoord(NoIndex), m_normal(NoIndex) {
         // empty
     }
 
-    //! \brief  Destructor
-    ~Face() {
-        // empty
+    bool operator==(const FaceVertex &other) const {
+        return m_vertex == other.m_vertex && m_texturCoord == other.m_texturCoord && m_normal == other.m_normal;
     }
 };
 
@@ -198,8 +192,12 @@ struct Mesh {
     static const unsigned int NoMaterial = ~0u;
     /// The name for the mesh
     std::string m_name;
-    /// Array with pointer to all stored faces
-    std::vector<Face *> m_Faces;
+    /// Corners of all stored faces, one face after another
+    std::vector<FaceVertex> m_FaceVertices;
+    /// Offset of each face into m_FaceVertices, followed by the total
+    std::vector<unsigned int> m_FaceOffsets;
+    /// Primitive type of each face
+    std::vector<unsigned char> m_FaceTypes;
     /// Assigned material
     Material *m_pMaterial;
     /// Number of stored indices.
@@ -215,15 +213,39 @@ struct Mesh {
 
     /// Constructor
     explicit Mesh(const std::string &name) :
-            m_name(name), m_pMaterial(NULL), m_uiNumIndices(0), m_uiMaterialIndex(NoMaterial), m_hasNormals(false) {
+            m_name(name), m_FaceOffsets(1, 0u), m_pMaterial(NULL), m_uiNumIndices(0), m_uiMaterialIndex(NoMaterial), m_hasNormals(false) {
         memset(m_uiUVCoordinates, 0, sizeof(unsigned int) * AI_MAX_NUMBER_OF_TEXTURECOORDS);
     }
 
-    /// Destructor
-    ~Mesh() {
-        for (std::vector<Face *>::iterator it = m_Faces.begin();
-                it != m_Faces.end(); ++it) {
-            delete *it;
+    /// Returns the number of stored faces
+    size_t GetNumFaces() const {
+        return m_FaceTypes.size();
+    }
+
+    /// Returns the number of corners of a face
+    unsigned int GetNumFaceVertices(size_t face) const {
+        return m_FaceOffsets[face + 1] - m_FaceOffsets[face];
+    }
+
+    /// Returns the first corner of a face
+    const FaceVertex *GetFaceVertices(size_t face) const {
+        return &m_FaceVertices[m_FaceOffsets[face]];
+    }
+
+    /// Returns the primitive type of a face
+    aiPrimitiveType GetFaceType(size_t face) const {
+        return static_cast<aiPrimitiveType>(m_FaceTypes[face]);
+    }
+
+    /// Appends a face
+    void AddFace(aiPrimitiveType type, const FaceVertex *vertices, unsigned int numVertices) {
+        m_FaceVertices.insert(m_FaceVertices.end(), vertices, vertices + numVertices);
+        m_FaceOffsets.push_back(static_cast<unsigned int>(m_FaceVertices.size()));
+        m_FaceTypes.push_back(static_cast<unsigned char>(type));
+        m_uiNumIndices += numVertices;
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            m_uiUVCoordinates[0] += vertices[i].m_texturCoord != FaceVertex::NoIndex ? 1 : 0;
+            m_hasNormals |= vertices[i].m_normal != FaceVertex::NoIndex;
         }
     }
 };
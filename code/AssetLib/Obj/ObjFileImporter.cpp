@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileData.h"
 #include "ObjFileParser.h"
+#include "Common/MeshChunkSink.h"
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/ai_assert.h>
@@ -52,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <memory>
+#include <unordered_map>
 
 static const aiImporterDesc desc = {
     "Wavefront Object Importer",
@@ -72,10 +74,73 @@ namespace Assimp {
 
 using namespace std;
 
+namespace {
+
+// Hashes the (v,vt,vn) triplet of a face corner for vertex sharing
+struct FaceVertexHash {
+    size_t operator()(const ObjFile::FaceVertex &corner) const {
+        size_t hash = corner.m_vertex;
+        hash = hash * 31 + corner.m_texturCoord;
+        hash = hash * 31 + corner.m_normal;
+        return hash;
+    }
+};
+
+// Reads the whole stream looking for face, line and point statements and for vertex
+// normals, then rewinds it. Decides whether a streaming import can pass the vertices
+// on while parsing, as it can only if no face refers to them later.
+ObjFileParser::PointStreaming GetPointStreaming(IOStream &stream) {
+    enum { LineStart, Statement, Vertex, VertexNormal, Rest } state = LineStart;
+    bool hasNormals = false;
+    char buffer[4096];
+    size_t read;
+    while (0 != (read = stream.Read(buffer, 1, sizeof(buffer)))) {
+        for (size_t i = 0; i < read; ++i) {
+            const char c = buffer[i];
+            const bool separator = ' ' == c || '\t' == c;
+            if ('\n' == c || '\r' == c) {
+                state = LineStart;
+                continue;
+            }
+            switch (state) {
+            case LineStart:
+                if ('f' == c || 'l' == c || 'p' == c) {
+                    state = Statement;
+                } else if ('v' == c) {
+                    state = Vertex;
+                } else if (!separator) {
+                    state = Rest;
+                }
+                break;
+            case Statement:
+                if (separator) {
+                    stream.Seek(0, aiOrigin_SET);
+                    return ObjFileParser::PointStreaming_None;
+                }
+                state = Rest;
+                break;
+            case Vertex:
+                state = 'n' == c ? VertexNormal : Rest;
+                break;
+            case VertexNormal:
+                hasNormals |= separator;
+                state = Rest;
+                break;
+            case Rest:
+                break;
+            }
+        }
+    }
+    stream.Seek(0, aiOrigin_SET);
+    return hasNormals ? ObjFileParser::PointStreaming_WithNormals : ObjFileParser::PointStreaming_Points;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 //  Default constructor
 ObjFileImporter::ObjFileImporter() :
-        m_Buffer(), m_pRootObject(nullptr), m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {}
+        m_Buffer(), m_pRootObject(nullptr), m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())), m_shareVertices(false) {}
 
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
@@ -97,6 +162,13 @@ bool ObjFileImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bo
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Setup configuration properties
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    // AI_CONFIG_IMPORT_OBJ_SHARE_VERTICES
+    m_shareVertices = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_OBJ_SHARE_VERTICES, 0));
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
@@ -138,7 +210,7 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
     }
 
     // parse the file into a temporary representation
-    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file, m_importer);
 
     // And create the proper return structures out of it
     CreateDataFromImport(parser.GetModel(), pScene);
@@ -154,6 +226,57 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Obj-file streaming import implementation
+void ObjFileImporter::InternReadStreamed(const std::string &file, IOSystem *pIOHandler, MeshChunkSink &sink) {
+    static const std::string mode = "rb";
+    std::unique_ptr<IOStream> fileStream(pIOHandler->Open(file, mode));
+    if (!fileStream.get()) {
+        throw DeadlyImportError("Failed to open file " + file + ".");
+    }
+    if (fileStream->FileSize() < ObjMinSize) {
+        throw DeadlyImportError("OBJ-file is too small.");
+    }
+
+    // a file without faces is a point cloud, its vertices go straight through
+    const ObjFileParser::PointStreaming pointStreaming = GetPointStreaming(*fileStream);
+
+    IOStreamBuffer<char> streamedBuffer;
+    streamedBuffer.open(fileStream.get());
+
+    std::string modelName = file;
+    const std::string::size_type pos = file.find_last_of("\\/");
+    bool pushed = false;
+    if (pos != std::string::npos) {
+        modelName = file.substr(pos + 1, file.size() - pos - 1);
+        const std::string folderName = file.substr(0, pos);
+        if (!folderName.empty()) {
+            pIOHandler->PushDirectory(folderName);
+            pushed = true;
+        }
+    }
+
+    // the faces are passed on while parsing, only the vertex data stays in memory
+    std::unique_ptr<ObjFileParser> parser;
+    try {
+        parser.reset(new ObjFileParser(streamedBuffer, modelName, pIOHandler, m_progress, file, m_importer, &sink, pointStreaming));
+    } catch (...) {
+        if (pushed) {
+            pIOHandler->PopDirectory();
+        }
+        throw;
+    }
+    if (pushed) {
+        pIOHandler->PopDirectory();
+    }
+    streamedBuffer.close();
+
+    // points still waiting for their normal lack one
+    if (ObjFileParser::PointStreaming_WithNormals == pointStreaming && !parser->GetModel()->m_Vertices.empty()) {
+        throw DeadlyImportError("OBJ: vertex normal index out of range");
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Create the data from parsed obj-file
 void ObjFileImporter::CreateDataFromImport(const ObjFile::Model *pModel, aiScene *pScene) {
@@ -320,7 +443,8 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
         return NULL;
     }
 
-    if (pObjMesh->m_Faces.empty()) {
+    const size_t numSourceFaces = pObjMesh->GetNumFaces();
+    if (0 == numSourceFaces) {
         return NULL;
     }
 
@@ -329,65 +453,89 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
         pMesh->mName.Set(pObjMesh->m_name);
     }
 
-    for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++) {
-        ObjFile::Face *const inp = pObjMesh->m_Faces[index];
-        ai_assert(NULL != inp);
-
-        if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size() - 1);
+    // lines are split into segments, point lists into single points
+    size_t numIndices = 0;
+    for (size_t index = 0; index < numSourceFaces; index++) {
+        const unsigned int numCorners = pObjMesh->GetNumFaceVertices(index);
+        const aiPrimitiveType type = pObjMesh->GetFaceType(index);
+        if (type == aiPrimitiveType_LINE) {
+            pMesh->mNumFaces += numCorners - 1;
+            numIndices += 2 * (numCorners - 1);
             pMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-        } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size());
+        } else if (type == aiPrimitiveType_POINT) {
+            pMesh->mNumFaces += numCorners;
+            numIndices += numCorners;
             pMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
         } else {
             ++pMesh->mNumFaces;
-            if (inp->m_vertices.size() > 3) {
+            numIndices += numCorners;
+            if (numCorners > 3) {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
             } else {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
             }
         }
     }
+    if (0 == pMesh->mNumFaces) {
+        throw DeadlyImportError("OBJ: no vertices");
+    }
 
-    unsigned int uiIdxCount(0u);
-    if (pMesh->mNumFaces > 0) {
-        pMesh->mFaces = new aiFace[pMesh->mNumFaces];
-        if (pObjMesh->m_uiMaterialIndex != ObjFile::Mesh::NoMaterial) {
-            pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
-        }
-
-        unsigned int outIndex(0);
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    if (pObjMesh->m_uiMaterialIndex != ObjFile::Mesh::NoMaterial) {
+        pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
+    }
 
-        // Copy all data from all stored meshes
-        for (auto &face : pObjMesh->m_Faces) {
-            ObjFile::Face *const inp = face;
-            if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-                for (size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
-                    aiFace &f = pMesh->mFaces[outIndex++];
-                    uiIdxCount += f.mNumIndices = 2;
-                    f.mIndices = new unsigned int[2];
-                }
-                continue;
-            } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-                for (size_t i = 0; i < inp->m_vertices.size(); ++i) {
-                    aiFace &f = pMesh->mFaces[outIndex++];
-                    uiIdxCount += f.mNumIndices = 1;
-                    f.mIndices = new unsigned int[1];
-                }
-                continue;
+    // Each face index gets a vertex of its own, unless faces share the
+    // vertices with equal (v,vt,vn) triplets
+    std::vector<ObjFile::FaceVertex> vertices;
+    std::unordered_map<ObjFile::FaceVertex, unsigned int, FaceVertexHash> vertexMap;
+    if (!m_shareVertices) {
+        vertices.reserve(numIndices);
+    }
+    auto addVertex = [&](const ObjFile::FaceVertex &corner) -> unsigned int {
+        const unsigned int newIndex = static_cast<unsigned int>(vertices.size());
+        if (m_shareVertices) {
+            auto it = vertexMap.insert(std::make_pair(corner, newIndex));
+            if (!it.second) {
+                return it.first->second;
             }
-
-            aiFace *pFace = &pMesh->mFaces[outIndex++];
-            const unsigned int uiNumIndices = (unsigned int)face->m_vertices.size();
-            uiIdxCount += pFace->mNumIndices = (unsigned int)uiNumIndices;
-            if (pFace->mNumIndices > 0) {
-                pFace->mIndices = new unsigned int[uiNumIndices];
+        }
+        vertices.push_back(corner);
+        return newIndex;
+    };
+
+    unsigned int outIndex = 0;
+    for (size_t index = 0; index < numSourceFaces; index++) {
+        const ObjFile::FaceVertex *corners = pObjMesh->GetFaceVertices(index);
+        const unsigned int numCorners = pObjMesh->GetNumFaceVertices(index);
+        const aiPrimitiveType type = pObjMesh->GetFaceType(index);
+        if (type == aiPrimitiveType_LINE) {
+            for (unsigned int i = 0; i + 1 < numCorners; ++i) {
+                aiFace &f = pMesh->mFaces[outIndex++];
+                f.mNumIndices = 2;
+                f.mIndices = new unsigned int[2];
+                f.mIndices[0] = addVertex(corners[i]);
+                f.mIndices[1] = addVertex(corners[i + 1]);
+            }
+        } else if (type == aiPrimitiveType_POINT) {
+            for (unsigned int i = 0; i < numCorners; ++i) {
+                aiFace &f = pMesh->mFaces[outIndex++];
+                f.mNumIndices = 1;
+                f.mIndices = new unsigned int[1];
+                f.mIndices[0] = addVertex(corners[i]);
+            }
+        } else {
+            aiFace &f = pMesh->mFaces[outIndex++];
+            f.mNumIndices = numCorners;
+            f.mIndices = new unsigned int[numCorners];
+            for (unsigned int i = 0; i < numCorners; ++i) {
+                f.mIndices[i] = addVertex(corners[i]);
             }
         }
     }
 
     // Create mesh vertices
-    createVertexArray(pModel, pData, meshIndex, pMesh.get(), uiIdxCount);
+    createVertexArray(pModel, pObjMesh, vertices, pMesh.get());
 
     return pMesh.release();
 }
@@ -395,28 +543,14 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
 // ------------------------------------------------------------------------------------------------
 //  Creates a vertex array
 void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
-        const ObjFile::Object *pCurrentObject,
-        unsigned int uiMeshIndex,
-        aiMesh *pMesh,
-        unsigned int numIndices) {
-    // Checking preconditions
-    ai_assert(NULL != pCurrentObject);
-
-    // Break, if no faces are stored in object
-    if (pCurrentObject->m_Meshes.empty())
-        return;
-
-    // Get current mesh
-    ObjFile::Mesh *pObjMesh = pModel->m_Meshes[uiMeshIndex];
-    if (NULL == pObjMesh || pObjMesh->m_uiNumIndices < 1) {
-        return;
-    }
-
+        const ObjFile::Mesh *pObjMesh,
+        const std::vector<ObjFile::FaceVertex> &vertices,
+        aiMesh *pMesh) {
     // Copy vertices of this mesh instance
-    pMesh->mNumVertices = numIndices;
+    pMesh->mNumVertices = static_cast<unsigned int>(vertices.size());
     if (pMesh->mNumVertices == 0) {
         throw DeadlyImportError("OBJ: no vertices");
-    } else if (pMesh->mNumVertices > AI_MAX_VERTICES) {
+    } else if (vertices.size() > AI_MAX_VERTICES) {
         throw DeadlyImportError("OBJ: Too many vertices");
     }
     pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
@@ -437,87 +571,35 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
 
     // Copy vertices, normals and textures into aiMesh instance
     bool normalsok = true, uvok = true;
-    unsigned int newIndex = 0, outIndex = 0;
-    for (auto sourceFace : pObjMesh->m_Faces) {
-        // Copy all index arrays
-        for (size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < sourceFace->m_vertices.size(); vertexIndex++) {
-            const unsigned int vertex = sourceFace->m_vertices.at(vertexIndex);
-            if (vertex >= pModel->m_Vertices.size()) {
-                throw DeadlyImportError("OBJ: vertex index out of range");
-            }
-
-            if (pMesh->mNumVertices <= newIndex) {
-                throw DeadlyImportError("OBJ: bad vertex index");
-            }
-
-            pMesh->mVertices[newIndex] = pModel->m_Vertices[vertex];
-
-            // Copy all normals
-            if (normalsok && !pModel->m_Normals.empty() && vertexIndex < sourceFace->m_normals.size()) {
-                const unsigned int normal = sourceFace->m_normals.at(vertexIndex);
-                if (normal >= pModel->m_Normals.size()) {
-                    normalsok = false;
-                } else {
-                    pMesh->mNormals[newIndex] = pModel->m_Normals[normal];
-                }
-            }
-
-            // Copy all vertex colors
-            if (!pModel->m_VertexColors.empty()) {
-                const aiVector3D &color = pModel->m_VertexColors[vertex];
-                pMesh->mColors[0][newIndex] = aiColor4D(color.x, color.y, color.z, 1.0);
-            }
-
-            // Copy all texture coordinates
-            if (uvok && !pModel->m_TextureCoord.empty() && vertexIndex < sourceFace->m_texturCoords.size()) {
-                const unsigned int tex = sourceFace->m_texturCoords.at(vertexIndex);
+    for (unsigned int newIndex = 0; newIndex < pMesh->mNumVertices; ++newIndex) {
+        const ObjFile::FaceVertex &corner = vertices[newIndex];
+        if (corner.m_vertex >= pModel->m_Vertices.size()) {
+            throw DeadlyImportError("OBJ: vertex index out of range");
+        }
+        pMesh->mVertices[newIndex] = pModel->m_Vertices[corner.m_vertex];
 
-                if (tex >= pModel->m_TextureCoord.size()) {
-                    uvok = false;
-                } else {
-                    const aiVector3D &coord3d = pModel->m_TextureCoord[tex];
-                    pMesh->mTextureCoords[0][newIndex] = aiVector3D(coord3d.x, coord3d.y, coord3d.z);
-                }
+        // Copy all normals
+        if (normalsok && pMesh->mNormals && corner.m_normal != ObjFile::FaceVertex::NoIndex) {
+            if (corner.m_normal >= pModel->m_Normals.size()) {
+                normalsok = false;
+            } else {
+                pMesh->mNormals[newIndex] = pModel->m_Normals[corner.m_normal];
             }
+        }
 
-            // Get destination face
-            aiFace *pDestFace = &pMesh->mFaces[outIndex];
-
-            const bool last = (vertexIndex == sourceFace->m_vertices.size() - 1);
-            if (sourceFace->m_PrimitiveType != aiPrimitiveType_LINE || !last) {
-                pDestFace->mIndices[outVertexIndex] = newIndex;
-                outVertexIndex++;
-            }
+        // Copy all vertex colors
+        if (pMesh->mColors[0] && corner.m_vertex < pModel->m_VertexColors.size()) {
+            const aiVector3D &color = pModel->m_VertexColors[corner.m_vertex];
+            pMesh->mColors[0][newIndex] = aiColor4D(color.x, color.y, color.z, 1.0);
+        }
 
-            if (sourceFace->m_PrimitiveType == aiPrimitiveType_POINT) {
-                outIndex++;
-                outVertexIndex = 0;
-            } else if (sourceFace->m_PrimitiveType == aiPrimitiveType_LINE) {
-                outVertexIndex = 0;
-
-                if (!last)
-                    outIndex++;
-
-                if (vertexIndex) {
-                    if (!last) {
-                        pMesh->mVertices[newIndex + 1] = pMesh->mVertices[newIndex];
-                        if (!sourceFace->m_normals.empty() && !pModel->m_Normals.empty()) {
-                            pMesh->mNormals[newIndex + 1] = pMesh->mNormals[newIndex];
-                        }
-                        if (!pModel->m_TextureCoord.empty()) {
-                            for (size_t i = 0; i < pMesh->GetNumUVChannels(); i++) {
-                                pMesh->mTextureCoords[i][newIndex + 1] = pMesh->mTextureCoords[i][newIndex];
-                            }
-                        }
-                        ++newIndex;
-                    }
-
-                    pDestFace[-1].mIndices[1] = newIndex;
-                }
-            } else if (last) {
-                outIndex++;
+        // Copy all texture coordinates
+        if (uvok && pMesh->mTextureCoords[0] && corner.m_texturCoord != ObjFile::FaceVertex::NoIndex) {
+            if (corner.m_texturCoord >= pModel->m_TextureCoord.size()) {
+                uvok = false;
+            } else {
+                pMesh->mTextureCoords[0][newIndex] = pModel->m_TextureCoord[corner.m_texturCoord];
             }
-            ++newIndex;
         }
     }
 
@@ -53,6 +53,8 @@ namespace Assimp {
 namespace ObjFile {
 struct Object;
 struct Model;
+struct Mesh;
+struct FaceVertex;
 } // namespace ObjFile
 
 // ------------------------------------------------------------------------------------------------
@@ -72,6 +74,9 @@ public:
     /// \remark See BaseImporter::CanRead() for details.
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const;
 
+    /// \brief  Reads the importer configuration.
+    void SetupProperties(const Importer *pImp);
+
 private:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const;
@@ -79,6 +84,9 @@ private:
     //! \brief  File import implementation.
     void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler);
 
+    //! \brief  Passes the faces on to the sink while parsing.
+    void InternReadStreamed(const std::string &pFile, IOSystem *pIOHandler, MeshChunkSink &sink);
+
     //! \brief  Create the data from imported content.
     void CreateDataFromImport(const ObjFile::Model *pModel, aiScene *pScene);
 
@@ -90,9 +98,9 @@ private:
     aiMesh *createTopology(const ObjFile::Model *pModel, const ObjFile::Object *pData,
             unsigned int uiMeshIndex);
 
-    //! \brief  Creates vertices from model.
-    void createVertexArray(const ObjFile::Model *pModel, const ObjFile::Object *pCurrentObject,
-            unsigned int uiMeshIndex, aiMesh *pMesh, unsigned int numIndices);
+    //! \brief  Creates the vertices of a mesh, one for each (v,vt,vn) triplet.
+    void createVertexArray(const ObjFile::Model *pModel, const ObjFile::Mesh *pObjMesh,
+            const std::vector<ObjFile::FaceVertex> &vertices, aiMesh *pMesh);
 
     //! \brief  Object counter helper method.
     void countObjects(const std::vector<ObjFile::Object *> &rObjects, int &iNumMeshes);
@@ -113,6 +121,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Faces share vertices with equal (v,vt,vn) triplets
+    bool m_shareVertices;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_OBJ_IMPORTER
 
 #include "ObjFileParser.h"
+#include "Common/MeshChunkSink.h"
 #include "ObjFileData.h"
 #include "ObjFileMtlImporter.h"
 #include "ObjTools.h"
@@ -50,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <utility>
@@ -66,13 +68,20 @@ ObjFileParser::ObjFileParser() :
         m_buffer(),
         m_pIO(nullptr),
         m_progress(nullptr),
-        m_originalObjFileName() {
+        m_importer(nullptr),
+        m_originalObjFileName(),
+        m_chunkSink(nullptr),
+        m_pointStreaming(PointStreaming_None),
+        m_numStreamedPoints(0),
+        m_vertexBase(0),
+        m_normalBase(0) {
     std::fill_n(m_buffer, Buffersize, '\0');
 }
 
 ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName,
         IOSystem *io, ProgressHandler *progress,
-        const std::string &originalObjFileName) :
+        const std::string &originalObjFileName, const Importer *importer, MeshChunkSink *chunkSink,
+        PointStreaming pointStreaming) :
         m_DataIt(),
         m_DataItEnd(),
         m_pModel(nullptr),
@@ -80,7 +89,13 @@ ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::stri
         m_buffer(),
         m_pIO(io),
         m_progress(progress),
-        m_originalObjFileName(originalObjFileName) {
+        m_importer(importer),
+        m_originalObjFileName(originalObjFileName),
+        m_chunkSink(chunkSink),
+        m_pointStreaming(nullptr != chunkSink ? pointStreaming : PointStreaming_None),
+        m_numStreamedPoints(0),
+        m_vertexBase(0),
+        m_normalBase(0) {
     std::fill_n(m_buffer, Buffersize, '\0');
 
     // Create the model instance to store all the data
@@ -130,6 +145,9 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
             lastFilePos = filePos;
             progressCounter++;
             m_progress->UpdateFileRead(processed, progressTotal);
+            if (m_importer && m_importer->IsCancelRequested()) {
+                throw DeadlyImportError("Import cancelled");
+            }
         }
 
         // parse line
@@ -149,6 +167,9 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
                     // read vertex and vertex-color
                     getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
                 }
+                if (PointStreaming_None != m_pointStreaming) {
+                    streamPoints();
+                }
             } else if (*m_DataIt == 't') {
                 // read in texture coordinate ( 2D or 3D )
                 ++m_DataIt;
@@ -158,6 +179,9 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
                 // Read in normal vector definition
                 ++m_DataIt;
                 getVector3(m_pModel->m_Normals);
+                if (PointStreaming_WithNormals == m_pointStreaming) {
+                    streamPoints();
+                }
             }
         } break;
 
@@ -413,8 +437,9 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
         return;
     }
 
-    ObjFile::Face *face = new ObjFile::Face(type);
-    bool hasNormal = false;
+    // the corners are collected in a reused buffer and copied into the mesh in one go
+    std::vector<ObjFile::FaceVertex> &corners = m_faceVertices;
+    corners.clear();
 
     const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
     const int vtSize = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
@@ -453,52 +478,37 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
             if (iPos == 1 && !vt && vn)
                 iPos = 2; // skip texture coords for normals if there are no tex coords
 
-            if (iVal > 0) {
-                // Store parsed index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(iVal - 1);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(iVal - 1);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(iVal - 1);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else if (iVal < 0) {
-                // Store relatively index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(vSize + iVal);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(vtSize + iVal);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(vnSize + iVal);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else {
+            if (0 == iVal) {
                 //On error, std::atoi will return 0 which is not a valid value
-                delete face;
                 throw DeadlyImportError("OBJ: Invalid face indice");
             }
+
+            // Store parsed index, negative ones are relative to the end
+            if (0 == iPos) {
+                corners.push_back(ObjFile::FaceVertex(iVal > 0 ? iVal - 1 : vSize + iVal));
+            } else if (1 == iPos && !corners.empty()) {
+                corners.back().m_texturCoord = iVal > 0 ? iVal - 1 : vtSize + iVal;
+            } else if (2 == iPos && !corners.empty()) {
+                corners.back().m_normal = iVal > 0 ? iVal - 1 : vnSize + iVal;
+            } else {
+                reportErrorTokenInFace();
+            }
         }
         m_DataIt += iStep;
     }
 
-    if (face->m_vertices.empty()) {
+    if (corners.empty()) {
         ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
         // skip line and clean up
         m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        delete face;
         return;
     }
 
-    // Set active material, if one set
-    if (NULL != m_pModel->m_pCurrentMaterial) {
-        face->m_pMaterial = m_pModel->m_pCurrentMaterial;
-    } else {
-        face->m_pMaterial = m_pModel->m_pDefaultMaterial;
+    // In streaming mode the face isn't kept, materials and groups are ignored
+    if (nullptr != m_chunkSink) {
+        streamFace(type, corners);
+        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+        return;
     }
 
     // Create a default object, if nothing is there
@@ -512,16 +522,103 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
     }
 
     // Store the face
-    m_pModel->m_pCurrentMesh->m_Faces.push_back(face);
-    m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_vertices.size();
-    m_pModel->m_pCurrentMesh->m_uiUVCoordinates[0] += (unsigned int)face->m_texturCoords.size();
-    if (!m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal) {
-        m_pModel->m_pCurrentMesh->m_hasNormals = true;
-    }
+    m_pModel->m_pCurrentMesh->AddFace(type, corners.data(), static_cast<unsigned int>(corners.size()));
+
     // Skip the rest of the line
     m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
+void ObjFileParser::streamFace(aiPrimitiveType type, const std::vector<ObjFile::FaceVertex> &corners) {
+    const std::vector<aiVector3D> &vertices = m_pModel->m_Vertices;
+    const std::vector<aiVector3D> &normals = m_pModel->m_Normals;
+    const std::vector<aiVector3D> &texCoords = m_pModel->m_TextureCoord;
+    const std::vector<aiVector3D> &colors = m_pModel->m_VertexColors;
+
+    // one vertex per corner, like ObjFileImporter::createTopology()
+    const unsigned int numCorners = static_cast<unsigned int>(corners.size());
+    m_chunkSink->SetNumUVComponents(m_pModel->m_TextureCoordDim);
+    m_chunkSink->Reserve(numCorners);
+    m_streamIndices.resize(numCorners);
+    for (unsigned int i = 0; i < numCorners; ++i) {
+        const ObjFile::FaceVertex &corner = corners[i];
+        if (corner.m_vertex >= vertices.size()) {
+            throw DeadlyImportError("OBJ: vertex index out of range");
+        }
+
+        const aiVector3D *normal = nullptr;
+        if (corner.m_normal != ObjFile::FaceVertex::NoIndex) {
+            if (corner.m_normal >= normals.size()) {
+                throw DeadlyImportError("OBJ: vertex normal index out of range");
+            }
+            normal = &normals[corner.m_normal];
+        }
+
+        const aiVector3D *texCoord = nullptr;
+        if (corner.m_texturCoord != ObjFile::FaceVertex::NoIndex) {
+            if (corner.m_texturCoord >= texCoords.size()) {
+                throw DeadlyImportError("OBJ: texture coordinate index out of range");
+            }
+            texCoord = &texCoords[corner.m_texturCoord];
+        }
+
+        aiColor4D color;
+        const bool hasColor = corner.m_vertex < colors.size();
+        if (hasColor) {
+            const aiVector3D &c = colors[corner.m_vertex];
+            color = aiColor4D(c.x, c.y, c.z, 1.0);
+        }
+        m_streamIndices[i] = m_chunkSink->AddVertex(vertices[corner.m_vertex], normal,
+                hasColor ? &color : nullptr, texCoord);
+    }
+
+    // points and lines are split up like in ObjFileImporter::createTopology()
+    if (aiPrimitiveType_POINT == type) {
+        for (unsigned int i = 0; i < numCorners; ++i) {
+            m_chunkSink->AddFace(&m_streamIndices[i], 1);
+        }
+    } else if (aiPrimitiveType_LINE == type) {
+        for (unsigned int i = 0; i + 1 < numCorners; ++i) {
+            m_chunkSink->AddFace(&m_streamIndices[i], 2);
+        }
+    } else {
+        m_chunkSink->AddFace(m_streamIndices.data(), numCorners);
+    }
+}
+
+void ObjFileParser::streamPoints() {
+    std::vector<aiVector3D> &vertices = m_pModel->m_Vertices;
+    std::vector<aiVector3D> &normals = m_pModel->m_Normals;
+    std::vector<aiVector3D> &colors = m_pModel->m_VertexColors;
+
+    // Points with normals need both, whichever array is ahead is kept until the other one
+    // catches up. Interleaved files need no memory beyond the chunk this way.
+    const bool withNormals = PointStreaming_WithNormals == m_pointStreaming;
+    size_t end = m_vertexBase + vertices.size();
+    if (withNormals) {
+        end = std::min(end, m_normalBase + normals.size());
+    }
+    for (; m_numStreamedPoints < end; ++m_numStreamedPoints) {
+        const size_t vertex = m_numStreamedPoints - m_vertexBase;
+        aiColor4D color;
+        if (vertex < colors.size()) {
+            color = aiColor4D(colors[vertex].x, colors[vertex].y, colors[vertex].z, 1.0);
+        }
+        m_chunkSink->Reserve(1);
+        m_chunkSink->AddVertex(vertices[vertex], withNormals ? &normals[m_numStreamedPoints - m_normalBase] : nullptr,
+                vertex < colors.size() ? &color : nullptr);
+    }
+
+    if (m_numStreamedPoints == m_vertexBase + vertices.size()) {
+        vertices.clear();
+        colors.clear();
+        m_vertexBase = m_numStreamedPoints;
+    }
+    if (withNormals && m_numStreamedPoints == m_normalBase + normals.size()) {
+        normals.clear();
+        m_normalBase = m_numStreamedPoints;
+    }
+}
+
 void ObjFileParser::getMaterialDesc() {
     // Get next data for material data
     m_DataIt = getNextToken<DataArrayIt>(m_DataIt, m_DataItEnd);
@@ -817,7 +914,7 @@ bool ObjFileParser::needsNewMesh(const std::string &materialName) {
     if (curMatIdx != int(ObjFile::Mesh::NoMaterial) && curMatIdx != matIdx
             // no need create a new mesh if no faces in current
             // lets say 'usemtl' goes straight after 'g'
-            && !m_pModel->m_pCurrentMesh->m_Faces.empty()) {
+            && m_pModel->m_pCurrentMesh->GetNumFaces() != 0) {
         // New material -> only one material per mesh, so we need to create a new
         // material
         newMat = true;
@@ -56,6 +56,7 @@ namespace ObjFile {
 struct Model;
 struct Object;
 struct Material;
+struct FaceVertex;
 struct Point3;
 struct Point2;
 } // namespace ObjFile
@@ -63,6 +64,8 @@ struct Point2;
 class ObjFileImporter;
 class IOSystem;
 class ProgressHandler;
+class Importer;
+class MeshChunkSink;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -74,10 +77,19 @@ public:
     typedef std::vector<char>::const_iterator ConstDataArrayIt;
 
 public:
+    /// How a streaming parser passes on the vertices of a file without faces
+    enum PointStreaming {
+        PointStreaming_None,        ///< The file has faces, the vertices are kept for them
+        PointStreaming_Points,      ///< The vertices are passed on as points while parsing
+        PointStreaming_WithNormals  ///< As above, each once the normal of the same index is known
+    };
+
     /// @brief  The default constructor.
     ObjFileParser();
     /// @brief  Constructor with data array.
-    ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName);
+    /// If chunkSink is given, the faces are passed on to it instead of being stored in the model.
+    ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName,
+            const Importer *importer = nullptr, MeshChunkSink *chunkSink = nullptr, PointStreaming pointStreaming = PointStreaming_None);
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -135,6 +147,10 @@ protected:
     bool needsNewMesh(const std::string &rMaterialName);
     /// Error report in token
     void reportErrorTokenInFace();
+    /// Passes a face on to the chunk sink.
+    void streamFace(aiPrimitiveType type, const std::vector<ObjFile::FaceVertex> &corners);
+    /// Passes the vertices read so far on to the chunk sink as points.
+    void streamPoints();
 
 private:
     // Copy and assignment constructor should be private
@@ -156,8 +172,22 @@ private:
     IOSystem *m_pIO;
     //! Pointer to progress handler
     ProgressHandler *m_progress;
+    /// Importer polled for cancellation, may be nullptr
+    const Importer *m_importer;
     /// Path to the current model, name of the obj file where the buffer comes from
     const std::string m_originalObjFileName;
+    /// Receives the faces in streaming mode, may be nullptr
+    MeshChunkSink *m_chunkSink;
+    /// Whether the vertices are passed on to the chunk sink as points
+    PointStreaming m_pointStreaming;
+    /// Number of points passed on to the chunk sink
+    size_t m_numStreamedPoints;
+    /// File index of the first entry of the model's vertex and normal arrays, while streaming points
+    size_t m_vertexBase, m_normalBase;
+    /// Corners of the face being parsed
+    std::vector<ObjFile::FaceVertex> m_faceVertices;
+    /// Chunk indices of the current streamed face
+    std::vector<unsigned int> m_streamIndices;
 };
 
 } // Namespace Assimp
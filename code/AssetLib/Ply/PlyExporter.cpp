@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/version.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include <assimp/qnan.h>
 
 
@@ -66,22 +67,19 @@ template<> const char* type_of(double&) { return "double"; }
 
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
-void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
+void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene);
+    const unsigned int numThreads = GetNumWorkerThreads(pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
+    // invoke the exporter
+    PlyExporter exporter(pFile, pScene, false, numThreads);
 
     // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
-
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    exporter.mOutput.WriteTo(outfile.get());
 }
 
 void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
@@ -94,8 +92,7 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
     if (outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
-
-    outfile->Write(exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()), 1);
+    exporter.mOutput.WriteTo(outfile.get());
 }
 
 #define PLY_EXPORT_HAS_NORMALS 0x1
@@ -104,15 +101,12 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary, unsigned int _numThreads)
+: mOutput()
+, filename(_filename)
+, numThreads(_numThreads)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
     unsigned int faces = 0u, vertices = 0u, components = 0u;
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
         const aiMesh& m = *pScene->mMeshes[i];
@@ -256,51 +250,52 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
 
     // If a component (for instance normal vectors) is present in at least one mesh in the scene,
     // then default values are written for meshes that do not contain this component.
-    for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-        mOutput <<
+    // vertices are independent of each other, so they can be formatted in parallel
+    FormatParallel(mOutput, numThreads, m->mNumVertices, [&](TextWriter& out, size_t i) {
+        out <<
             m->mVertices[i].x << " " <<
             m->mVertices[i].y << " " <<
             m->mVertices[i].z
         ;
         if(components & PLY_EXPORT_HAS_NORMALS) {
             if (m->HasNormals() && is_not_qnan(m->mNormals[i].x) && std::fabs(m->mNormals[i].x) != inf) {
-                mOutput <<
+                out <<
                     " " << m->mNormals[i].x <<
                     " " << m->mNormals[i].y <<
                     " " << m->mNormals[i].z;
             }
             else {
-                mOutput << " 0.0 0.0 0.0";
+                out << " 0.0 0.0 0.0";
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
             if (m->HasTextureCoords(c)) {
-                mOutput <<
+                out <<
                     " " << m->mTextureCoords[c][i].x <<
                     " " << m->mTextureCoords[c][i].y;
             }
             else {
-                mOutput << " -1.0 -1.0";
+                out << " -1.0 -1.0";
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
             if (m->HasVertexColors(c)) {
-                mOutput <<
+                out <<
                     " " << (int)(m->mColors[c][i].r * 255) <<
                     " " << (int)(m->mColors[c][i].g * 255) <<
                     " " << (int)(m->mColors[c][i].b * 255) <<
                     " " << (int)(m->mColors[c][i].a * 255);
             }
             else {
-                mOutput << " 0 0 0";
+                out << " 0 0 0";
             }
         }
 
         if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
             if (m->HasTangentsAndBitangents()) {
-                mOutput <<
+                out <<
                 " " << m->mTangents[i].x <<
                 " " << m->mTangents[i].y <<
                 " " << m->mTangents[i].z <<
@@ -310,12 +305,12 @@ void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
                 ;
             }
             else {
-                mOutput << " 0.0 0.0 0.0 0.0 0.0 0.0";
+                out << " 0.0 0.0 0.0 0.0 0.0 0.0";
             }
         }
 
-        mOutput << endl;
-    }
+        out << endl;
+    });
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -327,42 +322,42 @@ void PlyExporter::WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
     aiVector2D defaultUV(-1, -1);
     aiColor4D defaultColor(-1, -1, -1, -1);
     for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-        mOutput.write(reinterpret_cast<const char*>(&m->mVertices[i].x), 12);
+        mOutput.Write(reinterpret_cast<const char*>(&m->mVertices[i].x), 12);
         if (components & PLY_EXPORT_HAS_NORMALS) {
             if (m->HasNormals()) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mNormals[i].x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&m->mNormals[i].x), 12);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
             if (m->HasTextureCoords(c)) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mTextureCoords[c][i].x), 8);
+                mOutput.Write(reinterpret_cast<const char*>(&m->mTextureCoords[c][i].x), 8);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultUV.x), 8);
+                mOutput.Write(reinterpret_cast<const char*>(&defaultUV.x), 8);
             }
         }
 
         for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
             if (m->HasVertexColors(c)) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mColors[c][i].r), 16);
+                mOutput.Write(reinterpret_cast<const char*>(&m->mColors[c][i].r), 16);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultColor.r), 16);
+                mOutput.Write(reinterpret_cast<const char*>(&defaultColor.r), 16);
             }
         }
 
         if (components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
             if (m->HasTangentsAndBitangents()) {
-                mOutput.write(reinterpret_cast<const char*>(&m->mTangents[i].x), 12);
-                mOutput.write(reinterpret_cast<const char*>(&m->mBitangents[i].x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&m->mTangents[i].x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&m->mBitangents[i].x), 12);
             }
             else {
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
-                mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+                mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
             }
         }
     }
@@ -371,27 +366,27 @@ void PlyExporter::WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
 // ------------------------------------------------------------------------------------------------
 void PlyExporter::WriteMeshIndices(const aiMesh* m, unsigned int offset)
 {
-    for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+    FormatParallel(mOutput, numThreads, m->mNumFaces, [&](TextWriter& out, size_t i) {
         const aiFace& f = m->mFaces[i];
-        mOutput << f.mNumIndices;
+        out << f.mNumIndices;
         for(unsigned int c = 0; c < f.mNumIndices; ++c) {
-            mOutput << " " << (f.mIndices[c] + offset);
+            out << " " << (f.mIndices[c] + offset);
         }
-        mOutput << endl;
-    }
+        out << endl;
+    });
 }
 
 // Generic method in case we want to use different data types for the indices or make this configurable.
 template<typename NumIndicesType, typename IndexType>
-void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, std::ostringstream& output)
+void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, TextWriter& output)
 {
     for (unsigned int i = 0; i < m->mNumFaces; ++i) {
         const aiFace& f = m->mFaces[i];
         NumIndicesType numIndices = static_cast<NumIndicesType>(f.mNumIndices);
-        output.write(reinterpret_cast<const char*>(&numIndices), sizeof(NumIndicesType));
+        output.Write(reinterpret_cast<const char*>(&numIndices), sizeof(NumIndicesType));
         for (unsigned int c = 0; c < f.mNumIndices; ++c) {
             IndexType index = f.mIndices[c] + offset;
-            output.write(reinterpret_cast<const char*>(&index), sizeof(IndexType));
+            output.Write(reinterpret_cast<const char*>(&index), sizeof(IndexType));
         }
     }
 }
@@ -46,7 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "Common/TextWriter.h"
+
+#include <string>
 
 struct aiScene;
 struct aiNode;
@@ -59,14 +61,15 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 class PlyExporter {
 public:
-    /// The class constructor for a specific scene to export
-    PlyExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    /// The class constructor for a specific scene to export. The output is kept in mOutput.
+    /// Vertices and faces are formatted by up to numThreads threads.
+    PlyExporter(const char* filename, const aiScene* pScene, bool binary = false, unsigned int numThreads = 1);
     /// The class destructor, empty.
     ~PlyExporter();
 
 public:
-    /// public string-streams to write all output into:
-    std::ostringstream mOutput;
+    /// public writer to write all output into:
+    TextWriter mOutput;
 
 private:
     void WriteMeshVerts(const aiMesh* m, unsigned int components);
@@ -76,6 +79,7 @@ private:
 
 private:
     const std::string filename;  // tHE FILENAME
+    const unsigned int numThreads;
     const std::string endl;      // obviously, this endl() doesn't flush() the stream
 
 private:
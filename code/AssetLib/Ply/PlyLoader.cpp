@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "Common/MeshChunkSink.h"
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
@@ -88,7 +89,9 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mChunkSink(nullptr),
+        mStreamFaces(false) {
     // empty
 }
 
@@ -146,8 +149,8 @@ static bool isBigEndian(const char *szMe) {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Imports the given file into the given scene structure.
-void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
+// Checks the header and builds the DOM
+void PLYImporter::ParseFile(const std::string &pFile, IOSystem *pIOHandler, PLY::DOM &sPlyDom) {
     const std::string mode = "rb";
     std::unique_ptr<IOStream> fileStream(pIOHandler->Open(pFile, mode));
     if (!fileStream.get()) {
@@ -183,7 +186,6 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     SkipSpacesAndLineEnd(szMe, (const char **)&szMe);
 
     // determine the format of the file data and construct the aiMesh
-    PLY::DOM sPlyDom;
     this->pcDOM = &sPlyDom;
 
     if (TokenMatch(szMe, "format", 6)) {
@@ -234,6 +236,13 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     //free the file buffer
     streamedBuffer.close();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Imports the given file into the given scene structure.
+void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
+    PLY::DOM sPlyDom;
+    ParseFile(pFile, pIOHandler, sPlyDom);
 
     if (mGeneratedMesh == nullptr) {
         throw DeadlyImportError("Invalid .ply file: Unable to extract mesh data ");
@@ -274,6 +283,46 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Passes the faces of the given file on to the sink while reading.
+void PLYImporter::InternReadStreamed(const std::string &pFile, IOSystem *pIOHandler, MeshChunkSink &pSink) {
+    mChunkSink = &pSink;
+    mStreamFaces = false;
+    try {
+        PLY::DOM sPlyDom;
+        ParseFile(pFile, pIOHandler, sPlyDom);
+    } catch (...) {
+        mChunkSink = nullptr;
+        delete mGeneratedMesh;
+        mGeneratedMesh = nullptr;
+        throw;
+    }
+    mChunkSink = nullptr;
+
+    // the vertices were only kept to resolve the face indices
+    delete mGeneratedMesh;
+    mGeneratedMesh = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Passes a face on to the chunk sink
+void PLYImporter::StreamFace(const unsigned int *indices, unsigned int numIndices) {
+    const aiMesh *mesh = mGeneratedMesh;
+    for (unsigned int i = 0; i < numIndices; ++i) {
+        if (indices[i] >= mesh->mNumVertices) {
+            throw DeadlyImportError("Invalid .ply file: Vertex index out of range");
+        }
+    }
+
+    MeshChunkSink *sink = mChunkSink;
+    sink->AddIndexedFace(indices, numIndices, [mesh, sink](unsigned int v) {
+        return sink->AddVertex(mesh->mVertices[v],
+                mesh->mNormals ? &mesh->mNormals[v] : nullptr,
+                mesh->mColors[0] ? &mesh->mColors[0][v] : nullptr,
+                mesh->mTextureCoords[0] ? &mesh->mTextureCoords[0][v] : nullptr);
+    });
+}
+
 void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos) {
     ai_assert(nullptr != pcElement);
     ai_assert(nullptr != instElement);
@@ -448,6 +497,22 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
             haveTextureCoords = true;
         }
 
+        // streaming: without faces, the vertices are passed on as points right away
+        if (nullptr != mChunkSink) {
+            if (0 == pos) {
+                mStreamFaces = false;
+                for (const PLY::Element &element : pcDOM->alElements) {
+                    mStreamFaces |= PLY::EEST_Face == element.eSemantic || PLY::EEST_TriStrip == element.eSemantic;
+                }
+            }
+            if (!mStreamFaces) {
+                mChunkSink->Reserve(1);
+                mChunkSink->AddVertex(vOut, haveNormal ? &nOut : nullptr, haveColor ? &cOut : nullptr,
+                        haveTextureCoords ? &tOut : nullptr);
+                return;
+            }
+        }
+
         //create aiMesh if needed
         if (nullptr == mGeneratedMesh) {
             mGeneratedMesh = new aiMesh();
@@ -579,6 +644,49 @@ void PLYImporter::LoadFace(const PLY::Element *pcElement, const PLY::ElementInst
         }
     }
 
+    // streaming: pass the faces on instead of keeping them. Texture
+    // coordinates given per face aren't supported in this mode.
+    if (nullptr != mChunkSink) {
+        if (0xFFFFFFFF == iProperty) {
+            return;
+        }
+        const std::vector<PLY::PropertyInstance::ValueUnion> &avList = GetProperty(instElement->alProperties, iProperty).avList;
+        if (!bIsTriStrip) {
+            mStreamIndices.resize(avList.size());
+            for (size_t a = 0; a < avList.size(); ++a) {
+                mStreamIndices[a] = PLY::PropertyInstance::ConvertTo<unsigned int>(avList[a], eType);
+            }
+            StreamFace(mStreamIndices.data(), static_cast<unsigned int>(mStreamIndices.size()));
+            return;
+        }
+
+        // a value of -1 restarts the strip, every second triangle is flipped
+        bool flip = false;
+        int aiTable[2] = { -1, -1 };
+        for (const PLY::PropertyInstance::ValueUnion &value : avList) {
+            const int p = PLY::PropertyInstance::ConvertTo<int>(value, eType);
+            if (-1 == p) {
+                aiTable[0] = aiTable[1] = -1;
+                flip = false;
+            } else if (-1 == aiTable[0]) {
+                aiTable[0] = p;
+            } else if (-1 == aiTable[1]) {
+                aiTable[1] = p;
+            } else {
+                flip = !flip;
+                const unsigned int triangle[3] = {
+                    static_cast<unsigned int>(flip ? aiTable[1] : aiTable[0]),
+                    static_cast<unsigned int>(flip ? aiTable[0] : aiTable[1]),
+                    static_cast<unsigned int>(p)
+                };
+                StreamFace(triangle, 3);
+                aiTable[0] = aiTable[1];
+                aiTable[1] = p;
+            }
+        }
+        return;
+    }
+
     // check whether we have at least one per-face information set
     if (bOne) {
         if (mGeneratedMesh->mFaces == nullptr) {
@@ -97,6 +97,24 @@ protected:
     void InternReadFile(const std::string &pFile, aiScene *pScene,
             IOSystem *pIOHandler);
 
+    // -------------------------------------------------------------------
+    /** Passes the faces of the given file on to the sink while reading.
+    * See BaseImporter::InternReadStreamed() for details
+    */
+    void InternReadStreamed(const std::string &pFile, IOSystem *pIOHandler,
+            MeshChunkSink &pSink);
+
+    // -------------------------------------------------------------------
+    /** Checks the header and builds the DOM, calling LoadVertex() and
+    *  LoadFace() for each element instance
+    */
+    void ParseFile(const std::string &pFile, IOSystem *pIOHandler, PLY::DOM &sPlyDom);
+
+    // -------------------------------------------------------------------
+    /** Passes a face on to the chunk sink, streaming mode only
+    */
+    void StreamFace(const unsigned int *indices, unsigned int numIndices);
+
     // -------------------------------------------------------------------
     /** Extract a material list from the DOM
     */
@@ -127,6 +145,16 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Receives the geometry in streaming mode, nullptr otherwise */
+    MeshChunkSink *mChunkSink;
+
+    /** Streaming mode: whether the file has faces. If not, the
+    *  vertices are passed on as points without keeping them */
+    bool mStreamFaces;
+
+    /** Streaming mode: indices of the current face */
+    std::vector<unsigned int> mStreamIndices;
 };
 
 } // end of namespace Assimp
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
+#include <assimp/config.h>
 #include <memory>
 #include <assimp/Exceptional.h>
 #include <assimp/ByteSwapper.h>
@@ -62,21 +63,17 @@ namespace Assimp    {
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties )
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
+    const unsigned int numThreads = GetNumWorkerThreads(pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 
     // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds );
+    STLExporter exporter(pFile, pScene, exportPointClouds, false, numThreads);
 
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
     // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
-
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    exporter.mOutput.WriteTo(outfile.get());
 }
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties )
 {
@@ -85,17 +82,12 @@ void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene*
     // invoke the exporter
     STLExporter exporter(pFile, pScene, exportPointClouds, true);
 
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
     // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
-
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    exporter.mOutput.WriteTo(outfile.get());
 }
 
 } // end of namespace Assimp
@@ -104,19 +96,18 @@ static const char *SolidToken = "solid";
 static const char *EndSolidToken = "endsolid";
 
 // ------------------------------------------------------------------------------------------------
-STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool exportPointClouds, bool binary)
-: filename(_filename)
+STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool exportPointClouds, bool binary,
+        unsigned int _numThreads)
+: mOutput()
+, filename(_filename)
+, numThreads(_numThreads)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
     if (binary) {
         char buf[80] = {0} ;
         buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
         buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
-        mOutput.write(buf, 80);
+        mOutput.Write(buf, 80);
         unsigned int meshnum = 0;
         for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
             for (unsigned int j = 0; j < pScene->mMeshes[i]->mNumFaces; ++j) {
@@ -124,7 +115,7 @@ STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool expo
             }
         }
         AI_SWAP4(meshnum);
-        mOutput.write((char *)&meshnum, 4);
+        mOutput.Write((char *)&meshnum, 4);
 
         if (exportPointClouds) {
             throw DeadlyExportError("This functionality is not yet implemented for binary output.");
@@ -175,7 +166,8 @@ void STLExporter::WritePointCloud(const std::string &name, const aiScene* pScene
 // ------------------------------------------------------------------------------------------------
 void STLExporter::WriteMesh(const aiMesh* m)
 {
-    for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+    // facets are independent of each other, so they can be formatted in parallel
+    FormatParallel(mOutput, numThreads, m->mNumFaces, [&](TextWriter& out, size_t i) {
         const aiFace& f = m->mFaces[i];
 
         // we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
@@ -187,16 +179,16 @@ void STLExporter::WriteMesh(const aiMesh* m)
             }
             nor.NormalizeSafe();
         }
-        mOutput << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
-        mOutput << "  outer loop" << endl;
+        out << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
+        out << "  outer loop" << endl;
         for(unsigned int a = 0; a < f.mNumIndices; ++a) {
             const aiVector3D& v  = m->mVertices[f.mIndices[a]];
-            mOutput << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
+            out << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
         }
 
-        mOutput << "  endloop" << endl;
-        mOutput << " endfacet" << endl << endl;
-    }
+        out << "  endloop" << endl;
+        out << " endfacet" << endl << endl;
+    });
 }
 
 void STLExporter::WriteMeshBinary(const aiMesh* m)
@@ -218,15 +210,15 @@ void STLExporter::WriteMeshBinary(const aiMesh* m)
         float ny = (float) nor.y;
         float nz = (float) nor.z;
         AI_SWAP4(nx); AI_SWAP4(ny); AI_SWAP4(nz);
-        mOutput.write((char *)&nx, 4); mOutput.write((char *)&ny, 4); mOutput.write((char *)&nz, 4);
+        mOutput.Write((char *)&nx, 4); mOutput.Write((char *)&ny, 4); mOutput.Write((char *)&nz, 4);
         for(unsigned int a = 0; a < f.mNumIndices; ++a) {
             const aiVector3D& v  = m->mVertices[f.mIndices[a]];
             float vx = (float) v.x, vy = (float) v.y, vz = (float) v.z;
             AI_SWAP4(vx); AI_SWAP4(vy); AI_SWAP4(vz);
-            mOutput.write((char *)&vx, 4); mOutput.write((char *)&vy, 4); mOutput.write((char *)&vz, 4);
+            mOutput.Write((char *)&vx, 4); mOutput.Write((char *)&vy, 4); mOutput.Write((char *)&vz, 4);
         }
         char dummy[2] = {0};
-        mOutput.write(dummy, 2);
+        mOutput.Write(dummy, 2);
     }
 }
 
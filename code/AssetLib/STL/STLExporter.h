@@ -46,7 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "Common/TextWriter.h"
+
+#include <string>
 
 struct aiScene;
 struct aiNode;
@@ -60,11 +62,13 @@ namespace Assimp {
 class STLExporter
 {
 public:
-    /// Constructor for a specific scene to export
-    STLExporter(const char* filename, const aiScene* pScene, bool exportPOintClouds, bool binary = false);
+    /// Constructor for a specific scene to export. The output is kept in mOutput. Facets are
+    /// formatted by up to numThreads threads.
+    STLExporter(const char* filename, const aiScene* pScene, bool exportPOintClouds, bool binary = false,
+            unsigned int numThreads = 1);
 
-    /// public stringstreams to write all output into
-    std::ostringstream mOutput;
+    /// public writer to write all output into
+    TextWriter mOutput;
 
 private:
     void WritePointCloud(const std::string &name, const aiScene* pScene);
@@ -74,6 +78,7 @@ private:
 private:
 
     const std::string filename;
+    const unsigned int numThreads;
 
     // this endl() doesn't flush() the stream
     const std::string endl;
@@ -51,6 +51,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/IOStreamBuffer.h>
+#include "Common/MeshChunkSink.h"
+#include <algorithm>
 #include <memory>
 
 using namespace Assimp;
@@ -122,6 +126,157 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Searches the 80 byte header of a binary STL file for the default color of Materialise files
+static bool GetMaterialiseColor(const unsigned char *header, aiColor4D &color) {
+    const unsigned char *sz2 = header;
+    const unsigned char *const szEnd = sz2 + 80;
+    while (sz2 < szEnd) {
+
+        if ('C' == *sz2++ && 'O' == *sz2++ && 'L' == *sz2++ &&
+                'O' == *sz2++ && 'R' == *sz2++ && '=' == *sz2++) {
+
+            // read the default vertex color for facets
+            const ai_real invByte = (ai_real)1.0 / (ai_real)255.0;
+            color.r = (*sz2++) * invByte;
+            color.g = (*sz2++) * invByte;
+            color.b = (*sz2++) * invByte;
+            color.a = (*sz2++) * invByte;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Decodes the 15 bit facet color of a binary STL file
+static void DecodeColor(uint16_t color, bool isMaterialise, aiColor4D &clr) {
+    clr.a = 1.0;
+    const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+    if (isMaterialise) // this is reversed
+    {
+        clr.r = (color & 0x31u) * invVal;
+        clr.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+        clr.b = ((color & (0x31u << 10)) >> 10u) * invVal;
+    } else {
+        clr.b = (color & 0x31u) * invVal;
+        clr.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+        clr.r = ((color & (0x31u << 10)) >> 10u) * invVal;
+    }
+}
+
+// Size of a facet in a binary STL file: normal, three vertices and the attribute word
+static const size_t BinaryFacetSize = 50;
+
+// Decodes the normal and the three vertices of a binary facet. The vertices
+// are stored back to back, so with single precision they are a single copy.
+inline void DecodeBinaryFacet(const unsigned char *facet, aiVector3D &normal, aiVector3D *vertices) {
+#ifndef ASSIMP_DOUBLE_PRECISION
+    static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "aiVector3D must be tightly packed");
+    ::memcpy(&normal, facet, sizeof(aiVector3D));
+    ::memcpy(vertices, facet + sizeof(aiVector3D), 3 * sizeof(aiVector3D));
+#else
+    float values[12];
+    ::memcpy(values, facet, sizeof(values));
+    normal = aiVector3D(values[0], values[1], values[2]);
+    for (unsigned int v = 0; v < 3; ++v) {
+        vertices[v] = aiVector3D(values[3 + v * 3], values[4 + v * 3], values[5 + v * 3]);
+    }
+#endif
+}
+
+// Returns the attribute word of a binary facet
+inline uint16_t GetBinaryFacetAttribute(const unsigned char *facet) {
+    uint16_t attribute;
+    ::memcpy(&attribute, facet + BinaryFacetSize - sizeof(attribute), sizeof(attribute));
+    return attribute;
+}
+
+// Marks an unused slot of the VertexWelder table
+static const unsigned int EmptySlot = ~0u;
+
+// ------------------------------------------------------------------------------------------------
+// Hash table mapping the exact bit pattern of a vertex to its index, used
+// to weld the vertices of binary files while loading.
+class VertexWelder {
+public:
+    struct Key {
+        uint32_t mBits[3];
+        uint32_t mColor;
+
+        bool operator==(const Key &other) const {
+            return mBits[0] == other.mBits[0] && mBits[1] == other.mBits[1] &&
+                   mBits[2] == other.mBits[2] && mColor == other.mColor;
+        }
+    };
+
+    explicit VertexWelder(size_t expectedVertices) {
+        size_t numSlots = 16;
+        while (numSlots < expectedVertices * 2) {
+            numSlots <<= 1;
+        }
+        mSlots.resize(numSlots, EmptySlot);
+        mKeys.reserve(expectedVertices);
+    }
+
+    // Returns the index of the vertex, adding it if it is new
+    unsigned int Add(const Key &key) {
+        if ((mKeys.size() + 1) * 2 > mSlots.size()) {
+            Grow();
+        }
+        const size_t mask = mSlots.size() - 1;
+        for (size_t slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+            const unsigned int index = mSlots[slot];
+            if (index == EmptySlot) {
+                mSlots[slot] = static_cast<unsigned int>(mKeys.size());
+                mKeys.push_back(key);
+                return mSlots[slot];
+            }
+            if (mKeys[index] == key) {
+                return index;
+            }
+        }
+    }
+
+    const std::vector<Key> &GetKeys() const {
+        return mKeys;
+    }
+
+private:
+    static size_t Hash(const Key &key) {
+        uint64_t hash = key.mBits[0];
+        hash = (hash * 0x9E3779B97F4A7C15ull) ^ key.mBits[1];
+        hash = (hash * 0x9E3779B97F4A7C15ull) ^ key.mBits[2];
+        hash = (hash * 0x9E3779B97F4A7C15ull) ^ key.mColor;
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+
+    void Grow() {
+        std::vector<unsigned int> slots(mSlots.size() * 2, EmptySlot);
+        const size_t mask = slots.size() - 1;
+        for (unsigned int index = 0; index < mKeys.size(); ++index) {
+            size_t slot = Hash(mKeys[index]) & mask;
+            while (slots[slot] != EmptySlot) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = index;
+        }
+        mSlots.swap(slots);
+    }
+
+    std::vector<unsigned int> mSlots;
+    std::vector<Key> mKeys;
+};
+
+// Builds the key of a vertex; -0 and +0 are the same position
+inline VertexWelder::Key GetWeldKey(const float *position, uint16_t attribute) {
+    VertexWelder::Key key;
+    for (unsigned int i = 0; i < 3; ++i) {
+        const float value = position[i] + 0.0f;
+        ::memcpy(&key.mBits[i], &value, sizeof(float));
+    }
+    key.mColor = (attribute & (1 << 15)) ? attribute : 0;
+    return key;
+}
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -129,10 +284,18 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mWeldVertices(false) {
    // empty
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void STLImporter::SetupProperties(const Importer *pImp) {
+    // AI_CONFIG_IMPORT_STL_WELD_VERTICES
+    mWeldVertices = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STL_WELD_VERTICES, 0));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
 STLImporter::~STLImporter() {
@@ -296,6 +459,9 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
                     ASSIMP_LOG_WARN("STL: A new facet begins but the old is not yet complete");
                 }
                 faceVertexCounter = 0;
+                if ((normalBuffer.size() & 0xfff) == 0) {
+                    ThrowIfCancelled();
+                }
                 normalBuffer.push_back(aiVector3D());
                 aiVector3D *vn = &normalBuffer.back();
 
@@ -422,36 +588,23 @@ bool STLImporter::LoadBinaryFile() {
     if (mFileSize < 84) {
         throw DeadlyImportError("STL: file is too small for the header");
     }
-    bool bIsMaterialise = false;
 
     // search for an occurrence of "COLOR=" in the header
-    const unsigned char *sz2 = (const unsigned char *)mBuffer;
-    const unsigned char *const szEnd = sz2 + 80;
-    while (sz2 < szEnd) {
-
-        if ('C' == *sz2++ && 'O' == *sz2++ && 'L' == *sz2++ &&
-                'O' == *sz2++ && 'R' == *sz2++ && '=' == *sz2++) {
-
-            // read the default vertex color for facets
-            bIsMaterialise = true;
-            ASSIMP_LOG_INFO("STL: Taking code path for Materialise files");
-            const ai_real invByte = (ai_real)1.0 / (ai_real)255.0;
-            mClrColorDefault.r = (*sz2++) * invByte;
-            mClrColorDefault.g = (*sz2++) * invByte;
-            mClrColorDefault.b = (*sz2++) * invByte;
-            mClrColorDefault.a = (*sz2++) * invByte;
-            break;
-        }
+    const bool bIsMaterialise = GetMaterialiseColor((const unsigned char *)mBuffer, mClrColorDefault);
+    if (bIsMaterialise) {
+        ASSIMP_LOG_INFO("STL: Taking code path for Materialise files");
     }
     const unsigned char *sz = (const unsigned char *)mBuffer + 80;
 
     // now read the number of facets
     mScene->mRootNode->mName.Set("<STL_BINARY>");
 
-    pMesh->mNumFaces = *((uint32_t *)sz);
+    uint32_t numFaces;
+    ::memcpy(&numFaces, sz, sizeof(numFaces));
+    pMesh->mNumFaces = numFaces;
     sz += 4;
 
-    if (mFileSize < 84 + pMesh->mNumFaces * 50) {
+    if (mFileSize < 84 + size_t(pMesh->mNumFaces) * BinaryFacetSize) {
         throw DeadlyImportError("STL: file is too small to hold all facets");
     }
 
@@ -459,84 +612,71 @@ bool STLImporter::LoadBinaryFile() {
         throw DeadlyImportError("STL: file is empty. There are no facets defined");
     }
 
+    // welding never yields more vertices than decoding the facets one by one
+    if (size_t(pMesh->mNumFaces) * 3 > AI_MAX_VERTICES) {
+        throw DeadlyImportError("STL: Too many vertices");
+    }
+
+    if (mWeldVertices) {
+        WeldBinaryFacets(pMesh, sz, bIsMaterialise);
+    } else {
+        DecodeBinaryFacets(pMesh, sz, bIsMaterialise);
+    }
+
+    aiNode *root = mScene->mRootNode;
+
+    // allocate one node
+    aiNode *node = new aiNode();
+    node->mParent = root;
+
+    root->mNumChildren = 1u;
+    root->mChildren = new aiNode *[root->mNumChildren];
+    root->mChildren[0] = node;
+
+    // add all created meshes to the single node
+    node->mNumMeshes = mScene->mNumMeshes;
+    node->mMeshes = new unsigned int[mScene->mNumMeshes];
+    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
+        node->mMeshes[i] = i;
+    }
+
+    if (bIsMaterialise && !pMesh->mColors[0]) {
+        // use the color as diffuse material color
+        return true;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decodes the facets of a binary file into three vertices each
+void STLImporter::DecodeBinaryFacets(aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise) {
     pMesh->mNumVertices = pMesh->mNumFaces * 3;
 
     aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
     aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    typedef aiVector3t<float> aiVector3F;
-    aiVector3F *theVec;
-    aiVector3F theVec3F;
-
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+    const unsigned char *facet = facets;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i, facet += BinaryFacetSize, vp += 3, vn += 3) {
         // NOTE: Blender sometimes writes empty normals ... this is not
         // our fault ... the RemoveInvalidData helper step should fix that
 
         // There's one normal for the face in the STL; use it three times
         // for vertex normals
-        theVec = (aiVector3F *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
+        DecodeBinaryFacet(facet, *vn, vp);
         *(vn + 1) = *vn;
         *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
 
+        const uint16_t color = GetBinaryFacetAttribute(facet);
         if (color & (1 << 15)) {
             // seems we need to take the color
             if (!pMesh->mColors[0]) {
                 pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
-                }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
+                std::fill(pMesh->mColors[0], pMesh->mColors[0] + pMesh->mNumVertices, mClrColorDefault);
 
                 ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
             }
             aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
-            } else {
-                clr->b = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
-            }
+            DecodeColor(color, bIsMaterialise, *clr);
             // assign the color to all vertices of the face
             *(clr + 1) = *clr;
             *(clr + 2) = *clr;
@@ -545,29 +685,201 @@ bool STLImporter::LoadBinaryFile() {
 
     // now copy faces
     addFacesToMesh(pMesh);
+}
 
-    aiNode *root = mScene->mRootNode;
+// ------------------------------------------------------------------------------------------------
+// Decodes the facets of a binary file, sharing vertices with the same position and color
+void STLImporter::WeldBinaryFacets(aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise) {
+    // closed meshes have about half as many vertices as facets
+    VertexWelder welder(pMesh->mNumFaces / 2 + 1);
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
 
-    // allocate one node
-    aiNode *node = new aiNode();
-    node->mParent = root;
+    bool hasColors = false;
+    float values[12];
+    const unsigned char *facet = facets;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i, facet += BinaryFacetSize) {
+        ::memcpy(values, facet, sizeof(values));
+        const uint16_t attribute = GetBinaryFacetAttribute(facet);
+        hasColors |= (attribute & (1 << 15)) != 0;
 
-    root->mNumChildren = 1u;
-    root->mChildren = new aiNode *[root->mNumChildren];
-    root->mChildren[0] = node;
+        // the facet normal is dropped, vertices of different facets share it
+        aiFace &face = pMesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int v = 0; v < 3; ++v) {
+            face.mIndices[v] = welder.Add(GetWeldKey(values + 3 + v * 3, attribute));
+        }
+    }
 
-    // add all created meshes to the single node
-    node->mNumMeshes = mScene->mNumMeshes;
-    node->mMeshes = new unsigned int[mScene->mNumMeshes];
-    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
-        node->mMeshes[i] = i;
+    const std::vector<VertexWelder::Key> &keys = welder.GetKeys();
+    pMesh->mNumVertices = static_cast<unsigned int>(keys.size());
+    pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+    if (hasColors) {
+        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+    }
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        float position[3];
+        ::memcpy(position, keys[i].mBits, sizeof(position));
+        pMesh->mVertices[i] = aiVector3D(position[0], position[1], position[2]);
+        if (hasColors) {
+            pMesh->mColors[0][i] = mClrColorDefault;
+            if (keys[i].mColor) {
+                DecodeColor(static_cast<uint16_t>(keys[i].mColor), bIsMaterialise, pMesh->mColors[0][i]);
+            }
+        }
     }
 
-    if (bIsMaterialise && !pMesh->mColors[0]) {
-        // use the color as diffuse material color
-        return true;
+    ASSIMP_LOG_DEBUG_F("STL: welded ", pMesh->mNumFaces * 3, " vertices into ", pMesh->mNumVertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads the facets of the given file into the sink while reading.
+void STLImporter::InternReadStreamed(const std::string &pFile, IOSystem *pIOHandler, MeshChunkSink &pSink) {
+    std::unique_ptr<IOStream> file(pIOHandler->Open(pFile, "rb"));
+
+    // Check whether we can read from the file
+    if (file.get() == nullptr) {
+        throw DeadlyImportError("Failed to open STL file " + pFile + ".");
     }
-    return false;
+    const size_t fileSize = file->FileSize();
+
+    // the start of the file is enough to tell the flavours apart
+    std::vector<char> head(BufferSize * 2 + 1, '\0');
+    const size_t headSize = file->Read(&head[0], 1, std::min(fileSize, static_cast<size_t>(BufferSize * 2)));
+    file->Seek(0, aiOrigin_SET);
+
+    // the default vertex color is light gray.
+    mClrColorDefault.r = mClrColorDefault.g = mClrColorDefault.b = mClrColorDefault.a = (ai_real)0.6;
+
+    // same test as IsBinarySTL(), but without truncating the size of huge files
+    uint32_t faceCount = 0;
+    if (headSize >= 84) {
+        ::memcpy(&faceCount, &head[80], sizeof(faceCount));
+    }
+    if (headSize >= 84 && fileSize == 84 + size_t(faceCount) * 50) {
+        StreamBinaryFile(file.get(), pSink);
+    } else if (IsAsciiSTL(&head[0], static_cast<unsigned int>(headSize))) {
+        StreamASCIIFile(file.get(), pSink);
+    } else {
+        throw DeadlyImportError("Failed to determine STL storage representation for " + pFile + ".");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Streams the facets of a binary STL file, block by block
+void STLImporter::StreamBinaryFile(IOStream *pStream, MeshChunkSink &pSink) {
+    unsigned char header[84];
+    if (pStream->Read(header, 1, 84) != 84) {
+        throw DeadlyImportError("STL: file is too small for the header");
+    }
+    const bool bIsMaterialise = GetMaterialiseColor(header, mClrColorDefault);
+    pSink.SetDefaultColor(mClrColorDefault);
+
+    uint32_t numFaces;
+    ::memcpy(&numFaces, header + 80, sizeof(numFaces));
+    if (!numFaces) {
+        throw DeadlyImportError("STL: file is empty. There are no facets defined");
+    }
+
+    static const size_t FacetsPerBlock = 1 << 14;
+    std::vector<unsigned char> block(BinaryFacetSize * FacetsPerBlock);
+    aiVector3D normal, vertices[3];
+    aiColor4D color;
+    for (size_t done = 0; done < numFaces;) {
+        ThrowIfCancelled();
+        const size_t count = std::min(FacetsPerBlock, numFaces - done);
+        if (pStream->Read(&block[0], BinaryFacetSize, count) != count) {
+            throw DeadlyImportError("STL: file is too small to hold all facets");
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const unsigned char *facet = &block[i * BinaryFacetSize];
+
+            // There's one normal for the face in the STL; use it three times
+            // for vertex normals
+            DecodeBinaryFacet(facet, normal, vertices);
+            const uint16_t attribute = GetBinaryFacetAttribute(facet);
+            const aiColor4D *clr = nullptr;
+            if (attribute & (1 << 15)) {
+                DecodeColor(attribute, bIsMaterialise, color);
+                clr = &color;
+            }
+
+            pSink.Reserve(3);
+            unsigned int indices[3];
+            for (unsigned int v = 0; v < 3; ++v) {
+                indices[v] = pSink.AddVertex(vertices[v], &normal, clr);
+            }
+            pSink.AddFace(indices, 3);
+        }
+        done += count;
+        m_progress->UpdateFileRead(static_cast<int>(done * 1000 / numFaces), 1000);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Streams the facets of an ASCII STL file, line by line
+void STLImporter::StreamASCIIFile(IOStream *pStream, MeshChunkSink &pSink) {
+    IOStreamBuffer<char> streamBuffer(1024 * 1024);
+    streamBuffer.open(pStream);
+
+    std::vector<char> line;
+    aiVector3D normal, positions[3];
+    unsigned int faceVertexCounter = 3;
+    size_t numLines = 0;
+    while (streamBuffer.getNextLine(line)) {
+        if ((++numLines & 0xffff) == 0) {
+            ThrowIfCancelled();
+        }
+        const char *sz = &line[0];
+        SkipSpaces(&sz);
+
+        // facet normal -0.13 -0.13 -0.98
+        if (!strncmp(sz, "facet", 5) && IsSpaceOrNewLine(*(sz + 5))) {
+            if (faceVertexCounter != 3) {
+                ASSIMP_LOG_WARN("STL: A new facet begins but the old is not yet complete");
+            }
+            faceVertexCounter = 0;
+            normal = aiVector3D();
+            sz += 5;
+            SkipSpaces(&sz);
+            if (strncmp(sz, "normal", 6)) {
+                ASSIMP_LOG_WARN("STL: a facet normal vector was expected but not found");
+            } else {
+                sz += 6;
+                SkipSpaces(&sz);
+                sz = fast_atoreal_move<ai_real>(sz, (ai_real &)normal.x);
+                SkipSpaces(&sz);
+                sz = fast_atoreal_move<ai_real>(sz, (ai_real &)normal.y);
+                SkipSpaces(&sz);
+                fast_atoreal_move<ai_real>(sz, (ai_real &)normal.z);
+            }
+        } else if (!strncmp(sz, "vertex", 6) && IsSpaceOrNewLine(*(sz + 6))) { // vertex 1.50000 1.50000 0.00000
+            if (faceVertexCounter >= 3) {
+                ASSIMP_LOG_ERROR("STL: a facet with more than 3 vertices has been found");
+                continue;
+            }
+            aiVector3D &vn = positions[faceVertexCounter++];
+            sz += 7;
+            SkipSpaces(&sz);
+            sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn.x);
+            SkipSpaces(&sz);
+            sz = fast_atoreal_move<ai_real>(sz, (ai_real &)vn.y);
+            SkipSpaces(&sz);
+            fast_atoreal_move<ai_real>(sz, (ai_real &)vn.z);
+        } else if (!strncmp(sz, "endfacet", 8)) {
+            if (faceVertexCounter != 3) {
+                throw DeadlyImportError("STL: Invalid number of vertices");
+            }
+            pSink.Reserve(3);
+            unsigned int indices[3];
+            for (unsigned int v = 0; v < 3; ++v) {
+                indices[v] = pSink.AddVertex(positions[v], &normal);
+            }
+            pSink.AddFace(indices, 3);
+        }
+    }
+    streamBuffer.close();
 }
 
 void STLImporter::pushMeshesToNode(std::vector<unsigned int> &meshIndices, aiNode *node) {
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declarations
 struct aiNode;
+struct aiMesh;
 
 namespace Assimp {
 
@@ -76,6 +77,12 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /**
+     * @brief   Reads the importer configuration.
+     *  See BaseImporter::SetupProperties() for details.
+     */
+    void SetupProperties(const Importer* pImp);
+
 protected:
 
     /**
@@ -91,17 +98,44 @@ protected:
     void InternReadFile( const std::string& pFile, aiScene* pScene,
         IOSystem* pIOHandler);
 
+    /**
+     * @brief   Reads the facets of the given file into the sink while reading.
+    * See BaseImporter::InternReadStreamed() for details
+    */
+    void InternReadStreamed( const std::string& pFile, IOSystem* pIOHandler,
+        MeshChunkSink& pSink);
+
     /**
      * @brief   Loads a binary .stl file
      * @return true if the default vertex color must be used as material color
      */
     bool LoadBinaryFile();
 
+    /**
+     * @brief   Decodes the facets of a binary .stl file into three vertices each
+     */
+    void DecodeBinaryFacets( aiMesh* pMesh, const unsigned char* facets, bool bIsMaterialise );
+
+    /**
+     * @brief   Decodes the facets of a binary .stl file into an indexed mesh
+     */
+    void WeldBinaryFacets( aiMesh* pMesh, const unsigned char* facets, bool bIsMaterialise );
+
     /**
      * @brief   Loads a ASCII text .stl file
      */
     void LoadASCIIFile( aiNode *root );
 
+    /**
+     * @brief   Streams the facets of a binary .stl file, block by block
+     */
+    void StreamBinaryFile( IOStream* pStream, MeshChunkSink& pSink );
+
+    /**
+     * @brief   Streams the facets of an ASCII .stl file, line by line
+     */
+    void StreamASCIIFile( IOStream* pStream, MeshChunkSink& pSink );
+
     void pushMeshesToNode( std::vector<unsigned int> &meshIndices, aiNode *node );
 
 protected:
@@ -117,6 +151,9 @@ protected:
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Share the vertices of binary files, see AI_CONFIG_IMPORT_STL_WELD_VERTICES */
+    bool mWeldVertices;
 };
 
 } // end of namespace Assimp
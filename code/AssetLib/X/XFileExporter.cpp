@@ -303,13 +303,15 @@ void XFileExporter::WriteFrameTransform(aiMatrix4x4& m)
 // Recursively writes the given node
 void XFileExporter::WriteNode( aiNode* pNode)
 {
-    if (pNode->mName.length==0)
+    // unnamed nodes get a name in the file only, the scene may be shared with the caller
+    aiString name = pNode->mName;
+    if (name.length==0)
     {
         std::stringstream ss;
         ss << "Node_" << pNode;
-        pNode->mName.Set(ss.str());
+        name.Set(ss.str());
     }
-    mOutput << startstr << "Frame " << toXFileString(pNode->mName) << " {" << endstr;
+    mOutput << startstr << "Frame " << toXFileString(name) << " {" << endstr;
 
     PushTag();
 
@@ -62,26 +62,12 @@ using namespace Assimp::Formatter;
 
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_X
 
-#   ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#       include <zlib.h>
-#   else
-#       include "../contrib/zlib/zlib.h"
-#   endif
+#   include "Common/Compression.h"
 
 // Magic identifier for MSZIP compressed data
 #define MSZIP_MAGIC 0x4B43
 #define MSZIP_BLOCK 32786
 
-// ------------------------------------------------------------------------------------------------
-// Dummy memory wrappers for use with zlib
-static void* dummy_alloc (void* /*opaque*/, unsigned int items, unsigned int size)  {
-    return ::operator new(items*size);
-}
-
-static void  dummy_free  (void* /*opaque*/, void* address)  {
-    return ::operator delete(address);
-}
-
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 
 // ------------------------------------------------------------------------------------------------
@@ -176,15 +162,8 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
          * ///////////////////////////////////////////////////////////////////////
          */
 
-        // build a zlib stream
-        z_stream stream;
-        stream.opaque = NULL;
-        stream.zalloc = &dummy_alloc;
-        stream.zfree  = &dummy_free;
-        stream.data_type = (mIsBinaryFormat ? Z_BINARY : Z_ASCII);
-
-        // initialize the inflation algorithm
-        ::inflateInit2(&stream, -MAX_WBITS);
+        // MSZIP blocks are raw deflate streams, each using the previous block as dictionary
+        Inflater inflater(Inflater::Format_Raw);
 
         // skip unknown data (checksum, flags?)
         mP += 6;
@@ -227,28 +206,19 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
                 throw DeadlyImportError("X: Unexpected EOF in compressed chunk");
             }
 
-            // push data to the stream
-            stream.next_in   = (Bytef*)mP;
-            stream.avail_in  = ofs;
-            stream.next_out  = (Bytef*)out;
-            stream.avail_out = MSZIP_BLOCK;
-
             // and decompress the data ....
-            int ret = ::inflate( &stream, Z_SYNC_FLUSH );
-            if (ret != Z_OK && ret != Z_STREAM_END)
-                throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
+            const uint8_t* in = reinterpret_cast<const uint8_t*>(mP);
+            size_t avail = ofs;
+            const size_t have = inflater.Inflate(in, avail, reinterpret_cast<uint8_t*>(out), MSZIP_BLOCK);
 
-            ::inflateReset( &stream );
-            ::inflateSetDictionary( &stream, (const Bytef*)out , MSZIP_BLOCK - stream.avail_out );
+            inflater.Reset();
+            inflater.SetDictionary(out, have);
 
             // and advance to the next offset
-            out +=  MSZIP_BLOCK - stream.avail_out;
+            out +=  have;
             mP   += ofs;
         }
 
-        // terminate zlib
-        ::inflateEnd(&stream);
-
         // ok, update pointers to point to the uncompressed file data
         mP = &uncompressed[0];
         mEnd = out;
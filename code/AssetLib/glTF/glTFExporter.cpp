@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Header files, standard library.
 #include <memory>
+#include <vector>
 #include <limits>
 #include <inttypes.h>
 
@@ -622,19 +623,20 @@ void glTFExporter::ExportMeshes()
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
-            // Flip UV y coords
-            if (aim -> mNumUVComponents[i] > 1) {
-                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
+            if (aim->mNumUVComponents[i] > 0) {
+                // Flip UV y coords, on a copy as the meshes may be shared with the caller's scene
+                std::vector<aiVector3D> uvData(aim->mTextureCoords[i], aim->mTextureCoords[i] + aim->mNumVertices);
+                if (aim -> mNumUVComponents[i] > 1) {
+                    for (aiVector3D &uv : uvData) {
+                        uv.y = 1 - uv.y;
+                    }
                 }
-            }
 
-            if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
 				if(comp_allow) idx_srcdata_tc.push_back(b->byteLength);// Store index of texture coordinates array.
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, uvData.data(), AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
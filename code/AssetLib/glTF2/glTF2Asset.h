@@ -392,6 +392,7 @@ struct Accessor : public Object {
     ComponentType componentType; //!< The datatype of components in the attribute. (required)
     size_t count; //!< The number of attributes referenced by this accessor. (required)
     AttribType::Value type; //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+    bool normalized; //!< Specifies whether integer data values should be normalized.
     std::vector<double> max; //!< Maximum value of each component in this attribute.
     std::vector<double> min; //!< Minimum value of each component in this attribute.
     std::unique_ptr<Sparse> sparse;
@@ -405,6 +406,11 @@ struct Accessor : public Object {
     template <class T>
     void ExtractData(T *&outData);
 
+    //! Extracts the data into a vector type of ai_real components, converting
+    //! integer and normalized integer components
+    template <class T>
+    void ExtractFloatData(T *&outData);
+
     void WriteData(size_t count, const void *src_buffer, size_t src_stride);
 
     //! Helper class to iterate the data
@@ -441,7 +447,8 @@ struct Accessor : public Object {
         return Indexer(*this);
     }
 
-    Accessor() {}
+    Accessor() :
+            normalized(false) {}
     void Read(Value &obj, Asset &r);
 
     //sparse
@@ -571,8 +578,16 @@ public:
     bool ReplaceData_joint(const size_t pBufferData_Offset, const size_t pBufferData_Count, const uint8_t *pReplace_Data, const size_t pReplace_Count);
 
     size_t AppendData(uint8_t *data, size_t length);
+
+    /// \fn void Grow(size_t amount)
+    /// Extends the buffer by the given number of bytes. The storage grows geometrically, so
+    /// appending many small blocks doesn't copy the whole buffer each time.
     void Grow(size_t amount);
 
+    /// \fn void Reserve(size_t size)
+    /// Makes sure the storage can hold at least size bytes without reallocation.
+    void Reserve(size_t size);
+
     uint8_t *GetPointer() { return mData.get(); }
 
     void MarkAsSpecial() { mIsSpecial = true; }
@@ -1012,11 +1027,13 @@ public:
         bool KHR_materials_unlit;
         bool KHR_lights_punctual;
         bool KHR_texture_transform;
+        bool KHR_mesh_quantization;
     } extensionsUsed;
 
     //! Keeps info about the required extensions
     struct RequiredExtensions {
         bool KHR_draco_mesh_compression;
+        bool KHR_mesh_quantization;
     } extensionsRequired;
 
     AssetMetadata asset;
@@ -379,6 +379,7 @@ inline void Buffer::Read(Value &obj, Asset &r) {
             uint8_t *data = 0;
             this->byteLength = glTFCommon::Util::DecodeBase64(dataURI.data, dataURI.dataLength, data);
             this->mData.reset(data, std::default_delete<uint8_t[]>());
+            this->capacity = this->byteLength;
 
             if (statedLength > 0 && this->byteLength != statedLength) {
                 throw DeadlyImportError("GLTF: buffer \"" + id + "\", expected " + to_string(statedLength) +
@@ -391,6 +392,7 @@ inline void Buffer::Read(Value &obj, Asset &r) {
             }
 
             this->mData.reset(new uint8_t[dataURI.dataLength], std::default_delete<uint8_t[]>());
+            this->capacity = dataURI.dataLength;
             memcpy(this->mData.get(), dataURI.data, dataURI.dataLength);
         }
     } else { // Local file
@@ -419,6 +421,7 @@ inline bool Buffer::LoadFromStream(IOStream &stream, size_t length, size_t baseO
     }
 
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
+    capacity = byteLength;
 
     if (stream.Read(mData.get(), byteLength, 1) != 1) {
         return false;
@@ -487,6 +490,7 @@ inline bool Buffer::ReplaceData(const size_t pBufferData_Offset, const size_t pB
     // Apply new data
     mData.reset(new_data, std::default_delete<uint8_t[]>());
     byteLength = new_data_size;
+    capacity = new_data_size;
 
     return true;
 }
@@ -507,6 +511,7 @@ inline bool Buffer::ReplaceData_joint(const size_t pBufferData_Offset, const siz
     // Apply new data
     mData.reset(new_data, std::default_delete<uint8_t[]>());
     byteLength = new_data_size;
+    capacity = new_data_size;
 
     return true;
 }
@@ -530,15 +535,22 @@ inline void Buffer::Grow(size_t amount) {
         return;
     }
 
-    // Just allocate data which we need
-    capacity = byteLength + amount;
+    // Grow by half of the current size at least, so a series of appends costs linear time
+    Reserve(std::max(byteLength + amount, capacity + capacity / 2));
+    byteLength += amount;
+}
+
+inline void Buffer::Reserve(size_t size) {
+    if (capacity >= size) {
+        return;
+    }
 
-    uint8_t *b = new uint8_t[capacity];
+    uint8_t *b = new uint8_t[size];
     if (nullptr != mData) {
         memcpy(b, mData.get(), byteLength);
     }
     mData.reset(b, std::default_delete<uint8_t[]>());
-    byteLength += amount;
+    capacity = size;
 }
 
 //
@@ -626,6 +638,7 @@ inline void Accessor::Read(Value &obj, Asset &r) {
 
     const char *typestr;
     type = ReadMember(obj, "type", typestr) ? AttribType::FromString(typestr) : AttribType::SCALAR;
+    normalized = MemberOrDefault(obj, "normalized", false);
 
     if (Value *sparseValue = FindObject(obj, "sparse")) {
         sparse.reset(new Sparse);
@@ -744,6 +757,67 @@ void Accessor::ExtractData(T *&outData) {
     }
 }
 
+template <class T>
+void Accessor::ExtractFloatData(T *&outData) {
+    if (componentType == ComponentType_FLOAT) {
+        ExtractData(outData);
+        return;
+    }
+
+    uint8_t *data = GetPointer();
+    if (!data) {
+        throw DeadlyImportError("GLTF2: data is nullptr.");
+    }
+
+    const unsigned int numComponents = GetNumComponents();
+    const size_t elemSize = GetElementSize();
+    const size_t stride = bufferView && bufferView->byteStride ? bufferView->byteStride : elemSize;
+    ai_assert(numComponents * sizeof(ai_real) <= sizeof(T));
+    ai_assert(count * stride <= (bufferView ? bufferView->byteLength : sparse->data.size()));
+
+    outData = new T[count];
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *src = data + i * stride;
+        ai_real *dst = reinterpret_cast<ai_real *>(outData + i);
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            // normalization as defined by the glTF 2.0 specification
+            double value = 0;
+            switch (componentType) {
+            case ComponentType_BYTE: {
+                int8_t v;
+                memcpy(&v, src + c, sizeof(v));
+                value = normalized ? std::max(v / 127.0, -1.0) : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_BYTE:
+                value = normalized ? src[c] / 255.0 : src[c];
+                break;
+            case ComponentType_SHORT: {
+                int16_t v;
+                memcpy(&v, src + c * sizeof(v), sizeof(v));
+                value = normalized ? std::max(v / 32767.0, -1.0) : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_SHORT: {
+                uint16_t v;
+                memcpy(&v, src + c * sizeof(v), sizeof(v));
+                value = normalized ? v / 65535.0 : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_INT: {
+                uint32_t v;
+                memcpy(&v, src + c * sizeof(v), sizeof(v));
+                value = v;
+                break;
+            }
+            default:
+                break;
+            }
+            dst[c] = static_cast<ai_real>(value);
+        }
+    }
+}
+
 inline void Accessor::WriteData(size_t _count, const void *src_buffer, size_t src_stride) {
     uint8_t *buffer_ptr = bufferView->buffer->GetPointer();
     size_t offset = byteOffset + bufferView->byteOffset;
@@ -1586,6 +1660,7 @@ inline void Asset::ReadExtensionsRequired(Document &doc) {
     }
 
     CHECK_REQUIRED_EXT(KHR_draco_mesh_compression);
+    CHECK_REQUIRED_EXT(KHR_mesh_quantization);
 
 #undef CHECK_REQUIRED_EXT
 }
@@ -1606,6 +1681,7 @@ inline void Asset::ReadExtensionsUsed(Document &doc) {
     CHECK_EXT(KHR_materials_unlit);
     CHECK_EXT(KHR_lights_punctual);
     CHECK_EXT(KHR_texture_transform);
+    CHECK_EXT(KHR_mesh_quantization);
 
 #undef CHECK_EXT
 }
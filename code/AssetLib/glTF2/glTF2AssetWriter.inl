@@ -113,6 +113,9 @@ namespace glTF2 {
         obj.AddMember("componentType", int(a.componentType), w.mAl);
         obj.AddMember("count", (unsigned int)a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
 
         Value vTmpMax, vTmpMin;
 		if (a.componentType == ComponentType_FLOAT) {
@@ -689,12 +692,41 @@ namespace glTF2 {
         uint32_t jsonChunkLength = (docBuffer.GetSize() + 3) & ~3; // Round up to next multiple of 4
         auto paddingLength = jsonChunkLength - docBuffer.GetSize();
 
+        uint32_t binaryChunkLength = 0;
+        if (bodyBuffer->byteLength > 0) {
+            binaryChunkLength = (bodyBuffer->byteLength + 3) & ~3; // Round up to next multiple of 4
+        }
+
+        //
+        // Header
+        //
+        // All sizes are known up front, so the file is written front to back without seeking.
+
+        GLB_Header header;
+        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
+
+        header.version = 2;
+        AI_SWAP4(header.version);
+
+        header.length = uint32_t(sizeof(GLB_Header) + sizeof(GLB_Chunk) + jsonChunkLength);
+        if (binaryChunkLength > 0) {
+            header.length += uint32_t(sizeof(GLB_Chunk) + binaryChunkLength);
+        }
+        AI_SWAP4(header.length);
+
+        if (outfile->Write(&header, 1, sizeof(GLB_Header)) != sizeof(GLB_Header)) {
+            throw DeadlyExportError("Failed to write the header!");
+        }
+
+        //
+        // JSON chunk
+        //
+
         GLB_Chunk jsonChunk;
         jsonChunk.chunkLength = jsonChunkLength;
         jsonChunk.chunkType = ChunkType_JSON;
         AI_SWAP4(jsonChunk.chunkLength);
 
-        outfile->Seek(sizeof(GLB_Header), aiOrigin_SET);
         if (outfile->Write(&jsonChunk, 1, sizeof(GLB_Chunk)) != sizeof(GLB_Chunk)) {
             throw DeadlyExportError("Failed to write scene data header!");
         }
@@ -709,46 +741,34 @@ namespace glTF2 {
         // Binary chunk
         //
 
-        uint32_t binaryChunkLength = 0;
-        if (bodyBuffer->byteLength > 0) {
-            binaryChunkLength = (bodyBuffer->byteLength + 3) & ~3; // Round up to next multiple of 4
-            //auto curPaddingLength = binaryChunkLength - bodyBuffer->byteLength;
+        if (binaryChunkLength > 0) {
+            const size_t binaryPaddingLength = binaryChunkLength - bodyBuffer->byteLength;
 
             GLB_Chunk binaryChunk;
             binaryChunk.chunkLength = binaryChunkLength;
             binaryChunk.chunkType = ChunkType_BIN;
             AI_SWAP4(binaryChunk.chunkLength);
 
-            size_t bodyOffset = sizeof(GLB_Header) + sizeof(GLB_Chunk) + jsonChunk.chunkLength;
-            outfile->Seek(bodyOffset, aiOrigin_SET);
             if (outfile->Write(&binaryChunk, 1, sizeof(GLB_Chunk)) != sizeof(GLB_Chunk)) {
                 throw DeadlyExportError("Failed to write body data header!");
             }
-            if (outfile->Write(bodyBuffer->GetPointer(), 1, bodyBuffer->byteLength) != bodyBuffer->byteLength) {
-                throw DeadlyExportError("Failed to write body data!");
+
+            // stream the body in slices, so the IOStream never has to take the whole buffer at once
+            static const size_t SliceSize = 1 << 20;
+            const uint8_t *body = bodyBuffer->GetPointer();
+            for (size_t offset = 0; offset < bodyBuffer->byteLength; offset += SliceSize) {
+                const size_t length = std::min(SliceSize, bodyBuffer->byteLength - offset);
+                if (outfile->Write(body + offset, 1, length) != length) {
+                    throw DeadlyExportError("Failed to write body data!");
+                }
             }
-            if (paddingLength && outfile->Write(&padding, 1, paddingLength) != paddingLength) {
+
+            // the binary chunk is padded with zeros
+            const uint32_t zeros = 0;
+            if (binaryPaddingLength && outfile->Write(&zeros, 1, binaryPaddingLength) != binaryPaddingLength) {
                 throw DeadlyExportError("Failed to write body data padding!");
             }
         }
-
-        //
-        // Header
-        //
-
-        GLB_Header header;
-        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
-
-        header.version = 2;
-        AI_SWAP4(header.version);
-
-        header.length = uint32_t(sizeof(GLB_Header) + 2 * sizeof(GLB_Chunk) + jsonChunkLength + binaryChunkLength);
-        AI_SWAP4(header.length);
-
-        outfile->Seek(0, aiOrigin_SET);
-        if (outfile->Write(&header, 1, sizeof(GLB_Header)) != sizeof(GLB_Header)) {
-            throw DeadlyExportError("Failed to write the header!");
-        }
     }
 
     inline void AssetWriter::WriteMetadata()
@@ -775,10 +795,23 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_materials_unlit) {
               exts.PushBack(StringRef("KHR_materials_unlit"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+              exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            }
         }
 
         if (!exts.Empty())
             mDoc.AddMember("extensionsUsed", exts, mAl);
+
+        Value required;
+        required.SetArray();
+        if (this->mAsset.extensionsRequired.KHR_mesh_quantization) {
+            required.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+        }
+
+        if (!required.Empty())
+            mDoc.AddMember("extensionsRequired", required, mAl);
     }
 
     template<class T>
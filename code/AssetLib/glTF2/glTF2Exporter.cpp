@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssetLib/glTF2/glTF2Exporter.h"
 #include "AssetLib/glTF2/glTF2AssetWriter.h"
 #include "PostProcessing/SplitLargeMeshes.h"
+#include "PostProcessing/ProcessHelper.h"
 
 #include <assimp/commonMetaData.h>
 #include <assimp/Exceptional.h>
@@ -110,6 +111,7 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
     }
 
     ExportMeshes();
+    InsertDequantizationNodes();
     MergeMeshes();
 
     ExportScene();
@@ -214,14 +216,11 @@ inline void SetAccessorRange(ComponentType compType, Ref<Accessor> acc, void* da
 	}
 }
 
-inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
-    size_t count, void* data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType, BufferViewTarget target = BufferViewTarget_NONE)
+// Appends an accessor with room for count elements to the buffer. The data is left for the
+// caller to write, straight into the buffer.
+inline Ref<Accessor> CreateAccessor(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    size_t count, AttribType::Value typeOut, ComponentType compType, BufferViewTarget target = BufferViewTarget_NONE)
 {
-    if (!count || !data) {
-        return Ref<Accessor>();
-    }
-
-    unsigned int numCompsIn = AttribType::GetNumComponents(typeIn);
     unsigned int numCompsOut = AttribType::GetNumComponents(typeOut);
     unsigned int bytesPerComp = ComponentTypeSize(compType);
 
@@ -248,6 +247,22 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     acc->count = count;
     acc->type = typeOut;
 
+    return acc;
+}
+
+inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    size_t count, void* data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType, BufferViewTarget target = BufferViewTarget_NONE)
+{
+    if (!count || !data) {
+        return Ref<Accessor>();
+    }
+
+    unsigned int numCompsIn = AttribType::GetNumComponents(typeIn);
+    unsigned int numCompsOut = AttribType::GetNumComponents(typeOut);
+    unsigned int bytesPerComp = ComponentTypeSize(compType);
+
+    Ref<Accessor> acc = CreateAccessor(a, meshName, buffer, count, typeOut, compType, target);
+
     // calculate min and max values
 	SetAccessorRange(compType, acc, data, count, numCompsIn, numCompsOut);
 
@@ -257,6 +272,55 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     return acc;
 }
 
+// Maps an integer component value to the range of a normalized accessor, see
+// "Animations" and "Meshes" in the glTF 2.0 specification.
+inline double NormalizeComponent(ComponentType compType, double value)
+{
+    switch (compType) {
+        case ComponentType_BYTE:
+            return std::max(value / 127.0, -1.0);
+        case ComponentType_UNSIGNED_BYTE:
+            return value / 255.0;
+        case ComponentType_SHORT:
+            return std::max(value / 32767.0, -1.0);
+        case ComponentType_UNSIGNED_SHORT:
+            return value / 65535.0;
+        default:
+            return value;
+    }
+}
+
+// Exports vertex attributes with 1 or 2 byte components. The data holds four components
+// per element, the unused ones pad the elements to the 4 byte alignment required by the spec.
+inline Ref<Accessor> ExportPaddedData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    size_t count, void* data, AttribType::Value typeOut, ComponentType compType, bool normalized)
+{
+    Ref<Accessor> acc = ExportData(a, meshName, buffer, count, data, AttribType::VEC4, AttribType::VEC4, compType, BufferViewTarget_ARRAY_BUFFER);
+    if (!acc) {
+        return acc;
+    }
+
+    const unsigned int numComps = AttribType::GetNumComponents(typeOut);
+    acc->type = typeOut;
+    acc->normalized = normalized;
+    acc->min.resize(numComps);
+    acc->max.resize(numComps);
+    if (normalized) {
+        // the bounds of normalized accessors are given in the dequantized range
+        for (unsigned int i = 0; i < numComps; ++i) {
+            acc->min[i] = NormalizeComponent(compType, acc->min[i]);
+            acc->max[i] = NormalizeComponent(compType, acc->max[i]);
+        }
+    }
+    acc->bufferView->byteStride = 4 * ComponentTypeSize(compType);
+    return acc;
+}
+
+inline int16_t ToSnorm16(ai_real v)
+{
+    return static_cast<int16_t>(std::lround(std::max<ai_real>(-1, std::min<ai_real>(v, 1)) * 32767));
+}
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -609,18 +673,23 @@ void ExportSkin(Asset& mAsset, const aiMesh* aimesh, Ref<Mesh>& meshRef, Ref<Buf
         return;
     }
 
-    // Store the vertex joint and weight data.
+    // The vertex joint and weight data is written straight into the buffer.
+    // Joint indices are stored as unsigned shorts.
     const size_t NumVerts( aimesh->mNumVertices );
-    vec4* vertexJointData = new vec4[ NumVerts ];
-    vec4* vertexWeightData = new vec4[ NumVerts ];
-    int* jointsPerVertex = new int[ NumVerts ];
-    for (size_t i = 0; i < NumVerts; ++i) {
-        jointsPerVertex[i] = 0;
-        for (size_t j = 0; j < 4; ++j) {
-            vertexJointData[i][j] = 0;
-            vertexWeightData[i][j] = 0;
-        }
+    Ref<Accessor> vertexJointAccessor, vertexWeightAccessor;
+    uint16_t* vertexJointData = nullptr;
+    float* vertexWeightData = nullptr;
+    if (NumVerts > 0) {
+        vertexJointAccessor = CreateAccessor(mAsset, skinRef->id, bufferRef, NumVerts, AttribType::VEC4, ComponentType_UNSIGNED_SHORT);
+        vertexWeightAccessor = CreateAccessor(mAsset, skinRef->id, bufferRef, NumVerts, AttribType::VEC4, ComponentType_FLOAT);
+
+        // both pointers are taken after the last growth of the buffer
+        vertexJointData = reinterpret_cast<uint16_t*>(bufferRef->GetPointer() + vertexJointAccessor->bufferView->byteOffset);
+        vertexWeightData = reinterpret_cast<float*>(bufferRef->GetPointer() + vertexWeightAccessor->bufferView->byteOffset);
+        std::fill(vertexJointData, vertexJointData + NumVerts * 4, static_cast<uint16_t>(0));
+        std::fill(vertexWeightData, vertexWeightData + NumVerts * 4, 0.0f);
     }
+    std::vector<unsigned int> jointIndices(aimesh->mNumBones, 0);
 
     for (unsigned int idx_bone = 0; idx_bone < aimesh->mNumBones; ++idx_bone) {
         const aiBone* aib = aimesh->mBones[idx_bone];
@@ -649,58 +718,60 @@ void ExportSkin(Asset& mAsset, const aiMesh* aimesh, Ref<Mesh>& meshRef, Ref<Buf
             jointNamesIndex = static_cast<unsigned int>(inverseBindMatricesData.size() - 1);
         }
 
-        // aib->mWeights   =====>  vertexWeightData
-        for (unsigned int idx_weights = 0; idx_weights < aib->mNumWeights; ++idx_weights) {
-            unsigned int vertexId = aib->mWeights[idx_weights].mVertexId;
-            float vertWeight      = aib->mWeights[idx_weights].mWeight;
+        jointIndices[idx_bone] = jointNamesIndex;
+    } // End: for-loop mNumMeshes
 
-            // A vertex can only have at most four joint weights. Ignore all others.
-            if (jointsPerVertex[vertexId] > 3) {
-                continue;
+    // aimesh->mBoneInfluences   =====>  vertexJointData, vertexWeightData
+    std::unique_ptr<aiBoneInfluences> tempInfluences;
+    const aiBoneInfluences* influences = NumVerts ? GetBoneInfluences(aimesh, tempInfluences) : nullptr;
+    if (influences) {
+        // A vertex can only have at most four joint weights. The influences are sorted by
+        // descending weight, so the strongest ones are kept.
+        const unsigned int numSlots = influences->mNumInfluences, numUsed = std::min(numSlots, 4u);
+        for (size_t vertexId = 0; vertexId < NumVerts; ++vertexId) {
+            const unsigned int* bones = influences->mBoneIndices + vertexId * numSlots;
+            const ai_real* weights = influences->mWeights + vertexId * numSlots;
+            for (unsigned int j = 0; j < numUsed && weights[j] != 0.0; ++j) {
+                vertexJointData[vertexId * 4 + j] = static_cast<uint16_t>(jointIndices[bones[j]]);
+                vertexWeightData[vertexId * 4 + j] = static_cast<float>(weights[j]);
             }
-
-            vertexJointData[vertexId][jointsPerVertex[vertexId]] = static_cast<float>(jointNamesIndex);
-            vertexWeightData[vertexId][jointsPerVertex[vertexId]] = vertWeight;
-
-            jointsPerVertex[vertexId] += 1;
         }
-
-    } // End: for-loop mNumMeshes
+    }
 
     Mesh::Primitive& p = meshRef->primitives.back();
-    Ref<Accessor> vertexJointAccessor = ExportData(mAsset, skinRef->id, bufferRef, aimesh->mNumVertices, vertexJointData, AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT);
     if ( vertexJointAccessor ) {
-        size_t offset = vertexJointAccessor->bufferView->byteOffset;
-        size_t bytesLen = vertexJointAccessor->bufferView->byteLength;
-        unsigned int s_bytesPerComp= ComponentTypeSize(ComponentType_UNSIGNED_SHORT);
-        unsigned int bytesPerComp = ComponentTypeSize(vertexJointAccessor->componentType);
-        size_t s_bytesLen = bytesLen * s_bytesPerComp / bytesPerComp;
-        Ref<Buffer> buf = vertexJointAccessor->bufferView->buffer;
-        uint8_t* arrys = new uint8_t[bytesLen];
-        unsigned int i = 0;
-        for ( unsigned int j = 0; j <= bytesLen; j += bytesPerComp ){
-            size_t len_p = offset + j;
-            float f_value = *(float *)&buf->GetPointer()[len_p];
-            unsigned short c = static_cast<unsigned short>(f_value);
-            memcpy(&arrys[i*s_bytesPerComp], &c, s_bytesPerComp);
-            ++i;
-        }
-        buf->ReplaceData_joint(offset, bytesLen, arrys, bytesLen);
-        vertexJointAccessor->componentType = ComponentType_UNSIGNED_SHORT;
-        vertexJointAccessor->bufferView->byteLength = s_bytesLen;
-
+        SetAccessorRange(ComponentType_UNSIGNED_SHORT, vertexJointAccessor, vertexJointData, NumVerts, 4, 4);
         p.attributes.joint.push_back( vertexJointAccessor );
-        delete[] arrys;
     }
-
-    Ref<Accessor> vertexWeightAccessor = ExportData(mAsset, skinRef->id, bufferRef, aimesh->mNumVertices,
-            vertexWeightData, AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT);
     if ( vertexWeightAccessor ) {
+        SetAccessorRange(ComponentType_FLOAT, vertexWeightAccessor, vertexWeightData, NumVerts, 4, 4);
         p.attributes.weight.push_back( vertexWeightAccessor );
     }
-    delete[] jointsPerVertex;
-    delete[] vertexWeightData;
-    delete[] vertexJointData;
+}
+
+// Upper bound of the number of bytes the vertex and index data of a mesh takes in the buffer
+static size_t EstimateMeshDataSize(const aiMesh* aim)
+{
+    const size_t numVerts = aim->mNumVertices;
+    size_t size = numVerts * (2 * sizeof(aiVector3D) + 4);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        if (aim->HasTextureCoords(i)) {
+            size += numVerts * sizeof(aiVector3D) + 4;
+        }
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        if (aim->HasVertexColors(i)) {
+            size += numVerts * sizeof(aiColor4D) + 4;
+        }
+    }
+    for (unsigned int i = 0; i < aim->mNumFaces; ++i) {
+        size += aim->mFaces[i].mNumIndices * sizeof(unsigned int);
+    }
+    if (aim->HasBones()) {
+        size += numVerts * (4 * sizeof(uint16_t) + 4 * sizeof(float)) + 8 + aim->mNumBones * sizeof(aiMatrix4x4);
+    }
+    size += aim->mNumAnimMeshes * (numVerts * 2 * sizeof(aiVector3D) + 8);
+    return size + 4;
 }
 
 void glTF2Exporter::ExportMeshes()
@@ -716,6 +787,13 @@ void glTF2Exporter::ExportMeshes()
        b = mAsset->buffers.Create(bufferId);
     }
 
+    // size the buffer up front, so appending the attributes doesn't reallocate it
+    size_t estimatedSize = b->byteLength;
+    for (unsigned int idx_mesh = 0; idx_mesh < mScene->mNumMeshes; ++idx_mesh) {
+        estimatedSize += EstimateMeshDataSize(mScene->mMeshes[idx_mesh]);
+    }
+    b->Reserve(estimatedSize);
+
     //----------------------------------------
     // Initialize variables for the skin
     bool createSkin = false;
@@ -750,43 +828,117 @@ void glTF2Exporter::ExportMeshes()
 
         p.material = mAsset->materials.Get(aim->mMaterialIndex);
 
+        // KHR_mesh_quantization decodes positions through the node transform,
+        // which does not apply to skinned and morphed vertices
+        const aiQuantizedVertices* quantized = aim->mQuantized;
+        const bool quantizePositions = nullptr != quantized && !aim->HasBones() && 0 == aim->mNumAnimMeshes;
+
 		/******************* Vertices ********************/
-		Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
-		if (v) p.attributes.position.push_back(v);
+        if (quantizePositions) {
+            std::vector<uint16_t> positions(aim->mNumVertices * 4, 0);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                std::copy(quantized->mPositions + i * 3, quantized->mPositions + i * 3 + 3, &positions[i * 4]);
+            }
+            Ref<Accessor> v = ExportPaddedData(*mAsset, meshId, b, aim->mNumVertices, &positions[0], AttribType::VEC3, ComponentType_UNSIGNED_SHORT, true);
+            if (v) p.attributes.position.push_back(v);
+
+            aiMatrix4x4 translation, scaling;
+            aiMatrix4x4::Translation(quantized->mPositionOffset, translation);
+            aiMatrix4x4::Scaling(quantized->mPositionScale, scaling);
+            mDequantizationTransforms[idx_mesh] = translation * scaling;
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+            mAsset->extensionsRequired.KHR_mesh_quantization = true;
+        } else {
+		    Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+		    if (v) p.attributes.position.push_back(v);
+        }
 
 		/******************** Normals ********************/
-        // Normalize all normals as the validator can emit a warning otherwise
+        // Normalize all normals as the validator can emit a warning otherwise.
+        // The exporter may be handed the caller's meshes, so a copy is normalized.
+        std::vector<aiVector3D> normalData;
         if ( nullptr != aim->mNormals) {
-            for ( auto i = 0u; i < aim->mNumVertices; ++i ) {
-                aim->mNormals[ i ].NormalizeSafe();
+            normalData.assign(aim->mNormals, aim->mNormals + aim->mNumVertices);
+            for (aiVector3D &normal : normalData) {
+                normal.NormalizeSafe();
             }
         }
 
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
-        if (n) p.attributes.normal.push_back(n);
+        if (nullptr != quantized && !normalData.empty()) {
+            // normals are transformed by the inverse transpose of the dequantization
+            // scale, so they are scaled up front to end up in the original direction
+            std::vector<int16_t> normals(aim->mNumVertices * 4, 0);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                aiVector3D normal = normalData[i];
+                if (quantizePositions) {
+                    normal = normal.SymMul(quantized->mPositionScale);
+                    normal.NormalizeSafe();
+                }
+                normals[i * 4 + 0] = ToSnorm16(normal.x);
+                normals[i * 4 + 1] = ToSnorm16(normal.y);
+                normals[i * 4 + 2] = ToSnorm16(normal.z);
+            }
+            Ref<Accessor> n = ExportPaddedData(*mAsset, meshId, b, aim->mNumVertices, &normals[0], AttribType::VEC3, ComponentType_SHORT, true);
+            if (n) p.attributes.normal.push_back(n);
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+            mAsset->extensionsRequired.KHR_mesh_quantization = true;
+        } else {
+		    Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, normalData.empty() ? nullptr : &normalData[0], AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+            if (n) p.attributes.normal.push_back(n);
+        }
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
-			if (!aim->HasTextureCoords(i))
+			if (!aim->HasTextureCoords(i) || 0 == aim->mNumVertices)
 				continue;
 
-            // Flip UV y coords
+            // Flip UV y coords, on a copy for the same reason as the normals
+            std::vector<aiVector3D> uvData(aim->mTextureCoords[i], aim->mTextureCoords[i] + aim->mNumVertices);
             if (aim -> mNumUVComponents[i] > 1) {
-                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
+                for (aiVector3D &uv : uvData) {
+                    uv.y = 1 - uv.y;
+                }
+            }
+
+            // half floats are not allowed, normalized shorts are if all coordinates are in [0,1]
+            if (nullptr != quantized && aim->mNumUVComponents[i] == 2) {
+                std::vector<uint16_t> coords(aim->mNumVertices * 2);
+                bool inRange = true;
+                for (unsigned int j = 0; j < aim->mNumVertices && inRange; ++j) {
+                    const aiVector3D& uv = uvData[j];
+                    inRange = uv.x >= 0 && uv.x <= 1 && uv.y >= 0 && uv.y <= 1;
+                    coords[j * 2 + 0] = static_cast<uint16_t>(std::lround(uv.x * 65535));
+                    coords[j * 2 + 1] = static_cast<uint16_t>(std::lround(uv.y * 65535));
+                }
+                if (inRange) {
+                    Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, &coords[0], AttribType::VEC2, AttribType::VEC2, ComponentType_UNSIGNED_SHORT, BufferViewTarget_ARRAY_BUFFER);
+                    if (tc) {
+                        tc->normalized = true;
+                        p.attributes.texcoord.push_back(tc);
+                    }
+                    continue;
                 }
             }
 
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, &uvData[0], AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
 
 		/*************** Vertex colors ****************/
 		for (unsigned int indexColorChannel = 0; indexColorChannel < aim->GetNumColorChannels(); ++indexColorChannel) {
+            if (nullptr != quantized) {
+                Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, quantized->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_UNSIGNED_BYTE, BufferViewTarget_ARRAY_BUFFER);
+                if (c) {
+                    c->normalized = true;
+                    p.attributes.color.push_back(c);
+                }
+                continue;
+            }
+
 			Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 			if (c)
 				p.attributes.color.push_back(c);
@@ -850,10 +1002,10 @@ void glTF2Exporter::ExportMeshes()
                 }
 
                 // normal
-                if (pAnimMesh->HasNormals()) {
+                if (pAnimMesh->HasNormals() && !normalData.empty()) {
                     aiVector3D *pNormalDiff = new aiVector3D[pAnimMesh->mNumVertices];
                     for (unsigned int vt = 0; vt < pAnimMesh->mNumVertices; ++vt) {
-                        pNormalDiff[vt] = pAnimMesh->mNormals[vt] - aim->mNormals[vt];
+                        pNormalDiff[vt] = pAnimMesh->mNormals[vt] - normalData[vt];
                     }
                     Ref<Accessor> vec = ExportData(*mAsset, meshId, b,
                             pAnimMesh->mNumVertices, pNormalDiff,
@@ -915,6 +1067,37 @@ void glTF2Exporter::ExportMeshes()
     }
 }
 
+// Moves meshes with quantized positions into child nodes, which carry the dequantization transform
+void glTF2Exporter::InsertDequantizationNodes()
+{
+    if (mDequantizationTransforms.empty()) {
+        return;
+    }
+
+    const unsigned int nNodes = mAsset->nodes.Size();
+    for (unsigned int n = 0; n < nNodes; ++n) {
+        Ref<Node> node = mAsset->nodes.Get(n);
+
+        for (size_t m = 0; m < node->meshes.size();) {
+            auto it = mDequantizationTransforms.find(node->meshes[m].GetIndex());
+            if (it == mDequantizationTransforms.end()) {
+                ++m;
+                continue;
+            }
+
+            Ref<Node> child = mAsset->nodes.Create(mAsset->FindUniqueID(node->name, "dequantize"));
+            child->name = child->id;
+            child->parent = node;
+            child->matrix.isPresent = true;
+            CopyValue(it->second, child->matrix.value);
+            child->meshes.push_back(node->meshes[m]);
+
+            node->children.push_back(child);
+            node->meshes.erase(node->meshes.begin() + m);
+        }
+    }
+}
+
 // Merges a node's multiple meshes (with one primitive each) into one mesh with multiple primitives
 void glTF2Exporter::MergeMeshes()
 {
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 #include <assimp/material.h>
+#include <assimp/matrix4x4.h>
 
 #include <sstream>
 #include <vector>
@@ -109,6 +110,7 @@ namespace Assimp
         void ExportMetadata();
         void ExportMaterials();
         void ExportMeshes();
+        void InsertDequantizationNodes();
         void MergeMeshes();
         unsigned int ExportNodeHierarchy(const aiNode* n);
         unsigned int ExportNode(const aiNode* node, glTF2::Ref<glTF2::Node>& parent);
@@ -123,6 +125,7 @@ namespace Assimp
         std::map<std::string, unsigned int> mTexturesByPath;
         std::shared_ptr<glTF2::Asset> mAsset;
         std::vector<unsigned char> mBodyData;
+        std::map<unsigned int, aiMatrix4x4> mDequantizationTransforms;
     };
 
 }
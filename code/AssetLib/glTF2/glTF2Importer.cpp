@@ -382,11 +382,11 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
 			if (attr.position.size() > 0 && attr.position[0]) {
 				aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-				attr.position[0]->ExtractData(aim->mVertices);
+				attr.position[0]->ExtractFloatData(aim->mVertices);
 			}
 
 			if (attr.normal.size() > 0 && attr.normal[0]) {
-				attr.normal[0]->ExtractData(aim->mNormals);
+				attr.normal[0]->ExtractFloatData(aim->mNormals);
 
 				// only extract tangents if normals are present
 				if (attr.tangent.size() > 0 && attr.tangent[0]) {
@@ -413,7 +413,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 											   "\" does not match the vertex count");
 					continue;
 				}
-				attr.color[c]->ExtractData(aim->mColors[c]);
+				attr.color[c]->ExtractFloatData(aim->mColors[c]);
 			}
 			for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
                 if (!attr.texcoord[tc]) {
@@ -427,7 +427,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 					continue;
 				}
 
-				attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
+				attr.texcoord[tc]->ExtractFloatData(aim->mTextureCoords[tc]);
 				aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
 
 				aiVector3D *values = aim->mTextureCoords[tc];
@@ -790,7 +790,8 @@ static void GetNodeTransform(aiMatrix4x4 &matrix, const glTF2::Node &node) {
 	}
 }
 
-static void BuildVertexWeightMapping(Mesh::Primitive &primitive, std::vector<std::vector<aiVertexWeight>> &map) {
+static void BuildVertexWeightMapping(Mesh::Primitive &primitive, std::vector<std::vector<aiVertexWeight>> &map,
+		unsigned int numMeshVertices, aiBoneInfluences *&influences) {
 	Mesh::Primitive::Attributes &attr = primitive.attributes;
 	if (attr.weight.empty() || attr.joint.empty()) {
 		return;
@@ -827,13 +828,34 @@ static void BuildVertexWeightMapping(Mesh::Primitive &primitive, std::vector<std
 		return;
 	}
 
+	// the per-vertex influences are kept as they are, sorted by descending weight
+	if (num_vertices == numMeshVertices) {
+		influences = new aiBoneInfluences();
+		influences->mNumInfluences = 4;
+		influences->mBoneIndices = new unsigned int[num_vertices * 4]();
+		influences->mWeights = new ai_real[num_vertices * 4]();
+	}
+
 	for (size_t i = 0; i < num_vertices; ++i) {
+		unsigned int numUsed = 0;
 		for (int j = 0; j < 4; ++j) {
 			const unsigned int bone = (indices8 != nullptr) ? indices8[i].values[j] : indices16[i].values[j];
 			const float weight = weights[i].values[j];
 			if (weight > 0 && bone < map.size()) {
 				map[bone].reserve(8);
 				map[bone].emplace_back(static_cast<unsigned int>(i), weight);
+
+				if (influences) {
+					unsigned int *bones = influences->mBoneIndices + i * 4;
+					ai_real *vertexWeights = influences->mWeights + i * 4;
+					unsigned int slot = numUsed++;
+					for (; slot > 0 && vertexWeights[slot - 1] < weight; --slot) {
+						bones[slot] = bones[slot - 1];
+						vertexWeights[slot] = vertexWeights[slot - 1];
+					}
+					bones[slot] = bone;
+					vertexWeights[slot] = weight;
+				}
 			}
 		}
 	}
@@ -880,7 +902,8 @@ aiNode *ImportNode(aiScene *pScene, glTF2::Asset &r, std::vector<unsigned int> &
 				unsigned int numBones =static_cast<unsigned int>(node.skin->jointNames.size());
 
 				std::vector<std::vector<aiVertexWeight>> weighting(numBones);
-				BuildVertexWeightMapping(node.meshes[0]->primitives[primitiveNo], weighting);
+				aiBoneInfluences *influences = nullptr;
+				BuildVertexWeightMapping(node.meshes[0]->primitives[primitiveNo], weighting, mesh->mNumVertices, influences);
 
 				unsigned int realNumBones = 0;
 				for (uint32_t i = 0; i < numBones; ++i) {
@@ -900,7 +923,9 @@ aiNode *ImportNode(aiScene *pScene, glTF2::Asset &r, std::vector<unsigned int> &
 				// we copy the bone-to-vertex mapping into the bone.  This is unfortunate
 				// both because it's somewhat slow and because, for many applications,
 				// we then need to reconvert the data back into the vertex-to-bone
-				// mapping which makes things doubly-slow.
+				// mapping which makes things doubly-slow. That's why the vertex-to-bone
+				// mapping is kept in aiMesh::mBoneInfluences as well.
+				std::vector<unsigned int> boneMap(numBones, 0);
 
 				mat4 *pbindMatrices = nullptr;
 				node.skin->inverseBindMatrices->ExtractData(pbindMatrices);
@@ -926,10 +951,22 @@ aiNode *ImportNode(aiScene *pScene, glTF2::Asset &r, std::vector<unsigned int> &
 						bone->mNumWeights = static_cast<uint32_t>(weights.size());
 						bone->mWeights = new aiVertexWeight[bone->mNumWeights];
 						memcpy(bone->mWeights, weights.data(), bone->mNumWeights * sizeof(aiVertexWeight));
+						boneMap[i] = cb;
 						mesh->mBones[cb++] = bone;
 					}
 				}
 
+				if (influences && mesh->mNumBones) {
+					for (size_t i = 0, size = static_cast<size_t>(mesh->mNumVertices) * 4; i < size; ++i) {
+						if (influences->mWeights[i] != 0.0) {
+							influences->mBoneIndices[i] = boneMap[influences->mBoneIndices[i]];
+						}
+					}
+					mesh->mBoneInfluences = influences;
+				} else {
+					delete influences;
+				}
+
 				if (pbindMatrices) {
 					delete[] pbindMatrices;
 				}
@@ -0,0 +1,578 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AnimationEvaluator.cpp
+ *  @brief Implementation of the AnimationEvaluator class.
+ */
+
+#include <assimp/AnimationEvaluator.h>
+#include <assimp/scene.h>
+#include <assimp/ai_assert.h>
+
+#include "Common/ParallelFor.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(ASSIMP_DOUBLE_PRECISION)
+#   include <emmintrin.h>
+#   define AI_ANIMATIONEVALUATOR_SSE2
+#endif
+
+using namespace Assimp;
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Everything the evaluation needs that depends only on the scene and the animation
+class AnimationEvaluatorData {
+public:
+    struct NodeChannel {
+        const aiNodeAnim *mChannel;
+        unsigned int mNode;
+    };
+
+    struct MorphChannel {
+        const aiMeshMorphAnim *mChannel;
+        std::vector<unsigned int> mMeshes;
+    };
+
+    struct Influence {
+        unsigned int mBone;
+        float mWeight;
+    };
+
+    AnimationEvaluatorData() :
+            mScene(nullptr), mTicksPerSecond(25.0), mDuration(0.0) {
+        // empty
+    }
+
+    const aiScene *mScene;
+    double mTicksPerSecond;
+    double mDuration;
+
+    // flattened hierarchy, parents first
+    std::vector<const aiNode *> mNodes;
+    std::vector<unsigned int> mParents;
+    std::unordered_map<std::string, unsigned int> mNodesByName;
+
+    std::vector<NodeChannel> mNodeChannels;
+    std::vector<MorphChannel> mMorphChannels;
+
+    // per mesh: the node its bind pose refers to and the node of each bone
+    std::vector<unsigned int> mMeshNodes;
+    std::vector<std::vector<unsigned int>> mBoneNodes;
+
+    // per mesh: position of its weights in State::mMorphWeights, UINT_MAX if it has no anim meshes
+    std::vector<unsigned int> mMorphWeightOffsets;
+    std::vector<float> mDefaultMorphWeights;
+
+    // per mesh: bone influences of vertex v are mInfluences[mInfluenceOffsets[v] .. mInfluenceOffsets[v+1]]
+    std::vector<std::vector<unsigned int>> mInfluenceOffsets;
+    std::vector<std::vector<Influence>> mInfluences;
+};
+
+} // Namespace Assimp
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <class T>
+inline bool KeyBefore(double time, const T &key) {
+    return time < key.mTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the last key not after time, or 0 if time is before the first key. cursor holds the
+// result of the previous search, playback moves forward a few keys at a time at most.
+template <class T>
+unsigned int FindKey(const T *keys, unsigned int numKeys, double time, unsigned int &cursor) {
+    unsigned int i = cursor < numKeys ? cursor : 0;
+    if (keys[i].mTime <= time) {
+        for (unsigned int steps = 0; steps < 4 && i + 1 < numKeys && keys[i + 1].mTime <= time; ++steps) {
+            ++i;
+        }
+        if (i + 1 < numKeys && keys[i + 1].mTime <= time) {
+            i = static_cast<unsigned int>(std::upper_bound(keys + i + 1, keys + numKeys, time, KeyBefore<T>) - keys) - 1;
+        }
+    } else {
+        i = static_cast<unsigned int>(std::upper_bound(keys, keys + i, time, KeyBefore<T>) - keys);
+        i = i ? i - 1 : 0;
+    }
+    cursor = i;
+    return i;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Interpolation factor between key and key + 1
+template <class T>
+ai_real GetFactor(const T *keys, unsigned int numKeys, unsigned int key, double time) {
+    if (key + 1 >= numKeys || time <= keys[key].mTime) {
+        return ai_real(0.0);
+    }
+    const double span = keys[key + 1].mTime - keys[key].mTime;
+    return span > 0.0 ? static_cast<ai_real>(std::min(1.0, (time - keys[key].mTime) / span)) : ai_real(0.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D SampleVectorKeys(const aiVectorKey *keys, unsigned int numKeys, double time, unsigned int &cursor) {
+    const unsigned int key = FindKey(keys, numKeys, time, cursor);
+    const ai_real factor = GetFactor(keys, numKeys, key, time);
+    if (factor <= ai_real(0.0)) {
+        return keys[key].mValue;
+    }
+    return keys[key].mValue + (keys[key + 1].mValue - keys[key].mValue) * factor;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiQuaternion SampleQuatKeys(const aiQuatKey *keys, unsigned int numKeys, double time, unsigned int &cursor) {
+    const unsigned int key = FindKey(keys, numKeys, time, cursor);
+    const ai_real factor = GetFactor(keys, numKeys, key, time);
+    if (factor <= ai_real(0.0)) {
+        return keys[key].mValue;
+    }
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, keys[key].mValue, keys[key + 1].mValue, factor);
+    return out.Normalize();
+}
+
+// ------------------------------------------------------------------------------------------------
+void AddNodes(AnimationEvaluatorData &data, const aiNode *node, unsigned int parent) {
+    const unsigned int index = static_cast<unsigned int>(data.mNodes.size());
+    data.mNodes.push_back(node);
+    data.mParents.push_back(parent);
+    data.mNodesByName.insert(std::make_pair(std::string(node->mName.C_Str()), index));
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        const unsigned int mesh = node->mMeshes[i];
+        if (mesh < data.mMeshNodes.size() && UINT_MAX == data.mMeshNodes[mesh]) {
+            data.mMeshNodes[mesh] = index;
+        }
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        AddNodes(data, node->mChildren[i], index);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int FindNodeIndex(const AnimationEvaluatorData &data, const aiString &name) {
+    std::unordered_map<std::string, unsigned int>::const_iterator it = data.mNodesByName.find(std::string(name.C_Str()));
+    return it == data.mNodesByName.end() ? UINT_MAX : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PrepareMesh(AnimationEvaluatorData &data, unsigned int meshIndex) {
+    const aiMesh *mesh = data.mScene->mMeshes[meshIndex];
+
+    if (mesh->mNumAnimMeshes) {
+        data.mMorphWeightOffsets[meshIndex] = static_cast<unsigned int>(data.mDefaultMorphWeights.size());
+        for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+            data.mDefaultMorphWeights.push_back(mesh->mAnimMeshes[i]->mWeight);
+        }
+    }
+    if (!mesh->mNumBones) {
+        return;
+    }
+
+    std::vector<unsigned int> &boneNodes = data.mBoneNodes[meshIndex];
+    boneNodes.resize(mesh->mNumBones);
+    std::vector<unsigned int> &offsets = data.mInfluenceOffsets[meshIndex];
+    offsets.assign(mesh->mNumVertices + 1, 0);
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone *bone = mesh->mBones[b];
+        boneNodes[b] = FindNodeIndex(data, bone->mName);
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            if (bone->mWeights[w].mVertexId < mesh->mNumVertices) {
+                ++offsets[bone->mWeights[w].mVertexId + 1];
+            }
+        }
+    }
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<AnimationEvaluatorData::Influence> &influences = data.mInfluences[meshIndex];
+    influences.resize(offsets[mesh->mNumVertices]);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone *bone = mesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight &weight = bone->mWeights[w];
+            if (weight.mVertexId < mesh->mNumVertices) {
+                AnimationEvaluatorData::Influence &influence = influences[fill[weight.mVertexId]++];
+                influence.mBone = b;
+                influence.mWeight = static_cast<float>(weight.mWeight);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void EvaluateMorphChannel(const AnimationEvaluatorData &data, const AnimationEvaluatorData::MorphChannel &morph,
+        double time, unsigned int &cursor, float *weights) {
+    const aiMeshMorphAnim *channel = morph.mChannel;
+    const unsigned int key = FindKey(channel->mKeys, channel->mNumKeys, time, cursor);
+    const float factor = static_cast<float>(GetFactor(channel->mKeys, channel->mNumKeys, key, time));
+
+    for (unsigned int meshIndex : morph.mMeshes) {
+        const unsigned int offset = data.mMorphWeightOffsets[meshIndex];
+        const unsigned int numWeights = data.mScene->mMeshes[meshIndex]->mNumAnimMeshes;
+        float *meshWeights = weights + offset;
+        std::fill(meshWeights, meshWeights + numWeights, 0.0f);
+
+        // anim meshes not listed in a key have weight 0 at that key
+        for (unsigned int k = 0; k < 2; ++k) {
+            const float keyFactor = k ? factor : 1.0f - factor;
+            if (keyFactor <= 0.0f || key + k >= channel->mNumKeys) {
+                continue;
+            }
+            const aiMeshMorphKey &morphKey = channel->mKeys[key + k];
+            for (unsigned int i = 0; i < morphKey.mNumValuesAndWeights; ++i) {
+                if (morphKey.mValues[i] < numWeights) {
+                    meshWeights[morphKey.mValues[i]] += keyFactor * static_cast<float>(morphKey.mWeights[i]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+AnimationEvaluator::AnimationEvaluator(const aiScene *scene, unsigned int animationIndex) :
+        mData(new AnimationEvaluatorData()) {
+    ai_assert(nullptr != scene);
+
+    AnimationEvaluatorData &data = *mData;
+    data.mScene = scene;
+    data.mMeshNodes.assign(scene->mNumMeshes, UINT_MAX);
+    data.mBoneNodes.resize(scene->mNumMeshes);
+    data.mMorphWeightOffsets.assign(scene->mNumMeshes, UINT_MAX);
+    data.mInfluenceOffsets.resize(scene->mNumMeshes);
+    data.mInfluences.resize(scene->mNumMeshes);
+
+    if (nullptr != scene->mRootNode) {
+        AddNodes(data, scene->mRootNode, UINT_MAX);
+    }
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        PrepareMesh(data, i);
+    }
+
+    if (animationIndex >= scene->mNumAnimations) {
+        return;
+    }
+    const aiAnimation *animation = scene->mAnimations[animationIndex];
+    if (animation->mTicksPerSecond > 0.0) {
+        data.mTicksPerSecond = animation->mTicksPerSecond;
+    }
+    data.mDuration = animation->mDuration;
+
+    for (unsigned int i = 0; i < animation->mNumChannels; ++i) {
+        const aiNodeAnim *channel = animation->mChannels[i];
+        const unsigned int node = FindNodeIndex(data, channel->mNodeName);
+        if (UINT_MAX != node) {
+            AnimationEvaluatorData::NodeChannel nodeChannel;
+            nodeChannel.mChannel = channel;
+            nodeChannel.mNode = node;
+            data.mNodeChannels.push_back(nodeChannel);
+        }
+    }
+
+    // morph channels are named after the node holding the morphed meshes
+    for (unsigned int i = 0; i < animation->mNumMorphMeshChannels; ++i) {
+        const aiMeshMorphAnim *channel = animation->mMorphMeshChannels[i];
+        const unsigned int node = FindNodeIndex(data, channel->mName);
+        if (UINT_MAX == node || 0 == channel->mNumKeys) {
+            continue;
+        }
+        AnimationEvaluatorData::MorphChannel morph;
+        morph.mChannel = channel;
+        for (unsigned int m = 0; m < data.mNodes[node]->mNumMeshes; ++m) {
+            const unsigned int mesh = data.mNodes[node]->mMeshes[m];
+            if (mesh < scene->mNumMeshes && UINT_MAX != data.mMorphWeightOffsets[mesh]) {
+                morph.mMeshes.push_back(mesh);
+            }
+        }
+        if (!morph.mMeshes.empty()) {
+            data.mMorphChannels.push_back(morph);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationEvaluator::~AnimationEvaluator() {
+    delete mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::Evaluate(double seconds, State &state, bool loop) const {
+    const AnimationEvaluatorData &data = *mData;
+
+    // every following time calculation happens in ticks
+    double time = seconds * data.mTicksPerSecond;
+    if (data.mDuration > 0.0) {
+        if (loop) {
+            time = std::fmod(time, data.mDuration);
+            if (time < 0.0) {
+                time += data.mDuration;
+            }
+        } else {
+            time = std::max(0.0, std::min(time, data.mDuration));
+        }
+    } else {
+        time = 0.0;
+    }
+    state.mTime = time;
+
+    const size_t numNodes = data.mNodes.size();
+    const size_t numCursors = data.mNodeChannels.size() * 3 + data.mMorphChannels.size();
+    if (state.mKeyCursors.size() != numCursors) {
+        state.mKeyCursors.assign(numCursors, 0);
+    }
+    state.mLocalTransforms.resize(numNodes);
+    state.mGlobalTransforms.resize(numNodes);
+    state.mMorphWeights = data.mDefaultMorphWeights;
+
+    for (size_t i = 0; i < numNodes; ++i) {
+        state.mLocalTransforms[i] = data.mNodes[i]->mTransformation;
+    }
+
+    unsigned int *cursors = state.mKeyCursors.data();
+    for (const AnimationEvaluatorData::NodeChannel &nodeChannel : data.mNodeChannels) {
+        const aiNodeAnim *channel = nodeChannel.mChannel;
+        aiMatrix4x4 &local = state.mLocalTransforms[nodeChannel.mNode];
+
+        // channels without keys for a component keep it from the node transformation
+        aiVector3D scaling, position;
+        aiQuaternion rotation;
+        if (!channel->mNumPositionKeys || !channel->mNumRotationKeys || !channel->mNumScalingKeys) {
+            local.Decompose(scaling, rotation, position);
+        }
+        if (channel->mNumPositionKeys) {
+            position = SampleVectorKeys(channel->mPositionKeys, channel->mNumPositionKeys, time, cursors[0]);
+        }
+        if (channel->mNumRotationKeys) {
+            rotation = SampleQuatKeys(channel->mRotationKeys, channel->mNumRotationKeys, time, cursors[1]);
+        }
+        if (channel->mNumScalingKeys) {
+            scaling = SampleVectorKeys(channel->mScalingKeys, channel->mNumScalingKeys, time, cursors[2]);
+        }
+        local = aiMatrix4x4(scaling, rotation, position);
+        cursors += 3;
+    }
+
+    for (const AnimationEvaluatorData::MorphChannel &morph : data.mMorphChannels) {
+        EvaluateMorphChannel(data, morph, time, *cursors++, state.mMorphWeights.data());
+    }
+
+    for (size_t i = 0; i < numNodes; ++i) {
+        const unsigned int parent = data.mParents[i];
+        state.mGlobalTransforms[i] = UINT_MAX == parent ?
+                state.mLocalTransforms[i] :
+                state.mGlobalTransforms[parent] * state.mLocalTransforms[i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::Evaluate(const double *seconds, State *states, size_t count, bool loop,
+        int numThreads) const {
+    ParallelFor(GetNumWorkerThreads(numThreads), count, [&](size_t i) {
+        Evaluate(seconds[i], states[i], loop);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationEvaluator::GetNumNodes() const {
+    return static_cast<unsigned int>(mData->mNodes.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiNode *AnimationEvaluator::GetNode(unsigned int index) const {
+    return index < mData->mNodes.size() ? mData->mNodes[index] : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationEvaluator::FindNode(const char *name) const {
+    ai_assert(nullptr != name);
+    std::unordered_map<std::string, unsigned int>::const_iterator it = mData->mNodesByName.find(std::string(name));
+    return it == mData->mNodesByName.end() ? UINT_MAX : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::GetBoneMatrices(const State &state, unsigned int meshIndex, aiMatrix4x4 *out) const {
+    const AnimationEvaluatorData &data = *mData;
+    ai_assert(meshIndex < data.mScene->mNumMeshes);
+    ai_assert(state.mGlobalTransforms.size() == data.mNodes.size());
+
+    const aiMesh *mesh = data.mScene->mMeshes[meshIndex];
+    aiMatrix4x4 meshInverse;
+    if (UINT_MAX != data.mMeshNodes[meshIndex]) {
+        meshInverse = state.mGlobalTransforms[data.mMeshNodes[meshIndex]];
+        meshInverse.Inverse();
+    }
+
+    const std::vector<unsigned int> &boneNodes = data.mBoneNodes[meshIndex];
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        if (UINT_MAX == boneNodes[b]) {
+            // bone without node, leave the vertices in their bind pose
+            out[b] = aiMatrix4x4();
+            continue;
+        }
+        out[b] = meshInverse * state.mGlobalTransforms[boneNodes[b]] * mesh->mBones[b]->mOffsetMatrix;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+const float *AnimationEvaluator::GetMorphWeights(const State &state, unsigned int meshIndex) const {
+    ai_assert(meshIndex < mData->mScene->mNumMeshes);
+    const unsigned int offset = mData->mMorphWeightOffsets[meshIndex];
+    if (UINT_MAX == offset || offset >= state.mMorphWeights.size()) {
+        return nullptr;
+    }
+    return state.mMorphWeights.data() + offset;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::SkinMesh(const State &state, unsigned int meshIndex, aiVector3D *positions,
+        aiVector3D *normals) const {
+    const AnimationEvaluatorData &data = *mData;
+    ai_assert(meshIndex < data.mScene->mNumMeshes);
+    ai_assert(nullptr != positions);
+
+    const aiMesh *mesh = data.mScene->mMeshes[meshIndex];
+    if (nullptr == mesh->mNormals) {
+        normals = nullptr;
+    }
+    const std::vector<unsigned int> &offsets = data.mInfluenceOffsets[meshIndex];
+    if (offsets.empty()) {
+        std::copy(mesh->mVertices, mesh->mVertices + mesh->mNumVertices, positions);
+        if (normals) {
+            std::copy(mesh->mNormals, mesh->mNormals + mesh->mNumVertices, normals);
+        }
+        return;
+    }
+
+    std::vector<aiMatrix4x4> bones(mesh->mNumBones);
+    GetBoneMatrices(state, meshIndex, bones.data());
+    const AnimationEvaluatorData::Influence *influences = data.mInfluences[meshIndex].data();
+
+#ifdef AI_ANIMATIONEVALUATOR_SSE2
+    // store the matrices column by column, so blending and transforming are plain vector operations
+    std::vector<float> columns(bones.size() * 16);
+    for (size_t b = 0; b < bones.size(); ++b) {
+        const aiMatrix4x4 &m = bones[b];
+        const float values[16] = { m.a1, m.b1, m.c1, m.d1, m.a2, m.b2, m.c2, m.d2,
+            m.a3, m.b3, m.c3, m.d3, m.a4, m.b4, m.c4, m.d4 };
+        std::copy(values, values + 16, columns.begin() + b * 16);
+    }
+
+    float result[4];
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        if (offsets[v] == offsets[v + 1]) {
+            positions[v] = mesh->mVertices[v];
+            if (normals) {
+                normals[v] = mesh->mNormals[v];
+            }
+            continue;
+        }
+
+        __m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps(), c2 = _mm_setzero_ps(), c3 = _mm_setzero_ps();
+        for (unsigned int i = offsets[v]; i < offsets[v + 1]; ++i) {
+            const float *column = columns.data() + influences[i].mBone * 16;
+            const __m128 weight = _mm_set1_ps(influences[i].mWeight);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(weight, _mm_loadu_ps(column)));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(weight, _mm_loadu_ps(column + 4)));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(weight, _mm_loadu_ps(column + 8)));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(weight, _mm_loadu_ps(column + 12)));
+        }
+
+        const aiVector3D &p = mesh->mVertices[v];
+        __m128 out = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p.x)), _mm_mul_ps(c1, _mm_set1_ps(p.y))),
+                _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p.z)), c3));
+        _mm_storeu_ps(result, out);
+        positions[v].Set(result[0], result[1], result[2]);
+
+        if (normals) {
+            const aiVector3D &n = mesh->mNormals[v];
+            out = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n.x)), _mm_mul_ps(c1, _mm_set1_ps(n.y))),
+                    _mm_mul_ps(c2, _mm_set1_ps(n.z)));
+            _mm_storeu_ps(result, out);
+            normals[v].Set(result[0], result[1], result[2]);
+            normals[v].NormalizeSafe();
+        }
+    }
+#else
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        if (offsets[v] == offsets[v + 1]) {
+            positions[v] = mesh->mVertices[v];
+            if (normals) {
+                normals[v] = mesh->mNormals[v];
+            }
+            continue;
+        }
+
+        // blend the upper 3x4 part, the last row of an affine matrix stays (0, 0, 0, 1)
+        ai_real m[12] = { 0 };
+        for (unsigned int i = offsets[v]; i < offsets[v + 1]; ++i) {
+            const ai_real *bone = bones[influences[i].mBone][0];
+            const ai_real weight = influences[i].mWeight;
+            for (unsigned int k = 0; k < 12; ++k) {
+                m[k] += weight * bone[k];
+            }
+        }
+
+        const aiVector3D &p = mesh->mVertices[v];
+        positions[v].Set(m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3],
+                m[4] * p.x + m[5] * p.y + m[6] * p.z + m[7],
+                m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11]);
+        if (normals) {
+            const aiVector3D &n = mesh->mNormals[v];
+            normals[v].Set(m[0] * n.x + m[1] * n.y + m[2] * n.z,
+                    m[4] * n.x + m[5] * n.y + m[6] * n.z,
+                    m[8] * n.x + m[9] * n.y + m[10] * n.z);
+            normals[v].NormalizeSafe();
+        }
+    }
+#endif
+}
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/ImportTask.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
 
@@ -59,6 +60,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ScenePrivate.h"
 
 #include <list>
+#include <memory>
 
 // ------------------------------------------------------------------------------------------------
 #ifndef ASSIMP_BUILD_SINGLETHREADED
@@ -92,6 +94,20 @@ static PredefLogStreamMap gPredefinedStreams;
 /** Error message of the last failed import process */
 static std::string gLastErrorString;
 
+/** Runs asynchronous imports on a C executor */
+class CImportExecutorWrapper : public ImportExecutor {
+public:
+    explicit CImportExecutorWrapper(aiImportExecutor *executor) :
+            mExecutor(executor) {}
+
+    void Execute(aiImportTaskProc task, void *taskData) {
+        mExecutor->ExecuteProc(mExecutor, task, taskData);
+    }
+
+private:
+    aiImportExecutor *mExecutor;
+};
+
 /** Verbose logging active or not? */
 static aiBool gVerboseLogging = false;
 
@@ -258,6 +274,113 @@ const aiScene *aiImportFileFromMemoryWithProperties(
     return scene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// underlying structure for aiImportTask
+struct aiImportTask {
+    Importer *mImporter;
+    ImportTask *mTask;
+
+    // set once the importer has been handed over to the scene
+    bool mSceneOwnsImporter;
+};
+
+// ------------------------------------------------------------------------------------------------
+aiImportTask *aiImportFileAsync(const char *pFile, unsigned int pFlags,
+        aiFileIO *pFS, const aiPropertyStore *props, aiImportExecutor *pExecutor) {
+    ai_assert(NULL != pFile);
+
+    aiImportTask *task = NULL;
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    // create an Importer for this file, the task takes it over once started
+    std::unique_ptr<Assimp::Importer> imp(new Assimp::Importer());
+
+    // copy properties
+    if (props) {
+        const PropertyMap *pp = reinterpret_cast<const PropertyMap *>(props);
+        ImporterPimpl *pimpl = imp->Pimpl();
+        pimpl->mIntProperties = pp->ints;
+        pimpl->mFloatProperties = pp->floats;
+        pimpl->mStringProperties = pp->strings;
+        pimpl->mMatrixProperties = pp->matrices;
+    }
+    // setup a custom IO system if necessary
+    if (pFS) {
+        imp->SetIOHandler(new CIOSystemWrapper(pFS));
+    }
+
+    // the executor is only used to schedule the job, right away
+    std::unique_ptr<aiImportTask> newTask(new aiImportTask());
+    newTask->mSceneOwnsImporter = false;
+    if (pExecutor) {
+        CImportExecutorWrapper executor(pExecutor);
+        newTask->mTask = imp->ReadFileAsync(pFile, pFlags, &executor);
+    } else {
+        newTask->mTask = imp->ReadFileAsync(pFile, pFlags);
+    }
+    newTask->mImporter = imp.release();
+    task = newTask.release();
+
+    ASSIMP_END_EXCEPTION_REGION(aiImportTask *);
+    return task;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene *aiWaitImportTask(aiImportTask *pTask) {
+    ai_assert(NULL != pTask);
+
+    const aiScene *scene = pTask->mTask->Wait();
+
+    // if succeeded, store the importer in the scene and keep it alive
+    if (scene) {
+        ScenePrivateData *priv = const_cast<ScenePrivateData *>(ScenePriv(scene));
+        priv->mOrigImporter = pTask->mImporter;
+        pTask->mSceneOwnsImporter = true;
+    } else {
+        gLastErrorString = pTask->mImporter->GetErrorString();
+    }
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBool aiIsImportTaskDone(const aiImportTask *pTask) {
+    ai_assert(NULL != pTask);
+    return pTask->mTask->IsDone() ? AI_TRUE : AI_FALSE;
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiCancelImportTask(aiImportTask *pTask) {
+    ai_assert(NULL != pTask);
+    pTask->mTask->Cancel();
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiGetImportTaskProgress(const aiImportTask *pTask, aiImportProgress *pOut) {
+    ai_assert(NULL != pTask);
+    ai_assert(NULL != pOut);
+    *pOut = pTask->mTask->GetProgress();
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiReleaseImportTask(aiImportTask *pTask) {
+    if (!pTask) {
+        return;
+    }
+
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+    if (!pTask->mTask->IsDone()) {
+        pTask->mTask->Cancel();
+    }
+
+    // waits for the import to finish
+    delete pTask->mTask;
+    if (!pTask->mSceneOwnsImporter) {
+        delete pTask->mImporter;
+    }
+    delete pTask;
+    ASSIMP_END_EXCEPTION_REGION(void);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Releases all resources associated with the given import process.
 void aiReleaseImport(const aiScene *pScene) {
@@ -307,6 +430,22 @@ ASSIMP_API const aiScene *aiApplyPostProcessing(const aiScene *pScene,
     return sc;
 }
 
+// ------------------------------------------------------------------------------------------------
+ASSIMP_API void aiMarkMeshModified(const aiScene *pScene, unsigned int pMeshIndex) {
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    // find the importer associated with this data
+    const ScenePrivateData *priv = ScenePriv(pScene);
+    if (!priv || !priv->mOrigImporter) {
+        ReportSceneNotFoundError();
+        return;
+    }
+
+    priv->mOrigImporter->MarkMeshModified(pMeshIndex);
+
+    ASSIMP_END_EXCEPTION_REGION(void);
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API const aiScene *aiApplyCustomizedPostProcessing(const aiScene *scene,
         BaseProcess *process,
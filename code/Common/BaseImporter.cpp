@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ParsingUtils.h>
 #include "FileSystemFilter.h"
 #include "Importer.h"
+#include "MeshChunkSink.h"
 #include <assimp/ByteSwapper.h>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
@@ -66,7 +67,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-: m_progress() {
+: m_progress()
+, m_importer() {
     /**
     * Assimp Importer
     * unit conversions available
@@ -112,6 +114,7 @@ aiScene* BaseImporter::ReadFile(Importer* pImp, const std::string& pFile, IOSyst
     if (nullptr == m_progress) {
         return nullptr;
     }
+    m_importer = pImp;
 
     ai_assert(m_progress);
 
@@ -145,12 +148,54 @@ aiScene* BaseImporter::ReadFile(Importer* pImp, const std::string& pFile, IOSyst
     return sc.release();
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::ReadFileStreamed(Importer* pImp, const std::string& pFile, IOSystem* pIOHandler, MeshChunkSink& pSink) {
+    m_progress = pImp->GetProgressHandler();
+    if (nullptr == m_progress) {
+        return false;
+    }
+    m_importer = pImp;
+
+    // Gather configuration properties for this run
+    SetupProperties( pImp );
+
+    // Construct a file system filter to improve our success ratio at reading external files
+    FileSystemFilter filter(pFile,pIOHandler);
+
+    // dispatch importing
+    try
+    {
+        InternReadStreamed( pFile, &filter, pSink);
+        pSink.Finish();
+    } catch( const std::exception& err )    {
+        // extract error description
+        m_ErrorText = err.what();
+        ASSIMP_LOG_ERROR(m_ErrorText);
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseImporter::InternReadStreamed(const std::string& , IOSystem* , MeshChunkSink& ) {
+    const aiImporterDesc* desc = GetInfo();
+    throw DeadlyImportError(std::string(desc ? desc->mName : "This importer") + " does not support streaming imports");
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseImporter::SetupProperties(const Importer* )
 {
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseImporter::ThrowIfCancelled() const
+{
+    if (m_importer && m_importer->IsCancelRequested()) {
+        throw DeadlyImportError("Import cancelled");
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseImporter::GetExtensionList(std::set<std::string>& extensions) {
     const aiImporterDesc* desc = GetInfo();
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseProcess.h"
 #include "Importer.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/Exceptional.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -53,7 +54,9 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          meshSelection(),
+          progress(),
+          importer() {
     // empty
 }
 
@@ -70,6 +73,7 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
 
     progress = pImp->GetProgressHandler();
     ai_assert(nullptr != progress);
+    importer = pImp;
 
     SetupProperties(pImp);
 
@@ -87,6 +91,14 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
         delete pImp->Pimpl()->mScene;
         pImp->Pimpl()->mScene = nullptr;
     }
+    importer = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ThrowIfCancelled() const {
+    if (importer && importer->IsCancelRequested()) {
+        throw DeadlyImportError("Import cancelled");
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -94,7 +106,22 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsExtActive(unsigned int /*pExtFlags*/) const {
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsPerMeshStep() const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char *BaseProcess::GetName() const {
+    return "";
+}
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/GenericProperty.h>
 
 #include <map>
+#include <vector>
 
 struct aiScene;
 
@@ -194,11 +195,43 @@ public:
     */
     virtual bool IsActive(unsigned int pFlags) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is present in the given
+     * extended flag field.
+     * @param pExtFlags The value of the #AI_CONFIG_PP_EXTENDED_STEPS
+     *   property. A bitwise combination of #aiPostProcessStepsExt.
+     * @return true if the process is present in this flag field. The
+     *   default implementation always returns false.
+    */
+    virtual bool IsExtActive(unsigned int pExtFlags) const;
+
     // -------------------------------------------------------------------
     /** Check whether this step expects its input vertex data to be
      *  in verbose format. */
     virtual bool RequireVerboseFormat() const;
 
+    // -------------------------------------------------------------------
+    /** Check whether this step processes each mesh on its own, without
+     *  changing the number or the order of the meshes in the scene.
+     *  Only such steps honour the mesh selection set by SetMeshSelection().
+     *  The default implementation returns false. */
+    virtual bool IsPerMeshStep() const;
+
+    // -------------------------------------------------------------------
+    /** Returns the name of the step, as reported to the progress of an
+     *  asynchronous import. The default implementation returns an empty
+     *  string. */
+    virtual const char *GetName() const;
+
+    // -------------------------------------------------------------------
+    /** Restrict the next executions of a per-mesh step to some meshes.
+     * @param selection One entry per mesh, true if the mesh is to be
+     *   processed. nullptr selects all meshes.
+    */
+    inline void SetMeshSelection(const std::vector<bool> *selection) {
+        meshSelection = selection;
+    }
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * The function deletes the scene if the postprocess step fails (
@@ -239,11 +272,30 @@ public:
     }
 
 protected:
+    // -------------------------------------------------------------------
+    /** Check whether a mesh is selected for processing, see
+     *  SetMeshSelection(). */
+    inline bool IsMeshSelected(unsigned int meshIndex) const {
+        return nullptr == meshSelection || meshIndex >= meshSelection->size() || (*meshSelection)[meshIndex];
+    }
+
+    // -------------------------------------------------------------------
+    /** Polled by long-running steps between meshes. Throws if the
+     *  import has been cancelled, see Importer::RequestCancel(). Must
+     *  not be called from worker threads. */
+    void ThrowIfCancelled() const;
+
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo *shared;
 
+    /** Meshes to be processed by per-mesh steps, nullptr for all */
+    const std::vector<bool> *meshSelection;
+
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Importer running the step, nullptr if Execute() is called directly */
+    const Importer *importer;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,496 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file BatchImporter.cpp
+ *  @brief Implementation of #BatchImporter.
+ */
+
+#include "Common/Importer.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/BatchImporter.hpp>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/GenericProperty.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/scene.h>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#ifndef ASSIMP_BUILD_NO_THREADING
+#   include <system_error>
+#   include <thread>
+#endif
+
+namespace Assimp {
+
+namespace {
+
+static const size_t DefaultSharedFileCacheSize = 64 * 1024 * 1024;
+
+// ------------------------------------------------------------------------------------------------
+// Contents of a file read by several imports. Loaded by the first import which opens it.
+struct SharedFile {
+    SharedFile() :
+            mMutex(), mLoaded(false), mCached(false), mData() {
+        // empty
+    }
+
+    std::mutex mMutex;
+    bool mLoaded;
+    bool mCached; // false if the file is missing or didn't fit into the budget
+    std::vector<uint8_t> mData;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Memory stream over a cached file, keeps the file data alive while open
+class SharedFileStream : public MemoryIOStream {
+public:
+    explicit SharedFileStream(const std::shared_ptr<SharedFile> &file) :
+            MemoryIOStream(file->mData.empty() ? nullptr : &file->mData[0], file->mData.size()),
+            mFile(file) {
+        // empty
+    }
+
+private:
+    std::shared_ptr<SharedFile> mFile;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Cache of the files read by the imports of one run, shared by all workers
+class SharedFileCache {
+public:
+    SharedFileCache(IOSystem *io, const std::unordered_set<std::string> &requested, size_t budget) :
+            mIO(io), mRequested(requested), mMutex(), mFiles(), mBudget(budget), mHits(0) {
+        // empty
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode) {
+        // requested files are read once anyway, and writes are none of our business
+        if ('r' != pMode[0] || 0 == mBudget || mRequested.count(pFile)) {
+            return mIO->Open(pFile, pMode);
+        }
+
+        std::shared_ptr<SharedFile> file;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::shared_ptr<SharedFile> &entry = mFiles[pFile];
+            if (!entry) {
+                entry = std::make_shared<SharedFile>();
+            }
+            file = entry;
+        }
+
+        std::lock_guard<std::mutex> lock(file->mMutex);
+        if (file->mLoaded) {
+            if (!file->mCached) {
+                return mIO->Open(pFile, pMode);
+            }
+            ++mHits;
+            return new SharedFileStream(file);
+        }
+
+        file->mLoaded = true;
+        IOStream *stream = mIO->Open(pFile, pMode);
+        if (nullptr == stream) {
+            return nullptr;
+        }
+
+        const size_t size = stream->FileSize();
+        if (!Reserve(size)) {
+            return stream;
+        }
+
+        file->mData.resize(size);
+        const size_t read = size ? stream->Read(&file->mData[0], 1, size) : 0;
+        mIO->Close(stream);
+        if (read != size) {
+            Release(size);
+            file->mData.clear();
+            file->mData.shrink_to_fit();
+            return mIO->Open(pFile, pMode);
+        }
+        file->mCached = true;
+        return new SharedFileStream(file);
+    }
+
+    void Close(IOStream *pFile) {
+        if (dynamic_cast<SharedFileStream *>(pFile)) {
+            delete pFile;
+        } else {
+            mIO->Close(pFile);
+        }
+    }
+
+    IOSystem *GetIO() const {
+        return mIO;
+    }
+
+    size_t GetNumHits() const {
+        return mHits;
+    }
+
+private:
+    bool Reserve(size_t size) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (size > mBudget) {
+            return false;
+        }
+        mBudget -= size;
+        return true;
+    }
+
+    void Release(size_t size) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBudget += size;
+    }
+
+    IOSystem *mIO;
+    const std::unordered_set<std::string> &mRequested;
+    std::mutex mMutex;
+    std::unordered_map<std::string, std::shared_ptr<SharedFile>> mFiles;
+    size_t mBudget;
+    std::atomic<size_t> mHits;
+};
+
+// ------------------------------------------------------------------------------------------------
+// IO system of a single worker. Reads through the shared cache, but keeps a directory stack
+// of its own since importers push and pop directories while reading.
+class WorkerIOSystem : public IOSystem {
+public:
+    explicit WorkerIOSystem(SharedFileCache &cache) :
+            mCache(cache) {
+        // empty
+    }
+
+    bool Exists(const char *pFile) const override {
+        return mCache.GetIO()->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mCache.GetIO()->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        return mCache.Open(pFile, pMode);
+    }
+
+    void Close(IOStream *pFile) override {
+        mCache.Close(pFile);
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        return mCache.GetIO()->ComparePaths(one, second);
+    }
+
+private:
+    SharedFileCache &mCache;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct BatchRequest {
+    BatchRequest(const std::string &file, unsigned int flags) :
+            mFile(file), mFlags(flags) {
+        // empty
+    }
+
+    std::string mFile;
+    unsigned int mFlags;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Request ids of one worker. The owner takes them from the front, thieves from the back.
+struct WorkQueue {
+    std::mutex mMutex;
+    std::deque<unsigned int> mItems;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+class BatchImporterPimpl {
+public:
+    BatchImporterPimpl(IOSystem *io) :
+            mIO(io),
+            mOwnsIO(nullptr == io),
+            mNumThreads(-1),
+            mCacheSize(DefaultSharedFileCacheSize),
+            mRequests(),
+            mRequestIds(),
+            mHits(0) {
+        if (mOwnsIO) {
+            mIO = new DefaultIOSystem();
+        }
+    }
+
+    ~BatchImporterPimpl() {
+        if (mOwnsIO) {
+            delete mIO;
+        }
+    }
+
+    void RunWorker(unsigned int self, std::vector<WorkQueue> &queues, SharedFileCache &cache,
+            BatchImportHandler *handler, std::mutex &handlerMutex, std::atomic<size_t> &numSucceeded);
+
+    IOSystem *mIO;
+    bool mOwnsIO;
+    int mNumThreads;
+    size_t mCacheSize;
+
+    ImporterPimpl::IntPropertyMap mIntProperties;
+    ImporterPimpl::FloatPropertyMap mFloatProperties;
+    ImporterPimpl::StringPropertyMap mStringProperties;
+
+    std::vector<BatchRequest> mRequests;
+    std::unordered_map<std::string, unsigned int> mRequestIds;
+    size_t mHits;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Imports requests until no worker has any left
+void BatchImporterPimpl::RunWorker(unsigned int self, std::vector<WorkQueue> &queues, SharedFileCache &cache,
+        BatchImportHandler *handler, std::mutex &handlerMutex, std::atomic<size_t> &numSucceeded) {
+    Importer importer;
+    WorkerIOSystem io(cache);
+    importer.SetIOHandler(&io);
+
+    ImporterPimpl *pimpl = importer.Pimpl();
+    pimpl->mIntProperties = mIntProperties;
+    pimpl->mFloatProperties = mFloatProperties;
+    pimpl->mStringProperties = mStringProperties;
+
+    const unsigned int numQueues = static_cast<unsigned int>(queues.size());
+    try {
+        for (;;) {
+            // own queue first, then steal from the others
+            bool found = false;
+            unsigned int id = 0;
+            for (unsigned int i = 0; !found && i < numQueues; ++i) {
+                WorkQueue &queue = queues[(self + i) % numQueues];
+                std::lock_guard<std::mutex> lock(queue.mMutex);
+                if (queue.mItems.empty()) {
+                    continue;
+                }
+                if (0 == i) {
+                    id = queue.mItems.front();
+                    queue.mItems.pop_front();
+                } else {
+                    id = queue.mItems.back();
+                    queue.mItems.pop_back();
+                }
+                found = true;
+            }
+            // no request is ever added during a run, so all queues being empty means we're done
+            if (!found) {
+                break;
+            }
+
+            const BatchRequest &request = mRequests[id];
+            try {
+                importer.ReadFile(request.mFile.c_str(), request.mFlags);
+            } catch (const std::exception &e) {
+                // only reached in builds which don't catch them in ReadFile()
+                pimpl->mErrorString = e.what();
+            }
+            // GetOrphanedScene() resets the error string
+            const std::string error = importer.GetErrorString();
+            aiScene *scene = importer.GetOrphanedScene();
+            if (nullptr != scene) {
+                ++numSucceeded;
+            }
+
+            std::lock_guard<std::mutex> lock(handlerMutex);
+            handler->OnImported(id, request.mFile, scene, scene ? std::string() : error);
+        }
+    } catch (...) {
+        importer.SetIOHandler(nullptr);
+        throw;
+    }
+    importer.SetIOHandler(nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::BatchImporter(IOSystem *pIOHandler) :
+        mPimpl(new BatchImporterPimpl(pIOHandler)) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::~BatchImporter() {
+    delete mPimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::SetNumThreads(int numThreads) {
+    mPimpl->mNumThreads = numThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::SetSharedFileCacheSize(size_t bytes) {
+    mPimpl->mCacheSize = bytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::SetPropertyInteger(const char *szName, int iValue) {
+    SetGenericProperty<int>(mPimpl->mIntProperties, szName, iValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::SetPropertyFloat(const char *szName, ai_real fValue) {
+    SetGenericProperty<ai_real>(mPimpl->mFloatProperties, szName, fValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+void BatchImporter::SetPropertyString(const char *szName, const std::string &sValue) {
+    SetGenericProperty<std::string>(mPimpl->mStringProperties, szName, sValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BatchImporter::AddRequest(const std::string &file, unsigned int pFlags) {
+    ai_assert(!file.empty());
+
+    std::string key = file;
+    key.append(reinterpret_cast<const char *>(&pFlags), sizeof(pFlags));
+    const unsigned int id = static_cast<unsigned int>(mPimpl->mRequests.size());
+    std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> it =
+            mPimpl->mRequestIds.insert(std::make_pair(key, id));
+    if (it.second) {
+        mPimpl->mRequests.emplace_back(file, pFlags);
+    }
+    return it.first->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BatchImporter::GetNumRequests() const {
+    return mPimpl->mRequests.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BatchImporter::Run(BatchImportHandler *handler) {
+    ai_assert(nullptr != handler);
+
+    const size_t numRequests = mPimpl->mRequests.size();
+    mPimpl->mHits = 0;
+    if (0 == numRequests) {
+        return 0;
+    }
+
+    unsigned int numThreads = GetNumWorkerThreads(mPimpl->mNumThreads);
+    if (numThreads > numRequests) {
+        numThreads = static_cast<unsigned int>(numRequests);
+    }
+
+    // hand out contiguous ranges so files added together, which tend to
+    // share resources, start out on the same worker
+    std::vector<WorkQueue> queues(numThreads);
+    for (size_t i = 0; i < numRequests; ++i) {
+        queues[i * numThreads / numRequests].mItems.push_back(static_cast<unsigned int>(i));
+    }
+
+    std::unordered_set<std::string> requested;
+    for (const BatchRequest &request : mPimpl->mRequests) {
+        requested.insert(request.mFile);
+    }
+    SharedFileCache cache(mPimpl->mIO, requested, mPimpl->mCacheSize);
+
+    std::mutex handlerMutex;
+    std::atomic<size_t> numSucceeded(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&](unsigned int self) {
+        try {
+            mPimpl->RunWorker(self, queues, cache, handler, handlerMutex, numSucceeded);
+        } catch (...) {
+            // drop the remaining requests and report the first error once all workers are done
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            for (WorkQueue &queue : queues) {
+                std::lock_guard<std::mutex> queueLock(queue.mMutex);
+                queue.mItems.clear();
+            }
+        }
+    };
+
+#ifndef ASSIMP_BUILD_NO_THREADING
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(worker, t);
+        } catch (const std::system_error &) {
+            // out of threads - the others steal the orphaned queues
+            break;
+        }
+    }
+#endif
+    worker(0);
+#ifndef ASSIMP_BUILD_NO_THREADING
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+#endif
+
+    mPimpl->mHits = cache.GetNumHits();
+    mPimpl->mRequests.clear();
+    mPimpl->mRequestIds.clear();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return numSucceeded;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t BatchImporter::GetNumSharedFileHits() const {
+    return mPimpl->mHits;
+}
+
+} // Namespace Assimp
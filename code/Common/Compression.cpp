@@ -0,0 +1,283 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Compression.cpp
+ *  @brief Implementation of the zlib inflate helpers.
+ */
+
+#include "Compression.h"
+
+#include <assimp/ByteSwapper.h>
+#include <assimp/Exceptional.h>
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#   include <zlib.h>
+#else
+#   include "../contrib/zlib/zlib.h"
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace Assimp {
+
+// size of the chunks compressed data is read in
+static const size_t InputChunkSize = 64 * 1024;
+
+// deflate can't compress better than this, see zlib's technical details
+static const size_t MaxDeflateRatio = 1032;
+
+// ------------------------------------------------------------------------------------------------
+Inflater::Inflater(Format format) :
+        mStream(new z_stream()),
+        mFinished(false) {
+    mStream->zalloc = Z_NULL;
+    mStream->zfree = Z_NULL;
+    mStream->opaque = Z_NULL;
+    mStream->data_type = Z_BINARY;
+
+    int windowBits = MAX_WBITS;
+    if (format == Format_Gzip) {
+        windowBits += 16;
+    } else if (format == Format_Raw) {
+        windowBits = -windowBits;
+    }
+    if (Z_OK != inflateInit2(mStream, windowBits)) {
+        delete mStream;
+        throw DeadlyImportError("Inflater: Failed to initialize zlib");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+Inflater::~Inflater() {
+    inflateEnd(mStream);
+    delete mStream;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Inflater::Reset() {
+    inflateReset(mStream);
+    mFinished = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Inflater::SetDictionary(const void *data, size_t size) {
+    if (Z_OK != inflateSetDictionary(mStream, static_cast<const Bytef *>(data), static_cast<uInt>(size))) {
+        throw DeadlyImportError("Inflater: Failed to set dictionary");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t Inflater::Inflate(const uint8_t *&in, size_t &inSize, uint8_t *out, size_t outSize) {
+    size_t written = 0;
+    // keep going without input as long as zlib has pending output
+    while (!mFinished && written < outSize) {
+        // zlib counts in uInt, so feed huge buffers piece by piece
+        const uInt availIn = static_cast<uInt>(std::min<size_t>(inSize, UINT32_MAX));
+        const uInt availOut = static_cast<uInt>(std::min<size_t>(outSize - written, UINT32_MAX));
+        mStream->next_in = const_cast<Bytef *>(in);
+        mStream->avail_in = availIn;
+        mStream->next_out = out + written;
+        mStream->avail_out = availOut;
+
+        // Z_BUF_ERROR only tells that no progress was possible, which is fine as long as
+        // the input is exhausted and the caller has more of it
+        const int ret = inflate(mStream, Z_NO_FLUSH);
+        if ((ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) || (ret == Z_BUF_ERROR && availIn && availOut)) {
+            throw DeadlyImportError("Inflater: Failed to decompress data, it is corrupt or truncated");
+        }
+
+        const size_t consumed = availIn - mStream->avail_in;
+        const size_t produced = availOut - mStream->avail_out;
+        in += consumed;
+        inSize -= consumed;
+        written += produced;
+
+        if (ret == Z_STREAM_END) {
+            mFinished = true;
+        } else if (!consumed && !produced) {
+            break;
+        }
+    }
+    return written;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t Inflater::InflateAll(const void *in, size_t inSize, void *out, size_t outSize) {
+    Reset();
+    const uint8_t *next = static_cast<const uint8_t *>(in);
+    const size_t written = Inflate(next, inSize, static_cast<uint8_t *>(out), outSize);
+    if (!mFinished && written < outSize) {
+        throw DeadlyImportError("Inflater: Compressed data is truncated");
+    }
+    return written;
+}
+
+// ------------------------------------------------------------------------------------------------
+InflateIOStream::InflateIOStream(std::shared_ptr<IOStream> source, Inflater::Format format, size_t size) :
+        mSource(source),
+        mSourceStart(source->Tell()),
+        mInflater(format),
+        mInput(InputChunkSize),
+        mNext(nullptr),
+        mAvailable(0),
+        mSize(size),
+        mPosition(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+InflateIOStream::~InflateIOStream() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::InflateTo(uint8_t *out, size_t size) {
+    size = std::min(size, mSize - mPosition);
+    size_t written = 0;
+    while (written < size && !mInflater.IsFinished()) {
+        if (!mAvailable) {
+            mAvailable = mSource->Read(&mInput[0], 1, mInput.size());
+            mNext = &mInput[0];
+        }
+        if (!mAvailable) {
+            throw DeadlyImportError("InflateIOStream: Compressed data is truncated");
+        }
+        written += mInflater.Inflate(mNext, mAvailable, out + written, size - written);
+    }
+    if (written < size) {
+        throw DeadlyImportError("InflateIOStream: Decompressed data is shorter than expected");
+    }
+    mPosition += written;
+    return written;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    if (!pSize) {
+        return 0;
+    }
+    return InflateTo(static_cast<uint8_t *>(pvBuffer), pSize * pCount) / pSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn InflateIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t target = pOffset;
+    if (pOrigin == aiOrigin_CUR) {
+        target += mPosition;
+    } else if (pOrigin == aiOrigin_END) {
+        if (pOffset > mSize) {
+            return aiReturn_FAILURE;
+        }
+        target = mSize - pOffset;
+    }
+    if (target > mSize) {
+        return aiReturn_FAILURE;
+    }
+
+    if (target < mPosition) {
+        // no way back, start over
+        if (aiReturn_SUCCESS != mSource->Seek(mSourceStart, aiOrigin_SET)) {
+            return aiReturn_FAILURE;
+        }
+        mInflater.Reset();
+        mAvailable = 0;
+        mPosition = 0;
+    }
+
+    uint8_t scratch[4096];
+    while (mPosition < target) {
+        if (!InflateTo(scratch, std::min(sizeof(scratch), target - mPosition))) {
+            return aiReturn_FAILURE;
+        }
+    }
+    return aiReturn_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::Tell() const {
+    return mPosition;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InflateIOStream::Flush() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::GetGzipSize(IOStream &stream) {
+    const size_t fileSize = stream.FileSize();
+    // 10 bytes header, 8 bytes trailer
+    if (fileSize < 18) {
+        return 0;
+    }
+
+    const size_t pos = stream.Tell();
+    uint32_t isize = 0;
+    stream.Seek(fileSize - 4, aiOrigin_SET);
+    if (stream.Read(&isize, 4, 1) != 1) {
+        isize = 0;
+    }
+    stream.Seek(pos, aiOrigin_SET);
+
+    AI_SWAP4(isize);
+    return isize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t InflateIOStream::GetMaxInflatedSize(size_t compressedSize) {
+    if (compressedSize > std::numeric_limits<size_t>::max() / MaxDeflateRatio) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return compressedSize * MaxDeflateRatio;
+}
+
+} // Namespace Assimp
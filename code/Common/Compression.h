@@ -0,0 +1,161 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Compression.h
+ *  @brief Reusable zlib inflate helpers shared by the importers.
+ */
+#pragma once
+#ifndef AI_COMPRESSION_H_INC
+#define AI_COMPRESSION_H_INC
+
+#include <assimp/IOStream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct z_stream_s;
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Wraps a zlib inflate stream. The stream state is allocated once and can be reset
+ *  and reused for any number of compressed streams of the same format.
+ *
+ *  All functions throw DeadlyImportError if the compressed data is corrupt. */
+class ASSIMP_API Inflater {
+public:
+    /** Compressed data formats */
+    enum Format {
+        Format_Zlib, ///< zlib header and trailer, RFC 1950
+        Format_Gzip, ///< gzip header and trailer, RFC 1952
+        Format_Raw   ///< raw deflate data without header, RFC 1951
+    };
+
+    explicit Inflater(Format format);
+    ~Inflater();
+
+    /// Prepares for the next compressed stream.
+    void Reset();
+
+    /// Sets the dictionary to use, right after Reset() and for raw streams only.
+    void SetDictionary(const void *data, size_t size);
+
+    /** @brief Inflates the next piece of the current stream.
+     *
+     *  Consumes input from in/inSize, both are advanced accordingly. Stops when the
+     *  output buffer is full, the input is exhausted or the end of the stream is reached.
+     *  Running out of input is no error here, check IsFinished() once all input is given.
+     *  @return Number of bytes written to out. */
+    size_t Inflate(const uint8_t *&in, size_t &inSize, uint8_t *out, size_t outSize);
+
+    /** @brief Resets the stream and inflates a complete compressed stream from memory.
+     *
+     *  Throws DeadlyImportError if the input ends before the stream does, unless out is full.
+     *  @return Number of bytes written to out, at most outSize. */
+    size_t InflateAll(const void *in, size_t inSize, void *out, size_t outSize);
+
+    /// Returns true if the end of the current stream has been reached.
+    bool IsFinished() const {
+        return mFinished;
+    }
+
+private:
+    Inflater(const Inflater &);
+    Inflater &operator=(const Inflater &);
+
+    z_stream_s *mStream;
+    bool mFinished;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Read-only stream which inflates compressed data from another stream on the fly.
+ *
+ *  Compressed data is pulled from the source in small chunks and inflated directly into
+ *  the buffers passed to Read(), so wrapping a stream in a StreamReader decompresses it
+ *  straight into the reader's buffer. Seeking backwards restarts decompression. */
+class ASSIMP_API InflateIOStream : public IOStream {
+public:
+    /** @param source Stream positioned at the start of the compressed data.
+     *  @param format Format of the compressed data.
+     *  @param size Size of the decompressed data as reported by FileSize(). Reads
+     *    never go past this size, reads stopping short of it because the compressed
+     *    data ends throw DeadlyImportError. Sizes read from the file must be capped
+     *    by the caller, see GetMaxInflatedSize(). */
+    InflateIOStream(std::shared_ptr<IOStream> source, Inflater::Format format, size_t size);
+    ~InflateIOStream();
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+    /** @brief Reads the size of the decompressed data from the trailer of a gzip stream.
+     *
+     *  The trailer only holds the size modulo 2^32 and the last member of concatenated
+     *  streams, and comes from the file: the value is an untrusted hint, only fit for
+     *  checking the result and for reserving memory after capping it, see
+     *  GetMaxInflatedSize(). The stream position is left unchanged.
+     *  @return The size, 0 if the stream is too short. */
+    static size_t GetGzipSize(IOStream &stream);
+
+    /// Returns the largest size compressedSize bytes of deflate data can inflate to.
+    static size_t GetMaxInflatedSize(size_t compressedSize);
+
+private:
+    size_t InflateTo(uint8_t *out, size_t size);
+
+    std::shared_ptr<IOStream> mSource;
+    size_t mSourceStart;
+    Inflater mInflater;
+    std::vector<uint8_t> mInput;
+    const uint8_t *mNext;
+    size_t mAvailable;
+    size_t mSize;
+    size_t mPosition;
+};
+
+} // Namespace Assimp
+
+#endif // AI_COMPRESSION_H_INC
@@ -0,0 +1,209 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file CopyOnWriteScene.cpp
+ *  @brief Implementation of #CopyOnWriteScene.
+ */
+
+#include "Common/CopyOnWriteScene.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/SceneCombiner.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// New pointer array referencing the same objects
+template <typename T>
+T **ShareArray(T *const *src, unsigned int num) {
+    if (nullptr == src || 0 == num) {
+        return nullptr;
+    }
+    T **dest = new T *[num];
+    std::copy(src, src + num, dest);
+    return dest;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replaces all objects of a pointer array with deep copies
+template <typename T>
+void DetachArray(T **array, unsigned int num, unsigned int &numDetached) {
+    if (nullptr == array) {
+        return;
+    }
+    for (unsigned int i = 0; i < num; ++i) {
+        const T *shared = array[i];
+        if (nullptr != shared) {
+            SceneCombiner::Copy(&array[i], shared);
+            ++numDetached;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Drops the references to shared objects, so deleting the array owner leaves them alone
+template <typename T>
+void ReleaseArray(T **array, unsigned int num) {
+    if (nullptr != array) {
+        std::fill(array, array + num, nullptr);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+CopyOnWriteScene::CopyOnWriteScene(const aiScene *source) :
+        mScene(new aiScene()),
+        mSharedMeshes(source->mMeshes ? source->mNumMeshes : 0, true),
+        mSharesOthers(true),
+        mNumDetached(0) {
+    mScene->mFlags = source->mFlags;
+    mScene->mRootNode = source->mRootNode;
+
+    mScene->mNumMeshes = source->mNumMeshes;
+    mScene->mMeshes = ShareArray(source->mMeshes, source->mNumMeshes);
+    mScene->mNumMaterials = source->mNumMaterials;
+    mScene->mMaterials = ShareArray(source->mMaterials, source->mNumMaterials);
+    mScene->mNumAnimations = source->mNumAnimations;
+    mScene->mAnimations = ShareArray(source->mAnimations, source->mNumAnimations);
+    mScene->mNumTextures = source->mNumTextures;
+    mScene->mTextures = ShareArray(source->mTextures, source->mNumTextures);
+    mScene->mNumLights = source->mNumLights;
+    mScene->mLights = ShareArray(source->mLights, source->mNumLights);
+    mScene->mNumCameras = source->mNumCameras;
+    mScene->mCameras = ShareArray(source->mCameras, source->mNumCameras);
+
+    mScene->mMetaData = source->mMetaData;
+    mScene->mBVH = source->mBVH;
+    mScene->mNumBVHInstances = source->mNumBVHInstances;
+    mScene->mBVHInstances = source->mBVHInstances;
+
+    // source private data might be NULL if the scene is user-allocated
+    const ScenePrivateData *priv = ScenePriv(source);
+    ScenePriv(mScene)->mPPStepsApplied = priv ? priv->mPPStepsApplied : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+CopyOnWriteScene::~CopyOnWriteScene() {
+    for (unsigned int i = 0; i < mSharedMeshes.size(); ++i) {
+        if (mSharedMeshes[i]) {
+            mScene->mMeshes[i] = nullptr;
+        }
+    }
+    if (mSharesOthers) {
+        ReleaseArray(mScene->mMaterials, mScene->mNumMaterials);
+        ReleaseArray(mScene->mAnimations, mScene->mNumAnimations);
+        ReleaseArray(mScene->mTextures, mScene->mNumTextures);
+        ReleaseArray(mScene->mLights, mScene->mNumLights);
+        ReleaseArray(mScene->mCameras, mScene->mNumCameras);
+        mScene->mRootNode = nullptr;
+        mScene->mMetaData = nullptr;
+        mScene->mBVH = nullptr;
+        mScene->mBVHInstances = nullptr;
+    }
+    delete mScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CopyOnWriteScene::DetachMeshes() {
+    for (unsigned int i = 0; i < mSharedMeshes.size(); ++i) {
+        if (!mSharedMeshes[i]) {
+            continue;
+        }
+        const aiMesh *shared = mScene->mMeshes[i];
+        if (nullptr != shared) {
+            SceneCombiner::Copy(&mScene->mMeshes[i], shared);
+            ++mNumDetached;
+        }
+        mSharedMeshes[i] = false;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void CopyOnWriteScene::DetachAll() {
+    DetachMeshes();
+    if (!mSharesOthers) {
+        return;
+    }
+    mSharesOthers = false;
+
+    DetachArray(mScene->mMaterials, mScene->mNumMaterials, mNumDetached);
+    DetachArray(mScene->mAnimations, mScene->mNumAnimations, mNumDetached);
+    DetachArray(mScene->mTextures, mScene->mNumTextures, mNumDetached);
+    DetachArray(mScene->mLights, mScene->mNumLights, mNumDetached);
+    DetachArray(mScene->mCameras, mScene->mNumCameras, mNumDetached);
+
+    const aiNode *root = mScene->mRootNode;
+    mScene->mRootNode = nullptr;
+    if (nullptr != root) {
+        SceneCombiner::Copy(&mScene->mRootNode, root);
+    }
+
+    const aiMetadata *metaData = mScene->mMetaData;
+    mScene->mMetaData = nullptr;
+    if (nullptr != metaData) {
+        mScene->mMetaData = new aiMetadata(*metaData);
+    }
+
+    const aiBVH *bvh = mScene->mBVH;
+    mScene->mBVH = nullptr;
+    SceneCombiner::Copy(&mScene->mBVH, bvh);
+
+    const aiBVHInstance *instances = mScene->mBVHInstances;
+    mScene->mBVHInstances = nullptr;
+    if (nullptr != instances) {
+        mScene->mBVHInstances = new aiBVHInstance[mScene->mNumBVHInstances];
+        std::copy(instances, instances + mScene->mNumBVHInstances, mScene->mBVHInstances);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CopyOnWriteScene::IsMeshShared(unsigned int meshIndex) const {
+    return meshIndex < mSharedMeshes.size() && mSharedMeshes[meshIndex];
+}
+
+} // Namespace Assimp
@@ -0,0 +1,121 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file CopyOnWriteScene.h
+ *  @brief Scene copy which shares the data of its source until it is
+ *    about to be modified.
+ */
+#pragma once
+#ifndef AI_COPYONWRITESCENE_H_INC
+#define AI_COPYONWRITESCENE_H_INC
+
+#include <assimp/defs.h>
+
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Cheap copy of a scene for code paths which only sometimes modify it.
+ *
+ *  The copy gets its own scene object and pointer arrays, but the meshes,
+ *  materials, nodes and all other data are those of the source scene. Before
+ *  anything is modified, the affected parts must be detached - this replaces
+ *  them with private deep copies. Reading a shared scene is fine, modifying
+ *  it changes the source.
+ *
+ *  The source scene must outlive the copy. */
+class ASSIMP_API CopyOnWriteScene {
+public:
+    // -------------------------------------------------------------------
+    /** @brief Creates a copy sharing all data with the source scene. */
+    explicit CopyOnWriteScene(const aiScene *source);
+
+    // -------------------------------------------------------------------
+    /** @brief Deletes the copy and all detached data. Shared data is
+     *  left alone. */
+    ~CopyOnWriteScene();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the copy. */
+    aiScene *GetScene() const {
+        return mScene;
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Replaces all shared meshes with private copies. Enough for
+     *  code which modifies meshes in place, but doesn't touch the
+     *  mesh list or any other part of the scene. */
+    void DetachMeshes();
+
+    // -------------------------------------------------------------------
+    /** @brief Replaces all shared data with private copies. The result
+     *  is the same as that of SceneCombiner::CopyScene(). */
+    void DetachAll();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns true if a mesh of the copy is still the one of the
+     *  source scene. */
+    bool IsMeshShared(unsigned int meshIndex) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of deep copies made by DetachMeshes() and
+     *  DetachAll() so far, counting one per object. */
+    unsigned int GetNumDetached() const {
+        return mNumDetached;
+    }
+
+private:
+    CopyOnWriteScene(const CopyOnWriteScene &) = delete;
+    CopyOnWriteScene &operator=(const CopyOnWriteScene &) = delete;
+
+    aiScene *mScene;
+    std::vector<bool> mSharedMeshes;
+    bool mSharesOthers;
+    unsigned int mNumDetached;
+};
+
+} // Namespace Assimp
+
+#endif // AI_COPYONWRITESCENE_H_INC
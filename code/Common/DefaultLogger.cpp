@@ -62,6 +62,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #   include <thread>
 #   include <mutex>
     std::mutex loggerMutex;
+    // guards the streams and the repetition check, messages may come from worker threads
+    std::mutex streamMutex;
 #endif
 
 namespace Assimp    {
@@ -328,6 +330,10 @@ bool DefaultLogger::attachStream( LogStream *pStream, unsigned int severity ) {
         severity = Logger::Info | Logger::Err | Logger::Warn | Logger::Debugging;
     }
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(streamMutex);
+#endif
+
     for ( StreamIt it = m_StreamArray.begin();
         it != m_StreamArray.end();
         ++it )
@@ -354,6 +360,10 @@ bool DefaultLogger::detachStream( LogStream *pStream, unsigned int severity ) {
         severity = SeverityAll;
     }
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(streamMutex);
+#endif
+
     bool res( false );
     for ( StreamIt it = m_StreamArray.begin(); it != m_StreamArray.end(); ++it ) {
         if ( (*it)->m_pStream == pStream ) {
@@ -395,6 +405,10 @@ DefaultLogger::~DefaultLogger() {
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev ) {
     ai_assert(nullptr != message);
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+    std::lock_guard<std::mutex> lock(streamMutex);
+#endif
+
     // Check whether this is a repeated message
     if (! ::strncmp( message,lastMsg, lastLen-1))
     {
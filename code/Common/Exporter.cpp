@@ -60,9 +60,12 @@ Here we implement only the C++ interface (Assimp::Exporter).
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/Exceptional.h>
+#include <assimp/DefaultLogger.hpp>
 
 #include "Common/DefaultProgressHandler.h"
 #include "Common/BaseProcess.h"
+#include "Common/CopyOnWriteScene.h"
+#include "Common/ParallelFor.h"
 #include "Common/ScenePrivate.h"
 #include "PostProcessing/CalcTangentsProcess.h"
 #include "PostProcessing/MakeVerboseFormat.h"
@@ -348,16 +351,141 @@ const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const cha
 }
 
 // ------------------------------------------------------------------------------------------------
-aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const char* pPath,
-        unsigned int pPreprocessing, const ExportProperties* pProperties) {
-    ASSIMP_BEGIN_EXCEPTION_REGION();
-	ai_assert(nullptr != pimpl);
+// Returns the steps to run before exporting a scene to a format
+static unsigned int GetExportPreprocessing(const aiScene* pScene, const Exporter::ExportFormatEntry& exp,
+        unsigned int pPreprocessing) {
+    const ScenePrivateData* const priv = ScenePriv(pScene);
+
+    // steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
+    // original state before the step was applied first. When checking which steps we don't need
+    // to run, those are excluded.
+    const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
+
+    // Erase all pp steps that were already applied to this scene
+    const unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv && !priv->mIsCopy
+        ? (priv->mPPStepsApplied & ~nonIdempotentSteps)
+        : 0u);
+
+    // If no extra post-processing was specified, and we obtained this scene from an
+    // Assimp importer, apply the reverse steps automatically.
+    // TODO: either drop this, or document it. Otherwise it is just a bad surprise.
+    //if (!pPreprocessing && priv) {
+    //  pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
+    //}
+    return pp;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Runs the steps in pp on the scene copy, detaching the parts they modify. May run on worker
+// threads if each of them passes its own step instances and no progress handler.
+static void PreprocessForExport(CopyOnWriteScene& scenecopy, unsigned int pp, bool enforceJoin,
+        bool exportPointCloud, const std::vector<BaseProcess*>& steps, ProgressHandler* progress) {
     // when they create scenes from scratch, users will likely create them not in verbose
     // format. They will likely not be aware that there is a flag in the scene to indicate
     // this, however. To avoid surprises and bug reports, we check for duplicates in
     // meshes upfront.
-    const bool is_verbose_format = !(pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) || MakeVerboseFormatProcess::IsVerboseFormat(pScene);
+    aiScene* const scene = scenecopy.GetScene();
+    const bool is_verbose_format = !(scene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) || MakeVerboseFormatProcess::IsVerboseFormat(scene);
+
+    // If the input scene is not in verbose format, but there is at least post-processing step that relies on it,
+    // we need to run the MakeVerboseFormat step first.
+    bool must_join_again = false;
+    if (!is_verbose_format) {
+        bool verbosify = false;
+        for( unsigned int a = 0; a < steps.size(); a++) {
+            BaseProcess* const p = steps[a];
+
+            if (p->IsActive(pp) && p->RequireVerboseFormat()) {
+                verbosify = true;
+                break;
+            }
+        }
+
+        if (verbosify || enforceJoin) {
+            ASSIMP_LOG_DEBUG("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
+
+            MakeVerboseFormatProcess proc;
+            scenecopy.DetachMeshes();
+            proc.Execute(scene);
+
+            if(!enforceJoin) {
+                must_join_again = true;
+            }
+        }
+    }
 
+    if (progress) {
+        progress->UpdateFileWrite(2, 4);
+    }
+
+    if (pp) {
+        // the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
+        {
+            FlipWindingOrderProcess step;
+            if (step.IsActive(pp)) {
+                scenecopy.DetachMeshes();
+                step.Execute(scene);
+            }
+        }
+
+        {
+            FlipUVsProcess step;
+            if (step.IsActive(pp)) {
+                scenecopy.DetachAll();
+                step.Execute(scene);
+            }
+        }
+
+        {
+            MakeLeftHandedProcess step;
+            if (step.IsActive(pp)) {
+                scenecopy.DetachAll();
+                step.Execute(scene);
+            }
+        }
+
+        // dispatch other processes
+        for( unsigned int a = 0; a < steps.size(); a++) {
+            BaseProcess* const p = steps[a];
+
+            if (p->IsActive(pp)
+                && !dynamic_cast<FlipUVsProcess*>(p)
+                && !dynamic_cast<FlipWindingOrderProcess*>(p)
+                && !dynamic_cast<MakeLeftHandedProcess*>(p)) {
+                if (dynamic_cast<PretransformVertices*>(p) && exportPointCloud) {
+                    continue;
+                }
+                // steps working on single meshes leave the rest of the scene alone
+                if (p->IsPerMeshStep()) {
+                    scenecopy.DetachMeshes();
+                } else {
+                    scenecopy.DetachAll();
+                }
+                p->Execute(scene);
+            }
+        }
+        ScenePrivateData* const privOut = ScenePriv(scene);
+        ai_assert(nullptr != privOut);
+
+        privOut->mPPStepsApplied |= pp;
+    }
+
+    if (progress) {
+        progress->UpdateFileWrite(3, 4);
+    }
+
+    if(must_join_again) {
+        JoinVerticesProcess proc;
+        scenecopy.DetachMeshes();
+        proc.Execute(scene);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const char* pPath,
+        unsigned int pPreprocessing, const ExportProperties* pProperties) {
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+	ai_assert(nullptr != pimpl);
     pimpl->mProgressHandler->UpdateFileWrite(0, 4);
 
     pimpl->mError = "";
@@ -365,120 +493,26 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
         const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i];
         if (!strcmp(exp.mDescription.id,pFormatId)) {
             try {
-                // Always create a full copy of the scene. We might optimize this one day,
-                // but for now it is the most pragmatic way.
-                aiScene* scenecopy_tmp = nullptr;
-                SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+                // Share the scene data with the caller's scene. Before a step modifies
+                // the copy, the parts it writes to are replaced with deep copies.
+                CopyOnWriteScene scenecopy(pScene);
 
                 pimpl->mProgressHandler->UpdateFileWrite(1, 4);
 
-                std::unique_ptr<aiScene> scenecopy(scenecopy_tmp);
-                const ScenePrivateData* const priv = ScenePriv(pScene);
-
-                // steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
-                // original state before the step was applied first. When checking which steps we don't need
-                // to run, those are excluded.
-                const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
-
-                // Erase all pp steps that were already applied to this scene
-                const unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv && !priv->mIsCopy
-                    ? (priv->mPPStepsApplied & ~nonIdempotentSteps)
-                    : 0u);
-
-                // If no extra post-processing was specified, and we obtained this scene from an
-                // Assimp importer, apply the reverse steps automatically.
-                // TODO: either drop this, or document it. Otherwise it is just a bad surprise.
-                //if (!pPreprocessing && priv) {
-                //  pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
-                //}
-
-                // If the input scene is not in verbose format, but there is at least post-processing step that relies on it,
-                // we need to run the MakeVerboseFormat step first.
-                bool must_join_again = false;
-                if (!is_verbose_format) {
-                    bool verbosify = false;
-                    for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-                        BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-                        if (p->IsActive(pp) && p->RequireVerboseFormat()) {
-                            verbosify = true;
-                            break;
-                        }
-                    }
-
-                    if (verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-                        ASSIMP_LOG_DEBUG("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
-
-                        MakeVerboseFormatProcess proc;
-                        proc.Execute(scenecopy.get());
-
-                        if(!(exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-                            must_join_again = true;
-                        }
-                    }
-                }
+                const unsigned int pp = GetExportPreprocessing(pScene, exp, pPreprocessing);
 
-                pimpl->mProgressHandler->UpdateFileWrite(2, 4);
-
-                if (pp) {
-                    // the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
-                    {
-                        FlipWindingOrderProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    {
-                        FlipUVsProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    {
-                        MakeLeftHandedProcess step;
-                        if (step.IsActive(pp)) {
-                            step.Execute(scenecopy.get());
-                        }
-                    }
-
-                    bool exportPointCloud(false);
-                    if (nullptr != pProperties) {
-                        exportPointCloud = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
-                    }
-
-                    // dispatch other processes
-                    for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-                        BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-                        if (p->IsActive(pp)
-                            && !dynamic_cast<FlipUVsProcess*>(p)
-                            && !dynamic_cast<FlipWindingOrderProcess*>(p)
-                            && !dynamic_cast<MakeLeftHandedProcess*>(p)) {
-                            if (dynamic_cast<PretransformVertices*>(p) && exportPointCloud) {
-                                continue;
-                            }
-                            p->Execute(scenecopy.get());
-                        }
-                    }
-                    ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
-                    ai_assert(nullptr != privOut);
-
-                    privOut->mPPStepsApplied |= pp;
+                bool exportPointCloud(false);
+                if (nullptr != pProperties) {
+                    exportPointCloud = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
                 }
 
-                pimpl->mProgressHandler->UpdateFileWrite(3, 4);
-
-                if(must_join_again) {
-                    JoinVerticesProcess proc;
-                    proc.Execute(scenecopy.get());
-                }
+                PreprocessForExport(scenecopy, pp, 0 != (exp.mEnforcePP & aiProcess_JoinIdenticalVertices),
+                        exportPointCloud, pimpl->mPostProcessingSteps, pimpl->mProgressHandler);
 
                 ExportProperties emptyProperties;  // Never pass NULL ExportProperties so Exporters don't have to worry.
                 ExportProperties* pProp = pProperties ? (ExportProperties*)pProperties : &emptyProperties;
         		pProp->SetPropertyBool("bJoinIdenticalVertices", pp & aiProcess_JoinIdenticalVertices);
-                exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get(), pProp);
+                exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.GetScene(), pProp);
 
                 pimpl->mProgressHandler->UpdateFileWrite(4, 4);
             } catch (DeadlyExportError& err) {
@@ -495,6 +529,129 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
     return AI_FAILURE;
 }
 
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter::ExportMultiple( const aiScene* pScene, std::vector<ExportTarget>& pTargets,
+        const ExportProperties* pProperties) {
+    aiReturn result = AI_FAILURE;
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+	ai_assert(nullptr != pimpl);
+    pimpl->mProgressHandler->UpdateFileWrite(0, 2);
+    pimpl->mError = "";
+
+    const bool exportPointCloud = nullptr != pProperties && pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
+    // Steps and exporters log from the worker threads. Only our own loggers are known
+    // to be thread-safe, with one installed by the application everything runs here.
+    const bool threadSafeLogger = DefaultLogger::isNullLogger() || nullptr != dynamic_cast<DefaultLogger*>(DefaultLogger::get());
+    const unsigned int numThreads = threadSafeLogger ? GetNumWorkerThreads(nullptr != pProperties
+            ? pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1) : -1) : 1;
+
+    // Targets which need the same preprocessing share a copy of the scene. Merging
+    // different preprocessing isn't safe in general, e.g. a FlipUVs for one target
+    // would break all others.
+    struct SceneGroup {
+        unsigned int mPP;
+        bool mEnforceJoin;
+        std::unique_ptr<CopyOnWriteScene> mScene;
+        std::string mError;
+        std::vector<size_t> mTargets;
+    };
+    std::vector<SceneGroup> groups;
+    std::vector<const ExportFormatEntry*> formats(pTargets.size(), nullptr);
+    for (size_t i = 0; i < pTargets.size(); ++i) {
+        ExportTarget& target = pTargets[i];
+        target.mResult = AI_FAILURE;
+        target.mError.clear();
+        for (size_t e = 0; e < pimpl->mExporters.size(); ++e) {
+            if (target.mFormatId == pimpl->mExporters[e].mDescription.id) {
+                formats[i] = &pimpl->mExporters[e];
+                break;
+            }
+        }
+        if (nullptr == formats[i]) {
+            target.mError = "Found no exporter to handle this file format: " + target.mFormatId;
+            continue;
+        }
+
+        const unsigned int pp = GetExportPreprocessing(pScene, *formats[i], target.mPreprocessing);
+        const bool enforceJoin = 0 != (formats[i]->mEnforcePP & aiProcess_JoinIdenticalVertices);
+        size_t g = 0;
+        while (g < groups.size() && (groups[g].mPP != pp || groups[g].mEnforceJoin != enforceJoin)) {
+            ++g;
+        }
+        if (g == groups.size()) {
+            groups.push_back(SceneGroup());
+            groups.back().mPP = pp;
+            groups.back().mEnforceJoin = enforceJoin;
+        }
+        groups[g].mTargets.push_back(i);
+    }
+
+    // Preprocess the distinct copies. The first one uses our step instances,
+    // the others need their own as the steps keep state while running.
+    ParallelFor(numThreads, groups.size(), [&](size_t g) {
+        SceneGroup& group = groups[g];
+        group.mScene.reset(new CopyOnWriteScene(pScene));
+
+        std::vector<BaseProcess*> ownSteps;
+        if (g > 0 && group.mPP) {
+            GetPostProcessingStepInstanceList(ownSteps);
+        }
+        try {
+            PreprocessForExport(*group.mScene, group.mPP, group.mEnforceJoin, exportPointCloud,
+                    g > 0 ? ownSteps : pimpl->mPostProcessingSteps, nullptr);
+        } catch (const std::exception& err) {
+            group.mError = err.what();
+        } catch (...) {
+            group.mError = "Unknown exception";
+        }
+        for (BaseProcess* step : ownSteps) {
+            delete step;
+        }
+    });
+
+    pimpl->mProgressHandler->UpdateFileWrite(1, 2);
+
+    // Run the exporters, each gets its own copy of the properties as we write to them.
+    // The targets of a group run one after the other: their scene shares data with the
+    // others' and possibly with pScene, and not all exporters leave it alone.
+    ParallelFor(numThreads, groups.size(), [&](size_t g) {
+        const SceneGroup& group = groups[g];
+        for (size_t i : group.mTargets) {
+            ExportTarget& target = pTargets[i];
+            if (!group.mError.empty()) {
+                target.mError = group.mError;
+                continue;
+            }
+
+            ExportProperties properties = nullptr != pProperties ? ExportProperties(*pProperties) : ExportProperties();
+            properties.SetPropertyBool("bJoinIdenticalVertices", group.mPP & aiProcess_JoinIdenticalVertices);
+            try {
+                formats[i]->mExportFunction(target.mPath.c_str(), pimpl->mIOSystem.get(), group.mScene->GetScene(), &properties);
+                target.mResult = AI_SUCCESS;
+            } catch (const std::exception& err) {
+                target.mError = err.what();
+            } catch (...) {
+                target.mError = "Unknown exception";
+            }
+        }
+    });
+
+    pimpl->mProgressHandler->UpdateFileWrite(2, 2);
+
+    result = AI_SUCCESS;
+    for (const ExportTarget& target : pTargets) {
+        if (AI_SUCCESS != target.mResult) {
+            if (AI_SUCCESS == result) {
+                pimpl->mError = target.mError;
+            }
+            result = AI_FAILURE;
+        }
+    }
+    ASSIMP_END_EXCEPTION_REGION(aiReturn);
+
+    return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 const char* Exporter::GetErrorString() const {
 	ai_assert(nullptr != pimpl);
@@ -0,0 +1,457 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file ImportTask.cpp
+ *  @brief Implementation of Importer::ReadFileAsync() and #ImportTask.
+ */
+
+#include "Common/Importer.h"
+#include "Common/BaseProcess.h"
+
+#include <assimp/BaseImporter.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/ImportTask.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/importerdesc.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#ifndef ASSIMP_BUILD_NO_THREADING
+#   include <thread>
+#endif
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Stream wrapper counting the bytes read through it
+class CountingIOStream : public IOStream {
+public:
+    CountingIOStream(IOStream *wrapped, std::atomic<size_t> &bytesRead) :
+            mWrapped(wrapped), mBytesRead(bytesRead) {
+        // empty
+    }
+
+    ~CountingIOStream() {
+        // if the stream is deleted instead of being closed, take
+        // the wrapped stream with it as the caller intended to
+        delete mWrapped;
+    }
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override {
+        const size_t read = mWrapped->Read(pvBuffer, pSize, pCount);
+        mBytesRead += read * pSize;
+        return read;
+    }
+
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        return mWrapped->Write(pvBuffer, pSize, pCount);
+    }
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
+        return mWrapped->Seek(pOffset, pOrigin);
+    }
+
+    size_t Tell() const override {
+        return mWrapped->Tell();
+    }
+
+    size_t FileSize() const override {
+        return mWrapped->FileSize();
+    }
+
+    void Flush() override {
+        mWrapped->Flush();
+    }
+
+    IOStream *Release() {
+        IOStream *wrapped = mWrapped;
+        mWrapped = nullptr;
+        return wrapped;
+    }
+
+private:
+    IOStream *mWrapped;
+    std::atomic<size_t> &mBytesRead;
+};
+
+// ------------------------------------------------------------------------------------------------
+// IO system wrapper counting the bytes read through all streams opened by it. Also
+// records the size of the model file, which ProgressHandler only gets as an int.
+class CountingIOSystem : public IOSystem {
+public:
+    CountingIOSystem(IOSystem *wrapped, const std::string &file, std::atomic<size_t> &bytesRead, std::atomic<size_t> &fileSize) :
+            mWrapped(wrapped), mFile(file), mBytesRead(bytesRead), mFileSize(fileSize) {
+        // empty
+    }
+
+    bool Exists(const char *pFile) const override {
+        return mWrapped->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mWrapped->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        IOStream *stream = mWrapped->Open(pFile, pMode);
+        if (nullptr == stream) {
+            return nullptr;
+        }
+        if (mWrapped->ComparePaths(pFile, mFile.c_str())) {
+            mFileSize = stream->FileSize();
+        }
+        return new CountingIOStream(stream, mBytesRead);
+    }
+
+    void Close(IOStream *pFile) override {
+        CountingIOStream *stream = static_cast<CountingIOStream *>(pFile);
+        mWrapped->Close(stream->Release());
+        delete stream;
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        return mWrapped->ComparePaths(one, second);
+    }
+
+    bool PushDirectory(const std::string &path) override {
+        return mWrapped->PushDirectory(path);
+    }
+
+    const std::string &CurrentDirectory() const override {
+        return mWrapped->CurrentDirectory();
+    }
+
+    size_t StackSize() const override {
+        return mWrapped->StackSize();
+    }
+
+    bool PopDirectory() override {
+        return mWrapped->PopDirectory();
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        return mWrapped->DeleteFile(file);
+    }
+
+private:
+    IOSystem *mWrapped;
+    const std::string &mFile;
+    std::atomic<size_t> &mBytesRead;
+    std::atomic<size_t> &mFileSize;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// State shared between the task handle and the job running the import
+class ImportTaskState {
+public:
+    ImportTaskState(Importer *importer, const char *file, unsigned int flags) :
+            mImporter(importer),
+            mFile(file),
+            mFlags(flags),
+            mMutex(),
+            mFinishedCond(),
+            mFinished(false),
+            mScene(nullptr),
+            mStage(aiImportStage_Pending),
+            mStep(),
+            mStepIndex(0),
+            mNumSteps(0),
+            mPercentage(0.f),
+            mBytesRead(0),
+            mFileSize(0),
+            mCancelled(false) {
+        // empty
+    }
+
+    void Run();
+
+    void Cancel() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCancelled = true;
+        // an importer which finished must not carry the request over to its next import
+        if (!mFinished) {
+            mImporter->RequestCancel();
+        }
+    }
+
+    // ProgressHandler callbacks, called on the thread running the import
+    void OnUpdate(float percentage) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (percentage >= 0.f) {
+            mPercentage = percentage;
+        }
+    }
+
+    void OnFileRead() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (aiImportStage_Pending != mStage) {
+            return;
+        }
+
+        // Importer::ReadFile() reports the file size and has just selected the importer
+        mStage = aiImportStage_Reading;
+        const int index = mImporter->GetPropertyInteger("importerIndex", -1);
+        const aiImporterDesc *desc = index >= 0 ? mImporter->GetImporterInfo(index) : nullptr;
+        mStep = desc ? desc->mName : "";
+    }
+
+    void OnPostProcess(int currentStep, int numberOfSteps) {
+        const std::vector<BaseProcess *> &steps = mImporter->Pimpl()->mPostProcessingSteps;
+        std::string name;
+        if (currentStep >= 0 && static_cast<size_t>(currentStep) < steps.size()) {
+            name = steps[currentStep]->GetName();
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStage = aiImportStage_PostProcessing;
+        mStep.swap(name);
+        mStepIndex = static_cast<unsigned int>(currentStep);
+        mNumSteps = static_cast<unsigned int>(numberOfSteps);
+    }
+
+    Importer *mImporter;
+    const std::string mFile;
+    const unsigned int mFlags;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mFinishedCond;
+    bool mFinished;
+    const aiScene *mScene;
+
+    aiImportStage mStage;
+    std::string mStep;
+    unsigned int mStepIndex, mNumSteps;
+    float mPercentage;
+
+    std::atomic<size_t> mBytesRead, mFileSize;
+    bool mCancelled;
+};
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Progress handler installed for the duration of an asynchronous import. Records the
+// progress in the task state and forwards everything to the Importer's own handler.
+class TaskProgressHandler : public ProgressHandler {
+public:
+    TaskProgressHandler(ImportTaskState &state, ProgressHandler *wrapped) :
+            mState(state), mWrapped(wrapped) {
+        // empty
+    }
+
+    bool Update(float percentage) override {
+        mState.OnUpdate(percentage);
+        return mWrapped->Update(percentage);
+    }
+
+    void UpdateFileRead(int currentStep, int numberOfSteps) override {
+        mState.OnFileRead();
+        mWrapped->UpdateFileRead(currentStep, numberOfSteps);
+    }
+
+    void UpdatePostProcess(int currentStep, int numberOfSteps) override {
+        mState.OnPostProcess(currentStep, numberOfSteps);
+        mWrapped->UpdatePostProcess(currentStep, numberOfSteps);
+    }
+
+    void UpdateFileWrite(int currentStep, int numberOfSteps) override {
+        mWrapped->UpdateFileWrite(currentStep, numberOfSteps);
+    }
+
+private:
+    ImportTaskState &mState;
+    ProgressHandler *mWrapped;
+};
+
+// ------------------------------------------------------------------------------------------------
+// The job handed to the executor. Owns one reference to the state.
+void RunImportTask(void *data) {
+    std::shared_ptr<ImportTaskState> *ref = static_cast<std::shared_ptr<ImportTaskState> *>(data);
+    std::shared_ptr<ImportTaskState> state(*ref);
+    delete ref;
+
+    state->Run();
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void ImportTaskState::Run() {
+    ImporterPimpl *pimpl = mImporter->Pimpl();
+
+    // Route progress and file access through the task for the duration of the import.
+    // The Importer's own handlers stay in place underneath.
+    ProgressHandler *const oldProgress = pimpl->mProgressHandler;
+    IOSystem *const oldIO = pimpl->mIOHandler;
+    TaskProgressHandler progress(*this, oldProgress);
+    CountingIOSystem io(oldIO, mFile, mBytesRead, mFileSize);
+    pimpl->mProgressHandler = &progress;
+    pimpl->mIOHandler = &io;
+
+    const aiScene *scene = nullptr;
+    try {
+        scene = mImporter->ReadFile(mFile.c_str(), mFlags);
+    } catch (const std::exception &e) {
+        // only reached in builds which don't catch them in ReadFile()
+        pimpl->mErrorString = e.what();
+    }
+
+    pimpl->mProgressHandler = oldProgress;
+    pimpl->mIOHandler = oldIO;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    pimpl->mCancelState = ImporterPimpl::CancelState_Idle;
+    mScene = scene;
+    mStage = aiImportStage_Done;
+    mFinished = true;
+    mFinishedCond.notify_all();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Handle data, owns the thread if no executor was given
+class ImportTaskPimpl {
+public:
+    std::shared_ptr<ImportTaskState> mState;
+#ifndef ASSIMP_BUILD_NO_THREADING
+    std::thread mThread;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+ImportTask *Importer::ReadFileAsync(const char *pFile, unsigned int pFlags, ImportExecutor *pExecutor) {
+    ai_assert(nullptr != pimpl);
+    ai_assert(nullptr != pFile);
+
+    // the import counts as running from now on, so it can be cancelled before it starts
+    pimpl->mCancelState = ImporterPimpl::CancelState_Running;
+
+    ImportTaskPimpl *task = new ImportTaskPimpl();
+    task->mState = std::make_shared<ImportTaskState>(this, pFile, pFlags);
+
+    void *data = new std::shared_ptr<ImportTaskState>(task->mState);
+    if (nullptr != pExecutor) {
+        pExecutor->Execute(&RunImportTask, data);
+    } else {
+#ifdef ASSIMP_BUILD_NO_THREADING
+        RunImportTask(data);
+#else
+        task->mThread = std::thread(&RunImportTask, data);
+#endif
+    }
+
+    return new ImportTask(task);
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportTask::ImportTask(ImportTaskPimpl *pimpl) :
+        mPimpl(pimpl) {
+    ai_assert(nullptr != mPimpl);
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportTask::~ImportTask() {
+    Wait();
+#ifndef ASSIMP_BUILD_NO_THREADING
+    if (mPimpl->mThread.joinable()) {
+        mPimpl->mThread.join();
+    }
+#endif
+    delete mPimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene *ImportTask::Wait() {
+    ImportTaskState &state = *mPimpl->mState;
+    std::unique_lock<std::mutex> lock(state.mMutex);
+    state.mFinishedCond.wait(lock, [&state] { return state.mFinished; });
+    return state.mScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportTask::IsDone() const {
+    std::lock_guard<std::mutex> lock(mPimpl->mState->mMutex);
+    return mPimpl->mState->mFinished;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportTask::Cancel() {
+    mPimpl->mState->Cancel();
+}
+
+// ------------------------------------------------------------------------------------------------
+aiImportProgress ImportTask::GetProgress() const {
+    const ImportTaskState &state = *mPimpl->mState;
+
+    aiImportProgress out;
+    std::lock_guard<std::mutex> lock(state.mMutex);
+    out.mStage = state.mStage;
+    out.mStep.Set(state.mStep);
+    out.mStepIndex = state.mStepIndex;
+    out.mNumSteps = state.mNumSteps;
+    out.mBytesRead = state.mBytesRead;
+    out.mFileSize = state.mFileSize;
+    out.mPercentage = state.mPercentage;
+    out.mCancelled = state.mCancelled ? AI_TRUE : AI_FALSE;
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+Importer *ImportTask::GetImporter() const {
+    return mPimpl->mState->mImporter;
+}
+
+} // namespace Assimp
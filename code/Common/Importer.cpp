@@ -68,6 +68,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/MeshChunkSink.h"
 
 #include <assimp/BaseImporter.h>
 #include <assimp/GenericProperty.h>
@@ -77,6 +78,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 #include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
+#include <assimp/MeshChunkHandler.hpp>
 
 #include <set>
 #include <memory>
@@ -104,6 +106,50 @@ namespace Assimp {
 using namespace Assimp;
 using namespace Assimp::Intern;
 
+namespace {
+    // Marks an import as running, so it can be cancelled, and drops any cancellation
+    // request once it is over. ReadFileAsync() may have marked it running already.
+    struct CancelRequestScope {
+        explicit CancelRequestScope(std::atomic<int> &state) : mState(state) {
+            int idle = ImporterPimpl::CancelState_Idle;
+            mState.compare_exchange_strong(idle, ImporterPimpl::CancelState_Running);
+        }
+        ~CancelRequestScope() { mState = ImporterPimpl::CancelState_Idle; }
+        std::atomic<int> &mState;
+    };
+
+    const char *const CancelledMessage = "Import cancelled";
+
+    // The steps which work on each mesh on its own, and thus on the chunks of a streaming import
+    const unsigned int StreamingSteps = aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
+            aiProcess_MakeLeftHanded | aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_GenSmoothNormals |
+            aiProcess_SplitLargeMeshes | aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality |
+            aiProcess_FixInfacingNormals | aiProcess_SortByPType | aiProcess_FindDegenerates |
+            aiProcess_FindInvalidData | aiProcess_FlipUVs | aiProcess_FlipWindingOrder | aiProcess_GenBoundingBoxes;
+
+    // Finds the importer for a file, first by extension and then by signature. Returns its
+    // index, or -1 if none was found.
+    int FindImporter(const std::vector<BaseImporter*> &importers, const std::string &pFile, IOSystem *pIOHandler) {
+        for (unsigned int a = 0; a < importers.size(); a++) {
+            if (importers[a]->CanRead(pFile, pIOHandler, false)) {
+                return static_cast<int>(a);
+            }
+        }
+
+        // not so bad yet ... try format auto detection.
+        const std::string::size_type s = pFile.find_last_of('.');
+        if (s != std::string::npos) {
+            ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
+            for (unsigned int a = 0; a < importers.size(); a++) {
+                if (importers[a]->CanRead(pFile, pIOHandler, true)) {
+                    return static_cast<int>(a);
+                }
+            }
+        }
+        return -1;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Intern::AllocateFromAssimpHeap serves as abstract base class. It overrides
 // new and delete (and their array counterparts) of public API classes (e.g. Logger) to
@@ -390,6 +436,21 @@ void Importer::FreeScene( ) {
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Ask the running import to stop, may be called from any thread
+void Importer::RequestCancel() {
+    ai_assert(nullptr != pimpl);
+    // requests made while no import runs are ignored, they would cancel the next one
+    int running = ImporterPimpl::CancelState_Running;
+    pimpl->mCancelState.compare_exchange_strong(running, ImporterPimpl::CancelState_Requested);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Importer::IsCancelRequested() const {
+    ai_assert(nullptr != pimpl);
+    return ImporterPimpl::CancelState_Requested == pimpl->mCancelState;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the current error string, if any
 const char* Importer::GetErrorString() const {
@@ -564,6 +625,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
     
     ASSIMP_BEGIN_EXCEPTION_REGION();
     const std::string pFile(_pFile);
+    CancelRequestScope cancelScope(pimpl->mCancelState);
 
     // ----------------------------------------------------------------------
     // Put a large try block around everything to catch all std::exception's
@@ -599,37 +661,16 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         }
 
         // Find an worker class which can handle the file
-        BaseImporter* imp = nullptr;
-        SetPropertyInteger("importerIndex", -1);
-        for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-
-            if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
-                imp = pimpl->mImporter[a];
-                SetPropertyInteger("importerIndex", a);
-                break;
-            }
-        }
+        const int importerIndex = FindImporter(pimpl->mImporter, pFile, pimpl->mIOHandler);
+        SetPropertyInteger("importerIndex", importerIndex);
 
-        if (!imp)   {
-            // not so bad yet ... try format auto detection.
-            const std::string::size_type s = pFile.find_last_of('.');
-            if (s != std::string::npos) {
-                ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
-                for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-                    if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-                        imp = pimpl->mImporter[a];
-                        SetPropertyInteger("importerIndex", a);
-                        break;
-                    }
-                }
-            }
-            // Put a proper error message if no suitable importer was found
-            if( !imp)   {
-                pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
-                ASSIMP_LOG_ERROR(pimpl->mErrorString);
-                return nullptr;
-            }
+        // Put a proper error message if no suitable importer was found
+        if (importerIndex < 0) {
+            pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            return nullptr;
         }
+        BaseImporter* imp = pimpl->mImporter[importerIndex];
 
         // Get file size for progress handler
         IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
@@ -649,6 +690,12 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         ASSIMP_LOG_INFO("Found a matching importer for this file format: " + ext + "." );
         pimpl->mProgressHandler->UpdateFileRead( 0, fileSize );
 
+        if (IsCancelRequested()) {
+            pimpl->mErrorString = CancelledMessage;
+            ASSIMP_LOG_INFO(pimpl->mErrorString);
+            return nullptr;
+        }
+
         if (profiler) {
             profiler->BeginRegion("import");
         }
@@ -656,6 +703,12 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
+        // the importer may have finished before it noticed the request
+        if (pimpl->mScene && IsCancelRequested()) {
+            delete pimpl->mScene;
+            pimpl->mScene = nullptr;
+        }
+
         if (profiler) {
             profiler->EndRegion("import");
         }
@@ -698,7 +751,9 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
         }
         // if failed, extract the error string
-        else if( !pimpl->mScene) {
+        else if (IsCancelRequested()) {
+            pimpl->mErrorString = CancelledMessage;
+        } else {
             pimpl->mErrorString = imp->GetErrorText();
         }
 
@@ -730,6 +785,114 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// Reads the given file chunk by chunk
+bool Importer::ReadFileStreamed(const char* _pFile, unsigned int pFlags, MeshChunkHandler* pHandler) {
+    ai_assert(nullptr != pimpl);
+
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+    const std::string pFile(_pFile);
+    CancelRequestScope cancelScope(pimpl->mCancelState);
+
+    WriteLogOpening(pFile);
+
+#ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
+    try
+#endif // ! ASSIMP_CATCH_GLOBAL_EXCEPTIONS
+    {
+        if (pimpl->mScene)  {
+            ASSIMP_LOG_DEBUG("(Deleting previous scene)");
+        }
+        FreeScene();
+
+        if (nullptr == pHandler) {
+            pimpl->mErrorString = "No chunk handler given for streaming import";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            return false;
+        }
+
+        // First check if the file is accessible at all
+        if( !pimpl->mIOHandler->Exists( pFile)) {
+            pimpl->mErrorString = "Unable to open file \"" + pFile + "\".";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            return false;
+        }
+
+        const int importerIndex = FindImporter(pimpl->mImporter, pFile, pimpl->mIOHandler);
+        SetPropertyInteger("importerIndex", importerIndex);
+        if (importerIndex < 0) {
+            pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            return false;
+        }
+        BaseImporter* imp = pimpl->mImporter[importerIndex];
+        SetPropertyString("sourceFilePath", pFile);
+
+        // all other steps need to see the whole scene
+        const unsigned int flags = pFlags & StreamingSteps;
+        if (flags != pFlags) {
+            ASSIMP_LOG_WARN("Streaming import: ignoring post-processing steps which can't work on single chunks");
+        }
+
+        // Each chunk is wrapped into a scene of its own, post-processed and handed on
+        unsigned int numChunks = 0;
+        MeshChunkSink sink(static_cast<unsigned int>(GetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES,
+                AI_STREAM_DEFAULT_CHUNK_VERTICES)), [&](aiMesh* mesh) {
+            pimpl->mScene = new aiScene();
+            pimpl->mScene->mNumMeshes = 1;
+            pimpl->mScene->mMeshes = new aiMesh*[1];
+            pimpl->mScene->mMeshes[0] = mesh;
+            pimpl->mScene->mRootNode = new aiNode();
+            pimpl->mScene->mRootNode->mNumMeshes = 1;
+            pimpl->mScene->mRootNode->mMeshes = new unsigned int[1];
+            pimpl->mScene->mRootNode->mMeshes[0] = 0;
+
+#ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
+            if (flags & aiProcess_ValidateDataStructure) {
+                ValidateDSProcess ds;
+                ds.ExecuteOnScene (this);
+            }
+#endif // no validation
+            if (pimpl->mScene) {
+                ScenePreprocessor pre(pimpl->mScene);
+                pre.ProcessScene();
+                ApplyPostProcessing(flags & (~aiProcess_ValidateDataStructure));
+                pimpl->mPPShared->Clean();
+            }
+            if (!pimpl->mScene) {
+                throw DeadlyImportError(format() << "Streaming import: post-processing of chunk " << numChunks << " failed");
+            }
+
+            const bool proceed = pHandler->HandleChunk(pimpl->mScene, numChunks++);
+            delete pimpl->mScene;
+            pimpl->mScene = nullptr;
+            if (!proceed) {
+                RequestCancel();
+                throw DeadlyImportError(CancelledMessage);
+            }
+        });
+
+        if (!imp->ReadFileStreamed(this, pFile, pimpl->mIOHandler, sink)) {
+            pimpl->mErrorString = IsCancelRequested() ? std::string(CancelledMessage) : imp->GetErrorText();
+            delete pimpl->mScene;
+            pimpl->mScene = nullptr;
+            return false;
+        }
+        ASSIMP_LOG_INFO(format() << "Streaming import finished, " << numChunks << " chunks");
+    }
+#ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
+    catch (std::exception &e) {
+        pimpl->mErrorString = std::string("std::exception: ") + e.what();
+        ASSIMP_LOG_ERROR(pimpl->mErrorString);
+        delete pimpl->mScene; pimpl->mScene = nullptr;
+        return false;
+    }
+#endif // ! ASSIMP_CATCH_GLOBAL_EXCEPTIONS
+
+    ASSIMP_END_EXCEPTION_REGION_WITH_ERROR_STRING(bool, pimpl->mErrorString);
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Apply post-processing to the currently bound scene
 const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
@@ -741,8 +904,11 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         return nullptr;
     }
 
+    // Steps which don't fit into the flag field are enabled via a property
+    const unsigned int extFlags = static_cast<unsigned int>(GetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, 0));
+
     // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    if (!pFlags && !extFlags) {
         return pimpl->mScene;
     }
 
@@ -775,16 +941,49 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
+    // In incremental mode per-mesh steps are only run on meshes which haven't seen them yet.
+    // This holds as long as no step has restructured the mesh list.
+    const bool incremental = GetPropertyBool(AI_CONFIG_PP_INCREMENTAL, false);
+    std::vector<unsigned int> &meshSteps = ScenePriv(pimpl->mScene)->mMeshStepsApplied;
+    meshSteps.resize(pimpl->mScene->mNumMeshes, 0u);
+    bool meshesStable = true;
+
     std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
-        if( process->IsActive( pFlags)) {
+        if (IsCancelRequested()) {
+            pimpl->mErrorString = CancelledMessage;
+            ASSIMP_LOG_INFO(pimpl->mErrorString);
+            delete pimpl->mScene;
+            pimpl->mScene = nullptr;
+            break;
+        }
+        if( process->IsActive( pFlags) || process->IsExtActive( extFlags)) {
+            std::vector<bool> selection;
+            if (incremental && meshesStable && process->IsPerMeshStep()) {
+                bool any = false;
+                selection.resize(meshSteps.size());
+                for (unsigned int i = 0; i < meshSteps.size(); ++i) {
+                    selection[i] = process->IsActive(pFlags & ~meshSteps[i]);
+                    any = any || selection[i];
+                }
+
+                // IsActive() may cache state derived from the flags, so query it once more
+                if (!any || !process->IsActive(pFlags)) {
+                    continue;
+                }
+                process->SetMeshSelection(&selection);
+            } else if (!process->IsPerMeshStep()) {
+                meshesStable = false;
+            }
+
             if (profiler) {
                 profiler->BeginRegion("postprocess");
             }
 
             process->ExecuteOnScene ( this );
+            process->SetMeshSelection(nullptr);
 
             if (profiler) {
                 profiler->EndRegion("postprocess");
@@ -812,12 +1011,26 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         }
 #endif // ! DEBUG
     }
-    pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()), 
-        static_cast<int>(pimpl->mPostProcessingSteps.size()) );
+    if (pimpl->mScene) {
+        pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()),
+            static_cast<int>(pimpl->mPostProcessingSteps.size()) );
+    }
 
     // update private scene flags
     if( pimpl->mScene ) {
       ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+      ScenePriv(pimpl->mScene)->mPPExtStepsApplied |= extFlags;
+
+      // after a restructuring step the per-mesh history is meaningless, start over from here
+      ScenePrivateData *priv = ScenePriv(pimpl->mScene);
+      if (meshesStable && priv->mMeshStepsApplied.size() == pimpl->mScene->mNumMeshes) {
+          for (unsigned int &steps : priv->mMeshStepsApplied) {
+              steps |= pFlags;
+          }
+      } else {
+          priv->mMeshStepsApplied.assign(pimpl->mScene->mNumMeshes, pFlags);
+          priv->mSpatialSortCache.clear();
+      }
     }
 
     // clear any data allocated by post-process steps
@@ -829,6 +1042,24 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Flag a mesh of the currently bound scene as modified
+void Importer::MarkMeshModified(unsigned int pMeshIndex) {
+    ai_assert(nullptr != pimpl);
+
+    if (!pimpl->mScene || pMeshIndex >= pimpl->mScene->mNumMeshes) {
+        return;
+    }
+
+    ScenePrivateData *priv = ScenePriv(pimpl->mScene);
+    if (pMeshIndex < priv->mMeshStepsApplied.size()) {
+        priv->mMeshStepsApplied[pMeshIndex] = 0;
+    }
+    if (pMeshIndex < priv->mSpatialSortCache.size()) {
+        priv->mSpatialSortCache[pMeshIndex] = ScenePrivateData::SpatialSortCacheEntry();
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess, bool requestValidation ) {
     ai_assert(nullptr != pimpl);
@@ -1150,6 +1381,10 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const {
                 in.meshes += sizeof(aiBone);
                 in.meshes += mScene->mMeshes[i]->mBones[p]->mNumWeights * sizeof(aiVertexWeight);
             }
+            if (mScene->mMeshes[i]->HasBoneInfluences()) {
+                in.meshes += sizeof(aiBoneInfluences) + mScene->mMeshes[i]->mNumVertices *
+                        mScene->mMeshes[i]->mBoneInfluences->mNumInfluences * (sizeof(unsigned int) + sizeof(ai_real));
+            }
         }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
     }
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_IMPORTER_H
 #define INCLUDED_AI_IMPORTER_H
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <string>
@@ -119,6 +120,15 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Cancellation state of the running import, one of the values below.
+     *  Importer::RequestCancel() only has an effect while an import runs. */
+    enum {
+        CancelState_Idle,
+        CancelState_Running,
+        CancelState_Requested
+    };
+    std::atomic<int> mCancelState;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -138,7 +148,8 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT
 , mStringProperties()
 , mMatrixProperties()
 , bExtraVerbose( false )
-, mPPShared( nullptr ) {
+, mPPShared( nullptr )
+, mCancelState( CancelState_Idle ) {
     // empty
 }
 //! @endcond
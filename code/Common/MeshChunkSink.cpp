@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file MeshChunkSink.cpp
+ *  @brief Implementation of the chunk collector for streaming imports.
+ */
+
+#include "MeshChunkSink.h"
+
+#include <algorithm>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+MeshChunkSink::MeshChunkSink(unsigned int maxVertices, Consumer consumer) :
+        mMaxVertices(std::max(3u, maxVertices)),
+        mConsumer(consumer),
+        mNumChunks(0),
+        mNumUVComponents(2),
+        mDefaultColor(0, 0, 0, 1) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshChunkSink::~MeshChunkSink() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshChunkSink::Reserve(unsigned int numVertices) {
+    if (!mPositions.empty() && mPositions.size() + numVertices > mMaxVertices) {
+        Flush();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int MeshChunkSink::AddVertex(const aiVector3D &position, const aiVector3D *normal,
+        const aiColor4D *color, const aiVector3D *texCoord) {
+    const size_t index = mPositions.size();
+    mPositions.push_back(position);
+
+    // a component is stored for all vertices of the chunk once one of them has it
+    if (normal || !mNormals.empty()) {
+        mNormals.resize(index, aiVector3D());
+        mNormals.push_back(normal ? *normal : aiVector3D());
+    }
+    if (color || !mColors.empty()) {
+        mColors.resize(index, mDefaultColor);
+        mColors.push_back(color ? *color : mDefaultColor);
+    }
+    if (texCoord || !mTexCoords.empty()) {
+        mTexCoords.resize(index, aiVector3D());
+        mTexCoords.push_back(texCoord ? *texCoord : aiVector3D());
+    }
+    return static_cast<unsigned int>(index);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshChunkSink::AddFace(const unsigned int *indices, unsigned int numIndices) {
+    mFaceSizes.push_back(numIndices);
+    mIndices.insert(mIndices.end(), indices, indices + numIndices);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshChunkSink::Finish() {
+    Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshChunkSink::Flush() {
+    if (mPositions.empty()) {
+        return;
+    }
+
+    aiMesh *mesh = new aiMesh();
+    mesh->mMaterialIndex = 0;
+    mesh->mNumVertices = static_cast<unsigned int>(mPositions.size());
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    std::copy(mPositions.begin(), mPositions.end(), mesh->mVertices);
+    if (!mNormals.empty()) {
+        mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+        std::copy(mNormals.begin(), mNormals.end(), mesh->mNormals);
+    }
+    if (!mColors.empty()) {
+        mesh->mColors[0] = new aiColor4D[mesh->mNumVertices];
+        std::copy(mColors.begin(), mColors.end(), mesh->mColors[0]);
+    }
+    if (!mTexCoords.empty()) {
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumUVComponents[0] = mNumUVComponents;
+        std::copy(mTexCoords.begin(), mTexCoords.end(), mesh->mTextureCoords[0]);
+    }
+
+    // vertices which aren't referenced by any face become points, without any
+    // faces the chunk is a point cloud
+    std::vector<bool> referenced(mPositions.size(), false);
+    for (unsigned int index : mIndices) {
+        referenced[index] = true;
+    }
+    const size_t numPoints = std::count(referenced.begin(), referenced.end(), false);
+    if (mFaceSizes.empty()) {
+        mesh->mPrimitiveTypes = aiPrimitiveType_POINT;
+    }
+
+    mesh->mNumFaces = static_cast<unsigned int>(mFaceSizes.size() + numPoints);
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    const unsigned int *index = mIndices.data();
+    for (size_t i = 0; i < mFaceSizes.size(); ++i) {
+        aiFace &face = mesh->mFaces[i];
+        face.mNumIndices = mFaceSizes[i];
+        face.mIndices = new unsigned int[face.mNumIndices];
+        std::copy(index, index + face.mNumIndices, face.mIndices);
+        index += face.mNumIndices;
+    }
+    aiFace *point = mesh->mFaces + mFaceSizes.size();
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        if (!referenced[i]) {
+            point->mNumIndices = 1;
+            point->mIndices = new unsigned int[1];
+            point->mIndices[0] = i;
+            ++point;
+        }
+    }
+
+    mPositions.clear();
+    mNormals.clear();
+    mColors.clear();
+    mTexCoords.clear();
+    mFaceSizes.clear();
+    mIndices.clear();
+    mVertexMap.clear();
+
+    ++mNumChunks;
+    mConsumer(mesh);
+}
@@ -0,0 +1,163 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file MeshChunkSink.h
+ *  @brief Collects the geometry of a streaming import into bounded chunks.
+ */
+#pragma once
+#ifndef AI_MESHCHUNKSINK_H_INC
+#define AI_MESHCHUNKSINK_H_INC
+
+#include <assimp/mesh.h>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Used by the importers in Importer::ReadFileStreamed() mode.
+ *
+ *  Vertices and faces are added as they are read; whenever the next face
+ *  would not fit into the current chunk anymore, the chunk is turned into
+ *  an aiMesh and passed on. Components (normals, colors, texture coords)
+ *  appear in a chunk as soon as one of its vertices has them. Vertices which
+ *  aren't referenced by any face are emitted as points. */
+class ASSIMP_API MeshChunkSink {
+public:
+    /// Receives each finished chunk and takes ownership of it.
+    typedef std::function<void(aiMesh *)> Consumer;
+
+    /// @param maxVertices Maximum number of vertices per chunk, at least 3.
+    /// @param consumer Called for each chunk.
+    MeshChunkSink(unsigned int maxVertices, Consumer consumer);
+    ~MeshChunkSink();
+
+    /// Makes room for numVertices more vertices, passing on the current chunk if necessary.
+    void Reserve(unsigned int numVertices);
+
+    /// Adds a vertex to the current chunk. Call Reserve() first.
+    /// @return The index of the vertex in the chunk.
+    unsigned int AddVertex(const aiVector3D &position, const aiVector3D *normal = nullptr,
+            const aiColor4D *color = nullptr, const aiVector3D *texCoord = nullptr);
+
+    /// Adds a face referring to vertices of the current chunk.
+    void AddFace(const unsigned int *indices, unsigned int numIndices);
+
+    /// Adds a face referring to vertices by their index in the file. Vertices used by
+    /// several faces of a chunk are added only once: for the vertices which are new to
+    /// the current chunk, addVertex(fileIndex) is called and must return AddVertex().
+    template <typename AddVertexFunc>
+    void AddIndexedFace(const unsigned int *fileIndices, unsigned int numIndices, AddVertexFunc addVertex);
+
+    /// Sets the color of the vertices added without one, once a vertex of the chunk has a color.
+    void SetDefaultColor(const aiColor4D &color) {
+        mDefaultColor = color;
+    }
+
+    /// Sets the number of texture coordinate components, 2 by default.
+    void SetNumUVComponents(unsigned int numComponents) {
+        mNumUVComponents = numComponents;
+    }
+
+    /// Passes on the remaining data. Called by BaseImporter once the file has been read.
+    void Finish();
+
+    /// Returns the number of chunks passed on so far.
+    unsigned int GetNumChunks() const {
+        return mNumChunks;
+    }
+
+private:
+    MeshChunkSink(const MeshChunkSink &) = delete;
+    MeshChunkSink &operator=(const MeshChunkSink &) = delete;
+
+    void Flush();
+
+    unsigned int mMaxVertices;
+    Consumer mConsumer;
+    unsigned int mNumChunks;
+    unsigned int mNumUVComponents;
+    aiColor4D mDefaultColor;
+
+    std::vector<aiVector3D> mPositions;
+    std::vector<aiVector3D> mNormals;
+    std::vector<aiColor4D> mColors;
+    std::vector<aiVector3D> mTexCoords;
+    std::vector<unsigned int> mFaceSizes;
+    std::vector<unsigned int> mIndices;
+
+    /// File index to chunk index for AddIndexedFace()
+    std::unordered_map<unsigned int, unsigned int> mVertexMap;
+    std::vector<unsigned int> mFaceIndices;
+};
+
+// ------------------------------------------------------------------------------------------------
+template <typename AddVertexFunc>
+inline void MeshChunkSink::AddIndexedFace(const unsigned int *fileIndices, unsigned int numIndices, AddVertexFunc addVertex) {
+    unsigned int numNew = 0;
+    for (unsigned int i = 0; i < numIndices; ++i) {
+        numNew += mVertexMap.count(fileIndices[i]) ? 0 : 1;
+    }
+    if (mPositions.size() + numNew > mMaxVertices) {
+        Flush();
+        numNew = numIndices;
+    }
+    Reserve(numNew);
+
+    mFaceIndices.resize(numIndices);
+    for (unsigned int i = 0; i < numIndices; ++i) {
+        std::unordered_map<unsigned int, unsigned int>::const_iterator it = mVertexMap.find(fileIndices[i]);
+        if (it != mVertexMap.end()) {
+            mFaceIndices[i] = it->second;
+        } else {
+            mFaceIndices[i] = addVertex(fileIndices[i]);
+            mVertexMap[fileIndices[i]] = mFaceIndices[i];
+        }
+    }
+    AddFace(mFaceIndices.data(), numIndices);
+}
+
+} // namespace Assimp
+
+#endif // AI_MESHCHUNKSINK_H_INC
@@ -0,0 +1,156 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Helper to distribute independent work items over worker threads.
+ */
+#pragma once
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/defs.h>
+
+#include <cstddef>
+
+#ifndef ASSIMP_BUILD_NO_THREADING
+#   include <atomic>
+#   include <exception>
+#   include <mutex>
+#   include <system_error>
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Translates a value of the #AI_CONFIG_GLOB_MULTITHREADING property into a
+ *  number of threads.
+ *
+ *  @param configValue -1 to use all hardware threads, 0 to disable threading,
+ *    any positive value for a fixed number of threads.
+ *  @return The number of threads to use, at least 1. */
+inline unsigned int GetNumWorkerThreads(int configValue) {
+#ifdef ASSIMP_BUILD_NO_THREADING
+    (void)configValue;
+    return 1;
+#else
+    if (configValue < 0) {
+        const unsigned int hw = std::thread::hardware_concurrency();
+        return hw ? hw : 1;
+    }
+    return configValue > 0 ? static_cast<unsigned int>(configValue) : 1;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Calls func(i) for all i in [0, count), distributed over up to numThreads threads.
+ *
+ *  The calling thread takes part in the work. Items are handed out one at a time, so
+ *  uneven work loads balance out. If func throws, the remaining items are skipped and
+ *  the first exception is rethrown in the calling thread once all workers have finished.
+ *  Workers must not touch shared state without synchronization - this includes the
+ *  logger. DefaultLogger serializes its output, but the application may have
+ *  installed a logger of its own which doesn't.
+ *
+ *  @param numThreads Maximum number of threads, see #GetNumWorkerThreads.
+ *  @param count Number of work items.
+ *  @param func Callable taking the item index as size_t. */
+template <typename Func>
+inline void ParallelFor(unsigned int numThreads, size_t count, Func func) {
+#ifndef ASSIMP_BUILD_NO_THREADING
+    if (numThreads > count) {
+        numThreads = static_cast<unsigned int>(count);
+    }
+    if (numThreads > 1) {
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto worker = [&]() {
+            for (;;) {
+                const size_t i = next.fetch_add(1);
+                if (i >= count) {
+                    return;
+                }
+                try {
+                    func(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    next = count;
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads - 1);
+        for (unsigned int t = 1; t < numThreads; ++t) {
+            try {
+                threads.emplace_back(worker);
+            } catch (const std::system_error &) {
+                // out of threads - the ones we have will do the remaining work
+                break;
+            }
+        }
+        worker();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return;
+    }
+#else
+    (void)numThreads;
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        func(i);
+    }
+}
+
+} // Namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
@@ -137,6 +137,21 @@ corresponding preprocessor flag to selectively disable steps.
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
 #   include "PostProcessing/GenBoundingBoxesProcess.h"
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS)
+#   include "PostProcessing/GenerateMeshletsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENERATELODS_PROCESS)
+#   include "PostProcessing/GenerateLODsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+#   include "PostProcessing/QuantizeVerticesProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEBVH_PROCESS)
+#   include "PostProcessing/GenerateBVHProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS)
+#   include "PostProcessing/OptimizeAnimationsProcess.h"
+#endif
 
 
 
@@ -150,7 +165,7 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
     // of sequence it is executed. Steps that are added here are not
     // validated - as RegisterPPStep() does - all dependencies must be given.
     // ----------------------------------------------------------------------------
-    out.reserve(31);
+    out.reserve(32);
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
     out.push_back( new MakeLeftHandedProcess());
 #endif
@@ -254,12 +269,27 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATELODS_PROCESS)
+    out.push_back( new GenerateLODsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS)
+    out.push_back( new GenerateMeshletsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
     out.push_back(new GenBoundingBoxesProcess);
 #endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+    out.push_back( new QuantizeVerticesProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEBVH_PROCESS)
+    out.push_back( new GenerateBVHProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS)
+    out.push_back( new OptimizeAnimationsProcess());
+#endif
 }
 
 }
@@ -63,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <stdio.h>
 #include "ScenePrivate.h"
+#include "Material/MaterialSystem.h"
 
 namespace Assimp {
 
@@ -958,6 +959,7 @@ void SceneCombiner::MergeMaterials(aiMaterial** dest,
             }
         }
     }
+    UpdateMaterialIndex(out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1053,6 +1055,14 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
     // now - copy the root node of the scene (deep copy, too)
     Copy( &dest->mRootNode, src->mRootNode);
 
+    // copy the instance hierarchy
+    Copy(&dest->mBVH, src->mBVH);
+    dest->mNumBVHInstances = src->mNumBVHInstances;
+    if (src->mBVHInstances) {
+        dest->mBVHInstances = new aiBVHInstance[src->mNumBVHInstances];
+        std::copy(src->mBVHInstances, src->mBVHInstances + src->mNumBVHInstances, dest->mBVHInstances);
+    }
+
     // and keep the flags ...
     dest->mFlags = src->mFlags;
 
@@ -1101,6 +1111,54 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
 
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
+
+    // make a deep copy of all meshlets
+    if (dest->mMeshlets) {
+        dest->mMeshlets = new aiMeshlet[dest->mNumMeshlets];
+        for (unsigned int i = 0; i < dest->mNumMeshlets; ++i) {
+            dest->mMeshlets[i] = src->mMeshlets[i];
+        }
+    }
+
+    // make a deep copy of all levels of detail
+    CopyPtrArray(dest->mLODs, dest->mLODs, dest->mNumLODs);
+
+    // make a deep copy of the quantized vertex streams
+    if (src->mQuantized) {
+        const aiQuantizedVertices *q = src->mQuantized;
+        aiQuantizedVertices *qd = dest->mQuantized = new aiQuantizedVertices();
+        qd->mPositionOffset = q->mPositionOffset;
+        qd->mPositionScale = q->mPositionScale;
+        qd->mPositions = q->mPositions;
+        qd->mNormals = q->mNormals;
+        qd->mTangents = q->mTangents;
+        GetArrayCopy(qd->mPositions, dest->mNumVertices * 3);
+        GetArrayCopy(qd->mNormals, dest->mNumVertices * 2);
+        GetArrayCopy(qd->mTangents, dest->mNumVertices * 2);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            qd->mTextureCoords[i] = q->mTextureCoords[i];
+            GetArrayCopy(qd->mTextureCoords[i], dest->mNumVertices * 2);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            qd->mColors[i] = q->mColors[i];
+            GetArrayCopy(qd->mColors[i], dest->mNumVertices * 4);
+        }
+    }
+
+    // make a deep copy of the per-vertex bone influences
+    if (src->mBoneInfluences) {
+        const aiBoneInfluences *b = src->mBoneInfluences;
+        aiBoneInfluences *bd = dest->mBoneInfluences = new aiBoneInfluences();
+        bd->mNumInfluences = b->mNumInfluences;
+        bd->mBoneIndices = b->mBoneIndices;
+        bd->mWeights = b->mWeights;
+        GetArrayCopy(bd->mBoneIndices, dest->mNumVertices * b->mNumInfluences);
+        GetArrayCopy(bd->mWeights, dest->mNumVertices * b->mNumInfluences);
+    }
+
+    // make a deep copy of the face hierarchy
+    dest->mBVH = nullptr;
+    Copy(&dest->mBVH, src->mBVH);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1158,6 +1216,7 @@ void SceneCombiner::Copy (aiMaterial** _dest, const aiMaterial* src) {
         prop->mKey      = sprop->mKey;
         prop->mType     = sprop->mType;
     }
+    UpdateMaterialIndex(dest);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1221,6 +1280,31 @@ void SceneCombiner::Copy(aiNodeAnim** _dest, const aiNodeAnim* src) {
     GetArrayCopy( dest->mPositionKeys, dest->mNumPositionKeys );
     GetArrayCopy( dest->mScalingKeys,  dest->mNumScalingKeys );
     GetArrayCopy( dest->mRotationKeys, dest->mNumRotationKeys );
+
+    // make a deep copy of the quantized keys
+    if (src->mQuantized) {
+        const aiQuantizedNodeAnim *q = src->mQuantized;
+        aiQuantizedNodeAnim *qd = dest->mQuantized = new aiQuantizedNodeAnim();
+        qd->mNumPositionKeys = q->mNumPositionKeys;
+        qd->mPositionTimes = q->mPositionTimes;
+        qd->mPositions = q->mPositions;
+        qd->mPositionOffset = q->mPositionOffset;
+        qd->mPositionScale = q->mPositionScale;
+        GetArrayCopy(qd->mPositionTimes, qd->mNumPositionKeys);
+        GetArrayCopy(qd->mPositions, qd->mNumPositionKeys * 3);
+        qd->mNumRotationKeys = q->mNumRotationKeys;
+        qd->mRotationTimes = q->mRotationTimes;
+        qd->mRotations = q->mRotations;
+        GetArrayCopy(qd->mRotationTimes, qd->mNumRotationKeys);
+        GetArrayCopy(qd->mRotations, qd->mNumRotationKeys * 3);
+        qd->mNumScalingKeys = q->mNumScalingKeys;
+        qd->mScalingTimes = q->mScalingTimes;
+        qd->mScalings = q->mScalings;
+        qd->mScalingOffset = q->mScalingOffset;
+        qd->mScalingScale = q->mScalingScale;
+        GetArrayCopy(qd->mScalingTimes, qd->mNumScalingKeys);
+        GetArrayCopy(qd->mScalings, qd->mNumScalingKeys * 3);
+    }
 }
 
 void SceneCombiner::Copy(aiMeshMorphAnim** _dest, const aiMeshMorphAnim* src) {
@@ -1284,23 +1368,60 @@ void SceneCombiner::Copy     (aiNode** _dest, const aiNode* src)
 {
     ai_assert(NULL != _dest && NULL != src);
 
-    aiNode* dest = *_dest = new aiNode();
+    // copies a single node, the children array still refers to the source
+    auto copyNode = [](const aiNode *source) {
+        aiNode* node = new aiNode();
 
-    // get a flat copy
-    *dest = *src;
+        // get a flat copy
+        *node = *source;
+
+        node->mMetaData = nullptr;
+        if (source->mMetaData) {
+            Copy(&node->mMetaData, source->mMetaData);
+        }
+        GetArrayCopy( node->mMeshes, node->mNumMeshes );
+        return node;
+    };
+
+    // walk the hierarchy with an explicit stack, deep hierarchies would
+    // overflow the call stack otherwise
+    std::vector<aiNode*> stack;
+    stack.push_back(*_dest = copyNode(src));
+    while (!stack.empty()) {
+        aiNode* dest = stack.back();
+        stack.pop_back();
+
+        const aiNode* const* children = dest->mChildren;
+        if (!dest->mNumChildren || !children) {
+            dest->mNumChildren = 0;
+            dest->mChildren = NULL;
+            continue;
+        }
+
+        dest->mChildren = new aiNode*[dest->mNumChildren];
+        for( unsigned int i = 0; i < dest->mNumChildren; i ++ ) {
+            aiNode* child = dest->mChildren[i] = copyNode(children[i]);
 
-    if (src->mMetaData) {
-        Copy(&dest->mMetaData, src->mMetaData);
+            // need to set the mParent fields to the created aiNode.
+            child->mParent = dest;
+            stack.push_back(child);
+        }
     }
+}
 
-    // and reallocate all arrays
-    GetArrayCopy( dest->mMeshes, dest->mNumMeshes );
-    CopyPtrArray( dest->mChildren, src->mChildren,dest->mNumChildren);
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiBVH** _dest, const aiBVH* src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
 
-	// need to set the mParent fields to the created aiNode.
-	for( unsigned int i = 0; i < dest->mNumChildren; i ++ ) {
-		dest->mChildren[i]->mParent = dest;
-	}
+    aiBVH* dest = *_dest = new aiBVH();
+    dest->mNumNodes = src->mNumNodes;
+    dest->mNodes = new aiBVHNode[src->mNumNodes];
+    std::copy(src->mNodes, src->mNodes + src->mNumNodes, dest->mNodes);
+    dest->mNumPrimitives = src->mNumPrimitives;
+    dest->mPrimitives = new unsigned int[src->mNumPrimitives];
+    std::copy(src->mPrimitives, src->mPrimitives + src->mNumPrimitives, dest->mPrimitives);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -48,6 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
+#include <assimp/SpatialSort.h>
+
+#include <vector>
 
 namespace Assimp {
 
@@ -65,6 +68,33 @@ struct ScenePrivateData {
     // List of post-processing steps already applied to the scene.
     unsigned int mPPStepsApplied;
 
+    // List of extended post-processing steps already applied to the scene.
+    unsigned int mPPExtStepsApplied;
+
+    // List of post-processing steps already applied to each mesh. Reset for
+    // a mesh by Importer::MarkMeshModified(), so that per-mesh steps only
+    // revisit modified meshes if AI_CONFIG_PP_INCREMENTAL is set.
+    std::vector<unsigned int> mMeshStepsApplied;
+
+    // Spatial sort trees kept between post-processing runs for incremental
+    // updates, indexed like the meshes of the scene. An entry is only valid
+    // for the mesh it was built for and as long as the vertex positions keep
+    // the checksum they had then; in-place edits and reallocated vertex
+    // arrays are both caught this way. While a post-processing run uses the
+    // tree it is lent out to the shared data of the run (mLent).
+    struct SpatialSortCacheEntry {
+        const aiMesh *mMesh;
+        unsigned int mNumVertices;
+        uint32_t mChecksum;
+        SpatialSort mSort;
+        ai_real mEpsilon;
+        bool mLent;
+
+        SpatialSortCacheEntry() :
+                mMesh(nullptr), mNumVertices(0), mChecksum(0), mSort(), mEpsilon(), mLent(false) {}
+    };
+    std::vector<SpatialSortCacheEntry> mSpatialSortCache;
+
     // true if the scene is a copy made with aiCopyScene()
     // or the corresponding C++ API. This means that user code
     // may have made modifications to it, so mPPStepsApplied
@@ -77,6 +107,7 @@ inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
+, mPPExtStepsApplied( 0 )
 , mIsCopy( false ) {
     // empty
 }
@@ -43,6 +43,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/SpatialSort.h>
 #include <assimp/ai_assert.h>
+#include "Common/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 using namespace Assimp;
 
@@ -53,19 +60,128 @@ using namespace Assimp;
 
 const aiVector3D PlaneInit(0.8523f, 0.34321f, 0.5736f);
 
+namespace {
+
+// Below that many positions, sorting and searching stays on the calling thread
+const size_t MinParallelPositions = 1 << 16;
+
+// Unsigned integer with the size of ai_real, used as radix sort key
+typedef std::conditional<sizeof(ai_real) == 8, uint64_t, uint32_t>::type SortKey;
+
+// --------------------------------------------------------------------------------------------
+// Maps a floating-point value to an unsigned integer of the same ordering: positive values get
+// their sign bit set, negative values are inverted entirely.
+inline SortKey ToSortKey(ai_real pValue) {
+    static_assert(sizeof(SortKey) == sizeof(ai_real), "sizeof(SortKey) == sizeof(ai_real)");
+    SortKey key;
+    ::memcpy(&key, &pValue, sizeof(key));
+    const SortKey signBit = SortKey(1) << (sizeof(SortKey) * CHAR_BIT - 1);
+    return (key & signBit) ? ~key : (key | signBit);
+}
+
+// --------------------------------------------------------------------------------------------
+// Number of work chunks to split numItems items into
+inline size_t GetNumChunks(size_t numItems, unsigned int numThreads) {
+    return (numThreads > 1 && numItems >= MinParallelPositions) ? numThreads : 1;
+}
+
+// --------------------------------------------------------------------------------------------
+// Stable LSD radix sort of keys, values are moved along. Sorts one byte per pass and skips the
+// passes where all keys share the same byte. Large arrays are split into one chunk per thread;
+// each chunk is counted and scattered by its own thread, the chunks receive consecutive output
+// ranges per digit, which keeps the sort stable.
+void RadixSort(std::vector<SortKey> &keys, std::vector<unsigned int> &values, unsigned int numThreads) {
+    static const unsigned int NumDigits = sizeof(SortKey);
+    static const unsigned int NumBuckets = 256;
+
+    const size_t numKeys = keys.size();
+    const size_t numChunks = GetNumChunks(numKeys, numThreads);
+    const size_t chunkSize = (numKeys + numChunks - 1) / numChunks;
+
+    // histograms of all digits in a single pass over the keys, per chunk
+    std::vector<size_t> histograms(numChunks * NumDigits * NumBuckets, 0);
+    ParallelFor(static_cast<unsigned int>(numChunks), numChunks, [&](size_t c) {
+        size_t *histogram = &histograms[c * NumDigits * NumBuckets];
+        const size_t end = std::min(numKeys, (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            SortKey key = keys[i];
+            for (unsigned int d = 0; d < NumDigits; ++d, key >>= 8) {
+                ++histogram[d * NumBuckets + (key & 0xff)];
+            }
+        }
+    });
+
+    std::vector<SortKey> keysTemp(numKeys);
+    std::vector<unsigned int> valuesTemp(numKeys);
+    bool sorted = false;
+    for (unsigned int d = 0; d < NumDigits; ++d) {
+        const unsigned int shift = d * 8;
+
+        // all keys in the same bucket - nothing to do for this digit
+        const size_t firstBucket = (keys[0] >> shift) & 0xff;
+        size_t firstBucketSize = 0;
+        for (size_t c = 0; c < numChunks; ++c) {
+            firstBucketSize += histograms[(c * NumDigits + d) * NumBuckets + firstBucket];
+        }
+        if (firstBucketSize == numKeys) {
+            continue;
+        }
+
+        // once the keys have been moved, the chunks hold other keys than counted initially
+        if (numChunks > 1 && sorted) {
+            ParallelFor(static_cast<unsigned int>(numChunks), numChunks, [&](size_t c) {
+                size_t *histogram = &histograms[(c * NumDigits + d) * NumBuckets];
+                std::fill(histogram, histogram + NumBuckets, 0);
+                const size_t end = std::min(numKeys, (c + 1) * chunkSize);
+                for (size_t i = c * chunkSize; i < end; ++i) {
+                    ++histogram[(keys[i] >> shift) & 0xff];
+                }
+            });
+        }
+
+        // turn the counts into output offsets, bucket-major and chunk-minor
+        size_t offset = 0;
+        for (unsigned int b = 0; b < NumBuckets; ++b) {
+            for (size_t c = 0; c < numChunks; ++c) {
+                size_t &count = histograms[(c * NumDigits + d) * NumBuckets + b];
+                const size_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+        }
+
+        ParallelFor(static_cast<unsigned int>(numChunks), numChunks, [&](size_t c) {
+            size_t *offsets = &histograms[(c * NumDigits + d) * NumBuckets];
+            const size_t end = std::min(numKeys, (c + 1) * chunkSize);
+            for (size_t i = c * chunkSize; i < end; ++i) {
+                const size_t target = offsets[(keys[i] >> shift) & 0xff]++;
+                keysTemp[target] = keys[i];
+                valuesTemp[target] = values[i];
+            }
+        });
+        keys.swap(keysTemp);
+        values.swap(valuesTemp);
+        sorted = true;
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructs a spatially sorted representation from the given position array.
 // define the reference plane. We choose some arbitrary vector away from all basic axises
 // in the hope that no model spreads all its vertices along this plane.
 SpatialSort::SpatialSort(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) :
-        mPlaneNormal(PlaneInit) {
+        mPlaneNormal(PlaneInit),
+        mNumThreads(1) {
     mPlaneNormal.Normalize();
     Fill(pPositions, pNumPositions, pElementOffset);
 }
 
 // ------------------------------------------------------------------------------------------------
 SpatialSort::SpatialSort() :
-        mPlaneNormal(PlaneInit) {
+        mPlaneNormal(PlaneInit),
+        mNumThreads(1) {
     mPlaneNormal.Normalize();
 }
 
@@ -75,17 +191,53 @@ SpatialSort::~SpatialSort() {
     // empty
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::Swap(SpatialSort &pOther) {
+    std::swap(mPlaneNormal, pOther.mPlaneNormal);
+    std::swap(mNumThreads, pOther.mNumThreads);
+    mDistances.swap(pOther.mDistances);
+    mIndices.swap(pOther.mIndices);
+    mPositions.swap(pOther.mPositions);
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
         unsigned int pElementOffset,
         bool pFinalize /*= true */) {
+    mDistances.clear();
+    mIndices.clear();
     mPositions.clear();
     Append(pPositions, pNumPositions, pElementOffset, pFinalize);
 }
 
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Finalize() {
-    std::sort(mPositions.begin(), mPositions.end());
+    const size_t numPositions = mDistances.size();
+    if (numPositions < 2) {
+        return;
+    }
+
+    // sort the entry numbers by distance, then gather the arrays in that order
+    std::vector<SortKey> keys(numPositions);
+    std::vector<unsigned int> order(numPositions);
+    for (size_t i = 0; i < numPositions; ++i) {
+        keys[i] = ToSortKey(mDistances[i]);
+        order[i] = static_cast<unsigned int>(i);
+    }
+    RadixSort(keys, order, mNumThreads);
+
+    std::vector<ai_real> distances(numPositions);
+    std::vector<unsigned int> indices(numPositions);
+    std::vector<aiVector3D> positions(numPositions);
+    for (size_t i = 0; i < numPositions; ++i) {
+        const unsigned int src = order[i];
+        distances[i] = mDistances[src];
+        indices[i] = mIndices[src];
+        positions[i] = mPositions[src];
+    }
+    mDistances.swap(distances);
+    mIndices.swap(indices);
+    mPositions.swap(positions);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -93,15 +245,18 @@ void SpatialSort::Append(const aiVector3D *pPositions, unsigned int pNumPosition
         unsigned int pElementOffset,
         bool pFinalize /*= true */) {
     // store references to all given positions along with their distance to the reference plane
-    const size_t initial = mPositions.size();
-    mPositions.reserve(initial + (pFinalize ? pNumPositions : pNumPositions * 2));
+    const size_t initial = mDistances.size();
+    mDistances.reserve(initial + pNumPositions);
+    mIndices.reserve(initial + pNumPositions);
+    mPositions.reserve(initial + pNumPositions);
     for (unsigned int a = 0; a < pNumPositions; a++) {
         const char *tempPointer = reinterpret_cast<const char *>(pPositions);
         const aiVector3D *vec = reinterpret_cast<const aiVector3D *>(tempPointer + a * pElementOffset);
 
         // store position by index and distance
-        ai_real distance = *vec * mPlaneNormal;
-        mPositions.push_back(Entry(static_cast<unsigned int>(a + initial), *vec, distance));
+        mDistances.push_back(*vec * mPlaneNormal);
+        mIndices.push_back(static_cast<unsigned int>(a + initial));
+        mPositions.push_back(*vec);
     }
 
     if (pFinalize) {
@@ -121,45 +276,94 @@ void SpatialSort::FindPositions(const aiVector3D &pPosition,
     poResults.clear();
 
     // quick check for positions outside the range
-    if (mPositions.size() == 0)
+    if (mDistances.empty())
         return;
-    if (maxDist < mPositions.front().mDistance)
+    if (maxDist < mDistances.front())
         return;
-    if (minDist > mPositions.back().mDistance)
+    if (minDist > mDistances.back())
         return;
 
     // do a binary search for the minimal distance to start the iteration there
-    unsigned int index = (unsigned int)mPositions.size() / 2;
-    unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
-    while (binaryStepSize > 1) {
-        if (mPositions[index].mDistance < minDist)
-            index += binaryStepSize;
-        else
-            index -= binaryStepSize;
-
-        binaryStepSize /= 2;
+    size_t index = std::lower_bound(mDistances.begin(), mDistances.end(), minDist) - mDistances.begin();
+
+    // Now start iterating from there until the first position lays outside of the distance range.
+    // Add all positions inside the distance range within the given radius to the result array
+    const ai_real pSquared = pRadius * pRadius;
+    for (; index < mDistances.size() && mDistances[index] < maxDist; ++index) {
+        if ((mPositions[index] - pPosition).SquareLength() < pSquared)
+            poResults.push_back(mIndices[index]);
     }
 
-    // depending on the direction of the last step we need to single step a bit back or forth
-    // to find the actual beginning element of the range
-    while (index > 0 && mPositions[index].mDistance > minDist)
-        index--;
-    while (index < (mPositions.size() - 1) && mPositions[index].mDistance < minDist)
-        index++;
+    // that's it
+}
 
-    // Mow start iterating from there until the first position lays outside of the distance range.
-    // Add all positions inside the distance range within the given radius to the result aray
-    std::vector<Entry>::const_iterator it = mPositions.begin() + index;
+// ------------------------------------------------------------------------------------------------
+// Finds the positions close to all positions in one sweep over the sorted array
+bool SpatialSort::FindAllPositions(ai_real pRadius, std::vector<size_t> &poOffsets,
+        std::vector<unsigned int> &poResults, size_t pMaxResults) const {
+    const size_t numPositions = mDistances.size();
+    poOffsets.assign(numPositions + 1, 0);
+    poResults.clear();
+    if (0 == numPositions) {
+        return true;
+    }
+
+    // The queries are answered in sorted order, so the start of the search window only moves
+    // forward. Each chunk of the sorted array collects its results separately.
+    const size_t numChunks = GetNumChunks(numPositions, mNumThreads);
+    const size_t chunkSize = (numPositions + numChunks - 1) / numChunks;
     const ai_real pSquared = pRadius * pRadius;
-    while (it->mDistance < maxDist) {
-        if ((it->mPosition - pPosition).SquareLength() < pSquared)
-            poResults.push_back(it->mIndex);
-        ++it;
-        if (it == mPositions.end())
-            break;
+    std::vector<std::vector<unsigned int>> chunkResults(numChunks);
+    std::vector<size_t> counts(numPositions);
+    std::atomic<size_t> total(0);
+    std::atomic<bool> tooMany(false);
+    ParallelFor(static_cast<unsigned int>(numChunks), numChunks, [&](size_t c) {
+        std::vector<unsigned int> &results = chunkResults[c];
+        const size_t end = std::min(numPositions, (c + 1) * chunkSize);
+        size_t first = c * chunkSize;
+        for (size_t i = c * chunkSize; i < end && !tooMany; ++i) {
+            const ai_real minDist = mDistances[i] - pRadius, maxDist = mDistances[i] + pRadius;
+            while (first > 0 && mDistances[first - 1] >= minDist)
+                --first;
+            while (mDistances[first] < minDist)
+                ++first;
+
+            const size_t initial = results.size();
+            const aiVector3D &position = mPositions[i];
+            for (size_t k = first; k < numPositions && mDistances[k] < maxDist; ++k) {
+                if ((mPositions[k] - position).SquareLength() < pSquared)
+                    results.push_back(mIndices[k]);
+            }
+            const size_t count = results.size() - initial;
+            const size_t before = total.fetch_add(count);
+            if (count > pMaxResults || before > pMaxResults - count) {
+                tooMany = true;
+            }
+            counts[i] = count;
+        }
+    });
+    if (tooMany) {
+        poOffsets.clear();
+        return false;
     }
 
-    // that's it
+    // lay the results out by vertex index
+    for (size_t i = 0; i < numPositions; ++i) {
+        poOffsets[mIndices[i] + 1] = counts[i];
+    }
+    for (size_t i = 0; i < numPositions; ++i) {
+        poOffsets[i + 1] += poOffsets[i];
+    }
+    poResults.resize(poOffsets[numPositions]);
+    ParallelFor(static_cast<unsigned int>(numChunks), numChunks, [&](size_t c) {
+        const unsigned int *src = chunkResults[c].data();
+        const size_t end = std::min(numPositions, (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            std::copy(src, src + counts[i], poResults.begin() + poOffsets[mIndices[i]]);
+            src += counts[i];
+        }
+    });
+    return true;
 }
 
 namespace {
@@ -260,35 +464,17 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
     // the array which we want to avoid
     poResults.resize(0);
 
-    // do a binary search for the minimal distance to start the iteration there
-    unsigned int index = (unsigned int)mPositions.size() / 2;
-    unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
-    while (binaryStepSize > 1) {
-        // Ugly, but conditional jumps are faster with integers than with floats
-        if (minDistBinary > ToBinary(mPositions[index].mDistance))
-            index += binaryStepSize;
-        else
-            index -= binaryStepSize;
-
-        binaryStepSize /= 2;
-    }
-
-    // depending on the direction of the last step we need to single step a bit back or forth
-    // to find the actual beginning element of the range
-    while (index > 0 && minDistBinary < ToBinary(mPositions[index].mDistance))
-        index--;
-    while (index < (mPositions.size() - 1) && minDistBinary > ToBinary(mPositions[index].mDistance))
-        index++;
+    // do a binary search for the minimal distance to start the iteration there.
+    // Ugly, but conditional jumps are faster with integers than with floats
+    size_t index = std::lower_bound(mDistances.begin(), mDistances.end(), minDistBinary,
+                           [](ai_real distance, BinFloat value) { return ToBinary(distance) < value; }) -
+                   mDistances.begin();
 
     // Now start iterating from there until the first position lays outside of the distance range.
     // Add all positions inside the distance range within the tolerance to the result array
-    std::vector<Entry>::const_iterator it = mPositions.begin() + index;
-    while (ToBinary(it->mDistance) < maxDistBinary) {
-        if (distance3DToleranceInULPs >= ToBinary((it->mPosition - pPosition).SquareLength()))
-            poResults.push_back(it->mIndex);
-        ++it;
-        if (it == mPositions.end())
-            break;
+    for (; index < mDistances.size() && ToBinary(mDistances[index]) < maxDistBinary; ++index) {
+        if (distance3DToleranceInULPs >= ToBinary((mPositions[index] - pPosition).SquareLength()))
+            poResults.push_back(mIndices[index]);
     }
 
     // that's it
@@ -296,28 +482,27 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
 
 // ------------------------------------------------------------------------------------------------
 unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
-    fill.resize(mPositions.size(), UINT_MAX);
-    ai_real dist, maxDist;
+    fill.resize(mDistances.size(), UINT_MAX);
+    ai_real maxDist;
 
     unsigned int t = 0;
     const ai_real pSquared = pRadius * pRadius;
-    for (size_t i = 0; i < mPositions.size();) {
-        dist = mPositions[i].mPosition * mPlaneNormal;
-        maxDist = dist + pRadius;
-
-        fill[mPositions[i].mIndex] = t;
-        const aiVector3D &oldpos = mPositions[i].mPosition;
-        for (++i; i < fill.size() && mPositions[i].mDistance < maxDist && (mPositions[i].mPosition - oldpos).SquareLength() < pSquared; ++i) {
-            fill[mPositions[i].mIndex] = t;
+    for (size_t i = 0; i < mDistances.size();) {
+        maxDist = mDistances[i] + pRadius;
+
+        fill[mIndices[i]] = t;
+        const aiVector3D &oldpos = mPositions[i];
+        for (++i; i < fill.size() && mDistances[i] < maxDist && (mPositions[i] - oldpos).SquareLength() < pSquared; ++i) {
+            fill[mIndices[i]] = t;
         }
         ++t;
     }
 
 #ifdef ASSIMP_BUILD_DEBUG
 
-    // debug invariant: mPositions[i].mIndex values must range from 0 to mPositions.size()-1
+    // debug invariant: mIndices values must range from 0 to mIndices.size()-1
     for (size_t i = 0; i < fill.size(); ++i) {
-        ai_assert(fill[i] < mPositions.size());
+        ai_assert(fill[i] < mIndices.size());
     }
 
 #endif
@@ -46,12 +46,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Vertex.h>
 #include <assimp/ai_assert.h>
 
+#include "Common/ParallelFor.h"
 #include "PostProcessing/ProcessHelper.h"
 
-#include <stdio.h>
+#include <algorithm>
+#include <climits>
+#include <stdint.h>
 
 using namespace Assimp;
-void mydummy() {}
 
 #ifdef _WIN32
 #    pragma warning( disable : 4709 ) 
@@ -67,45 +69,95 @@ public:
     void Subdivide (aiMesh** smesh, size_t nmesh,
         aiMesh** out, unsigned int num, bool discard_input);
 
+    typedef std::vector<unsigned int> UIntVector;
+
     // ---------------------------------------------------------------------------
-    /** Intermediate description of an edge between two corners of a polygon*/
+    /** Indexed polygon soup of all meshes being subdivided. Intermediate levels
+     *  are kept in this form rather than being materialized as verbose meshes.
+     *  All faces of all meshes are stored continuously, mesh after mesh. */
     // ---------------------------------------------------------------------------
-    struct Edge
+    struct Cage
     {
-        Edge()
-            : ref(0)
+        Cage()
+            : numTopo(0)
         {}
-        Vertex edge_point, midpoint;
-        unsigned int ref;
-    };
 
-    typedef std::vector<unsigned int> UIntVector;
-    typedef std::map<uint64_t,Edge> EdgeMap;
+        //! Returns the number of faces
+        unsigned int NumFaces() const {
+            return static_cast<unsigned int>(faceStart.size()-1);
+        }
+
+        //! Returns the distinct (welded) vertex index of a face corner
+        unsigned int Topo(unsigned int corner) const {
+            const unsigned int v = indices[corner];
+            return topo.empty() ? v : topo[v];
+        }
+
+        std::vector<Vertex> verts;  // vertex data
+        UIntVector topo;            // distinct vertex index per vertex, empty if identical
+        unsigned int numTopo;       // number of distinct vertices
+        UIntVector faceStart;       // first corner of each face, plus the end
+        UIntVector indices;         // vertex index of each corner
+        UIntVector meshFaces;       // first face of each mesh, plus the end
+    };
 
     // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
-    // 'unsigned int' vertex coordinates (!!distinct coordinates - same
-    // vertex position == same index!!).
-    // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-    // and (id[0]>2^32-1 or id[0]>2^32-1).
-    // MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-    // at the head of every function which is about to use MAKE_EDGE_HASH().
-    // Reason is that the hash is that hash construction needs to hold the
-    // invariant id0<id1 to identify an edge - else two hashes would refer
-    // to the same edge.
+    /** Open addressing hash table to map an edge between two distinct vertices
+     *  to a dense edge index. Every edge exists twice if there is a neighboring
+     *  face, the order of the two vertices does not matter. */
     // ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0,id1) (eh_tmp0__=id0,eh_tmp1__=id1,\
-    (eh_tmp0__<eh_tmp1__?std::swap(eh_tmp0__,eh_tmp1__):mydummy()),(uint64_t)eh_tmp0__^((uint64_t)eh_tmp1__<<32u))
+    class EdgeTable
+    {
+    public:
+        explicit EdgeTable(size_t maxEdges)
+            : mCount(0)
+        {
+            size_t capacity = 16;
+            while (capacity < maxEdges*2) {
+                capacity <<= 1;
+            }
+            mMask = capacity-1;
+            mKeys.assign(capacity,EmptyKey);
+            mValues.resize(capacity);
+        }
+
+        //! Returns the index of the edge, a new edge gets the next free index
+        unsigned int Insert(unsigned int id0, unsigned int id1, bool& inserted) {
+            const uint64_t key = id0 < id1 ? ((uint64_t)id0<<32u)|id1 : ((uint64_t)id1<<32u)|id0;
+            uint64_t h = key ^ (key >> 33u);
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33u;
+            for (size_t slot = static_cast<size_t>(h) & mMask;; slot = (slot+1) & mMask) {
+                if (mKeys[slot] == key) {
+                    inserted = false;
+                    return mValues[slot];
+                }
+                if (mKeys[slot] == EmptyKey) {
+                    mKeys[slot] = key;
+                    inserted = true;
+                    return mValues[slot] = mCount++;
+                }
+            }
+        }
 
+    private:
+        // no valid edge, vertex indices are always smaller than 0xffffffff
+        static const uint64_t EmptyKey = ~(uint64_t)0;
 
-#define INIT_EDGE_HASH_TEMPORARIES()\
-    unsigned int eh_tmp0__, eh_tmp1__;
+        std::vector<uint64_t> mKeys;
+        UIntVector mValues;
+        size_t mMask;
+        unsigned int mCount;
+    };
 
 private:
     void InternSubdivide (const aiMesh* const * smesh,
         size_t nmesh,aiMesh** out, unsigned int num);
+
+    void SubdivideCage (const Cage& in, Cage& out);
 };
 
+const uint64_t CatmullClarkSubdivider::EdgeTable::EmptyKey;
 
 // ------------------------------------------------------------------------------------------------
 // Construct a subdivider of a specific type
@@ -218,16 +270,26 @@ void CatmullClarkSubdivider::Subdivide (
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Runs func(begin, end) for consecutive ranges of [0, count), distributed over numThreads threads
+template <typename Func>
+static void ParallelRanges(unsigned int numThreads, size_t count, Func func)
+{
+    static const size_t BatchSize = 1024;
+    ParallelFor(numThreads, (count+BatchSize-1)/BatchSize, [&](size_t batch) {
+        func(batch*BatchSize, std::min(count, (batch+1)*BatchSize));
+    });
+}
+
 // ------------------------------------------------------------------------------------------------
 // Note - this is an implementation of the standard (recursive) Cm-Cl algorithm without further
-// optimizations (except we're using some nice LUTs). A description of the algorithm can be found
-// here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
+// optimizations. A description of the algorithm can be found here:
+// http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
-// The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
-// mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
-// in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings).
-// Previous data is replaced/deleted then.
+// The input meshes are welded into a single indexed cage once. Every subdivision level maps a
+// cage to the next one, only the last level is written back to verbose output meshes. Each level
+// is O(n) - edges are looked up in a hash table - and the per face, per edge and per vertex work
+// is spread over mNumThreads threads. Calling #InternSubdivide() directly is not encouraged.
 // ------------------------------------------------------------------------------------------------
 void CatmullClarkSubdivider::InternSubdivide (
     const aiMesh* const * smesh,
@@ -237,203 +299,83 @@ void CatmullClarkSubdivider::InternSubdivide (
     )
 {
     ai_assert(NULL != smesh && NULL != out);
-    INIT_EDGE_HASH_TEMPORARIES();
 
-    // no subdivision requested or end of recursive refinement
+    // no subdivision requested
     if (!num) {
         return;
     }
 
-    UIntVector maptbl;
-    SpatialSort spatial;
-
     // ---------------------------------------------------------------------
-    // 0. Offset table to index all meshes continuously, generate a spatially
-    // sorted representation of all vertices in all meshes.
+    // 0. Generate a spatially sorted representation of all vertices in all
+    // meshes and weld them into the initial cage. Vertex data is taken from
+    // the face corners, only the topology is welded.
     // ---------------------------------------------------------------------
-    typedef std::pair<unsigned int,unsigned int> IntPair;
-    std::vector<IntPair> moffsets(nmesh);
-    unsigned int totfaces = 0, totvert = 0;
+    Cage cage;
+    {
+    SpatialSort spatial;
+    UIntVector voffsets(nmesh);
+    unsigned int totfaces = 0, totvert = 0, totcorners = 0;
+    cage.meshFaces.resize(nmesh+1);
     for (size_t t = 0; t < nmesh; ++t) {
         const aiMesh* mesh = smesh[t];
 
         spatial.Append(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D),false);
-        moffsets[t] = IntPair(totfaces,totvert);
+        cage.meshFaces[t] = totfaces;
+        voffsets[t] = totvert;
 
         totfaces += mesh->mNumFaces;
         totvert  += mesh->mNumVertices;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            totcorners += mesh->mFaces[i].mNumIndices;
+        }
     }
+    cage.meshFaces[nmesh] = totfaces;
 
     spatial.Finalize();
-    const unsigned int num_unique = spatial.GenerateMappingTable(maptbl,ComputePositionEpsilon(smesh,nmesh));
-
+    cage.numTopo = spatial.GenerateMappingTable(cage.topo,ComputePositionEpsilon(smesh,nmesh));
 
-#define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second+vert_idx)
-#define   FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first+face_idx)
-
-    // ---------------------------------------------------------------------
-    // 1. Compute the centroid point for all faces
-    // ---------------------------------------------------------------------
-    std::vector<Vertex> centroids(totfaces);
-    unsigned int nfacesout = 0;
-    for (size_t t = 0, n = 0; t < nmesh; ++t) {
+    cage.verts.resize(totvert);
+    cage.faceStart.resize(totfaces+1);
+    cage.indices.resize(totcorners);
+    for (size_t t = 0, f = 0, c = 0; t < nmesh; ++t) {
         const aiMesh* mesh = smesh[t];
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n)
-        {
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++f) {
             const aiFace& face = mesh->mFaces[i];
-            Vertex& c = centroids[n];
-
-            for (unsigned int a = 0; a < face.mNumIndices;++a) {
-                c += Vertex(mesh,face.mIndices[a]);
+            cage.faceStart[f] = static_cast<unsigned int>(c);
+            for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+                cage.indices[c++] = voffsets[t] + face.mIndices[a];
             }
-
-            c /= static_cast<float>(face.mNumIndices);
-            nfacesout += face.mNumIndices;
         }
     }
+    cage.faceStart[totfaces] = totcorners;
 
-    {
-    // we want edges to go away before the recursive calls so begin a new scope
-    EdgeMap edges;
-
-    // ---------------------------------------------------------------------
-    // 2. Set each edge point to be the average of all neighbouring
-    // face points and original points. Every edge exists twice
-    // if there is a neighboring face.
-    // ---------------------------------------------------------------------
-    for (size_t t = 0; t < nmesh; ++t) {
+    ParallelFor(mNumThreads, nmesh, [&](size_t t) {
         const aiMesh* mesh = smesh[t];
-
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i)   {
-            const aiFace& face = mesh->mFaces[i];
-
-            for (unsigned int p =0; p< face.mNumIndices; ++p) {
-                const unsigned int id[] = {
-                    face.mIndices[p],
-                    face.mIndices[p==face.mNumIndices-1?0:p+1]
-                };
-                const unsigned int mp[] = {
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[0])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[1])]
-                };
-
-                Edge& e = edges[MAKE_EDGE_HASH(mp[0],mp[1])];
-                e.ref++;
-                if (e.ref<=2) {
-                    if (e.ref==1) { // original points (end points) - add only once
-                        e.edge_point = e.midpoint = Vertex(mesh,id[0])+Vertex(mesh,id[1]);
-                        e.midpoint *= 0.5f;
-                    }
-                    e.edge_point += centroids[FLATTEN_FACE_IDX(t,i)];
-                }
-            }
-        }
-    }
-
-    // ---------------------------------------------------------------------
-    // 3. Normalize edge points
-    // ---------------------------------------------------------------------
-    {unsigned int bad_cnt = 0;
-    for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-        if ((*it).second.ref < 2) {
-            ai_assert((*it).second.ref);
-            ++bad_cnt;
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            cage.verts[voffsets[t]+i] = Vertex(mesh,i);
         }
-        (*it).second.edge_point *= 1.f/((*it).second.ref+2.f);
+    });
     }
 
-    if (bad_cnt) {
-        // Report the number of bad edges. bad edges are referenced by less than two
-        // faces in the mesh. They occur at outer model boundaries in non-closed
-        // shapes.
-        ASSIMP_LOG_VERBOSE_DEBUG_F("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ", 
-            static_cast<unsigned int>(edges.size()), " edges). ");
-    }}
-
     // ---------------------------------------------------------------------
-    // 4. Compute a vertex-face adjacency table. We can't reuse the code
-    // from VertexTriangleAdjacency because we need the table for multiple
-    // meshes and out vertex indices need to be mapped to distinct values
-    // first.
+    // 1. Refine the cage level after level.
     // ---------------------------------------------------------------------
-    UIntVector faceadjac(nfacesout), cntadjfac(maptbl.size(),0), ofsadjvec(maptbl.size()+1,0); {
-    for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* const minp = smesh[t];
-        for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-            const aiFace& f = minp->mFaces[i];
-            for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                ++cntadjfac[maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]];
-            }
-        }
-    }
-    unsigned int cur = 0;
-    for (size_t i = 0; i < cntadjfac.size(); ++i) {
-        ofsadjvec[i+1] = cur;
-        cur += cntadjfac[i];
-    }
-    for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh* const minp = smesh[t];
-        for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-            const aiFace& f = minp->mFaces[i];
-            for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                faceadjac[ofsadjvec[1+maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]]++] = FLATTEN_FACE_IDX(t,i);
-            }
-        }
+    for (unsigned int level = 0; level < num; ++level) {
+        Cage next;
+        SubdivideCage(cage,next);
+        std::swap(cage,next);
     }
 
-    // check the other way round for consistency
-#ifdef ASSIMP_BUILD_DEBUG
-
-    for (size_t t = 0; t < ofsadjvec.size()-1; ++t) {
-        for (unsigned int m = 0; m <  cntadjfac[t]; ++m) {
-            const unsigned int fidx = faceadjac[ofsadjvec[t]+m];
-            ai_assert(fidx < totfaces);
-            for (size_t n = 1; n < nmesh; ++n) {
-
-                if (moffsets[n].first > fidx) {
-                    const aiMesh* msh = smesh[--n];
-                    const aiFace& f = msh->mFaces[fidx-moffsets[n].first];
-
-                    bool haveit = false;
-                    for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-                        if (maptbl[FLATTEN_VERTEX_IDX(n,f.mIndices[i])]==(unsigned int)t) {
-                            haveit = true;
-                            break;
-                        }
-                    }
-                    ai_assert(haveit);
-                    if (!haveit) {
-                        ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: Index not used");
-                    }
-                    break;
-                }
-            }
-        }
-    }
-
-#endif
-    }
-
-#define GET_ADJACENT_FACES_AND_CNT(vidx,fstartout,numout) \
-    fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
-
-    typedef std::pair<bool,Vertex> TouchedOVertex;
-    std::vector<TouchedOVertex > new_points(num_unique,TouchedOVertex(false,Vertex()));
     // ---------------------------------------------------------------------
-    // 5. Spawn a quad from each face point to the corresponding edge points
-    // the original points being the fourth quad points.
+    // 2. Write the final level back to one verbose mesh per input mesh. All
+    // faces are quads, every face corner gets its own output vertex.
     // ---------------------------------------------------------------------
-    for (size_t t = 0; t < nmesh; ++t) {
+    ParallelFor(mNumThreads, nmesh, [&](size_t t) {
         const aiMesh* const minp = smesh[t];
         aiMesh* const mout = out[t] = new aiMesh();
 
-        for (unsigned int a  = 0; a < minp->mNumFaces; ++a) {
-            mout->mNumFaces += minp->mFaces[a].mNumIndices;
-        }
-
-        // We need random access to the old face buffer, so reuse is not possible.
+        const unsigned int fbegin = cage.meshFaces[t];
+        mout->mNumFaces = cage.meshFaces[t+1] - fbegin;
         mout->mFaces = new aiFace[mout->mNumFaces];
 
         mout->mNumVertices = mout->mNumFaces*4;
@@ -461,132 +403,199 @@ void CatmullClarkSubdivider::InternSubdivide (
             mout->mColors[i] = new aiColor4D[mout->mNumVertices];
         }
 
-        mout->mNumVertices = mout->mNumFaces<<2u;
-        for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces;++i) {
-
-            const aiFace& face = minp->mFaces[i];
-            for (unsigned int a = 0; a < face.mNumIndices;++a)  {
-
-                // Get a clean new face.
-                aiFace& faceOut = mout->mFaces[n++];
-                faceOut.mIndices = new unsigned int [faceOut.mNumIndices = 4];
-
-                // Spawn a new quadrilateral (ccw winding) for this original point between:
-                // a) face centroid
-                centroids[FLATTEN_FACE_IDX(t,i)].SortBack(mout,faceOut.mIndices[0]=v++);
-
-                // b) adjacent edge on the left, seen from the centroid
-                const Edge& e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a==face.mNumIndices-1?0:a+1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
-
-                // c) adjacent edge on the right, seen from the centroid
-                const Edge& e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[!a?face.mNumIndices-1:a-1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
-
-                e0.edge_point.SortBack(mout,faceOut.mIndices[3]=v++);
-                e1.edge_point.SortBack(mout,faceOut.mIndices[1]=v++);
-
-                // d= original point P with distinct index i
-                // F := 0
-                // R := 0
-                // n := 0
-                // for each face f containing i
-                //    F := F+ centroid of f
-                //    R := R+ midpoint of edge of f from i to i+1
-                //    n := n+1
-                //
-                // (F+2R+(n-3)P)/n
-                const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])];
-                TouchedOVertex& ov = new_points[org];
-
-                if (!ov.first) {
-                    ov.first = true;
-
-                    const unsigned int* adj; unsigned int cnt;
-                    GET_ADJACENT_FACES_AND_CNT(org,adj,cnt);
-
-                    if (cnt < 3) {
-                        ov.second = Vertex(minp,face.mIndices[a]);
-                    }
-                    else {
-
-                        Vertex F,R;
-                        for (unsigned int o = 0; o < cnt; ++o) {
-                            ai_assert(adj[o] < totfaces);
-                            F += centroids[adj[o]];
-
-                            // adj[0] is a global face index - search the face in the mesh list
-                            const aiMesh* mp = NULL;
-                            size_t nidx;
-
-                            if (adj[o] < moffsets[0].first) {
-                                mp = smesh[nidx=0];
-                            }
-                            else {
-                                for (nidx = 1; nidx<= nmesh; ++nidx) {
-                                    if (nidx == nmesh ||moffsets[nidx].first > adj[o]) {
-                                        mp = smesh[--nidx];
-                                        break;
-                                    }
-                                }
-                            }
-
-                            ai_assert(adj[o]-moffsets[nidx].first < mp->mNumFaces);
-                            const aiFace& f = mp->mFaces[adj[o]-moffsets[nidx].first];
-                            bool haveit = false;
-
-                            // find our original point in the face
-                            for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(nidx,f.mIndices[m])] == org) {
-
-                                    // add *both* edges. this way, we can be sure that we add
-                                    // *all* adjacent edges to R. In a closed shape, every
-                                    // edge is added twice - so we simply leave out the
-                                    // factor 2.f in the amove formula and get the right
-                                    // result.
-
-                                    const Edge& c0 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[!m?f.mNumIndices-1:m-1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-
-                                    const Edge& c1 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[m==f.mNumIndices-1?0:m+1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-                                    R += c0.midpoint+c1.midpoint;
-
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-
-                            // this invariant *must* hold if the vertex-to-face adjacency table is valid
-                            ai_assert(haveit);
-                            if ( !haveit ) {
-                                ASSIMP_LOG_WARN( "OBJ: no name for material library specified." );
-                            }
-                        }
-
-                        const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
-                        ov.second = Vertex(minp,face.mIndices[a])*((div-3.f) / div) + R*divsq + F*divsq;
-                    }
-                }
-                ov.second.SortBack(mout,faceOut.mIndices[2]=v++);
+        for (unsigned int i = 0, v = 0; i < mout->mNumFaces; ++i) {
+            aiFace& faceOut = mout->mFaces[i];
+            faceOut.mIndices = new unsigned int [faceOut.mNumIndices = 4];
+
+            const unsigned int cbegin = cage.faceStart[fbegin+i];
+            for (unsigned int a = 0; a < 4; ++a) {
+                cage.verts[cage.indices[cbegin+a]].SortBack(mout,faceOut.mIndices[a]=v++);
+            }
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Apply one subdivision step to a cage. The new vertices are stored as all face points, then all
+// edge points, then one new point per distinct original vertex.
+// ------------------------------------------------------------------------------------------------
+void CatmullClarkSubdivider::SubdivideCage (
+    const Cage& in,
+    Cage& out
+    )
+{
+    const unsigned int nfaces = in.NumFaces();
+    const unsigned int ncorners = static_cast<unsigned int>(in.indices.size());
+
+    // corner indices of the next and previous corner within the face
+#define NEXT_CORNER(f, c) ((c)+1 == in.faceStart[(f)+1] ? in.faceStart[f] : (c)+1)
+#define PREV_CORNER(f, c) ((c) == in.faceStart[f] ? in.faceStart[(f)+1]-1 : (c)-1)
+
+    // ---------------------------------------------------------------------
+    // 1. Compute the centroid point for all faces
+    // ---------------------------------------------------------------------
+    std::vector<Vertex> centroids(nfaces);
+    ParallelRanges(mNumThreads, nfaces, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            Vertex& c = centroids[f];
+            const unsigned int cbegin = in.faceStart[f], cend = in.faceStart[f+1];
+            for (unsigned int a = cbegin; a < cend; ++a) {
+                c += in.verts[in.indices[a]];
+            }
+            c /= static_cast<ai_real>(cend-cbegin);
+        }
+    });
+
+    // ---------------------------------------------------------------------
+    // 2. Assign an index to each edge. For every edge, remember the first
+    // corner and the first two faces referencing it.
+    // ---------------------------------------------------------------------
+    UIntVector cornerEdge(ncorners), cornerFace(ncorners);
+    UIntVector edgeCorner, edgeFace1, edgeRef;
+    {
+    EdgeTable table(ncorners);
+    edgeCorner.reserve(ncorners);
+    edgeFace1.reserve(ncorners);
+    edgeRef.reserve(ncorners);
+    for (unsigned int f = 0; f < nfaces; ++f) {
+        for (unsigned int c = in.faceStart[f]; c < in.faceStart[f+1]; ++c) {
+            bool inserted;
+            const unsigned int e = table.Insert(in.Topo(c),in.Topo(NEXT_CORNER(f,c)),inserted);
+            cornerEdge[c] = e;
+            cornerFace[c] = f;
+            if (inserted) {
+                edgeCorner.push_back(c);
+                edgeFace1.push_back(UINT_MAX);
+                edgeRef.push_back(1);
+            }
+            else if (++edgeRef[e] == 2) {
+                edgeFace1[e] = f;
+            }
+        }
+    }
+    }
+    const unsigned int nedges = static_cast<unsigned int>(edgeCorner.size());
+
+    // ---------------------------------------------------------------------
+    // 3. Set each edge point to be the average of all neighbouring face
+    // points and original points.
+    // ---------------------------------------------------------------------
+    std::vector<Vertex> midpoints(nedges);
+    out.verts.resize(nfaces+nedges+in.numTopo);
+    ParallelRanges(mNumThreads, nedges, [&](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; ++e) {
+            const unsigned int c = edgeCorner[e], f = cornerFace[c];
+            Vertex& ep = out.verts[nfaces+e];
+
+            ep = midpoints[e] = in.verts[in.indices[c]] + in.verts[in.indices[NEXT_CORNER(f,c)]];
+            midpoints[e] *= 0.5f;
+            ep += centroids[f];
+            if (edgeRef[e] >= 2) {
+                ep += centroids[edgeFace1[e]];
             }
+            ep *= 1.f/(edgeRef[e]+2.f);
+        }
+    });
+
+    {unsigned int bad_cnt = 0;
+    for (unsigned int e = 0; e < nedges; ++e) {
+        if (edgeRef[e] < 2) {
+            ++bad_cnt;
         }
     }
-    }  // end of scope for edges, freeing its memory
+
+    if (bad_cnt) {
+        // Report the number of bad edges. bad edges are referenced by less than two
+        // faces in the mesh. They occur at outer model boundaries in non-closed
+        // shapes.
+        ASSIMP_LOG_VERBOSE_DEBUG_F("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ",
+            nedges, " edges). ");
+    }}
+
+    // ---------------------------------------------------------------------
+    // 4. Compute a vertex-corner adjacency table for the distinct vertices,
+    // sorted by corner index.
+    // ---------------------------------------------------------------------
+    UIntVector adjstart(in.numTopo+1,0), adjcorner(ncorners);
+    for (unsigned int c = 0; c < ncorners; ++c) {
+        ++adjstart[in.Topo(c)+1];
+    }
+    for (unsigned int v = 0; v < in.numTopo; ++v) {
+        adjstart[v+1] += adjstart[v];
+    }
+    {UIntVector fill(adjstart.begin(),adjstart.end()-1);
+    for (unsigned int c = 0; c < ncorners; ++c) {
+        adjcorner[fill[in.Topo(c)]++] = c;
+    }}
+
+    // ---------------------------------------------------------------------
+    // 5. Compute the new position of each original point P with n adjacent
+    // faces as (F+2R+(n-3)P)/n, F being the average of the face points and
+    // R the average of the midpoints of all edges touching P. Vertex data
+    // of P is taken from the first corner referencing it.
+    // ---------------------------------------------------------------------
+    ParallelRanges(mNumThreads, in.numTopo, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            const unsigned int* adj = adjcorner.empty() ? NULL : &adjcorner[adjstart[v]];
+            const unsigned int cnt = adjstart[v+1] - adjstart[v];
+            if (!cnt) {
+                continue;
+            }
+
+            Vertex& ov = out.verts[nfaces+nedges+v];
+            const Vertex& p = in.verts[in.indices[adj[0]]];
+            if (cnt < 3) {
+                ov = p;
+                continue;
+            }
+
+            Vertex F,R;
+            for (unsigned int o = 0; o < cnt; ++o) {
+                const unsigned int c = adj[o], f = cornerFace[c];
+                F += centroids[f];
+
+                // add *both* edges. this way, we can be sure that we add *all* adjacent
+                // edges to R. In a closed shape, every edge is added twice - so we simply
+                // leave out the factor 2.f in the above formula and get the right result.
+                R += midpoints[cornerEdge[PREV_CORNER(f,c)]] + midpoints[cornerEdge[c]];
+            }
+
+            const ai_real div = static_cast<ai_real>(cnt), divsq = 1.f/(div*div);
+            ov = p*((div-3.f) / div) + R*divsq + F*divsq;
+        }
+    });
 
     // ---------------------------------------------------------------------
-    // 7. Apply the next subdivision step.
+    // 6. Spawn a quad from each face point to the corresponding edge points
+    // the original points being the fourth quad points.
     // ---------------------------------------------------------------------
-    if (num != 1) {
-        std::vector<aiMesh*> tmp(nmesh);
-        InternSubdivide (out,nmesh,&tmp.front(),num-1);
-        for (size_t i = 0; i < nmesh; ++i) {
-            delete out[i];
-            out[i] = tmp[i];
+    std::copy(centroids.begin(),centroids.end(),out.verts.begin());
+    out.topo.clear();
+    out.numTopo = static_cast<unsigned int>(out.verts.size());
+    out.faceStart.resize(ncorners+1);
+    out.indices.resize(ncorners*4);
+    ParallelRanges(mNumThreads, nfaces, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            for (unsigned int c = in.faceStart[f]; c < in.faceStart[f+1]; ++c) {
+                unsigned int* quad = &out.indices[c*4];
+                out.faceStart[c] = c*4;
+
+                // ccw winding: face centroid, adjacent edge on the right, seen from the
+                // centroid, the original point and the adjacent edge on the left
+                quad[0] = static_cast<unsigned int>(f);
+                quad[1] = nfaces + cornerEdge[PREV_CORNER(f,c)];
+                quad[2] = nfaces + nedges + in.Topo(c);
+                quad[3] = nfaces + cornerEdge[c];
+            }
         }
+    });
+    out.faceStart[ncorners] = ncorners*4;
+
+    out.meshFaces.resize(in.meshFaces.size());
+    for (size_t t = 0; t < in.meshFaces.size(); ++t) {
+        out.meshFaces[t] = in.faceStart[in.meshFaces[t]];
     }
+
+#undef NEXT_CORNER
+#undef PREV_CORNER
 }
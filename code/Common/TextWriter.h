@@ -0,0 +1,444 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file TextWriter.h
+ *  @brief Fast, locale-independent text output for the text based exporters.
+ */
+#pragma once
+#ifndef AI_TEXTWRITER_H_INC
+#define AI_TEXTWRITER_H_INC
+
+#include "ParallelFor.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/IOStream.hpp>
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Buffered text writer, a faster replacement for std::ostringstream in exporters.
+ *
+ *  Numbers are always formatted using the C locale. Floating-point values are written
+ *  with the shortest number of digits that reads back to the very same value, so no
+ *  precision setting is needed. If a stream is given, the output is flushed to it in
+ *  chunks of about chunkSize bytes; otherwise everything is kept in memory. The
+ *  destructor does not flush, call Flush() once the output is complete. */
+class TextWriter {
+public:
+    static const size_t DefaultChunkSize = 1 << 16;
+
+    explicit TextWriter(IOStream *stream = nullptr, size_t chunkSize = DefaultChunkSize) :
+            mStream(stream),
+            mChunkSize(chunkSize),
+            mFlushed(0) {
+        if (mStream) {
+            mBuffer.reserve(mChunkSize + 64);
+        }
+    }
+
+    TextWriter &operator<<(const char *s) {
+        Write(s, ::strlen(s));
+        return *this;
+    }
+
+    TextWriter &operator<<(const std::string &s) {
+        Write(s.data(), s.length());
+        return *this;
+    }
+
+    TextWriter &operator<<(char c) {
+        mBuffer.push_back(c);
+        CheckFlush();
+        return *this;
+    }
+
+    TextWriter &operator<<(int i) { return WriteSigned(i); }
+    TextWriter &operator<<(long i) { return WriteSigned(i); }
+    TextWriter &operator<<(long long i) { return WriteSigned(i); }
+    TextWriter &operator<<(unsigned int i) { return WriteUnsigned(i); }
+    TextWriter &operator<<(unsigned long i) { return WriteUnsigned(i); }
+    TextWriter &operator<<(unsigned long long i) { return WriteUnsigned(i); }
+
+    TextWriter &operator<<(float f) {
+        char tmp[32];
+        Write(tmp, FormatFloat(f, tmp));
+        return *this;
+    }
+
+    TextWriter &operator<<(double d) {
+        char tmp[32];
+        Write(tmp, FormatDouble(d, tmp));
+        return *this;
+    }
+
+    /// Appends raw bytes, for instance for binary output.
+    void Write(const char *data, size_t length) {
+        if (mStream && length >= mChunkSize) {
+            Flush();
+            WriteToStream(data, length);
+            return;
+        }
+        mBuffer.append(data, length);
+        CheckFlush();
+    }
+
+    /// Appends everything another in-memory writer has collected.
+    void Append(const TextWriter &other) {
+        Write(other.mBuffer.data(), other.mBuffer.length());
+    }
+
+    /// Hands all buffered output over to the stream. Throws DeadlyExportError on failure.
+    void Flush() {
+        if (mStream && !mBuffer.empty()) {
+            WriteToStream(mBuffer.data(), mBuffer.length());
+            mBuffer.clear();
+        }
+    }
+
+    /// Writes all buffered output to another stream in one go, for writers without a stream
+    /// of their own. Throws DeadlyExportError on failure.
+    void WriteTo(IOStream *stream) const {
+        if (!mBuffer.empty() && stream->Write(mBuffer.data(), mBuffer.length(), 1) == 0) {
+            throw DeadlyExportError("failed to write to the output stream");
+        }
+    }
+
+    /// Discards all buffered output.
+    void Clear() {
+        mBuffer.clear();
+    }
+
+    /// Returns the output not yet flushed - all of it if no stream is attached.
+    const std::string &GetBuffer() const {
+        return mBuffer;
+    }
+
+    /// Returns the total number of bytes written so far.
+    size_t Tell() const {
+        return mFlushed + mBuffer.length();
+    }
+
+    // --------------------------------------------------------------------------------------------
+    /** @brief Formats an unsigned integer in decimal notation.
+     *  @return The number of characters written, no terminating zero is added. */
+    static size_t FormatUnsigned(unsigned long long value, char *out) {
+        char tmp[24];
+        char *p = tmp + sizeof(tmp);
+        do {
+            *--p = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        const size_t length = static_cast<size_t>(tmp + sizeof(tmp) - p);
+        ::memcpy(out, p, length);
+        return length;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    /** @brief Formats a float with the fewest significant digits that parse back to it.
+     *
+     *  Candidates of increasing length are rounded from the exact value and accepted as
+     *  soon as they fall into the rounding interval of the float. Since a double has more
+     *  than twice the precision of a float, this test is exact up to a tiny safety margin,
+     *  nine digits always suffice.
+     *  @param out Receives the text, at least 32 bytes. No terminating zero is added.
+     *  @return The number of characters written. */
+    static size_t FormatFloat(float value, char *out) {
+        if (value != value) {
+            return CopyLiteral(out, "nan");
+        }
+        const bool negative = std::signbit(value);
+        const float f = negative ? -value : value;
+        if (f == std::numeric_limits<float>::infinity()) {
+            return CopyLiteral(out, negative ? "-inf" : "inf");
+        }
+        if (f == 0.0f) {
+            return CopyLiteral(out, negative ? "-0" : "0");
+        }
+
+        const double x = f;
+        const float up = std::nextafter(f, std::numeric_limits<float>::infinity());
+        const double down = std::nextafter(f, 0.0f);
+        const double lo = (x + down) * 0.5;
+        const double hi = (up == std::numeric_limits<float>::infinity()) ? x + (x - down) * 0.5 : (x + up) * 0.5;
+
+        int exponent = static_cast<int>(std::floor(std::log10(x)));
+        for (int numDigits = 1; numDigits <= 9; ++numDigits) {
+            const int scale = numDigits - 1 - exponent;
+            unsigned long long digits = static_cast<unsigned long long>(std::llround(Scale(x, scale)));
+            if (digits >= Pow10(numDigits)) {
+                // leading digit estimate was too low or rounding carried over, retry
+                ++exponent;
+                --numDigits;
+                continue;
+            }
+            if (digits < Pow10(numDigits - 1)) {
+                --exponent;
+                --numDigits;
+                continue;
+            }
+            const double candidate = Scale(static_cast<double>(digits), -scale);
+            const double margin = candidate * 1e-14;
+            if (numDigits == 9 || (candidate - margin > lo && candidate + margin < hi)) {
+                int length = numDigits;
+                while (length > 1 && digits % 10 == 0) {
+                    digits /= 10;
+                    --length;
+                }
+                return FormatDecimal(out, negative, digits, length, exponent);
+            }
+        }
+        // not reached
+        return CopyLiteral(out, "0");
+    }
+
+    // --------------------------------------------------------------------------------------------
+    /** @brief Formats a double with the fewest significant digits (15 to 17) that parse back to it.
+     *  @param out Receives the text, at least 32 bytes. No terminating zero is added.
+     *  @return The number of characters written. */
+    static size_t FormatDouble(double value, char *out) {
+        if (value != value) {
+            return CopyLiteral(out, "nan");
+        }
+        if (value == std::numeric_limits<double>::infinity()) {
+            return CopyLiteral(out, "inf");
+        }
+        if (value == -std::numeric_limits<double>::infinity()) {
+            return CopyLiteral(out, "-inf");
+        }
+        if (value == 0.0) {
+            return CopyLiteral(out, std::signbit(value) ? "-0" : "0");
+        }
+
+        int length = 0;
+        for (int precision = 15; precision <= 17; ++precision) {
+            length = ::snprintf(out, 32, "%.*g", precision, value);
+            // snprintf and strtod agree on the locale, so the round-trip check is valid
+            if (precision == 17 || ::strtod(out, nullptr) == value) {
+                break;
+            }
+        }
+        const char point = *::localeconv()->decimal_point;
+        if (point != '.') {
+            char *p = static_cast<char *>(::memchr(out, point, static_cast<size_t>(length)));
+            if (p) {
+                *p = '.';
+            }
+        }
+        return static_cast<size_t>(length);
+    }
+
+private:
+    TextWriter(const TextWriter &);
+    TextWriter &operator=(const TextWriter &);
+
+    void CheckFlush() {
+        if (mStream && mBuffer.length() >= mChunkSize) {
+            Flush();
+        }
+    }
+
+    void WriteToStream(const char *data, size_t length) {
+        if (mStream->Write(data, length, 1) == 0) {
+            throw DeadlyExportError("failed to write to the output stream");
+        }
+        mFlushed += length;
+    }
+
+    template <typename T>
+    TextWriter &WriteSigned(T value) {
+        char tmp[24];
+        size_t length = 0;
+        unsigned long long magnitude = static_cast<unsigned long long>(value);
+        if (value < 0) {
+            tmp[length++] = '-';
+            magnitude = 0ull - magnitude;
+        }
+        length += FormatUnsigned(magnitude, tmp + length);
+        Write(tmp, length);
+        return *this;
+    }
+
+    template <typename T>
+    TextWriter &WriteUnsigned(T value) {
+        char tmp[24];
+        Write(tmp, FormatUnsigned(value, tmp));
+        return *this;
+    }
+
+    static size_t CopyLiteral(char *out, const char *literal) {
+        const size_t length = ::strlen(literal);
+        ::memcpy(out, literal, length);
+        return length;
+    }
+
+    static unsigned long long Pow10(int n) {
+        static const unsigned long long table[] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+            100000000ull, 1000000000ull, 10000000000ull
+        };
+        return table[n];
+    }
+
+    /// Returns x * 10^n for the exponent range needed by float values.
+    static double Scale(double x, int n) {
+        static const double table[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+            1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23,
+            1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31,
+            1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38, 1e39,
+            1e40, 1e41, 1e42, 1e43, 1e44, 1e45, 1e46, 1e47,
+            1e48, 1e49, 1e50, 1e51, 1e52, 1e53, 1e54, 1e55,
+            1e56, 1e57, 1e58, 1e59, 1e60, 1e61, 1e62, 1e63
+        };
+        return n >= 0 ? x * table[n] : x / table[-n];
+    }
+
+    /// Writes digits * 10^(exponent - numDigits + 1), the way printf's %g would.
+    static size_t FormatDecimal(char *out, bool negative, unsigned long long digits, int numDigits, int exponent) {
+        char d[20];
+        for (int i = numDigits - 1; i >= 0; --i) {
+            d[i] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+
+        char *p = out;
+        if (negative) {
+            *p++ = '-';
+        }
+        if (exponent >= -4 && exponent < 9) {
+            if (exponent >= 0) {
+                for (int i = 0; i <= exponent; ++i) {
+                    *p++ = i < numDigits ? d[i] : '0';
+                }
+                if (numDigits > exponent + 1) {
+                    *p++ = '.';
+                    for (int i = exponent + 1; i < numDigits; ++i) {
+                        *p++ = d[i];
+                    }
+                }
+            } else {
+                *p++ = '0';
+                *p++ = '.';
+                for (int i = exponent + 1; i < 0; ++i) {
+                    *p++ = '0';
+                }
+                for (int i = 0; i < numDigits; ++i) {
+                    *p++ = d[i];
+                }
+            }
+        } else {
+            *p++ = d[0];
+            if (numDigits > 1) {
+                *p++ = '.';
+                for (int i = 1; i < numDigits; ++i) {
+                    *p++ = d[i];
+                }
+            }
+            *p++ = 'e';
+            *p++ = exponent < 0 ? '-' : '+';
+            const int e = exponent < 0 ? -exponent : exponent;
+            if (e < 10) {
+                *p++ = '0';
+            }
+            p += FormatUnsigned(static_cast<unsigned long long>(e), p);
+        }
+        return static_cast<size_t>(p - out);
+    }
+
+private:
+    IOStream *mStream;
+    size_t mChunkSize;
+    size_t mFlushed;
+    std::string mBuffer;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Formats count independent items, possibly in parallel, and appends them to out in order.
+ *
+ *  Items are formatted in blocks into temporary in-memory writers by up to numThreads
+ *  threads. Only a bounded number of blocks is kept in memory at any time.
+ *
+ *  @param format Callable taking a TextWriter& to write to and the item index as size_t. */
+template <typename Func>
+inline void FormatParallel(TextWriter &out, unsigned int numThreads, size_t count, Func format) {
+    static const size_t BlockSize = 4096;
+    if (numThreads <= 1 || count < 2 * BlockSize) {
+        for (size_t i = 0; i < count; ++i) {
+            format(out, i);
+        }
+        return;
+    }
+
+    const size_t numBlocks = (count + BlockSize - 1) / BlockSize;
+    const size_t blocksPerRound = std::min(numBlocks, static_cast<size_t>(numThreads) * 4);
+    std::unique_ptr<TextWriter[]> blocks(new TextWriter[blocksPerRound]);
+    for (size_t first = 0; first < numBlocks; first += blocksPerRound) {
+        const size_t n = std::min(blocksPerRound, numBlocks - first);
+        ParallelFor(numThreads, n, [&](size_t b) {
+            TextWriter &block = blocks[b];
+            block.Clear();
+            const size_t begin = (first + b) * BlockSize;
+            const size_t end = std::min(count, begin + BlockSize);
+            for (size_t i = begin; i < end; ++i) {
+                format(block, i);
+            }
+        });
+        for (size_t b = 0; b < n; ++b) {
+            out.Append(blocks[b]);
+        }
+    }
+}
+
+} // Namespace Assimp
+
+#endif // AI_TEXTWRITER_H_INC
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <assimp/scene.h>
 
+#include <vector>
+
 aiNode::aiNode()
 : mName("")
 , mParent(nullptr)
@@ -66,12 +68,26 @@ aiNode::aiNode(const std::string& name)
 
 /** Destructor */
 aiNode::~aiNode() {
-    // delete all children recursively
-    // to make sure we won't crash if the data is invalid ...
-    if (mNumChildren && mChildren)
-    {
-        for (unsigned int a = 0; a < mNumChildren; a++)
-            delete mChildren[a];
+    // Delete the subtree with an explicit stack rather than recursively,
+    // deep hierarchies (long bone chains, flattened scene graphs) would
+    // otherwise overflow the call stack. Every node is detached from its
+    // children before it is deleted, so each destructor runs exactly once.
+    // Bail out on invalid data to make sure we won't crash.
+    std::vector<aiNode*> stack;
+    if (mNumChildren && mChildren) {
+        stack.assign(mChildren, mChildren + mNumChildren);
+    }
+    while (!stack.empty()) {
+        aiNode *node = stack.back();
+        stack.pop_back();
+        if (nullptr == node) {
+            continue;
+        }
+        if (node->mNumChildren && node->mChildren) {
+            stack.insert(stack.end(), node->mChildren, node->mChildren + node->mNumChildren);
+        }
+        node->mNumChildren = 0;
+        delete node;
     }
     delete[] mChildren;
     delete[] mMeshes;
@@ -52,8 +52,123 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <unordered_map>
+#include <vector>
+
 using namespace Assimp;
 
+namespace {
+
+// Materials with fewer properties are searched linearly, which beats hashing them
+static const unsigned int MinPropertiesForIndex = 16;
+
+// ------------------------------------------------------------------------------------------------
+// Hash index over the property keys of a material, held in aiMaterial::mPrivate. It is only
+// written by the functions which change the property list through the material, so lookups
+// need no locking. Code which writes mProperties directly changes the array or the property
+// count; the index no longer matches then and lookups search linearly until it is rebuilt.
+struct MaterialIndex {
+    MaterialIndex() :
+            mProperties(nullptr), mNumProperties(0), mPositions() {
+        // empty
+    }
+
+    // the property list the index was built for
+    const aiMaterialProperty *const *mProperties;
+    unsigned int mNumProperties;
+
+    // key hash -> positions of the properties with that key, ascending
+    std::unordered_map<uint32_t, std::vector<unsigned int>> mPositions;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Returns the index of a material if it matches the current property list, nullptr otherwise.
+const MaterialIndex *GetMaterialIndex(const aiMaterial *pMat) {
+    const MaterialIndex *materialIndex = static_cast<const MaterialIndex *>(pMat->mPrivate);
+    if (nullptr == materialIndex || materialIndex->mProperties != pMat->mProperties ||
+            materialIndex->mNumProperties != pMat->mNumProperties) {
+        return nullptr;
+    }
+    return materialIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsMatchingProperty(const aiMaterialProperty *prop, const char *pKey, unsigned int type, unsigned int index,
+        bool exact) {
+    return prop /* just for safety ... */
+        && 0 == strcmp( prop->mKey.data, pKey )
+        && ((!exact && UINT_MAX == type)  || prop->mSemantic == type) /* UINT_MAX is a wild-card, but this is undocumented :-) */
+        && ((!exact && UINT_MAX == index) || prop->mIndex == index);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the position of the first matching property, UINT_MAX if there is none. Unless exact
+// is set, UINT_MAX for type or index matches any value.
+unsigned int FindMaterialProperty(const aiMaterial *pMat, const char *pKey, unsigned int type, unsigned int index,
+        bool exact) {
+    const MaterialIndex *materialIndex = GetMaterialIndex(pMat);
+    if (nullptr == materialIndex) {
+        for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+            if (IsMatchingProperty(pMat->mProperties[i], pKey, type, index, exact)) {
+                return i;
+            }
+        }
+        return UINT_MAX;
+    }
+
+    std::unordered_map<uint32_t, std::vector<unsigned int>>::const_iterator it = materialIndex->mPositions.find(SuperFastHash(pKey));
+    if (it != materialIndex->mPositions.end()) {
+        for (unsigned int i : it->second) {
+            if (IsMatchingProperty(pMat->mProperties[i], pKey, type, index, exact)) {
+                return i;
+            }
+        }
+    }
+    return UINT_MAX;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Adds the last property of a material to its index. oldProperties and oldNumProperties describe
+// the property list before it was appended to.
+void OnMaterialPropertyAppended(aiMaterial *pMat, const aiMaterialProperty *const *oldProperties,
+        unsigned int oldNumProperties) {
+    MaterialIndex *materialIndex = static_cast<MaterialIndex *>(pMat->mPrivate);
+    if (nullptr == materialIndex || materialIndex->mProperties != oldProperties ||
+            materialIndex->mNumProperties != oldNumProperties) {
+        // none yet or out of date
+        UpdateMaterialIndex(pMat);
+        return;
+    }
+    const unsigned int last = pMat->mNumProperties - 1;
+    materialIndex->mPositions[SuperFastHash(pMat->mProperties[last]->mKey.data)].push_back(last);
+    materialIndex->mProperties = pMat->mProperties;
+    materialIndex->mNumProperties = pMat->mNumProperties;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::UpdateMaterialIndex(aiMaterial *pMat) {
+    MaterialIndex *materialIndex = static_cast<MaterialIndex *>(pMat->mPrivate);
+    if (pMat->mNumProperties < MinPropertiesForIndex) {
+        delete materialIndex;
+        pMat->mPrivate = nullptr;
+        return;
+    }
+
+    if (nullptr == materialIndex) {
+        pMat->mPrivate = materialIndex = new MaterialIndex();
+    }
+    materialIndex->mPositions.clear();
+    for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+        if (nullptr != pMat->mProperties[i]) {
+            materialIndex->mPositions[SuperFastHash(pMat->mProperties[i]->mKey.data)].push_back(i);
+        }
+    }
+    materialIndex->mProperties = pMat->mProperties;
+    materialIndex->mNumProperties = pMat->mNumProperties;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
@@ -66,21 +181,10 @@ aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
     ai_assert( pKey != NULL );
     ai_assert( pPropOut != NULL );
 
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
-    for ( unsigned int i = 0; i < pMat->mNumProperties; ++i ) {
-        aiMaterialProperty* prop = pMat->mProperties[i];
-
-        if (prop /* just for safety ... */
-            && 0 == strcmp( prop->mKey.data, pKey )
-            && (UINT_MAX == type  || prop->mSemantic == type) /* UINT_MAX is a wild-card, but this is undocumented :-) */
-            && (UINT_MAX == index || prop->mIndex == index))
-        {
-            *pPropOut = pMat->mProperties[i];
-            return AI_SUCCESS;
-        }
+    const unsigned int i = FindMaterialProperty(pMat, pKey, type, index, false);
+    if (UINT_MAX != i) {
+        *pPropOut = pMat->mProperties[i];
+        return AI_SUCCESS;
     }
     *pPropOut = NULL;
     return AI_FAILURE;
@@ -401,7 +505,8 @@ static const unsigned int DefaultNumAllocated = 5;
 aiMaterial::aiMaterial() 
 : mProperties( nullptr )
 , mNumProperties( 0 )
-, mNumAllocated( DefaultNumAllocated ) {
+, mNumAllocated( DefaultNumAllocated )
+, mPrivate( nullptr ) {
     // Allocate 5 entries by default
     mProperties = new aiMaterialProperty*[ DefaultNumAllocated ];
 }
@@ -431,6 +536,7 @@ void aiMaterial::Clear()
         AI_DEBUG_INVALIDATE_PTR(mProperties[i]);
     }
     mNumProperties = 0;
+    UpdateMaterialIndex(this);
 
     // The array remains allocated, we just invalidated its contents
 }
@@ -440,25 +546,21 @@ aiReturn aiMaterial::RemoveProperty ( const char* pKey,unsigned int type, unsign
 {
     ai_assert( nullptr != pKey );
 
-    for (unsigned int i = 0; i < mNumProperties;++i) {
-        aiMaterialProperty* prop = mProperties[i];
+    const unsigned int i = FindMaterialProperty(this, pKey, type, index, true);
+    if (UINT_MAX == i) {
+        return AI_FAILURE;
+    }
 
-        if (prop && !strcmp( prop->mKey.data, pKey ) &&
-            prop->mSemantic == type && prop->mIndex == index)
-        {
-            // Delete this entry
-            delete mProperties[i];
+    // Delete this entry
+    delete mProperties[i];
 
-            // collapse the array behind --.
-            --mNumProperties;
-            for (unsigned int a = i; a < mNumProperties;++a)    {
-                mProperties[a] = mProperties[a+1];
-            }
-            return AI_SUCCESS;
-        }
+    // collapse the array behind --. This moves the properties, so the index is rebuilt.
+    --mNumProperties;
+    for (unsigned int a = i; a < mNumProperties;++a)    {
+        mProperties[a] = mProperties[a+1];
     }
-
-    return AI_FAILURE;
+    UpdateMaterialIndex(this);
+    return AI_SUCCESS;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -479,17 +581,7 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     }
 
     // first search the list whether there is already an entry with this key
-    unsigned int iOutIndex( UINT_MAX );
-    for ( unsigned int i = 0; i < mNumProperties; ++i ) {
-        aiMaterialProperty *prop( mProperties[ i ] );
-
-        if (prop /* just for safety */ && !strcmp( prop->mKey.data, pKey ) &&
-            prop->mSemantic == type && prop->mIndex == index){
-
-            delete mProperties[i];
-            iOutIndex = i;
-        }
-    }
+    const unsigned int iOutIndex = FindMaterialProperty(this, pKey, type, index, true);
 
     // Allocate a new material property
     aiMaterialProperty* pcNew = new aiMaterialProperty();
@@ -508,6 +600,7 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     strcpy( pcNew->mKey.data, pKey );
 
     if (UINT_MAX != iOutIndex)  {
+        delete mProperties[iOutIndex];
         mProperties[iOutIndex] = pcNew;
         return AI_SUCCESS;
     }
@@ -532,7 +625,10 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
         mProperties = ppTemp;
     }
     // push back ...
+    const aiMaterialProperty *const *pcOld = mProperties;
+    const unsigned int iOldNum = mNumProperties;
     mProperties[mNumProperties++] = pcNew;
+    OnMaterialPropertyAppended(this, pcOld, iOldNum);
 
     return AI_SUCCESS;
 }
@@ -629,4 +725,5 @@ void aiMaterial::CopyPropertyList(aiMaterial* pcDest,
         prop->mData = new char[propSrc->mDataLength];
         memcpy(prop->mData,propSrc->mData,prop->mDataLength);
     }
+    UpdateMaterialIndex(pcDest);
 }
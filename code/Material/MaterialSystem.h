@@ -66,6 +66,12 @@ namespace Assimp    {
  */
 uint32_t ComputeMaterialHash(const aiMaterial* mat, bool includeMatName = false);
 
+// ------------------------------------------------------------------------------
+/** Rebuilds the key index of a material. Call this after writing the property
+ *  list of a material directly, lookups search it linearly until then.
+ */
+void UpdateMaterialIndex(aiMaterial* mat);
+
 
 } // ! namespace Assimp
 
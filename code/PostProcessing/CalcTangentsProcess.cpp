@@ -89,6 +89,12 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX,0);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step works on each mesh on its own.
+bool CalcTangentsProcess::IsPerMeshStep() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void CalcTangentsProcess::Execute( aiScene* pScene)
@@ -99,6 +105,10 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 
     bool bHas = false;
     for ( unsigned int a = 0; a < pScene->mNumMeshes; a++ ) {
+        if (!IsMeshSelected(a)) {
+            continue;
+        }
+        ThrowIfCancelled();
         if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
     }
 
@@ -65,6 +65,9 @@ public:
     // Check whether step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "FindDegeneratesProcess"; }
+
     // -------------------------------------------------------------------
     // Execute step on a given scene
     void Execute( aiScene* pScene);
@@ -119,6 +119,9 @@ public:
     // Check whether step is active in given flags combination
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "FindInstancesProcess"; }
+
     // -------------------------------------------------------------------
     // Execute step on a given scene
     void Execute( aiScene* pScene);
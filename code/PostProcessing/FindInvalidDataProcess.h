@@ -71,6 +71,9 @@ public:
     //
     bool IsActive(unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "FindInvalidDataProcess"; }
+
     // -------------------------------------------------------------------
     // Setup import settings
     void SetupProperties(const Importer *pImp);
@@ -61,6 +61,10 @@ bool GenBoundingBoxesProcess::IsActive(unsigned int pFlags) const {
     return 0 != ( pFlags & aiProcess_GenBoundingBoxes );
 }
 
+bool GenBoundingBoxesProcess::IsPerMeshStep() const {
+    return true;
+}
+
 void checkMesh(aiMesh* mesh, aiVector3D& min, aiVector3D& max) {
     ai_assert(nullptr != mesh);
 
@@ -99,7 +103,7 @@ void GenBoundingBoxesProcess::Execute(aiScene* pScene) {
 
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
         aiMesh* mesh = pScene->mMeshes[i];
-        if (nullptr == mesh) {
+        if (nullptr == mesh || !IsMeshSelected(i)) {
             continue;
         }
 
@@ -65,6 +65,11 @@ public:
     ~GenBoundingBoxesProcess();
     /// Will return true, if aiProcess_GenBoundingBoxes is defined.
     bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "GenBoundingBoxesProcess"; }
+    /// Will return true, the bounding box of each mesh is computed on its own.
+    bool IsPerMeshStep() const override;
     /// The execution callback.
     void Execute(aiScene* pScene) override;
 };
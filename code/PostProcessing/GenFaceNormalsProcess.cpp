@@ -77,6 +77,12 @@ bool GenFaceNormalsProcess::IsActive( unsigned int pFlags) const {
     return  (pFlags & aiProcess_GenNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step works on each mesh on its own.
+bool GenFaceNormalsProcess::IsPerMeshStep() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenFaceNormalsProcess::Execute( aiScene* pScene) {
@@ -88,6 +94,9 @@ void GenFaceNormalsProcess::Execute( aiScene* pScene) {
 
     bool bHas = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)   {
+        if (!IsMeshSelected(a)) {
+            continue;
+        }
         if(this->GenMeshFaceNormals( pScene->mMeshes[a])) {
             bHas = true;
         }
@@ -69,6 +69,13 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "GenFaceNormalsProcess"; }
+
+    // -------------------------------------------------------------------
+    /** Returns true, the step processes each mesh on its own. */
+    bool IsPerMeshStep() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -85,6 +85,12 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,(ai_real)175.0),(ai_real)0.0));
 }
 
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step works on each mesh on its own.
+bool GenVertexNormalsProcess::IsPerMeshStep() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::Execute( aiScene* pScene)
@@ -97,6 +103,10 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
 
     bool bHas = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        if (!IsMeshSelected(a)) {
+            continue;
+        }
+        ThrowIfCancelled();
         if(GenMeshVertexNormals( pScene->mMeshes[a],a))
             bHas = true;
     }
@@ -212,14 +222,27 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
     // the effect, this one is the most straightforward one.
     else    {
         const ai_real fLimit = std::cos(configMaxAngle);
-        for (unsigned int i = 0; i < pMesh->mNumVertices;++i)   {
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
 
+        // Every vertex is queried, so get the vertices sharing each of them in one go.
+        // Large clusters of coincident vertices make the results grow quadratically,
+        // beyond 64 per vertex on average the vertices are queried one by one instead.
+        std::vector<size_t> offsets;
+        const bool foundAll = vertexFinder->FindAllPositions( posEpsilon, offsets, verticesFound,
+                size_t(64) * pMesh->mNumVertices);
+        for (unsigned int i = 0; i < pMesh->mNumVertices;++i)   {
             aiVector3D vr = pMesh->mNormals[i];
 
+            size_t begin = 0, end;
+            if (foundAll) {
+                begin = offsets[i];
+                end = offsets[i+1];
+            } else {
+                vertexFinder->FindPositions( pMesh->mVertices[i], posEpsilon, verticesFound);
+                end = verticesFound.size();
+            }
+
             aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
+            for (size_t a = begin; a < end; ++a) {
                 aiVector3D v = pMesh->mNormals[verticesFound[a]];
 
                 // Check whether the angle between the two normals is not too large.
@@ -72,6 +72,13 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "GenVertexNormalsProcess"; }
+
+    // -------------------------------------------------------------------
+    /** Returns true, the step processes each mesh on its own. */
+    bool IsPerMeshStep() const;
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -0,0 +1,516 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post processing step to build bounding
+ *  volume hierarchies for meshes and mesh instances.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENERATEBVH_PROCESS
+
+#include "PostProcessing/GenerateBVHProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+using namespace Assimp;
+
+namespace {
+
+// Minimum number of primitives of a subtree which is built as a task of its own
+static const size_t MinTaskSize = 1024;
+
+// Cost of a traversal step relative to a primitive test, used by the surface area heuristic
+static const ai_real TraversalCost = ai_real(1.0);
+
+// ------------------------------------------------------------------------------------------------
+struct Primitive {
+    aiAABB mBox;
+    aiVector3D mCentroid;
+    unsigned int mIndex;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct Bin {
+    aiAABB mBox;
+    unsigned int mCount;
+};
+
+// ------------------------------------------------------------------------------------------------
+inline aiAABB EmptyBox() {
+    const ai_real m = std::numeric_limits<ai_real>::max();
+    return aiAABB(aiVector3D(m, m, m), aiVector3D(-m, -m, -m));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void Grow(aiAABB &box, const aiVector3D &p) {
+    box.mMin = aiVector3D(std::min(box.mMin.x, p.x), std::min(box.mMin.y, p.y), std::min(box.mMin.z, p.z));
+    box.mMax = aiVector3D(std::max(box.mMax.x, p.x), std::max(box.mMax.y, p.y), std::max(box.mMax.z, p.z));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void Grow(aiAABB &box, const aiAABB &other) {
+    Grow(box, other.mMin);
+    Grow(box, other.mMax);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Half the surface area of a box, 0 for empty boxes
+inline ai_real HalfArea(const aiAABB &box) {
+    const aiVector3D d = box.mMax - box.mMin;
+    if (d.x < 0 || d.y < 0 || d.z < 0) {
+        return 0;
+    }
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds one hierarchy. The upper levels are built first, the subtrees below them are
+// collected as tasks which can be built concurrently, each one into its own node array.
+class HierarchyBuilder {
+public:
+    struct Task {
+        unsigned int mNode;
+        unsigned int mBegin;
+        unsigned int mEnd;
+        std::vector<aiBVHNode> mNodes;
+    };
+
+    HierarchyBuilder(std::vector<Primitive> &prims, unsigned int maxLeafSize, unsigned int numBins) :
+            mMaxLeafSize(std::max(1u, maxLeafSize)),
+            mNumBins(std::max(2u, std::min(numBins, 256u))) {
+        mPrims.swap(prims);
+    }
+
+    // Builds the upper levels, subtrees with at most taskSize primitives are left to
+    // BuildTask(). A taskSize of 0 builds the whole hierarchy at once.
+    void BuildUpperLevels(size_t taskSize) {
+        mNodes.resize(1);
+        Subdivide(mNodes, 0, 0, static_cast<unsigned int>(mPrims.size()), taskSize);
+    }
+
+    std::vector<Task> &GetTasks() {
+        return mTasks;
+    }
+
+    // Builds the subtree of a task. Tasks work on disjoint ranges, so they may run concurrently.
+    void BuildTask(Task &task) {
+        task.mNodes.resize(1);
+        Subdivide(task.mNodes, 0, task.mBegin, task.mEnd, 0);
+    }
+
+    // Splices the subtrees of all tasks into the node array and returns the hierarchy
+    aiBVH *Finish() {
+        for (Task &task : mTasks) {
+            const unsigned int base = static_cast<unsigned int>(mNodes.size()) - 1;
+            for (aiBVHNode &node : task.mNodes) {
+                if (!node.IsLeaf()) {
+                    node.mFirst += base;
+                }
+            }
+            mNodes[task.mNode] = task.mNodes[0];
+            mNodes.insert(mNodes.end(), task.mNodes.begin() + 1, task.mNodes.end());
+        }
+        mTasks.clear();
+
+        aiBVH *bvh = new aiBVH();
+        bvh->mNumNodes = static_cast<unsigned int>(mNodes.size());
+        bvh->mNodes = new aiBVHNode[bvh->mNumNodes];
+        std::copy(mNodes.begin(), mNodes.end(), bvh->mNodes);
+        bvh->mNumPrimitives = static_cast<unsigned int>(mPrims.size());
+        bvh->mPrimitives = new unsigned int[bvh->mNumPrimitives];
+        for (unsigned int i = 0; i < bvh->mNumPrimitives; ++i) {
+            bvh->mPrimitives[i] = mPrims[i].mIndex;
+        }
+        return bvh;
+    }
+
+private:
+    struct Range {
+        unsigned int mNode;
+        unsigned int mBegin;
+        unsigned int mEnd;
+    };
+
+    // Builds the subtree below nodes[root] over the primitives [begin, end)
+    void Subdivide(std::vector<aiBVHNode> &nodes, unsigned int root, unsigned int begin, unsigned int end, size_t taskSize) {
+        std::vector<Bin> bins(mNumBins);
+        std::vector<Range> stack;
+        stack.push_back(Range{ root, begin, end });
+        while (!stack.empty()) {
+            const Range r = stack.back();
+            stack.pop_back();
+
+            aiAABB box = EmptyBox(), centroids = EmptyBox();
+            for (unsigned int i = r.mBegin; i < r.mEnd; ++i) {
+                Grow(box, mPrims[i].mBox);
+                Grow(centroids, mPrims[i].mCentroid);
+            }
+            nodes[r.mNode].mAABB = box;
+
+            const unsigned int count = r.mEnd - r.mBegin;
+            if (taskSize && count <= taskSize) {
+                Task task;
+                task.mNode = r.mNode;
+                task.mBegin = r.mBegin;
+                task.mEnd = r.mEnd;
+                mTasks.push_back(task);
+                continue;
+            }
+
+            unsigned int mid = 0;
+            if (!FindSplit(r.mBegin, r.mEnd, box, centroids, bins, mid)) {
+                nodes[r.mNode].mFirst = r.mBegin;
+                nodes[r.mNode].mCount = count;
+                continue;
+            }
+
+            // children are stored next to each other, the left one is processed first
+            const unsigned int left = static_cast<unsigned int>(nodes.size());
+            nodes.resize(nodes.size() + 2);
+            nodes[r.mNode].mFirst = left;
+            nodes[r.mNode].mCount = 0;
+            stack.push_back(Range{ left + 1, mid, r.mEnd });
+            stack.push_back(Range{ left, r.mBegin, mid });
+        }
+    }
+
+    // Partitions [begin, end) along the cheapest binned split. Returns false if a leaf is cheaper.
+    bool FindSplit(unsigned int begin, unsigned int end, const aiAABB &box, const aiAABB &centroids,
+            std::vector<Bin> &bins, unsigned int &mid) {
+        const unsigned int count = end - begin;
+        if (count <= 1) {
+            return false;
+        }
+
+        ai_real bestCost = std::numeric_limits<ai_real>::max();
+        int bestAxis = -1;
+        unsigned int bestSplit = 0;
+        std::vector<ai_real> rightCost(mNumBins);
+        for (int axis = 0; axis < 3; ++axis) {
+            const ai_real extent = centroids.mMax[axis] - centroids.mMin[axis];
+            if (!(extent > 0)) {
+                continue;
+            }
+            const ai_real scale = mNumBins / extent;
+            for (Bin &bin : bins) {
+                bin.mBox = EmptyBox();
+                bin.mCount = 0;
+            }
+            for (unsigned int i = begin; i < end; ++i) {
+                Bin &bin = bins[BinIndex(mPrims[i].mCentroid[axis], centroids.mMin[axis], scale)];
+                Grow(bin.mBox, mPrims[i].mBox);
+                ++bin.mCount;
+            }
+
+            // rightCost[s] is the cost of the bins s .. n-1
+            aiAABB acc = EmptyBox();
+            unsigned int accCount = 0;
+            for (unsigned int s = mNumBins - 1; s > 0; --s) {
+                Grow(acc, bins[s].mBox);
+                accCount += bins[s].mCount;
+                rightCost[s] = accCount ? accCount * HalfArea(acc) : ai_real(-1);
+            }
+
+            acc = EmptyBox();
+            accCount = 0;
+            for (unsigned int s = 1; s < mNumBins; ++s) {
+                Grow(acc, bins[s - 1].mBox);
+                accCount += bins[s - 1].mCount;
+                if (0 == accCount || rightCost[s] < 0) {
+                    continue;
+                }
+                const ai_real cost = accCount * HalfArea(acc) + rightCost[s];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = s;
+                }
+            }
+        }
+
+        if (bestAxis < 0) {
+            // all centroids coincide, only the leaf size can force a split
+            if (count <= mMaxLeafSize) {
+                return false;
+            }
+            mid = begin + count / 2;
+            return true;
+        }
+
+        const ai_real area = HalfArea(box);
+        if (count <= mMaxLeafSize && TraversalCost * area + bestCost >= count * area) {
+            return false;
+        }
+
+        const ai_real origin = centroids.mMin[bestAxis];
+        const ai_real scale = mNumBins / (centroids.mMax[bestAxis] - origin);
+        const unsigned int numBins = mNumBins;
+        Primitive *first = mPrims.data() + begin;
+        mid = begin + static_cast<unsigned int>(std::partition(first, mPrims.data() + end,
+                [bestAxis, bestSplit, origin, scale, numBins](const Primitive &p) {
+                    return BinIndex(p.mCentroid[bestAxis], origin, scale, numBins) < bestSplit;
+                }) - first);
+        return true;
+    }
+
+    unsigned int BinIndex(ai_real value, ai_real origin, ai_real scale) const {
+        return BinIndex(value, origin, scale, mNumBins);
+    }
+
+    static unsigned int BinIndex(ai_real value, ai_real origin, ai_real scale, unsigned int numBins) {
+        const ai_real b = (value - origin) * scale;
+        return b <= 0 ? 0u : std::min(numBins - 1, static_cast<unsigned int>(b));
+    }
+
+    std::vector<Primitive> mPrims;
+    std::vector<aiBVHNode> mNodes;
+    std::vector<Task> mTasks;
+    unsigned int mMaxLeafSize;
+    unsigned int mNumBins;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Subtrees up to this size are built as tasks, 0 if there is only one thread
+size_t GetTaskSize(size_t numPrimitives, unsigned int numThreads) {
+    if (numThreads <= 1) {
+        return 0;
+    }
+    return std::max(MinTaskSize, numPrimitives / (numThreads * 4));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the hierarchies of all builders, sharing the threads between them
+void BuildAll(std::vector<std::unique_ptr<HierarchyBuilder>> &builders, unsigned int numThreads) {
+    typedef std::pair<HierarchyBuilder *, HierarchyBuilder::Task *> TaskRef;
+    std::vector<TaskRef> tasks;
+    for (std::unique_ptr<HierarchyBuilder> &builder : builders) {
+        if (builder) {
+            for (HierarchyBuilder::Task &task : builder->GetTasks()) {
+                tasks.push_back(TaskRef(builder.get(), &task));
+            }
+        }
+    }
+
+    // big subtrees first, so they don't end up as the last item of a worker
+    std::sort(tasks.begin(), tasks.end(), [](const TaskRef &a, const TaskRef &b) {
+        return a.second->mEnd - a.second->mBegin > b.second->mEnd - b.second->mBegin;
+    });
+    ParallelFor(numThreads, tasks.size(), [&](size_t i) {
+        tasks[i].first->BuildTask(*tasks[i].second);
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+aiAABB TransformBox(const aiAABB &box, const aiMatrix4x4 &m) {
+    aiAABB out = EmptyBox();
+    for (unsigned int c = 0; c < 8; ++c) {
+        const aiVector3D corner((c & 1) ? box.mMax.x : box.mMin.x,
+                (c & 2) ? box.mMax.y : box.mMin.y,
+                (c & 4) ? box.mMax.z : box.mMin.z);
+        Grow(out, m * corner);
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CollectInstances(const aiScene *scene, const aiNode *node, const aiMatrix4x4 &parent,
+        std::vector<aiBVHInstance> &instances) {
+    const aiMatrix4x4 transform = parent * node->mTransformation;
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        if (node->mMeshes[i] < scene->mNumMeshes && scene->mMeshes[node->mMeshes[i]]->HasBVH()) {
+            aiBVHInstance instance;
+            instance.mMeshIndex = node->mMeshes[i];
+            instance.mTransformation = transform;
+            instances.push_back(instance);
+        }
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectInstances(scene, node->mChildren[i], transform, instances);
+    }
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenerateBVHProcess::GenerateBVHProcess() :
+        BaseProcess(),
+        mMaxLeafSize(AI_BVH_DEFAULT_MAX_LEAF_SIZE),
+        mNumBins(AI_BVH_DEFAULT_BINS),
+        mNumThreads(1) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenerateBVHProcess::~GenerateBVHProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateBVHProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateBVHProcess::IsExtActive(unsigned int pExtFlags) const {
+    return 0 != (pExtFlags & aiProcessExt_GenerateBVH);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateBVHProcess::SetupProperties(const Importer *pImp) {
+    mMaxLeafSize = static_cast<unsigned int>(std::max(1, pImp->GetPropertyInteger(AI_CONFIG_PP_BVH_MAX_LEAF_SIZE, AI_BVH_DEFAULT_MAX_LEAF_SIZE)));
+    mNumBins = static_cast<unsigned int>(std::max(2, std::min(pImp->GetPropertyInteger(AI_CONFIG_PP_BVH_BINS, AI_BVH_DEFAULT_BINS), 256)));
+    mNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateBVHProcess::Execute(aiScene *pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("GenerateBVHProcess skipped; there is nothing to do");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("GenerateBVHProcess begin");
+
+    // face bounds and upper levels of each mesh
+    std::vector<std::unique_ptr<HierarchyBuilder>> builders(pScene->mNumMeshes);
+    ParallelFor(mNumThreads, pScene->mNumMeshes, [&](size_t m) {
+        aiMesh *mesh = pScene->mMeshes[m];
+        delete mesh->mBVH;
+        mesh->mBVH = nullptr;
+        if (!mesh->HasPositions()) {
+            return;
+        }
+
+        std::vector<Primitive> prims;
+        prims.reserve(mesh->mNumFaces);
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const aiFace &face = mesh->mFaces[f];
+            if (0 == face.mNumIndices) {
+                continue;
+            }
+            Primitive prim;
+            prim.mBox = EmptyBox();
+            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                Grow(prim.mBox, mesh->mVertices[face.mIndices[i]]);
+            }
+            prim.mCentroid = (prim.mBox.mMin + prim.mBox.mMax) * ai_real(0.5);
+            prim.mIndex = f;
+            prims.push_back(prim);
+        }
+        if (prims.empty()) {
+            return;
+        }
+
+        const size_t taskSize = GetTaskSize(prims.size(), mNumThreads);
+        builders[m].reset(new HierarchyBuilder(prims, mMaxLeafSize, mNumBins));
+        builders[m]->BuildUpperLevels(taskSize);
+    });
+
+    BuildAll(builders, mNumThreads);
+
+    unsigned int numNodes = 0;
+    for (unsigned int m = 0; m < pScene->mNumMeshes; ++m) {
+        if (builders[m]) {
+            pScene->mMeshes[m]->mBVH = builders[m]->Finish();
+            numNodes += pScene->mMeshes[m]->mBVH->mNumNodes;
+            builders[m].reset();
+        }
+    }
+
+    // top-level hierarchy over the instances of the node graph
+    delete pScene->mBVH;
+    delete[] pScene->mBVHInstances;
+    pScene->mBVH = nullptr;
+    pScene->mBVHInstances = nullptr;
+    pScene->mNumBVHInstances = 0;
+
+    std::vector<aiBVHInstance> instances;
+    if (nullptr != pScene->mRootNode) {
+        CollectInstances(pScene, pScene->mRootNode, aiMatrix4x4(), instances);
+    }
+    if (!instances.empty()) {
+        std::vector<aiAABB> boxes;
+        boxes.reserve(instances.size());
+        for (const aiBVHInstance &instance : instances) {
+            const aiBVH *bvh = pScene->mMeshes[instance.mMeshIndex]->mBVH;
+            boxes.push_back(TransformBox(bvh->mNodes[0].mAABB, instance.mTransformation));
+        }
+        pScene->mBVH = Build(boxes, mMaxLeafSize, mNumBins, mNumThreads);
+        pScene->mNumBVHInstances = static_cast<unsigned int>(instances.size());
+        pScene->mBVHInstances = new aiBVHInstance[pScene->mNumBVHInstances];
+        std::copy(instances.begin(), instances.end(), pScene->mBVHInstances);
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_INFO_F("GenerateBVHProcess finished. Mesh nodes: ", numNodes,
+                ", instances: ", instances.size());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBVH *GenerateBVHProcess::Build(const std::vector<aiAABB> &pBoxes, unsigned int pMaxLeafSize,
+        unsigned int pNumBins, unsigned int pNumThreads) {
+    if (pBoxes.empty()) {
+        return nullptr;
+    }
+
+    std::vector<Primitive> prims(pBoxes.size());
+    for (size_t i = 0; i < pBoxes.size(); ++i) {
+        prims[i].mBox = pBoxes[i];
+        prims[i].mCentroid = (pBoxes[i].mMin + pBoxes[i].mMax) * ai_real(0.5);
+        prims[i].mIndex = static_cast<unsigned int>(i);
+    }
+
+    const size_t taskSize = GetTaskSize(prims.size(), pNumThreads);
+    std::vector<std::unique_ptr<HierarchyBuilder>> builders;
+    builders.emplace_back(new HierarchyBuilder(prims, pMaxLeafSize, pNumBins));
+    builders[0]->BuildUpperLevels(taskSize);
+    BuildAll(builders, pNumThreads);
+    return builders[0]->Finish();
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENERATEBVH_PROCESS
@@ -0,0 +1,116 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to build bounding volume hierarchies */
+#pragma once
+#ifndef AI_GENERATEBVHPROCESS_H_INC
+#define AI_GENERATEBVHPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENERATEBVH_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/aabb.h>
+
+#include <vector>
+
+struct aiBVH;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenerateBVHProcess builds a bounding volume hierarchy over the faces
+ *  of each mesh (#aiMesh::mBVH) and one over all mesh instances of the node
+ *  graph (#aiScene::mBVH).
+ *
+ *  Splits are chosen by the surface area heuristic, evaluated over a fixed
+ *  number of bins per axis. The upper levels of each hierarchy are built
+ *  first, the remaining subtrees of all meshes are then built in parallel.
+ */
+class ASSIMP_API GenerateBVHProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenerateBVHProcess();
+
+    /// The class destructor.
+    ~GenerateBVHProcess();
+
+    /// Will return false, the step is enabled via the extended flags only.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "GenerateBVHProcess"; }
+
+    /// Will return true, if aiProcessExt_GenerateBVH is defined.
+    bool IsExtActive(unsigned int pExtFlags) const override;
+
+    /// Reads the leaf size, bin count and threading configuration.
+    void SetupProperties(const Importer *pImp) override;
+
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Builds a hierarchy over a set of boxes.
+     *  @param pBoxes The primitive bounds, primitive i is the box at index i.
+     *  @param pMaxLeafSize Maximum number of primitives per leaf.
+     *  @param pNumBins Number of bins per axis for the split search.
+     *  @param pNumThreads Maximum number of threads to use.
+     *  @return The hierarchy, nullptr if pBoxes is empty. */
+    static aiBVH *Build(const std::vector<aiAABB> &pBoxes, unsigned int pMaxLeafSize,
+            unsigned int pNumBins, unsigned int pNumThreads);
+
+private:
+    //! Maximum number of primitives per leaf
+    unsigned int mMaxLeafSize;
+
+    //! Number of SAH bins per axis
+    unsigned int mNumBins;
+
+    //! Number of worker threads, see AI_CONFIG_GLOB_MULTITHREADING
+    unsigned int mNumThreads;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENERATEBVH_PROCESS
+
+#endif // AI_GENERATEBVHPROCESS_H_INC
@@ -0,0 +1,578 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post processing step to generate levels of detail.
+ * <br>
+ * The simplifier follows Garland and Heckbert, "Surface Simplification Using
+ * Quadric Error Metrics", restricted to half-edge collapses. Collapses are done
+ * in passes: all candidate edges are ranked by cost and the cheapest
+ * independent ones are applied before the candidates are recomputed.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENERATELODS_PROCESS
+
+#include "PostProcessing/GenerateLODsProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+using namespace Assimp;
+
+namespace {
+
+const unsigned int NoBone = std::numeric_limits<unsigned int>::max();
+
+// ------------------------------------------------------------------------------------------------
+// Symmetric 4x4 matrix measuring the squared distance to a set of planes
+struct Quadric {
+    double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+    Quadric() :
+            a2(0), ab(0), ac(0), ad(0), b2(0), bc(0), bd(0), c2(0), cd(0), d2(0) {}
+
+    Quadric(double a, double b, double c, double d) :
+            a2(a * a), ab(a * b), ac(a * c), ad(a * d), b2(b * b), bc(b * c), bd(b * d), c2(c * c), cd(c * d), d2(d * d) {}
+
+    Quadric &operator+=(const Quadric &o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        return *this;
+    }
+
+    double Evaluate(const aiVector3D &p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+                + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+                + c2 * z * z + 2 * cd * z
+                + d2;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Hashes a vertex position by its bit pattern
+struct PositionHash {
+    size_t operator()(const aiVector3D &v) const {
+        ai_real c[3] = { v.x, v.y, v.z };
+        size_t h = 0;
+        for (unsigned int i = 0; i < 3; ++i) {
+            // +0 and -0 compare equal, so they must hash equally
+            if (c[i] == 0) {
+                c[i] = 0;
+            }
+            size_t bits = 0;
+            ::memcpy(&bits, &c[i], std::min(sizeof(bits), sizeof(ai_real)));
+            h ^= bits + 0x9e3779b9 + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Simplification state shared by all levels of a mesh
+class MeshSimplifier {
+public:
+    explicit MeshSimplifier(const aiMesh *mesh);
+
+    bool Simplify(std::vector<unsigned int> &indices, size_t targetTriangles, ai_real maxError);
+
+private:
+    void Classify(const std::vector<unsigned int> &indices);
+    bool Flips(const std::vector<unsigned int> &indices, unsigned int from, unsigned int to) const;
+
+    const aiMesh *mMesh;
+    std::vector<Quadric> mQuadrics;
+    std::vector<unsigned int> mDominantBone;
+    std::vector<bool> mLocked;
+    std::vector<unsigned int> mOffsets;
+    std::vector<unsigned int> mAdjacency;
+    double mScale;
+    bool mInitialized;
+};
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiMesh *mesh) :
+        mMesh(mesh),
+        mQuadrics(mesh->mNumVertices),
+        mDominantBone(mesh->mNumVertices, NoBone),
+        mLocked(mesh->mNumVertices, false),
+        mScale(0),
+        mInitialized(false) {
+    // the dominant bone of each vertex, collapses must not cross bone boundaries
+    std::vector<ai_real> maxWeight(mesh->mNumVertices, 0);
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone *bone = mesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight &weight = bone->mWeights[w];
+            if (weight.mVertexId < mesh->mNumVertices && weight.mWeight > maxWeight[weight.mVertexId]) {
+                maxWeight[weight.mVertexId] = weight.mWeight;
+                mDominantBone[weight.mVertexId] = b;
+            }
+        }
+    }
+
+    // error bounds are relative to the mesh extents
+    aiVector3D min = mesh->mVertices[0], max = mesh->mVertices[0];
+    for (unsigned int i = 1; i < mesh->mNumVertices; ++i) {
+        const aiVector3D &p = mesh->mVertices[i];
+        min.x = std::min(min.x, p.x);
+        min.y = std::min(min.y, p.y);
+        min.z = std::min(min.z, p.z);
+        max.x = std::max(max.x, p.x);
+        max.y = std::max(max.y, p.y);
+        max.z = std::max(max.z, p.z);
+    }
+    mScale = (max - min).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Locks border and seam vertices and computes the initial quadrics
+void MeshSimplifier::Classify(const std::vector<unsigned int> &indices) {
+    const unsigned int numVertices = mMesh->mNumVertices;
+
+    // weld vertices by position, vertices sharing a position are attribute seams
+    std::unordered_map<aiVector3D, unsigned int, PositionHash> positions;
+    positions.reserve(numVertices);
+    std::vector<unsigned int> weld(numVertices);
+    std::vector<unsigned int> weldCount(numVertices, 0);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        weld[i] = positions.insert(std::make_pair(mMesh->mVertices[i], i)).first->second;
+        ++weldCount[weld[i]];
+    }
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        if (weldCount[weld[i]] > 1) {
+            mLocked[i] = true;
+        }
+    }
+
+    // an edge used by exactly one triangle of the welded mesh lies on a border
+    std::unordered_map<uint64_t, unsigned int> edges;
+    edges.reserve(indices.size());
+    for (size_t t = 0; t < indices.size(); t += 3) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const uint64_t a = weld[indices[t + k]], b = weld[indices[t + (k + 1) % 3]];
+            ++edges[a < b ? (a << 32 | b) : (b << 32 | a)];
+        }
+    }
+    std::vector<bool> border(numVertices, false);
+    for (const auto &edge : edges) {
+        if (edge.second == 1) {
+            border[static_cast<unsigned int>(edge.first >> 32)] = true;
+            border[static_cast<unsigned int>(edge.first & 0xffffffff)] = true;
+        }
+    }
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        if (border[weld[i]]) {
+            mLocked[i] = true;
+        }
+    }
+
+    // plane quadrics of all adjacent triangles
+    for (size_t t = 0; t < indices.size(); t += 3) {
+        const aiVector3D &p0 = mMesh->mVertices[indices[t]];
+        aiVector3D n = (mMesh->mVertices[indices[t + 1]] - p0) ^ (mMesh->mVertices[indices[t + 2]] - p0);
+        const ai_real len = n.Length();
+        if (len <= 0) {
+            continue;
+        }
+        n /= len;
+        const Quadric q(n.x, n.y, n.z, -(n * p0));
+        mQuadrics[indices[t]] += q;
+        mQuadrics[indices[t + 1]] += q;
+        mQuadrics[indices[t + 2]] += q;
+    }
+    mInitialized = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether moving 'from' onto 'to' turns any of the remaining triangles around
+bool MeshSimplifier::Flips(const std::vector<unsigned int> &indices, unsigned int from, unsigned int to) const {
+    const aiVector3D *pos = mMesh->mVertices;
+    for (unsigned int i = mOffsets[from]; i < mOffsets[from + 1]; ++i) {
+        const unsigned int *tri = &indices[mAdjacency[i] * 3];
+        if (tri[0] == to || tri[1] == to || tri[2] == to) {
+            // this triangle collapses
+            continue;
+        }
+        const unsigned int k = tri[0] == from ? 0 : (tri[1] == from ? 1 : 2);
+        const aiVector3D &p1 = pos[tri[(k + 1) % 3]];
+        const aiVector3D &p2 = pos[tri[(k + 2) % 3]];
+        const aiVector3D before = (p1 - pos[from]) ^ (p2 - pos[from]);
+        const aiVector3D after = (p1 - pos[to]) ^ (p2 - pos[to]);
+        if (before * after <= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::Simplify(std::vector<unsigned int> &indices, size_t targetTriangles, ai_real maxError) {
+    if (!mInitialized) {
+        Classify(indices);
+    }
+
+    struct Collapse {
+        unsigned int from, to;
+        double cost;
+        bool operator<(const Collapse &o) const { return cost < o.cost; }
+    };
+
+    const unsigned int numVertices = mMesh->mNumVertices;
+    const double maxCost = static_cast<double>(maxError) * mScale * static_cast<double>(maxError) * mScale;
+    const size_t startTriangles = indices.size() / 3;
+    std::vector<Collapse> candidates;
+    std::vector<unsigned int> remap(numVertices);
+    std::vector<bool> touched(numVertices);
+
+    while (indices.size() / 3 > targetTriangles) {
+        const size_t numTriangles = indices.size() / 3;
+
+        // vertex -> triangle adjacency of the current triangle list
+        mOffsets.assign(numVertices + 1, 0);
+        for (unsigned int idx : indices) {
+            ++mOffsets[idx + 1];
+        }
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            mOffsets[i + 1] += mOffsets[i];
+        }
+        mAdjacency.resize(indices.size());
+        std::vector<unsigned int> fill(mOffsets.begin(), mOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            mAdjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        // rank all possible half-edge collapses
+        candidates.clear();
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int a = indices[t + k], b = indices[t + (k + 1) % 3];
+                if (mDominantBone[a] != mDominantBone[b]) {
+                    continue;
+                }
+                Quadric q = mQuadrics[a];
+                q += mQuadrics[b];
+                if (!mLocked[a]) {
+                    candidates.push_back({ a, b, q.Evaluate(mMesh->mVertices[b]) });
+                }
+                if (!mLocked[b]) {
+                    candidates.push_back({ b, a, q.Evaluate(mMesh->mVertices[a]) });
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // apply the cheapest independent collapses
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            remap[i] = i;
+        }
+        std::fill(touched.begin(), touched.end(), false);
+        const size_t needed = numTriangles - targetTriangles;
+        size_t removed = 0, collapsed = 0;
+        for (const Collapse &c : candidates) {
+            if (c.cost > maxCost || removed >= needed) {
+                break;
+            }
+            if (touched[c.from] || touched[c.to] || Flips(indices, c.from, c.to)) {
+                continue;
+            }
+
+            remap[c.from] = c.to;
+            mQuadrics[c.to] += mQuadrics[c.from];
+            for (unsigned int i = mOffsets[c.from]; i < mOffsets[c.from + 1]; ++i) {
+                const unsigned int *tri = &indices[mAdjacency[i] * 3];
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = true;
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    ++removed;
+                }
+            }
+            ++collapsed;
+        }
+        if (!collapsed) {
+            break;
+        }
+
+        // rewrite the triangle list and drop the collapsed triangles
+        size_t out = 0;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            const unsigned int a = remap[indices[t]], b = remap[indices[t + 1]], c = remap[indices[t + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+        indices.resize(out);
+    }
+
+    return indices.size() / 3 < startTriangles;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Gathers the entries of a vertex stream referenced by the index list
+template <typename T>
+T *CopyStream(const std::vector<unsigned int> &oldIndex, const T *in) {
+    if (nullptr == in) {
+        return nullptr;
+    }
+    T *out = new T[oldIndex.size()];
+    for (size_t i = 0; i < oldIndex.size(); ++i) {
+        out[i] = in[oldIndex[i]];
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds a compact mesh from the vertices of 'src' referenced by a triangle list
+aiMesh *BuildLODMesh(const aiMesh *src, const std::vector<unsigned int> &indices) {
+    const unsigned int unused = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> newIndex(src->mNumVertices, unused);
+    std::vector<unsigned int> oldIndex;
+    oldIndex.reserve(src->mNumVertices);
+    for (unsigned int idx : indices) {
+        if (unused == newIndex[idx]) {
+            newIndex[idx] = static_cast<unsigned int>(oldIndex.size());
+            oldIndex.push_back(idx);
+        }
+    }
+
+    aiMesh *mesh = new aiMesh();
+    mesh->mName = src->mName;
+    mesh->mMaterialIndex = src->mMaterialIndex;
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = static_cast<unsigned int>(oldIndex.size());
+
+    mesh->mVertices = CopyStream(oldIndex, src->mVertices);
+    mesh->mNormals = CopyStream(oldIndex, src->mNormals);
+    mesh->mTangents = CopyStream(oldIndex, src->mTangents);
+    mesh->mBitangents = CopyStream(oldIndex, src->mBitangents);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        mesh->mTextureCoords[i] = CopyStream(oldIndex, src->mTextureCoords[i]);
+        mesh->mNumUVComponents[i] = src->mNumUVComponents[i];
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        mesh->mColors[i] = CopyStream(oldIndex, src->mColors[i]);
+    }
+
+    mesh->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace &face = mesh->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int k = 0; k < 3; ++k) {
+            face.mIndices[k] = newIndex[indices[f * 3 + k]];
+        }
+    }
+
+    // keep all bones which still influence a vertex
+    std::vector<aiBone *> bones;
+    for (unsigned int b = 0; b < src->mNumBones; ++b) {
+        const aiBone *srcBone = src->mBones[b];
+        std::vector<aiVertexWeight> weights;
+        for (unsigned int w = 0; w < srcBone->mNumWeights; ++w) {
+            const aiVertexWeight &weight = srcBone->mWeights[w];
+            if (unused != newIndex[weight.mVertexId]) {
+                weights.push_back(aiVertexWeight(newIndex[weight.mVertexId], weight.mWeight));
+            }
+        }
+        if (weights.empty()) {
+            continue;
+        }
+        aiBone *bone = new aiBone();
+        bone->mName = srcBone->mName;
+        bone->mOffsetMatrix = srcBone->mOffsetMatrix;
+        bone->mArmature = srcBone->mArmature;
+        bone->mNode = srcBone->mNode;
+        bone->mNumWeights = static_cast<unsigned int>(weights.size());
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        std::copy(weights.begin(), weights.end(), bone->mWeights);
+        bones.push_back(bone);
+    }
+    if (!bones.empty()) {
+        mesh->mNumBones = static_cast<unsigned int>(bones.size());
+        mesh->mBones = new aiBone *[mesh->mNumBones];
+        std::copy(bones.begin(), bones.end(), mesh->mBones);
+    }
+
+    return mesh;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenerateLODsProcess::GenerateLODsProcess() :
+        BaseProcess(),
+        mNumLODs(AI_LOD_DEFAULT_COUNT),
+        mReduction(AI_LOD_DEFAULT_REDUCTION),
+        mMaxError(AI_LOD_DEFAULT_MAX_ERROR),
+        mNumThreads(1) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenerateLODsProcess::~GenerateLODsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsProcess::IsExtActive(unsigned int pExtFlags) const {
+    return 0 != (pExtFlags & aiProcessExt_GenerateLODs);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::SetupProperties(const Importer *pImp) {
+    SetConfig(pImp->GetPropertyInteger(AI_CONFIG_PP_LOD_COUNT, AI_LOD_DEFAULT_COUNT),
+            pImp->GetPropertyFloat(AI_CONFIG_PP_LOD_REDUCTION, AI_LOD_DEFAULT_REDUCTION),
+            pImp->GetPropertyFloat(AI_CONFIG_PP_LOD_MAX_ERROR, AI_LOD_DEFAULT_MAX_ERROR));
+    mNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::SetConfig(unsigned int numLODs, ai_real reduction, ai_real maxError) {
+    mNumLODs = numLODs;
+    mReduction = std::max(static_cast<ai_real>(0.0), std::min(reduction, static_cast<ai_real>(1.0)));
+    mMaxError = std::max(static_cast<ai_real>(0.0), maxError);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::Execute(aiScene *pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes || 0 == mNumLODs) {
+        ASSIMP_LOG_DEBUG("GenerateLODsProcess skipped; there is nothing to do");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("GenerateLODsProcess begin");
+
+    std::vector<char> processed(pScene->mNumMeshes, 0);
+    ParallelFor(mNumThreads, pScene->mNumMeshes, [&](size_t i) {
+        processed[i] = ProcessMesh(pScene->mMeshes[i]) ? 1 : 0;
+    });
+
+    unsigned int numMeshes = 0, numLODs = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (processed[i]) {
+            ++numMeshes;
+            numLODs += pScene->mMeshes[i]->mNumLODs;
+        } else if (pScene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+            ASSIMP_LOG_WARN_F("GenerateLODsProcess: Mesh ", i, " skipped, it does not consist of triangles only");
+        }
+    }
+
+    if (numMeshes) {
+        ASSIMP_LOG_INFO_F("GenerateLODsProcess finished. Generated ", numLODs, " LODs for ", numMeshes, " meshes");
+    } else {
+        ASSIMP_LOG_DEBUG("GenerateLODsProcess finished. There was nothing to do.");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsProcess::ProcessMesh(aiMesh *pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions() || pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        return false;
+    }
+
+    // drop LODs from a previous run
+    for (unsigned int i = 0; i < pMesh->mNumLODs; ++i) {
+        delete pMesh->mLODs[i];
+    }
+    delete[] pMesh->mLODs;
+    pMesh->mLODs = nullptr;
+    pMesh->mNumLODs = 0;
+
+    std::vector<unsigned int> indices;
+    indices.reserve(static_cast<size_t>(pMesh->mNumFaces) * 3);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace &face = pMesh->mFaces[f];
+        indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+    }
+
+    // every level continues from the previous one
+    MeshSimplifier simplifier(pMesh);
+    std::vector<aiMesh *> lods;
+    double target = pMesh->mNumFaces;
+    for (unsigned int level = 0; level < mNumLODs; ++level) {
+        target *= mReduction;
+        if (!simplifier.Simplify(indices, static_cast<size_t>(target), mMaxError) || indices.empty()) {
+            break;
+        }
+        lods.push_back(BuildLODMesh(pMesh, indices));
+    }
+
+    if (lods.empty()) {
+        return false;
+    }
+
+    pMesh->mNumLODs = static_cast<unsigned int>(lods.size());
+    pMesh->mLODs = new aiMesh *[pMesh->mNumLODs];
+    std::copy(lods.begin(), lods.end(), pMesh->mLODs);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateLODsProcess::Simplify(const aiMesh *pMesh, std::vector<unsigned int> &indices,
+        size_t targetTriangles, ai_real maxError) {
+    ai_assert(nullptr != pMesh);
+    if (!pMesh->HasPositions()) {
+        return false;
+    }
+    MeshSimplifier simplifier(pMesh);
+    return simplifier.Simplify(indices, targetTriangles, maxError);
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENERATELODS_PROCESS
@@ -0,0 +1,137 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to generate simplified levels of detail */
+#pragma once
+#ifndef AI_GENERATELODSPROCESS_H_INC
+#define AI_GENERATELODSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENERATELODS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/types.h>
+
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenerateLODsProcess attaches a chain of simplified meshes to each
+ *  triangle mesh (#aiMesh::mLODs).
+ *
+ *  Simplification is done by quadric error driven half-edge collapses.
+ *  Since a collapse moves a vertex onto one of its neighbours, all vertex
+ *  attributes of the remaining vertices stay untouched. Vertices on mesh
+ *  borders and on attribute seams (several vertices sharing a position,
+ *  e.g. because of differing UVs or normals) are never removed, collapses
+ *  between vertices with different dominant bones are rejected.
+ *
+ *  @note This step expects triangulated, indexed input data.
+ */
+class ASSIMP_API GenerateLODsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenerateLODsProcess();
+
+    /// The class destructor.
+    ~GenerateLODsProcess();
+
+    /// Will return false, the step is enabled via the extended flags only.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "GenerateLODsProcess"; }
+
+    /// Will return true, if aiProcessExt_GenerateLODs is defined.
+    bool IsExtActive(unsigned int pExtFlags) const override;
+
+    /// Reads the LOD chain configuration from the importer.
+    void SetupProperties(const Importer *pImp) override;
+
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Generates the LOD chain for a single mesh.
+     *  @param pMesh The mesh to process.
+     *  @return true if at least one LOD was generated. */
+    bool ProcessMesh(aiMesh *pMesh) const;
+
+    // -------------------------------------------------------------------
+    /** Sets the chain parameters directly, overriding the configuration.
+     *  @param numLODs Maximum number of LODs per mesh.
+     *  @param reduction Triangle ratio between two successive levels.
+     *  @param maxError Maximum error relative to the mesh extents. */
+    void SetConfig(unsigned int numLODs, ai_real reduction, ai_real maxError);
+
+    // -------------------------------------------------------------------
+    /** Simplifies a triangle list of a mesh.
+     *  @param pMesh Mesh providing vertices and bones.
+     *  @param indices Triangle list to simplify in place, three indices
+     *    per triangle.
+     *  @param targetTriangles Number of triangles to reduce to.
+     *  @param maxError Maximum error relative to the mesh extents.
+     *  @return true if at least one triangle was removed. */
+    static bool Simplify(const aiMesh *pMesh, std::vector<unsigned int> &indices,
+            size_t targetTriangles, ai_real maxError);
+
+private:
+    //! Configuration option: number of levels to generate
+    unsigned int mNumLODs;
+
+    //! Configuration option: triangle ratio between successive levels
+    ai_real mReduction;
+
+    //! Configuration option: maximum relative simplification error
+    ai_real mMaxError;
+
+    //! Number of worker threads, see AI_CONFIG_GLOB_MULTITHREADING
+    unsigned int mNumThreads;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENERATELODS_PROCESS
+
+#endif // AI_GENERATELODSPROCESS_H_INC
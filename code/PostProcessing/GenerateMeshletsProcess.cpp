@@ -0,0 +1,380 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post processing step to partition meshes into meshlets.
+ * <br>
+ * The clustering is a greedy region growing over the vertex-triangle adjacency,
+ * the bounds follow the usual bounding sphere / normal cone formulation used for
+ * cluster culling.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
+
+#include "PostProcessing/GenerateMeshletsProcess.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+const unsigned int NotAssigned = std::numeric_limits<unsigned int>::max();
+
+// ------------------------------------------------------------------------------------------------
+// Returns the number of vertices of a triangle which are not yet part of the current meshlet
+unsigned int CountNewVertices(const aiFace &face, const std::vector<unsigned int> &localIndex) {
+    const unsigned int *idx = face.mIndices;
+    unsigned int n = 0;
+    if (localIndex[idx[0]] == NotAssigned) {
+        ++n;
+    }
+    if (localIndex[idx[1]] == NotAssigned && idx[1] != idx[0]) {
+        ++n;
+    }
+    if (localIndex[idx[2]] == NotAssigned && idx[2] != idx[0] && idx[2] != idx[1]) {
+        ++n;
+    }
+    return n;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Range of a meshlet within the flat output arrays
+struct MeshletRange {
+    unsigned int mFirstVertex;
+    unsigned int mNumVertices;
+    unsigned int mFirstTriangle;
+    unsigned int mNumTriangles;
+};
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenerateMeshletsProcess::GenerateMeshletsProcess() :
+        BaseProcess(),
+        mMaxVertices(AI_GM_DEFAULT_MAX_VERTICES),
+        mMaxTriangles(AI_GM_DEFAULT_MAX_TRIANGLES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenerateMeshletsProcess::~GenerateMeshletsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateMeshletsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateMeshletsProcess::IsExtActive(unsigned int pExtFlags) const {
+    return 0 != (pExtFlags & aiProcessExt_GenerateMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::SetupProperties(const Importer *pImp) {
+    SetLimits(pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, AI_GM_DEFAULT_MAX_VERTICES),
+            pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES, AI_GM_DEFAULT_MAX_TRIANGLES));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::SetLimits(unsigned int maxVertices, unsigned int maxTriangles) {
+    mMaxVertices = std::max(3u, std::min(maxVertices, static_cast<unsigned int>(AI_MAX_MESHLET_VERTICES)));
+    mMaxTriangles = std::max(1u, maxTriangles);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::Execute(aiScene *pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("GenerateMeshletsProcess skipped; there are no meshes");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("GenerateMeshletsProcess begin");
+
+    unsigned int numMeshlets = 0, numMeshes = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (ProcessMesh(pScene->mMeshes[i])) {
+            numMeshlets += pScene->mMeshes[i]->mNumMeshlets;
+            ++numMeshes;
+        }
+    }
+
+    if (numMeshes) {
+        ASSIMP_LOG_INFO_F("GenerateMeshletsProcess finished. Generated ", numMeshlets, " meshlets for ", numMeshes, " meshes");
+    } else {
+        ASSIMP_LOG_DEBUG("GenerateMeshletsProcess finished. There was nothing to do.");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenerateMeshletsProcess::ProcessMesh(aiMesh *pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        ASSIMP_LOG_ERROR("GenerateMeshletsProcess: This algorithm works on triangle meshes only");
+        return false;
+    }
+
+    // drop meshlets from a previous run, they are rebuilt from scratch
+    delete[] pMesh->mMeshlets;
+    pMesh->mMeshlets = nullptr;
+    pMesh->mNumMeshlets = 0;
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, pMesh->mNumVertices, false);
+
+    std::vector<bool> emitted(numFaces, false);
+    std::vector<unsigned int> localIndex(pMesh->mNumVertices, NotAssigned);
+
+    std::vector<unsigned int> outVertices;
+    std::vector<unsigned char> outTriangles;
+    std::vector<MeshletRange> ranges;
+    outVertices.reserve(pMesh->mNumVertices + pMesh->mNumVertices / 2);
+    outTriangles.reserve(static_cast<size_t>(numFaces) * 3);
+
+    MeshletRange cur = { 0, 0, 0, 0 };
+    unsigned int seed = 0, last = NotAssigned;
+
+    // picks the best not yet emitted triangle adjacent to the given vertices
+    auto findCandidate = [&](const unsigned int *verts, unsigned int numVerts, unsigned int &bestNew) -> unsigned int {
+        unsigned int best = NotAssigned;
+        bestNew = 4;
+        for (unsigned int i = 0; i < numVerts && bestNew > 0; ++i) {
+            const unsigned int *tris = adj.GetAdjacentTriangles(verts[i]);
+            const unsigned int numTris = adj.mOffsetTable[verts[i] + 1] - adj.mOffsetTable[verts[i]];
+            for (unsigned int t = 0; t < numTris; ++t) {
+                const unsigned int tri = tris[t];
+                if (emitted[tri]) {
+                    continue;
+                }
+                const unsigned int n = CountNewVertices(pMesh->mFaces[tri], localIndex);
+                if (n < bestNew || (n == bestNew && tri < best)) {
+                    best = tri;
+                    bestNew = n;
+                }
+            }
+        }
+        return best;
+    };
+
+    auto flush = [&]() {
+        if (0 == cur.mNumTriangles) {
+            return;
+        }
+        for (unsigned int i = 0; i < cur.mNumVertices; ++i) {
+            localIndex[outVertices[cur.mFirstVertex + i]] = NotAssigned;
+        }
+        ranges.push_back(cur);
+        cur.mFirstVertex = static_cast<unsigned int>(outVertices.size());
+        cur.mFirstTriangle = static_cast<unsigned int>(outTriangles.size() / 3);
+        cur.mNumVertices = cur.mNumTriangles = 0;
+        last = NotAssigned;
+    };
+
+    for (;;) {
+        unsigned int best = NotAssigned, bestNew = 4;
+
+        // grow the meshlet around the last triangle first, then around the whole meshlet
+        if (NotAssigned != last) {
+            best = findCandidate(pMesh->mFaces[last].mIndices, 3, bestNew);
+            if (NotAssigned == best) {
+                best = findCandidate(&outVertices[cur.mFirstVertex], cur.mNumVertices, bestNew);
+            }
+        }
+
+        // nothing connected left, continue in input order
+        if (NotAssigned == best) {
+            while (seed < numFaces && emitted[seed]) {
+                ++seed;
+            }
+            if (seed == numFaces) {
+                break;
+            }
+            best = seed;
+            bestNew = CountNewVertices(pMesh->mFaces[best], localIndex);
+        }
+
+        if (cur.mNumVertices + bestNew > mMaxVertices || cur.mNumTriangles + 1 > mMaxTriangles) {
+            flush();
+        }
+
+        const aiFace &face = pMesh->mFaces[best];
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int idx = face.mIndices[k];
+            if (NotAssigned == localIndex[idx]) {
+                localIndex[idx] = cur.mNumVertices++;
+                outVertices.push_back(idx);
+            }
+            outTriangles.push_back(static_cast<unsigned char>(localIndex[idx]));
+        }
+        ++cur.mNumTriangles;
+        emitted[best] = true;
+        last = best;
+    }
+    flush();
+
+    pMesh->mNumMeshlets = static_cast<unsigned int>(ranges.size());
+    pMesh->mMeshlets = new aiMeshlet[pMesh->mNumMeshlets];
+    for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+        const MeshletRange &r = ranges[i];
+        aiMeshlet &meshlet = pMesh->mMeshlets[i];
+
+        meshlet.mNumVertices = r.mNumVertices;
+        meshlet.mVertices = new unsigned int[r.mNumVertices];
+        std::copy(outVertices.begin() + r.mFirstVertex, outVertices.begin() + r.mFirstVertex + r.mNumVertices,
+                meshlet.mVertices);
+
+        meshlet.mNumTriangles = r.mNumTriangles;
+        meshlet.mTriangles = new unsigned char[r.mNumTriangles * 3];
+        std::copy(outTriangles.begin() + r.mFirstTriangle * 3, outTriangles.begin() + (r.mFirstTriangle + r.mNumTriangles) * 3,
+                meshlet.mTriangles);
+
+        ComputeBounds(pMesh, meshlet);
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::ComputeBounds(const aiMesh *pMesh, aiMeshlet &meshlet) {
+    const aiVector3D *pos = pMesh->mVertices;
+    const unsigned int *verts = meshlet.mVertices;
+
+    // bounding sphere, Ritter's approximation
+    const aiVector3D &p0 = pos[verts[0]];
+    aiVector3D p1 = p0, p2 = p0;
+    for (unsigned int i = 1; i < meshlet.mNumVertices; ++i) {
+        if ((pos[verts[i]] - p0).SquareLength() > (p1 - p0).SquareLength()) {
+            p1 = pos[verts[i]];
+        }
+    }
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        if ((pos[verts[i]] - p1).SquareLength() > (p2 - p1).SquareLength()) {
+            p2 = pos[verts[i]];
+        }
+    }
+    aiVector3D center = (p1 + p2) * static_cast<ai_real>(0.5);
+    ai_real radius = (p2 - p1).Length() * static_cast<ai_real>(0.5);
+    for (unsigned int i = 0; i < meshlet.mNumVertices; ++i) {
+        const ai_real d = (pos[verts[i]] - center).Length();
+        if (d > radius) {
+            // move the center towards the outlier just far enough to enclose it
+            const ai_real newRadius = (radius + d) * static_cast<ai_real>(0.5);
+            center += (pos[verts[i]] - center) * ((newRadius - radius) / d);
+            radius = newRadius;
+        }
+    }
+    meshlet.mCenter = center;
+    meshlet.mRadius = radius;
+
+    // normal cone: average of the unit triangle normals
+    std::vector<aiVector3D> normals;
+    normals.reserve(meshlet.mNumTriangles);
+    aiVector3D axis;
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        const aiVector3D &a = pos[verts[meshlet.mTriangles[t * 3 + 0]]];
+        const aiVector3D &b = pos[verts[meshlet.mTriangles[t * 3 + 1]]];
+        const aiVector3D &c = pos[verts[meshlet.mTriangles[t * 3 + 2]]];
+        aiVector3D n = (b - a) ^ (c - a);
+        const ai_real len = n.Length();
+        if (len <= static_cast<ai_real>(0.0)) {
+            normals.push_back(aiVector3D());
+            continue;
+        }
+        n /= len;
+        normals.push_back(n);
+        axis += n;
+    }
+
+    meshlet.mConeApex = center;
+    meshlet.mConeAxis = aiVector3D();
+    meshlet.mConeCutoff = static_cast<ai_real>(1.0);
+
+    const ai_real axisLength = axis.Length();
+    if (axisLength <= static_cast<ai_real>(0.0)) {
+        return;
+    }
+    axis /= axisLength;
+    meshlet.mConeAxis = axis;
+
+    ai_real minDot = static_cast<ai_real>(1.0);
+    for (const aiVector3D &n : normals) {
+        if (n.SquareLength() > static_cast<ai_real>(0.0)) {
+            minDot = std::min(minDot, n * axis);
+        }
+    }
+
+    // the normals spread too far, culling would never succeed
+    if (minDot <= static_cast<ai_real>(0.1)) {
+        return;
+    }
+
+    // move the apex back along the axis until it lies behind all triangle planes
+    ai_real maxT = static_cast<ai_real>(0.0);
+    for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+        const aiVector3D &n = normals[t];
+        if (n.SquareLength() <= static_cast<ai_real>(0.0)) {
+            continue;
+        }
+        const aiVector3D &a = pos[verts[meshlet.mTriangles[t * 3]]];
+        const ai_real dc = (center - a) * n;
+        const ai_real dn = axis * n;
+        maxT = std::max(maxT, dc / dn);
+    }
+
+    meshlet.mConeApex = center - axis * maxT;
+    meshlet.mConeCutoff = std::sqrt(static_cast<ai_real>(1.0) - minDot * minDot);
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
@@ -0,0 +1,117 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to partition meshes into meshlets */
+#pragma once
+#ifndef AI_GENERATEMESHLETSPROCESS_H_INC
+#define AI_GENERATEMESHLETSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+struct aiMeshlet;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenerateMeshletsProcess splits triangle meshes into meshlets, i.e.
+ *  clusters with a bounded number of vertices and triangles, and computes a
+ *  bounding sphere and a normal cone for each of them.
+ *
+ *  Triangles are added greedily: the next triangle is picked from the
+ *  triangles adjacent to the vertices already in the current meshlet,
+ *  preferring the one which adds the fewest new vertices. The input face
+ *  order (see #ImproveCacheLocalityProcess) is used to seed new meshlets.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenerateMeshletsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenerateMeshletsProcess();
+
+    /// The class destructor.
+    ~GenerateMeshletsProcess();
+
+    /// Will return false, the step is enabled via the extended flags only.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "GenerateMeshletsProcess"; }
+
+    /// Will return true, if aiProcessExt_GenerateMeshlets is defined.
+    bool IsExtActive(unsigned int pExtFlags) const override;
+
+    /// Reads the meshlet limits from the importer configuration.
+    void SetupProperties(const Importer *pImp) override;
+
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Partitions a single mesh into meshlets.
+     *  @param pMesh The mesh to process.
+     *  @return true if meshlets were generated. */
+    bool ProcessMesh(aiMesh *pMesh) const;
+
+    // -------------------------------------------------------------------
+    /** Sets the meshlet limits directly, overriding the configuration. */
+    void SetLimits(unsigned int maxVertices, unsigned int maxTriangles);
+
+private:
+    // Computes bounding sphere and normal cone of a finished meshlet
+    static void ComputeBounds(const aiMesh *pMesh, aiMeshlet &meshlet);
+
+private:
+    //! Configuration option: maximum number of vertices per meshlet
+    unsigned int mMaxVertices;
+
+    //! Configuration option: maximum number of triangles per meshlet
+    unsigned int mMaxTriangles;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
+
+#endif // AI_GENERATEMESHLETSPROCESS_H_INC
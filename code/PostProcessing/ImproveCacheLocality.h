@@ -74,6 +74,9 @@ public:
     // Check whether the pp step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "ImproveCacheLocalityProcess"; }
+
     // -------------------------------------------------------------------
     // Executes the pp step on a given scene
     void Execute( aiScene* pScene);
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Vertex.h>
 #include <assimp/TinyFormatter.h>
 #include <stdio.h>
+#include <memory>
 #include <unordered_set>
 
 using namespace Assimp;
@@ -76,6 +77,12 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step works on each mesh on its own.
+bool JoinVerticesProcess::IsPerMeshStep() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
@@ -92,8 +99,14 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 
     // execute the step
     int iNumVertices = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+    for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+        ThrowIfCancelled();
+        if (IsMeshSelected(a)) {
+            iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+        } else {
+            iNumVertices += pScene->mMeshes[a]->mNumVertices;
+        }
+    }
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger()) {
@@ -304,6 +317,10 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
+    // For each unique vertex the index of the source vertex it was taken from
+    std::vector<unsigned int> uniqueSources;
+    uniqueSources.reserve( pMesh->mNumVertices);
+
     // Now check each vertex if it brings something new to the table
     for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
         if (usedVertexIndices.find(a) == usedVertexIndices.end()) {
@@ -363,6 +380,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
             // no unique vertex matches it up to now -> so add it
             replaceIndex[a] = (unsigned int)uniqueVertices.size();
             uniqueVertices.push_back( v);
+            uniqueSources.push_back( a);
             if (hasAnimMeshes) {
                 for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
                     Vertex aniMeshVertex(pMesh->mAnimMeshes[animMeshIndex], a);
@@ -386,6 +404,18 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         );
     }
 
+    // the influences of the unique vertices, taken before the vertex count changes
+    std::unique_ptr<aiBoneInfluences> joinedInfluences;
+    bool attachInfluences = false;
+    if (pMesh->HasBones()) {
+        std::unique_ptr<aiBoneInfluences> temp;
+        const aiBoneInfluences* influences = GetBoneInfluences(pMesh, temp);
+        if (influences) {
+            joinedInfluences.reset(CopyBoneInfluences(*influences, uniqueSources.data(), (unsigned int)uniqueSources.size()));
+            attachInfluences = !temp;
+        }
+    }
+
     updateXMeshVertices(pMesh, uniqueVertices);
     if (hasAnimMeshes) {
         for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
@@ -402,34 +432,12 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
         }
     }
 
-    // adjust bone vertex weights.
-    for( int a = 0; a < (int)pMesh->mNumBones; a++) {
-        aiBone* bone = pMesh->mBones[a];
-        std::vector<aiVertexWeight> newWeights;
-        newWeights.reserve( bone->mNumWeights);
-
-        if ( NULL != bone->mWeights ) {
-            for ( unsigned int b = 0; b < bone->mNumWeights; b++ ) {
-                const aiVertexWeight& ow = bone->mWeights[ b ];
-                // if the vertex is a unique one, translate it
-                if ( !( replaceIndex[ ow.mVertexId ] & 0x80000000 ) ) {
-                    aiVertexWeight nw;
-                    nw.mVertexId = replaceIndex[ ow.mVertexId ];
-                    nw.mWeight = ow.mWeight;
-                    newWeights.push_back( nw );
-                }
-            }
-        } else {
-            ASSIMP_LOG_ERROR( "X-Export: aiBone shall contain weights, but pointer to them is NULL." );
-        }
-
-        if (newWeights.size() > 0) {
-            // kill the old and replace them with the translated weights
-            delete [] bone->mWeights;
-            bone->mNumWeights = (unsigned int)newWeights.size();
-
-            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
-            memcpy( bone->mWeights, &newWeights[0], bone->mNumWeights * sizeof( aiVertexWeight));
+    // adjust bone vertex weights, rebuilding the weight list of each bone from the influences of the unique vertices
+    if (joinedInfluences) {
+        SetBoneWeights(pMesh, *joinedInfluences);
+        if (attachInfluences) {
+            delete pMesh->mBoneInfluences;
+            pMesh->mBoneInfluences = joinedInfluences.release();
         }
     }
     return pMesh->mNumVertices;
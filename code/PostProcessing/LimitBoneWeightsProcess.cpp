@@ -44,12 +44,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "LimitBoneWeightsProcess.h"
-#include <assimp/SmallVector.h>
+#include "ProcessHelper.h"
 #include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <stdio.h>
+#include <memory>
 
 using namespace Assimp;
 
@@ -102,81 +103,58 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh)
     if (!pMesh->HasBones())
         return;
 
-    // collect all bone weights per vertex
-    typedef SmallVector<Weight,8> VertexWeightArray;
-    typedef std::vector<VertexWeightArray> WeightsPerVertex;
-    WeightsPerVertex vertexWeights(pMesh->mNumVertices);
-    size_t maxVertexWeights = 0;
-
-    for (unsigned int b = 0; b < pMesh->mNumBones; ++b)
-    {
-        const aiBone* bone = pMesh->mBones[b];
-        for (unsigned int w = 0; w < bone->mNumWeights; ++w)
-        {
-            const aiVertexWeight& vw = bone->mWeights[w];
-            vertexWeights[vw.mVertexId].push_back(Weight(b, vw.mWeight));
-            maxVertexWeights = std::max(maxVertexWeights, vertexWeights[vw.mVertexId].size());
-        }
-    }
-
-    if (maxVertexWeights <= mMaxWeights)
+    // the influence table has the weights of each vertex sorted by descending weight already
+    std::unique_ptr<aiBoneInfluences> temp;
+    const aiBoneInfluences* influences = GetBoneInfluences(pMesh, temp);
+    if (!influences || influences->mNumInfluences <= mMaxWeights)
         return;
 
     unsigned int removed = 0, old_bones = pMesh->mNumBones;
 
-    // now cut the weight count if it exceeds the maximum
-    for (WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit)
+    // now kill everything beyond the maximum count and renormalize the remaining weights
+    const unsigned int numSlots = influences->mNumInfluences, numKept = std::max(mMaxWeights, 1u);
+    std::unique_ptr<aiBoneInfluences> limited(new aiBoneInfluences());
+    limited->mNumInfluences = numKept;
+    limited->mBoneIndices = new unsigned int[static_cast<size_t>(pMesh->mNumVertices) * numKept]();
+    limited->mWeights = new ai_real[static_cast<size_t>(pMesh->mNumVertices) * numKept]();
+    for (unsigned int a = 0; a < pMesh->mNumVertices; ++a)
     {
-        if (vit->size() <= mMaxWeights)
-            continue;
-
-        // more than the defined maximum -> first sort by weight in descending order. That's
-        // why we defined the < operator in such a weird way.
-        std::sort(vit->begin(), vit->end());
-
-        // now kill everything beyond the maximum count
-        unsigned int m = static_cast<unsigned int>(vit->size());
-        vit->resize(mMaxWeights);
-        removed += static_cast<unsigned int>(m - vit->size());
-
-        // and renormalize the weights
-        float sum = 0.0f;
-        for(const Weight* it = vit->begin(); it != vit->end(); ++it) {
-            sum += it->mWeight;
+        const unsigned int* srcBones = influences->mBoneIndices + static_cast<size_t>(a) * numSlots;
+        const ai_real* srcWeights = influences->mWeights + static_cast<size_t>(a) * numSlots;
+        unsigned int* dstBones = limited->mBoneIndices + static_cast<size_t>(a) * numKept;
+        ai_real* dstWeights = limited->mWeights + static_cast<size_t>(a) * numKept;
+
+        for (unsigned int s = mMaxWeights; s < numSlots && srcWeights[s] != 0.0; ++s) {
+            ++removed;
         }
-        if (0.0f != sum) {
-            const float invSum = 1.0f / sum;
-            for(Weight* it = vit->begin(); it != vit->end(); ++it) {
-                it->mWeight *= invSum;
+
+        ai_real sum = 0.0;
+        for (unsigned int s = 0; s < mMaxWeights && s < numSlots; ++s) {
+            dstBones[s] = srcBones[s];
+            dstWeights[s] = srcWeights[s];
+            sum += srcWeights[s];
+        }
+        if (0.0 != sum) {
+            const ai_real invSum = ai_real(1.0) / sum;
+            for (unsigned int s = 0; s < numKept; ++s) {
+                dstWeights[s] *= invSum;
             }
         }
     }
 
-    // clear weight count for all bone
-    for (unsigned int a = 0; a < pMesh->mNumBones; ++a)
-    {
-        pMesh->mBones[a]->mNumWeights = 0;
-    }
-
     // rebuild the vertex weight array for all bones
-    for (unsigned int a = 0; a < vertexWeights.size(); ++a)
-    {
-        const VertexWeightArray& vw = vertexWeights[a];
-        for (const Weight* it = vw.begin(); it != vw.end(); ++it)
-        {
-            aiBone* bone = pMesh->mBones[it->mBone];
-            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(a, it->mWeight);
-        }
-    }
+    SetBoneWeights(pMesh, *limited);
 
     // remove empty bones
     unsigned int writeBone = 0;
+    std::vector<unsigned int> boneMap(pMesh->mNumBones, 0);
 
     for (unsigned int readBone = 0; readBone< pMesh->mNumBones; ++readBone)
     {
         aiBone* bone = pMesh->mBones[readBone];
         if (bone->mNumWeights > 0)
         {
+            boneMap[readBone] = writeBone;
             pMesh->mBones[writeBone++] = bone;
         }
         else
@@ -186,6 +164,16 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh)
     }
     pMesh->mNumBones = writeBone;
 
+    // keep an attached influence table in sync
+    if (!temp) {
+        const size_t size = static_cast<size_t>(pMesh->mNumVertices) * numKept;
+        for (size_t i = 0; i < size; ++i) {
+            limited->mBoneIndices[i] = boneMap[limited->mBoneIndices[i]];
+        }
+        delete pMesh->mBoneInfluences;
+        pMesh->mBoneInfluences = limited.release();
+    }
+
     if (!DefaultLogger::isNullLogger()) {
         ASSIMP_LOG_INFO_F("Removed ", removed, " weights. Input bones: ", old_bones, ". Output bones: ", pMesh->mNumBones);
     }
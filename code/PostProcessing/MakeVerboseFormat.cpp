@@ -45,8 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "MakeVerboseFormat.h"
+#include "ProcessHelper.h"
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <memory>
 
 using namespace Assimp;
 
@@ -116,11 +118,10 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
     while (pcMesh->HasVertexColors(p))
         apvColorSets[p++] = new aiColor4D[iNumVerts];
 
-    // allocate enough memory to hold output bones and vertex weights ...
-    std::vector<aiVertexWeight>* newWeights = new std::vector<aiVertexWeight>[pcMesh->mNumBones];
-    for (unsigned int i = 0;i < pcMesh->mNumBones;++i) {
-        newWeights[i].reserve(pcMesh->mBones[i]->mNumWeights*3);
-    }
+    // the influences of the old vertices, gathered per new vertex afterwards
+    std::unique_ptr<aiBoneInfluences> tempInfluences;
+    const aiBoneInfluences* influences = pcMesh->HasBones() ? GetBoneInfluences(pcMesh, tempInfluences) : NULL;
+    std::vector<unsigned int> srcVertices(influences ? iNumVerts : 0);
 
     // iterate through all faces and build a clean list
     unsigned int iIndex = 0;
@@ -129,18 +130,9 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
         aiFace* pcFace = &pcMesh->mFaces[a];
         for (unsigned int q = 0; q < pcFace->mNumIndices;++q,++iIndex)
         {
-            // need to build a clean list of bones, too
-            for (unsigned int i = 0;i < pcMesh->mNumBones;++i)
-            {
-				for (unsigned int boneIdx = 0; boneIdx < pcMesh->mBones[i]->mNumWeights; ++boneIdx) {
-					const aiVertexWeight &w = pcMesh->mBones[i]->mWeights[boneIdx];
-                    if(pcFace->mIndices[q] == w.mVertexId) {
-                        aiVertexWeight wNew;
-                        wNew.mVertexId = iIndex;
-                        wNew.mWeight = w.mWeight;
-                        newWeights[i].push_back(wNew);
-                    }
-                }
+            // remember the source vertex to build a clean list of bones, too
+            if (influences) {
+                srcVertices[iIndex] = pcFace->mIndices[q];
             }
 
             pvPositions[iIndex] = pcMesh->mVertices[pcFace->mIndices[q]];
@@ -173,21 +165,6 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 
 
 
-    // build output vertex weights
-    for (unsigned int i = 0;i < pcMesh->mNumBones;++i)
-    {
-        delete [] pcMesh->mBones[i]->mWeights;
-        if (!newWeights[i].empty()) {
-            pcMesh->mBones[i]->mWeights = new aiVertexWeight[newWeights[i].size()];
-            aiVertexWeight *weightToCopy = &( newWeights[i][0] );
-            memcpy(pcMesh->mBones[i]->mWeights, weightToCopy,
-                sizeof(aiVertexWeight) * newWeights[i].size());
-        } else {
-            pcMesh->mBones[i]->mWeights = NULL;
-        }
-    }
-    delete[] newWeights;
-
     // delete the old members
     delete[] pcMesh->mVertices;
     pcMesh->mVertices = pvPositions;
@@ -208,6 +185,16 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
     }
     pcMesh->mNumVertices = iNumVerts;
 
+    // build output vertex weights
+    if (influences) {
+        std::unique_ptr<aiBoneInfluences> newInfluences(CopyBoneInfluences(*influences, srcVertices.data(), iNumVerts));
+        SetBoneWeights(pcMesh, *newInfluences);
+        if (!tempInfluences) {
+            delete pcMesh->mBoneInfluences;
+            pcMesh->mBoneInfluences = newInfluences.release();
+        }
+    }
+
     if (pcMesh->HasNormals())
     {
         delete[] pcMesh->mNormals;
@@ -88,6 +88,9 @@ public:
         return false;
     }
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "MakeVerboseFormatProcess"; }
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
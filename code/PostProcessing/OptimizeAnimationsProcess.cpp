@@ -0,0 +1,349 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file Implementation of the post processing step to remove animation keys
+ *  which can be reconstructed by interpolation.
+ */
+
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
+
+#include "PostProcessing/OptimizeAnimationsProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <class T>
+inline ai_real GetFactor(const T &from, const T &to, const T &at) {
+    const double span = to.mTime - from.mTime;
+    return span > 0.0 ? static_cast<ai_real>((at.mTime - from.mTime) / span) : ai_real(0.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Distance between a vector key and the linear interpolation of two others
+inline ai_real GetError(const aiVectorKey &from, const aiVectorKey &to, const aiVectorKey &at) {
+    const aiVector3D value = from.mValue + (to.mValue - from.mValue) * GetFactor(from, to, at);
+    return (value - at.mValue).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle between two rotations, taken from the chord length as acos() of the dot product is too
+// imprecise for the small angles the tolerances are about
+inline ai_real GetAngle(aiQuaternion a, aiQuaternion b) {
+    a.Normalize();
+    b.Normalize();
+    const ai_real sign = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z < ai_real(0.0) ? ai_real(-1.0) : ai_real(1.0);
+    const aiVector3D d(a.x - sign * b.x, a.y - sign * b.y, a.z - sign * b.z);
+    const ai_real chord = std::sqrt(d.SquareLength() + (a.w - sign * b.w) * (a.w - sign * b.w));
+    return ai_real(4.0) * std::asin(std::min(chord * ai_real(0.5), ai_real(1.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle between a rotation key and the spherical interpolation of two others
+inline ai_real GetError(const aiQuatKey &from, const aiQuatKey &to, const aiQuatKey &at) {
+    aiQuaternion value;
+    aiQuaternion::Interpolate(value, from.mValue, to.mValue, GetFactor(from, to, at));
+    return GetAngle(value, at.mValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsSame(const aiVectorKey &a, const aiVectorKey &b, ai_real maxError) {
+    return (a.mValue - b.mValue).Length() <= maxError;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsSame(const aiQuatKey &a, const aiQuatKey &b, ai_real maxError) {
+    return GetAngle(a.mValue, b.mValue) <= maxError;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Keeps the keys needed to reproduce the track within maxError and returns the number of removed
+// keys. The first and the last key are always kept, the key deviating most from the interpolation
+// of the kept keys around it is added until all deviations are small enough.
+template <class T>
+unsigned int ReduceTrack(T *&keys, unsigned int &numKeys, ai_real maxError) {
+    if (numKeys < 2) {
+        return 0;
+    }
+
+    // constant tracks need a single key only
+    bool constant = true;
+    for (unsigned int i = 1; i < numKeys && constant; ++i) {
+        constant = IsSame(keys[0], keys[i], maxError);
+    }
+
+    std::vector<bool> keep(numKeys, false);
+    keep[0] = true;
+    if (!constant) {
+        keep[numKeys - 1] = true;
+        std::vector<std::pair<unsigned int, unsigned int>> ranges;
+        ranges.push_back(std::make_pair(0u, numKeys - 1));
+        while (!ranges.empty()) {
+            const std::pair<unsigned int, unsigned int> range = ranges.back();
+            ranges.pop_back();
+
+            unsigned int worst = 0;
+            ai_real worstError = maxError;
+            for (unsigned int i = range.first + 1; i < range.second; ++i) {
+                const ai_real error = GetError(keys[range.first], keys[range.second], keys[i]);
+                if (error > worstError) {
+                    worst = i;
+                    worstError = error;
+                }
+            }
+            if (worst) {
+                keep[worst] = true;
+                ranges.push_back(std::make_pair(range.first, worst));
+                ranges.push_back(std::make_pair(worst, range.second));
+            }
+        }
+    }
+
+    const unsigned int numKept = static_cast<unsigned int>(std::count(keep.begin(), keep.end(), true));
+    if (numKept == numKeys) {
+        return 0;
+    }
+    T *kept = new T[numKept];
+    for (unsigned int i = 0, k = 0; i < numKeys; ++i) {
+        if (keep[i]) {
+            kept[k++] = keys[i];
+        }
+    }
+    delete[] keys;
+    keys = kept;
+
+    const unsigned int removed = numKeys - numKept;
+    numKeys = numKept;
+    return removed;
+}
+
+// ------------------------------------------------------------------------------------------------
+float *GetTimes(const aiVectorKey *keys, unsigned int numKeys) {
+    float *times = new float[numKeys];
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        times[i] = static_cast<float>(keys[i].mTime);
+    }
+    return times;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes vectors relative to their bounding box
+uint16_t *QuantizeVectors(const aiVectorKey *keys, unsigned int numKeys, aiVector3D &offset, aiVector3D &scale) {
+    aiVector3D min = keys[0].mValue, max = keys[0].mValue;
+    for (unsigned int i = 1; i < numKeys; ++i) {
+        const aiVector3D &v = keys[i].mValue;
+        min = aiVector3D(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+        max = aiVector3D(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+    }
+
+    // degenerated axes keep a scale of 1, like the vertex quantization does
+    offset = min;
+    scale = max - min;
+    for (unsigned int c = 0; c < 3; ++c) {
+        if (scale[c] <= ai_real(0.0)) {
+            scale[c] = ai_real(1.0);
+        }
+    }
+
+    uint16_t *out = new uint16_t[numKeys * 3];
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const ai_real v = (keys[i].mValue[c] - offset[c]) / scale[c];
+            out[i * 3 + c] = static_cast<uint16_t>(std::lround(std::max(ai_real(0.0), std::min(v, ai_real(1.0))) * 65535.0));
+        }
+    }
+    return out;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+OptimizeAnimationsProcess::OptimizeAnimationsProcess() :
+        BaseProcess(),
+        mPositionError(AI_OA_DEFAULT_POSITION_ERROR),
+        mRotationError(AI_OA_DEFAULT_ROTATION_ERROR),
+        mScaleError(AI_OA_DEFAULT_SCALE_ERROR),
+        mQuantize(false),
+        mNumThreads(1) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+OptimizeAnimationsProcess::~OptimizeAnimationsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool OptimizeAnimationsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool OptimizeAnimationsProcess::IsExtActive(unsigned int pExtFlags) const {
+    return 0 != (pExtFlags & aiProcessExt_OptimizeAnimations);
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::SetupProperties(const Importer *pImp) {
+    mPositionError = std::max(ai_real(0.0), pImp->GetPropertyFloat(AI_CONFIG_PP_OA_POSITION_ERROR, AI_OA_DEFAULT_POSITION_ERROR));
+    mRotationError = std::max(ai_real(0.0), pImp->GetPropertyFloat(AI_CONFIG_PP_OA_ROTATION_ERROR, AI_OA_DEFAULT_ROTATION_ERROR));
+    mScaleError = std::max(ai_real(0.0), pImp->GetPropertyFloat(AI_CONFIG_PP_OA_SCALE_ERROR, AI_OA_DEFAULT_SCALE_ERROR));
+    mQuantize = pImp->GetPropertyBool(AI_CONFIG_PP_OA_QUANTIZE, false);
+    mNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::Execute(aiScene *pScene) {
+    std::vector<aiNodeAnim *> channels;
+    for (unsigned int a = 0; pScene && a < pScene->mNumAnimations; ++a) {
+        const aiAnimation *animation = pScene->mAnimations[a];
+        channels.insert(channels.end(), animation->mChannels, animation->mChannels + animation->mNumChannels);
+    }
+    if (channels.empty()) {
+        ASSIMP_LOG_DEBUG("OptimizeAnimationsProcess skipped; there is nothing to do");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("OptimizeAnimationsProcess begin");
+
+    std::vector<unsigned int> numKeys(channels.size()), numRemoved(channels.size());
+    ParallelFor(mNumThreads, channels.size(), [&](size_t i) {
+        aiNodeAnim *channel = channels[i];
+        numKeys[i] = channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+        numRemoved[i] = ReduceKeys(channel, mPositionError, mRotationError, mScaleError);
+        if (mQuantize) {
+            QuantizeKeys(channel);
+        }
+    });
+
+    if (!DefaultLogger::isNullLogger()) {
+        unsigned int total = 0, removed = 0;
+        for (size_t i = 0; i < channels.size(); ++i) {
+            total += numKeys[i];
+            removed += numRemoved[i];
+        }
+        ASSIMP_LOG_INFO_F("OptimizeAnimationsProcess finished. Removed ", removed, " of ", total, " keys");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int OptimizeAnimationsProcess::ReduceKeys(aiNodeAnim *pChannel, ai_real pPositionError,
+        ai_real pRotationError, ai_real pScaleError) {
+    ai_assert(nullptr != pChannel);
+
+    unsigned int removed = ReduceTrack(pChannel->mPositionKeys, pChannel->mNumPositionKeys, pPositionError);
+    removed += ReduceTrack(pChannel->mRotationKeys, pChannel->mNumRotationKeys, pRotationError);
+    removed += ReduceTrack(pChannel->mScalingKeys, pChannel->mNumScalingKeys, pScaleError);
+
+    // the quantized keys no longer match
+    if (removed && pChannel->mQuantized) {
+        delete pChannel->mQuantized;
+        pChannel->mQuantized = nullptr;
+    }
+    return removed;
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::QuantizeKeys(aiNodeAnim *pChannel) {
+    ai_assert(nullptr != pChannel);
+
+    delete pChannel->mQuantized;
+    aiQuantizedNodeAnim *q = pChannel->mQuantized = new aiQuantizedNodeAnim();
+
+    if (pChannel->mNumPositionKeys) {
+        q->mNumPositionKeys = pChannel->mNumPositionKeys;
+        q->mPositionTimes = GetTimes(pChannel->mPositionKeys, pChannel->mNumPositionKeys);
+        q->mPositions = QuantizeVectors(pChannel->mPositionKeys, pChannel->mNumPositionKeys, q->mPositionOffset, q->mPositionScale);
+    }
+    if (pChannel->mNumScalingKeys) {
+        q->mNumScalingKeys = pChannel->mNumScalingKeys;
+        q->mScalingTimes = GetTimes(pChannel->mScalingKeys, pChannel->mNumScalingKeys);
+        q->mScalings = QuantizeVectors(pChannel->mScalingKeys, pChannel->mNumScalingKeys, q->mScalingOffset, q->mScalingScale);
+    }
+    if (pChannel->mNumRotationKeys) {
+        q->mNumRotationKeys = pChannel->mNumRotationKeys;
+        q->mRotationTimes = new float[pChannel->mNumRotationKeys];
+        q->mRotations = new uint16_t[pChannel->mNumRotationKeys * 3];
+        for (unsigned int i = 0; i < pChannel->mNumRotationKeys; ++i) {
+            q->mRotationTimes[i] = static_cast<float>(pChannel->mRotationKeys[i].mTime);
+            EncodeRotation(pChannel->mRotationKeys[i].mValue, q->mRotations + i * 3);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::EncodeRotation(const aiQuaternion &pRotation, uint16_t *pOut) {
+    aiQuaternion q = pRotation;
+    q.Normalize();
+    const ai_real c[4] = { q.w, q.x, q.y, q.z };
+
+    // the dropped component is restored as positive value, q and -q are the same rotation
+    unsigned int largest = 0;
+    for (unsigned int i = 1; i < 4; ++i) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) {
+            largest = i;
+        }
+    }
+    const ai_real sign = c[largest] < ai_real(0.0) ? ai_real(-1.0) : ai_real(1.0);
+
+    // the other components are within [-1/sqrt(2), 1/sqrt(2)]
+    for (unsigned int i = 0, k = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const ai_real v = (c[i] * sign * ai_real(1.41421356237309504880) + ai_real(1.0)) * ai_real(0.5);
+        pOut[k++] = static_cast<uint16_t>(std::lround(std::max(ai_real(0.0), std::min(v, ai_real(1.0))) * 32767.0));
+    }
+    pOut[0] |= static_cast<uint16_t>((largest & 0x2) << 14);
+    pOut[1] |= static_cast<uint16_t>((largest & 0x1) << 15);
+}
+
+#endif // !! ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
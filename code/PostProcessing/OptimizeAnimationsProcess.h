@@ -0,0 +1,129 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to remove redundant animation keys */
+#pragma once
+#ifndef AI_OPTIMIZEANIMATIONSPROCESS_H_INC
+#define AI_OPTIMIZEANIMATIONSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/types.h>
+
+struct aiNodeAnim;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The OptimizeAnimationsProcess removes the keys of each node animation
+ *  channel which interpolating the remaining keys reproduces within an
+ *  error bound, and optionally attaches quantized copies of the remaining
+ *  keys (#aiNodeAnim::mQuantized).
+ *
+ *  Keys are selected per track by recursive subdivision: starting with the
+ *  first and the last key, the key deviating most from the interpolation
+ *  between the selected keys is added until all deviations are in bounds.
+ */
+class ASSIMP_API OptimizeAnimationsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    OptimizeAnimationsProcess();
+
+    /// The class destructor.
+    ~OptimizeAnimationsProcess();
+
+    /// Will return false, the step is enabled via the extended flags only.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "OptimizeAnimationsProcess"; }
+
+    /// Will return true, if aiProcessExt_OptimizeAnimations is defined.
+    bool IsExtActive(unsigned int pExtFlags) const override;
+
+    /// Reads the error bounds, quantization and threading configuration.
+    void SetupProperties(const Importer *pImp) override;
+
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Removes the redundant keys of a single channel.
+     *  @param pChannel The channel to process.
+     *  @param pPositionError Maximum position deviation.
+     *  @param pRotationError Maximum rotation deviation, in radians.
+     *  @param pScaleError Maximum scaling deviation.
+     *  @return The number of removed keys. */
+    static unsigned int ReduceKeys(aiNodeAnim *pChannel, ai_real pPositionError,
+            ai_real pRotationError, ai_real pScaleError);
+
+    // -------------------------------------------------------------------
+    /** Generates the quantized keys of a single channel, replacing
+     *  existing ones. */
+    static void QuantizeKeys(aiNodeAnim *pChannel);
+
+    /// Encodes a rotation in smallest three encoding, see aiQuantizedNodeAnim.
+    static void EncodeRotation(const aiQuaternion &pRotation, uint16_t *pOut);
+
+private:
+    //! Maximum position deviation
+    ai_real mPositionError;
+
+    //! Maximum rotation deviation, in radians
+    ai_real mRotationError;
+
+    //! Maximum scaling deviation
+    ai_real mScaleError;
+
+    //! Whether to attach quantized keys
+    bool mQuantize;
+
+    //! Number of worker threads, see AI_CONFIG_GLOB_MULTITHREADING
+    unsigned int mNumThreads;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
+
+#endif // AI_OPTIMIZEANIMATIONSPROCESS_H_INC
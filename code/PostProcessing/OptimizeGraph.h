@@ -77,6 +77,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const override;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "OptimizeGraphProcess"; }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene) override;
 
@@ -98,6 +98,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "OptimizeMeshesProcess"; }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
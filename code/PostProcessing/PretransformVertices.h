@@ -75,6 +75,9 @@ public:
 	// Check whether step is active
 	bool IsActive(unsigned int pFlags) const override;
 
+	// -------------------------------------------------------------------
+	const char *GetName() const override { return "PretransformVertices"; }
+
 	// -------------------------------------------------------------------
 	// Execute step on a given scene
 	void Execute(aiScene *pScene) override;
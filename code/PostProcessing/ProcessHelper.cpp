@@ -45,8 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "ProcessHelper.h"
+#include <assimp/Hash.h>
 
 
+#include <algorithm>
 #include <limits>
 
 namespace Assimp {
@@ -176,6 +178,25 @@ ai_real ComputePositionEpsilon(const aiMesh* const* pMeshes, size_t num)
 }
 
 
+// -------------------------------------------------------------------------------
+uint32_t ComputePositionChecksum(const aiMesh* pMesh)
+{
+    ai_assert( NULL != pMesh );
+
+    // hash in slices, SuperFastHash takes a 32 bit length
+    static const size_t SliceSize = 1u << 30;
+    const char* data = reinterpret_cast<const char*>(pMesh->mVertices);
+    size_t remaining = pMesh->mVertices ? sizeof(aiVector3D) * pMesh->mNumVertices : 0;
+    uint32_t hash = pMesh->mNumVertices;
+    while (remaining) {
+        const size_t slice = std::min(remaining, SliceSize);
+        hash = SuperFastHash(data, static_cast<uint32_t>(slice), hash);
+        data += slice;
+        remaining -= slice;
+    }
+    return hash;
+}
+
 // -------------------------------------------------------------------------------
 unsigned int GetMeshVFormatUnique(const aiMesh* pcMesh)
 {
@@ -230,6 +251,124 @@ VertexWeightTable* ComputeVertexBoneWeightTable(const aiMesh* pMesh)
     return avPerVertexWeights;
 }
 
+// -------------------------------------------------------------------------------
+aiBoneInfluences* ComputeBoneInfluences(const aiMesh* pMesh)
+{
+    if (!pMesh || !pMesh->mNumVertices || !pMesh->HasBones()) {
+        return NULL;
+    }
+
+    // the widest vertex determines the number of slots. The mesh need not have been
+    // validated, so weights of vertices which don't exist are skipped.
+    std::vector<unsigned int> numUsed(pMesh->mNumVertices, 0);
+    unsigned int numSlots = 1;
+    unsigned int numInvalid = 0;
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        const aiBone* bone = pMesh->mBones[i];
+        for (unsigned int a = 0; a < bone->mNumWeights; ++a) {
+            const aiVertexWeight& weight = bone->mWeights[a];
+            if (weight.mVertexId >= pMesh->mNumVertices) {
+                ++numInvalid;
+            } else if (weight.mWeight != 0.0) {
+                numSlots = std::max(numSlots, ++numUsed[weight.mVertexId]);
+            }
+        }
+    }
+    if (numInvalid) {
+        ASSIMP_LOG_WARN_F("ComputeBoneInfluences: skipping ", numInvalid, " bone weights of vertices out of range");
+    }
+
+    aiBoneInfluences* out = new aiBoneInfluences();
+    const size_t size = static_cast<size_t>(pMesh->mNumVertices) * numSlots;
+    out->mNumInfluences = numSlots;
+    out->mBoneIndices = new unsigned int[size]();
+    out->mWeights = new ai_real[size]();
+
+    // insert each weight into the sorted slots of its vertex, bones of equal weight keep their order
+    std::fill(numUsed.begin(), numUsed.end(), 0);
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        const aiBone* bone = pMesh->mBones[i];
+        for (unsigned int a = 0; a < bone->mNumWeights; ++a) {
+            const aiVertexWeight& weight = bone->mWeights[a];
+            if (weight.mWeight == 0.0 || weight.mVertexId >= pMesh->mNumVertices) {
+                continue;
+            }
+            unsigned int* const bones = out->mBoneIndices + static_cast<size_t>(weight.mVertexId) * numSlots;
+            ai_real* const weights = out->mWeights + static_cast<size_t>(weight.mVertexId) * numSlots;
+            unsigned int slot = numUsed[weight.mVertexId]++;
+            for (; slot > 0 && weights[slot - 1] < weight.mWeight; --slot) {
+                bones[slot] = bones[slot - 1];
+                weights[slot] = weights[slot - 1];
+            }
+            bones[slot] = i;
+            weights[slot] = weight.mWeight;
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------------------------
+const aiBoneInfluences* GetBoneInfluences(const aiMesh* pMesh, std::unique_ptr<aiBoneInfluences>& temp)
+{
+    if (pMesh->HasBoneInfluences()) {
+        return pMesh->mBoneInfluences;
+    }
+    temp.reset(ComputeBoneInfluences(pMesh));
+    return temp.get();
+}
+
+// -------------------------------------------------------------------------------
+aiBoneInfluences* CopyBoneInfluences(const aiBoneInfluences& src, const unsigned int* srcVertices,
+        unsigned int numVertices, const unsigned int* boneMap)
+{
+    const unsigned int numSlots = src.mNumInfluences;
+    aiBoneInfluences* out = new aiBoneInfluences();
+    out->mNumInfluences = numSlots;
+    out->mBoneIndices = new unsigned int[static_cast<size_t>(numVertices) * numSlots];
+    out->mWeights = new ai_real[static_cast<size_t>(numVertices) * numSlots];
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const size_t from = static_cast<size_t>(srcVertices[i]) * numSlots, to = static_cast<size_t>(i) * numSlots;
+        std::copy(src.mWeights + from, src.mWeights + from + numSlots, out->mWeights + to);
+        for (unsigned int s = 0; s < numSlots; ++s) {
+            const unsigned int bone = src.mBoneIndices[from + s];
+            out->mBoneIndices[to + s] = (boneMap && src.mWeights[from + s] != 0.0) ? boneMap[bone] : bone;
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------------------------
+void SetBoneWeights(aiMesh* pMesh, const aiBoneInfluences& influences)
+{
+    const unsigned int numSlots = influences.mNumInfluences;
+    const size_t size = static_cast<size_t>(pMesh->mNumVertices) * numSlots;
+
+    std::vector<unsigned int> numWeights(pMesh->mNumBones, 0);
+    for (size_t i = 0; i < size; ++i) {
+        if (influences.mWeights[i] != 0.0) {
+            ++numWeights[influences.mBoneIndices[i]];
+        }
+    }
+
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        aiBone* bone = pMesh->mBones[i];
+        if (bone->mNumWeights != numWeights[i]) {
+            delete[] bone->mWeights;
+            bone->mWeights = numWeights[i] ? new aiVertexWeight[numWeights[i]] : NULL;
+        }
+        bone->mNumWeights = 0;
+    }
+
+    // vertex by vertex, so the weights of each bone end up sorted by vertex index
+    for (size_t i = 0; i < size; ++i) {
+        if (influences.mWeights[i] != 0.0) {
+            aiBone* bone = pMesh->mBones[influences.mBoneIndices[i]];
+            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(static_cast<unsigned int>(i / numSlots), influences.mWeights[i]);
+        }
+    }
+}
+
 // -------------------------------------------------------------------------------
 const char* MappingTypeToString(aiTextureMapping in)
 {
@@ -394,6 +533,23 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 
             ai_assert(nbParanoia==oMesh->mNumBones);
             (void)nbParanoia; // remove compiler warning on release build
+
+            // carry the per-vertex influences over, with the bone indices of the submesh
+            if(pMesh->HasBoneInfluences()) {
+                std::vector<unsigned int> boneMap(pMesh->mNumBones,0), srcVertices(numSubVerts);
+                for(unsigned int a=0,b=0;a<pMesh->mNumBones;++a) {
+                    if(subBones[a]>0) {
+                        boneMap[a] = b++;
+                    }
+                }
+                for(unsigned int srcIndex = 0; srcIndex < pMesh->mNumVertices; ++srcIndex) {
+                    if(vMap[srcIndex]!=UINT_MAX) {
+                        srcVertices[vMap[srcIndex]] = srcIndex;
+                    }
+                }
+                oMesh->mBoneInfluences = CopyBoneInfluences(*pMesh->mBoneInfluences,srcVertices.data(),
+                        oMesh->mNumVertices,boneMap.data());
+            }
         }
     }
 
@@ -49,12 +49,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 #include <assimp/SpatialSort.h>
 #include "Common/BaseProcess.h"
+#include "Common/ParallelFor.h"
+#include "Common/ScenePrivate.h"
 #include <assimp/ParsingUtils.h>
 
 #include <list>
+#include <memory>
 
 // -------------------------------------------------------------------------------
 // Some extensions to std namespace. Mainly std::min and std::max for all
@@ -303,6 +308,11 @@ ai_real ComputePositionEpsilon(const aiMesh* pMesh);
 ai_real ComputePositionEpsilon(const aiMesh* const* pMeshes, size_t num);
 
 
+// -------------------------------------------------------------------------------
+// Compute a checksum over the vertex positions of a mesh
+uint32_t ComputePositionChecksum(const aiMesh* pMesh);
+
+
 // -------------------------------------------------------------------------------
 // Compute an unique value for the vertex format of a mesh
 unsigned int GetMeshVFormatUnique(const aiMesh* pcMesh);
@@ -316,6 +326,27 @@ typedef std::vector <PerVertexWeight> VertexWeightTable;
 // Compute a per-vertex bone weight table
 VertexWeightTable* ComputeVertexBoneWeightTable(const aiMesh* pMesh);
 
+// -------------------------------------------------------------------------------
+// Compute the per-vertex bone influence table of a mesh from the weights of its
+// bones. Returns NULL for meshes without bones.
+ASSIMP_API aiBoneInfluences* ComputeBoneInfluences(const aiMesh* pMesh);
+
+// -------------------------------------------------------------------------------
+// Get the bone influence table of a mesh. Meshes not carrying one get a table
+// computed into temp which lives as long as temp does.
+const aiBoneInfluences* GetBoneInfluences(const aiMesh* pMesh, std::unique_ptr<aiBoneInfluences>& temp);
+
+// -------------------------------------------------------------------------------
+// Gather the influences of the vertices srcVertices[0..numVertices-1] of a table
+// into a new one. Bone indices are translated by boneMap unless it is NULL.
+aiBoneInfluences* CopyBoneInfluences(const aiBoneInfluences& src, const unsigned int* srcVertices,
+        unsigned int numVertices, const unsigned int* boneMap = NULL);
+
+// -------------------------------------------------------------------------------
+// Rebuild the weight lists of all bones of a mesh from an influence table. Bones
+// not referenced by the table end up with an empty weight list.
+void SetBoneWeights(aiMesh* pMesh, const aiBoneInfluences& influences);
+
 // -------------------------------------------------------------------------------
 // Get a string for a given aiTextureMapping
 const char* MappingTypeToString(aiTextureMapping in);
@@ -333,29 +364,92 @@ aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &su
 // all steps which use it to speedup its computations.
 class ComputeSpatialSortProcess : public BaseProcess
 {
+public:
+    ComputeSpatialSortProcess() : incremental(false), numThreads(1) {}
+
     bool IsActive( unsigned int pFlags) const
     {
         return NULL != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    const char *GetName() const { return "ComputeSpatialSortProcess"; }
+
+    bool IsPerMeshStep() const
+    {
+        return true;
+    }
+
+    void SetupProperties(const Importer* pImp)
+    {
+        incremental = pImp->GetPropertyBool(AI_CONFIG_PP_INCREMENTAL, false);
+        numThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+    }
+
     void Execute( aiScene* pScene)
     {
         typedef std::pair<SpatialSort, ai_real> _Type;
         ASSIMP_LOG_DEBUG("Generate spatially-sorted vertex cache");
 
         std::vector<_Type>* p = new std::vector<_Type>(pScene->mNumMeshes);
-        std::vector<_Type>::iterator it = p->begin();
 
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
+        // In incremental mode the sorted tables survive between calls, an entry stays
+        // valid as long as it belongs to the same mesh and the positions are unchanged.
+        // The cached tables are lent to this run rather than copied and go back into
+        // the cache in DestroySpatialSortProcess.
+        std::vector<ScenePrivateData::SpatialSortCacheEntry> *cache = nullptr;
+        if (incremental && nullptr != pScene->mPrivate) {
+            cache = &ScenePriv(pScene)->mSpatialSortCache;
+            cache->resize(pScene->mNumMeshes);
+        }
+
+        auto sortMesh = [&](unsigned int i, unsigned int sortThreads) {
             aiMesh* mesh = pScene->mMeshes[i];
-            _Type& blubb = *it;
-            blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
-            blubb.second = ComputePositionEpsilon(mesh);
+            _Type& blubb = (*p)[i];
+            if (nullptr == cache) {
+                blubb.first.SetNumThreads(sortThreads);
+                blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
+                blubb.second = ComputePositionEpsilon(mesh);
+                return;
+            }
+
+            ScenePrivateData::SpatialSortCacheEntry &entry = (*cache)[i];
+            const uint32_t checksum = ComputePositionChecksum(mesh);
+            // an entry still marked as lent never came back from an aborted run
+            if (entry.mLent || entry.mMesh != mesh || entry.mNumVertices != mesh->mNumVertices || entry.mChecksum != checksum) {
+                entry.mSort.SetNumThreads(sortThreads);
+                entry.mSort.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
+                entry.mEpsilon = ComputePositionEpsilon(mesh);
+                entry.mMesh = mesh;
+                entry.mNumVertices = mesh->mNumVertices;
+                entry.mChecksum = checksum;
+            }
+            blubb.first.Swap(entry.mSort);
+            blubb.second = entry.mEpsilon;
+            entry.mLent = true;
+        };
+
+        // small meshes are sorted in parallel, large ones one after the other using all threads
+        static const unsigned int LargeMeshVertices = 1 << 16;
+        std::vector<unsigned int> smallMeshes, largeMeshes;
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            if (IsMeshSelected(i)) {
+                (pScene->mMeshes[i]->mNumVertices >= LargeMeshVertices ? largeMeshes : smallMeshes).push_back(i);
+            }
+        }
+        ParallelFor(numThreads, smallMeshes.size(), [&](size_t a) {
+            sortMesh(smallMeshes[a], 1);
+        });
+        for (unsigned int i : largeMeshes) {
+            sortMesh(i, numThreads);
         }
 
         shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
     }
+
+private:
+    bool incremental;
+    unsigned int numThreads;
 };
 
 // -------------------------------------------------------------------------------
@@ -368,8 +462,27 @@ class DestroySpatialSortProcess : public BaseProcess
             aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
-    void Execute( aiScene* /*pScene*/)
+    const char *GetName() const { return "DestroySpatialSortProcess"; }
+
+    bool IsPerMeshStep() const
     {
+        return true;
+    }
+
+    void Execute( aiScene* pScene)
+    {
+        // return the trees lent by ComputeSpatialSortProcess to the cache
+        std::vector<std::pair<SpatialSort, ai_real> > *p = nullptr;
+        shared->GetProperty(AI_SPP_SPATIAL_SORT, p);
+        if (nullptr != p && nullptr != pScene->mPrivate) {
+            std::vector<ScenePrivateData::SpatialSortCacheEntry> &cache = ScenePriv(pScene)->mSpatialSortCache;
+            for (size_t i = 0; i < cache.size() && i < p->size(); ++i) {
+                if (cache[i].mLent) {
+                    cache[i].mSort.Swap((*p)[i].first);
+                    cache[i].mLent = false;
+                }
+            }
+        }
         shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
     }
 };
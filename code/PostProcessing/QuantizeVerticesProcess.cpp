@@ -0,0 +1,317 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post processing step to generate compact
+ *  companion copies of the vertex streams.
+ */
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#include "PostProcessing/QuantizeVerticesProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+inline float SignNotZero(float v) {
+    return v < 0.0f ? -1.0f : 1.0f;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int16_t ToSnorm16(float v) {
+    return static_cast<int16_t>(std::lround(std::max(-1.0f, std::min(v, 1.0f)) * 32767.0f));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline uint16_t ToUnorm16(float v) {
+    return static_cast<uint16_t>(std::lround(std::max(0.0f, std::min(v, 1.0f)) * 65535.0f));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline uint8_t ToUnorm8(float v) {
+    return static_cast<uint8_t>(std::lround(std::max(0.0f, std::min(v, 1.0f)) * 255.0f));
+}
+
+// ------------------------------------------------------------------------------------------------
+int16_t *EncodeDirections(const aiVector3D *in, unsigned int numVertices) {
+    if (nullptr == in) {
+        return nullptr;
+    }
+    int16_t *out = new int16_t[numVertices * 2];
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        QuantizeVerticesProcess::EncodeOctahedral(in[i], out + i * 2);
+    }
+    return out;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+QuantizeVerticesProcess::QuantizeVerticesProcess() :
+        BaseProcess(),
+        mNumThreads(1) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+QuantizeVerticesProcess::~QuantizeVerticesProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::IsExtActive(unsigned int pExtFlags) const {
+    return 0 != (pExtFlags & aiProcessExt_QuantizeVertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::SetupProperties(const Importer *pImp) {
+    mNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::Execute(aiScene *pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("QuantizeVerticesProcess skipped; there is nothing to do");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("QuantizeVerticesProcess begin");
+
+    ParallelFor(mNumThreads, pScene->mNumMeshes, [&](size_t i) {
+        ProcessMesh(pScene->mMeshes[i]);
+    });
+
+    ASSIMP_LOG_DEBUG("QuantizeVerticesProcess finished");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::ProcessMesh(aiMesh *pMesh) {
+    ai_assert(nullptr != pMesh);
+
+    delete pMesh->mQuantized;
+    pMesh->mQuantized = nullptr;
+    if (!pMesh->HasPositions()) {
+        return false;
+    }
+
+    const unsigned int numVertices = pMesh->mNumVertices;
+    aiQuantizedVertices *q = pMesh->mQuantized = new aiQuantizedVertices();
+
+    // use the box from aiProcess_GenBoundingBoxes, unless it is missing
+    aiAABB box = pMesh->mAABB;
+    if (box.mMin == box.mMax) {
+        box.mMin = box.mMax = pMesh->mVertices[0];
+        for (unsigned int i = 1; i < numVertices; ++i) {
+            const aiVector3D &v = pMesh->mVertices[i];
+            box.mMin = aiVector3D(std::min(box.mMin.x, v.x), std::min(box.mMin.y, v.y), std::min(box.mMin.z, v.z));
+            box.mMax = aiVector3D(std::max(box.mMax.x, v.x), std::max(box.mMax.y, v.y), std::max(box.mMax.z, v.z));
+        }
+    }
+
+    // degenerated axes keep a scale of 1, so the decoding transform stays invertible
+    q->mPositionOffset = box.mMin;
+    q->mPositionScale = box.mMax - box.mMin;
+    for (unsigned int c = 0; c < 3; ++c) {
+        if (!(q->mPositionScale[c] > 0)) {
+            q->mPositionScale[c] = 1;
+        }
+    }
+
+    q->mPositions = new uint16_t[numVertices * 3];
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const aiVector3D &v = pMesh->mVertices[i];
+        for (unsigned int c = 0; c < 3; ++c) {
+            q->mPositions[i * 3 + c] = ToUnorm16(static_cast<float>((v[c] - q->mPositionOffset[c]) / q->mPositionScale[c]));
+        }
+    }
+
+    q->mNormals = EncodeDirections(pMesh->mNormals, numVertices);
+    q->mTangents = EncodeDirections(pMesh->mTangents, numVertices);
+
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        if (!pMesh->HasTextureCoords(a)) {
+            continue;
+        }
+        uint16_t *uv = q->mTextureCoords[a] = new uint16_t[numVertices * 2];
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            uv[i * 2 + 0] = FloatToHalf(static_cast<float>(pMesh->mTextureCoords[a][i].x));
+            uv[i * 2 + 1] = FloatToHalf(static_cast<float>(pMesh->mTextureCoords[a][i].y));
+        }
+    }
+
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        if (!pMesh->HasVertexColors(a)) {
+            continue;
+        }
+        uint8_t *rgba = q->mColors[a] = new uint8_t[numVertices * 4];
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            const aiColor4D &c = pMesh->mColors[a][i];
+            rgba[i * 4 + 0] = ToUnorm8(static_cast<float>(c.r));
+            rgba[i * 4 + 1] = ToUnorm8(static_cast<float>(c.g));
+            rgba[i * 4 + 2] = ToUnorm8(static_cast<float>(c.b));
+            rgba[i * 4 + 3] = ToUnorm8(static_cast<float>(c.a));
+        }
+    }
+
+    // levels of detail are complete meshes of their own
+    for (unsigned int i = 0; i < pMesh->mNumLODs; ++i) {
+        ProcessMesh(pMesh->mLODs[i]);
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::EncodeOctahedral(const aiVector3D &v, int16_t *out) {
+    const float l1 = static_cast<float>(std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z));
+    if (l1 <= 0.0f) {
+        out[0] = out[1] = 0;
+        return;
+    }
+
+    // project onto the octahedron, fold the lower hemisphere over the upper one
+    float x = static_cast<float>(v.x) / l1, y = static_cast<float>(v.y) / l1;
+    if (v.z < 0) {
+        const float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D QuantizeVerticesProcess::DecodeOctahedral(const int16_t *in) {
+    float x = std::max(in[0] / 32767.0f, -1.0f), y = std::max(in[1] / 32767.0f, -1.0f);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f) {
+        const float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    aiVector3D v(x, y, z);
+    return v.NormalizeSafe();
+}
+
+// ------------------------------------------------------------------------------------------------
+uint16_t QuantizeVerticesProcess::FloatToHalf(float value) {
+    uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t absBits = bits & 0x7fffffff;
+
+    // infinity and NaN
+    if (absBits >= 0x7f800000) {
+        return static_cast<uint16_t>(sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0));
+    }
+
+    // overflow, everything rounding to 65520 or more
+    if (absBits >= 0x477ff000) {
+        return static_cast<uint16_t>(sign | 0x7c00);
+    }
+
+    // subnormal half floats and zero
+    if (absBits < 0x38800000) {
+        if (absBits < 0x33000000) {
+            return sign;
+        }
+        const uint32_t shift = 126 - (absBits >> 23);
+        const uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        uint32_t result = mantissa >> shift;
+        if (remainder > halfway || (remainder == halfway && (result & 1))) {
+            ++result;
+        }
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    // normalized numbers: rebias the exponent, round the mantissa to nearest even
+    uint32_t result = (absBits - 0x38000000) >> 13;
+    const uint32_t remainder = absBits & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1))) {
+        ++result;
+    }
+    return static_cast<uint16_t>(sign | result);
+}
+
+// ------------------------------------------------------------------------------------------------
+float QuantizeVerticesProcess::HalfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1f;
+    const uint32_t mantissa = value & 0x3ff;
+
+    if (0 == exponent) {
+        const float f = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -f : f;
+    }
+
+    uint32_t bits;
+    if (0x1f == exponent) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float result;
+    ::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+#endif // !! ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
@@ -0,0 +1,117 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to generate compact vertex streams */
+#pragma once
+#ifndef AI_QUANTIZEVERTICESPROCESS_H_INC
+#define AI_QUANTIZEVERTICESPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/types.h>
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The QuantizeVerticesProcess attaches compact copies of the vertex
+ *  streams to each mesh (#aiMesh::mQuantized): 16 bit positions relative
+ *  to the bounding box, octahedral normals and tangents, half float
+ *  texture coordinates and RGBA8 colors.
+ *
+ *  The bounding box computed by #aiProcess_GenBoundingBoxes is used if
+ *  present, otherwise it is computed on the fly.
+ */
+class ASSIMP_API QuantizeVerticesProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    QuantizeVerticesProcess();
+
+    /// The class destructor.
+    ~QuantizeVerticesProcess();
+
+    /// Will return false, the step is enabled via the extended flags only.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    const char *GetName() const override { return "QuantizeVerticesProcess"; }
+
+    /// Will return true, if aiProcessExt_QuantizeVertices is defined.
+    bool IsExtActive(unsigned int pExtFlags) const override;
+
+    /// Reads the threading configuration from the importer.
+    void SetupProperties(const Importer *pImp) override;
+
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    // -------------------------------------------------------------------
+    /** Generates the quantized streams of a single mesh, replacing
+     *  existing ones.
+     *  @param pMesh The mesh to process.
+     *  @return true if the mesh has vertices. */
+    static bool ProcessMesh(aiMesh *pMesh);
+
+    /// Encodes a unit vector into two signed normalized values.
+    static void EncodeOctahedral(const aiVector3D &v, int16_t *out);
+
+    /// Decodes an octahedral encoded vector, the result is normalized.
+    static aiVector3D DecodeOctahedral(const int16_t *in);
+
+    /// Converts a float to an IEEE 754 half float, rounding to nearest.
+    static uint16_t FloatToHalf(float value);
+
+    /// Converts an IEEE 754 half float to a float.
+    static float HalfToFloat(uint16_t value);
+
+private:
+    //! Number of worker threads, see AI_CONFIG_GLOB_MULTITHREADING
+    unsigned int mNumThreads;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#endif // AI_QUANTIZEVERTICESPROCESS_H_INC
@@ -69,6 +69,9 @@ public:
     // Check whether step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "RemoveRedundantMatsProcess"; }
+
     // -------------------------------------------------------------------
     // Execute step on a given scene
     void Execute( aiScene* pScene);
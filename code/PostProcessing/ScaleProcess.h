@@ -77,6 +77,9 @@ public:
     /// Overwritten, @see BaseProcess
     virtual bool IsActive( unsigned int pFlags ) const;
 
+    // -------------------------------------------------------------------
+    virtual const char *GetName() const { return "ScaleProcess"; }
+
     /// Overwritten, @see BaseProcess
     virtual void SetupProperties( const Importer* pImp );
 
@@ -66,6 +66,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "SortByPTypeProcess"; }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
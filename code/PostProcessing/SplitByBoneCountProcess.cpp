@@ -46,23 +46,339 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <memory>
+#include <unordered_map>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <set>
 
 using namespace Assimp;
 using namespace Assimp::Formatter;
 
+namespace {
+
+// bone sets are bit masks over the bones of a mesh, numWords consecutive words per set
+typedef uint64_t BoneWord;
+const unsigned int BitsPerWord = 64;
+
+// ------------------------------------------------------------------------------------------------
+inline unsigned int CountBits( BoneWord w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(w));
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ull);
+    w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned int>((w * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Faces affected by the same set of bones
+struct FaceGroup
+{
+    std::vector<unsigned int> mFaces;
+    unsigned int mNumBones;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Groups the faces of a mesh by the set of bones affecting their vertices. masks receives the bone
+// set of each group.
+void GroupFacesByBones( const aiMesh* pMesh, const aiBoneInfluences& influences, size_t numWords,
+        size_t maxBones, std::vector<FaceGroup>& groups, std::vector<BoneWord>& masks)
+{
+    const unsigned int numSlots = influences.mNumInfluences;
+    std::vector<BoneWord> mask( numWords);
+    std::unordered_multimap<uint64_t, unsigned int> groupsByHash;
+
+    for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+    {
+        std::fill( mask.begin(), mask.end(), 0);
+        const aiFace& face = pMesh->mFaces[a];
+        for( unsigned int b = 0; b < face.mNumIndices; ++b)
+        {
+            const size_t row = static_cast<size_t>(face.mIndices[b]) * numSlots;
+            for( unsigned int c = 0; c < numSlots && influences.mWeights[row + c] != 0.0; ++c)
+            {
+                const unsigned int bone = influences.mBoneIndices[row + c];
+                mask[bone / BitsPerWord] |= BoneWord(1) << (bone % BitsPerWord);
+            }
+        }
+
+        uint64_t hash = 14695981039346656037ull;
+        unsigned int numBones = 0;
+        for( size_t w = 0; w < numWords; ++w)
+        {
+            hash = (hash ^ mask[w]) * 1099511628211ull;
+            numBones += CountBits( mask[w]);
+        }
+        if( numBones > maxBones )
+        {
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
+        }
+
+        // faces with the same bones end up in the same group
+        unsigned int group = std::numeric_limits<unsigned int>::max();
+        const auto range = groupsByHash.equal_range( hash);
+        for( auto it = range.first; it != range.second; ++it)
+        {
+            if( std::equal( mask.begin(), mask.end(), masks.begin() + it->second * numWords) )
+            {
+                group = it->second;
+                break;
+            }
+        }
+        if( group == std::numeric_limits<unsigned int>::max() )
+        {
+            group = static_cast<unsigned int>(groups.size());
+            groups.push_back( FaceGroup());
+            groups.back().mNumBones = numBones;
+            masks.insert( masks.end(), mask.begin(), mask.end());
+            groupsByHash.insert( std::make_pair( hash, group));
+        }
+        groups[group].mFaces.push_back( a);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Merges the face groups greedily into as few clusters of at most maxBones bones as possible. Each
+// cluster is seeded with the remaining group using the most bones. Groups whose bones are all in the
+// cluster already join it for free, of the others the one adding the fewest new bones - and sharing
+// the most - is merged until no group fits anymore.
+void ClusterFaceGroups( const std::vector<FaceGroup>& groups, const std::vector<BoneWord>& masks, size_t numWords,
+        size_t maxBones, std::vector<std::vector<unsigned int> >& clusterFaces, std::vector<BoneWord>& clusterMasks)
+{
+    std::vector<unsigned int> remaining( groups.size());
+    for( unsigned int a = 0; a < remaining.size(); ++a)
+    {
+        remaining[a] = a;
+    }
+    std::stable_sort( remaining.begin(), remaining.end(), [&groups]( unsigned int x, unsigned int y) {
+        return groups[x].mNumBones > groups[y].mNumBones;
+    });
+
+    std::vector<BoneWord> mask( numWords);
+    std::vector<unsigned int> members;
+    while( !remaining.empty() )
+    {
+        const unsigned int seed = remaining.front();
+        remaining.erase( remaining.begin());
+        std::copy( masks.begin() + seed * numWords, masks.begin() + (seed + 1) * numWords, mask.begin());
+        size_t numBones = groups[seed].mNumBones;
+        members.assign( 1, seed);
+
+        for( ;; )
+        {
+            size_t best = std::numeric_limits<size_t>::max(), keep = 0;
+            unsigned int bestAdded = std::numeric_limits<unsigned int>::max(), bestShared = 0;
+            for( size_t a = 0; a < remaining.size(); ++a)
+            {
+                const unsigned int group = remaining[a];
+                const BoneWord* groupMask = &masks[group * numWords];
+                unsigned int added = 0, shared = 0;
+                for( size_t w = 0; w < numWords; ++w)
+                {
+                    added += CountBits( groupMask[w] & ~mask[w]);
+                    shared += CountBits( groupMask[w] & mask[w]);
+                }
+                if( 0 == added )
+                {
+                    members.push_back( group);
+                    continue;
+                }
+
+                remaining[keep++] = group;
+                if( numBones + added <= maxBones && (added < bestAdded || (added == bestAdded && shared > bestShared)) )
+                {
+                    best = keep - 1;
+                    bestAdded = added;
+                    bestShared = shared;
+                }
+            }
+            remaining.resize( keep);
+            if( best == std::numeric_limits<size_t>::max() )
+            {
+                break;
+            }
+
+            const unsigned int group = remaining[best];
+            remaining.erase( remaining.begin() + best);
+            members.push_back( group);
+            for( size_t w = 0; w < numWords; ++w)
+            {
+                mask[w] |= masks[group * numWords + w];
+            }
+            numBones += bestAdded;
+        }
+
+        // the faces of a cluster keep their original order
+        clusterFaces.push_back( std::vector<unsigned int>());
+        std::vector<unsigned int>& faces = clusterFaces.back();
+        for( unsigned int group : members)
+        {
+            faces.insert( faces.end(), groups[group].mFaces.begin(), groups[group].mFaces.end());
+        }
+        std::sort( faces.begin(), faces.end());
+        clusterMasks.insert( clusterMasks.end(), mask.begin(), mask.end());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Creates the submesh holding the given faces and the bones in mask
+aiMesh* BuildSubMesh( const aiMesh* pMesh, const std::vector<unsigned int>& subMeshFaces, const BoneWord* mask,
+        const aiBoneInfluences& influences, size_t subMeshIndex)
+{
+    aiMesh* newMesh = new aiMesh;
+    if( pMesh->mName.length > 0 )
+    {
+        newMesh->mName.Set( format() << pMesh->mName.data << "_sub" << subMeshIndex);
+    }
+    newMesh->mMaterialIndex = pMesh->mMaterialIndex;
+    newMesh->mPrimitiveTypes = pMesh->mPrimitiveTypes;
+
+    // per new vertex: its index in the source mesh. Vertices shared by faces of the submesh stay shared
+    std::vector<unsigned int> newVertexIndices( pMesh->mNumVertices, std::numeric_limits<unsigned int>::max());
+    std::vector<unsigned int> previousVertexIndices;
+    for( unsigned int a : subMeshFaces)
+    {
+        const aiFace& face = pMesh->mFaces[a];
+        for( unsigned int b = 0; b < face.mNumIndices; ++b)
+        {
+            if( newVertexIndices[face.mIndices[b]] == std::numeric_limits<unsigned int>::max() )
+            {
+                newVertexIndices[face.mIndices[b]] = static_cast<unsigned int>(previousVertexIndices.size());
+                previousVertexIndices.push_back( face.mIndices[b]);
+            }
+        }
+    }
+    const unsigned int numSubMeshVertices = static_cast<unsigned int>(previousVertexIndices.size());
+
+    // create all the arrays for this mesh if the old mesh contained them
+    newMesh->mNumVertices = numSubMeshVertices;
+    newMesh->mNumFaces = static_cast<unsigned int>(subMeshFaces.size());
+    newMesh->mVertices = new aiVector3D[newMesh->mNumVertices];
+    if( pMesh->HasNormals() )
+    {
+        newMesh->mNormals = new aiVector3D[newMesh->mNumVertices];
+    }
+    if( pMesh->HasTangentsAndBitangents() )
+    {
+        newMesh->mTangents = new aiVector3D[newMesh->mNumVertices];
+        newMesh->mBitangents = new aiVector3D[newMesh->mNumVertices];
+    }
+    for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a )
+    {
+        if( pMesh->HasTextureCoords( a) )
+        {
+            newMesh->mTextureCoords[a] = new aiVector3D[newMesh->mNumVertices];
+        }
+        newMesh->mNumUVComponents[a] = pMesh->mNumUVComponents[a];
+    }
+    for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a )
+    {
+        if( pMesh->HasVertexColors( a) )
+        {
+            newMesh->mColors[a] = new aiColor4D[newMesh->mNumVertices];
+        }
+    }
+
+    // and copy over the data
+    newMesh->mFaces = new aiFace[subMeshFaces.size()];
+    for( unsigned int a = 0; a < subMeshFaces.size(); ++a )
+    {
+        const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
+        aiFace& dstFace = newMesh->mFaces[a];
+        dstFace.mNumIndices = srcFace.mNumIndices;
+        dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+        for( unsigned int b = 0; b < dstFace.mNumIndices; ++b )
+        {
+            dstFace.mIndices[b] = newVertexIndices[srcFace.mIndices[b]];
+        }
+    }
+
+    for( unsigned int nvi = 0; nvi < numSubMeshVertices; ++nvi )
+    {
+        const unsigned int srcIndex = previousVertexIndices[nvi];
+        newMesh->mVertices[nvi] = pMesh->mVertices[srcIndex];
+        if( pMesh->HasNormals() )
+        {
+            newMesh->mNormals[nvi] = pMesh->mNormals[srcIndex];
+        }
+        if( pMesh->HasTangentsAndBitangents() )
+        {
+            newMesh->mTangents[nvi] = pMesh->mTangents[srcIndex];
+            newMesh->mBitangents[nvi] = pMesh->mBitangents[srcIndex];
+        }
+        for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c )
+        {
+            if( pMesh->HasTextureCoords( c) )
+            {
+                newMesh->mTextureCoords[c][nvi] = pMesh->mTextureCoords[c][srcIndex];
+            }
+        }
+        for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c )
+        {
+            if( pMesh->HasVertexColors( c) )
+            {
+                newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
+            }
+        }
+    }
+
+    // Create the bones for the new submesh: first create the bone array
+    std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
+    for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
+    {
+        if( mask[a / BitsPerWord] & (BoneWord(1) << (a % BitsPerWord)) )
+        {
+            mappedBoneIndex[a] = newMesh->mNumBones++;
+        }
+    }
+    newMesh->mBones = new aiBone*[newMesh->mNumBones];
+    for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
+    {
+        if( mappedBoneIndex[a] == std::numeric_limits<unsigned int>::max() )
+        {
+            continue;
+        }
+
+        const aiBone* srcBone = pMesh->mBones[a];
+        aiBone* dstBone = newMesh->mBones[mappedBoneIndex[a]] = new aiBone;
+        dstBone->mName = srcBone->mName;
+        dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
+        dstBone->mNumWeights = 0;
+    }
+
+    // gather the influences of the new vertices from their old vertices in the source mesh. All of the
+    // bones affecting them are present in the new submesh, or else the faces they comprise wouldn't be
+    std::unique_ptr<aiBoneInfluences> subInfluences( CopyBoneInfluences( influences,
+            previousVertexIndices.data(), numSubMeshVertices, mappedBoneIndex.data()));
+
+    // and build the bone vertex weights from them
+    SetBoneWeights( newMesh, *subInfluences);
+    if( pMesh->HasBoneInfluences() )
+    {
+        newMesh->mBoneInfluences = subInfluences.release();
+    }
+    return newMesh;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor
 SplitByBoneCountProcess::SplitByBoneCountProcess()
 {
     // set default, might be overridden by importer config
     mMaxBoneCount = AI_SBBC_DEFAULT_MAX_BONES;
+    mNumThreads = 1;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -84,6 +400,7 @@ bool SplitByBoneCountProcess::IsActive( unsigned int pFlags) const
 void SplitByBoneCountProcess::SetupProperties(const Importer* pImp)
 {
     mMaxBoneCount = pImp->GetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES,AI_SBBC_DEFAULT_MAX_BONES);
+    mNumThreads = GetNumWorkerThreads(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -107,7 +424,26 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
         return;
     }
 
-    // we need to do something. Let's go.
+    // we need to do something. Let's go. The meshes are independent of each other.
+    std::vector< std::vector<aiMesh*> > newMeshes( pScene->mNumMeshes);
+    try
+    {
+        ParallelFor( mNumThreads, pScene->mNumMeshes, [&]( size_t a) {
+            SplitMesh( pScene->mMeshes[a], newMeshes[a]);
+        });
+    }
+    catch( ... )
+    {
+        for( std::vector<aiMesh*>& subMeshes : newMeshes)
+        {
+            for( aiMesh* mesh : subMeshes)
+            {
+                delete mesh;
+            }
+        }
+        throw;
+    }
+
     mSubMeshIndices.clear();
     mSubMeshIndices.resize( pScene->mNumMeshes);
 
@@ -118,17 +454,14 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
     {
         aiMesh* srcMesh = pScene->mMeshes[a];
 
-        std::vector<aiMesh*> newMeshes;
-        SplitMesh( pScene->mMeshes[a], newMeshes);
-
         // mesh was split
-        if( !newMeshes.empty() )
+        if( !newMeshes[a].empty() )
         {
             // store new meshes and indices of the new meshes
-            for( unsigned int b = 0; b < newMeshes.size(); ++b)
+            for( unsigned int b = 0; b < newMeshes[a].size(); ++b)
             {
                 mSubMeshIndices[a].push_back( static_cast<unsigned int>(meshes.size()));
-                meshes.push_back( newMeshes[b]);
+                meshes.push_back( newMeshes[a][b]);
             }
 
             // and destroy the source mesh. It should be completely contained inside the new submeshes
@@ -143,6 +476,7 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
     }
 
     // rebuild the scene's mesh array
+    const unsigned int numOldMeshes = pScene->mNumMeshes;
     pScene->mNumMeshes = static_cast<unsigned int>(meshes.size());
     delete [] pScene->mMeshes;
     pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
@@ -151,7 +485,7 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
     // recurse through all nodes and translate the node's mesh indices to fit the new mesh array
     UpdateNode( pScene->mRootNode);
 
-    ASSIMP_LOG_DEBUG( format() << "SplitByBoneCountProcess end: split " << mSubMeshIndices.size() << " meshes into " << meshes.size() << " submeshes." );
+    ASSIMP_LOG_DEBUG( format() << "SplitByBoneCountProcess end: split " << numOldMeshes << " meshes into " << meshes.size() << " submeshes." );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -164,251 +498,28 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         return;
     }
 
-    // necessary optimisation: build a list of all affecting bones for each vertex
-    // TODO: (thom) maybe add a custom allocator here to avoid allocating tens of thousands of small arrays
-    typedef std::pair<unsigned int, float> BoneWeight;
-    std::vector< std::vector<BoneWeight> > vertexBones( pMesh->mNumVertices);
-    for( unsigned int a = 0; a < pMesh->mNumBones; ++a)
+    // necessary optimisation: the affecting bones of each vertex as flat table
+    std::unique_ptr<aiBoneInfluences> tempInfluences;
+    const aiBoneInfluences* influences = GetBoneInfluences( pMesh, tempInfluences);
+    if( !influences )
     {
-        const aiBone* bone = pMesh->mBones[a];
-        for( unsigned int b = 0; b < bone->mNumWeights; ++b)
-        {
-          if (bone->mWeights[b].mWeight > 0.0f)
-          {
-            int vertexId = bone->mWeights[b].mVertexId;
-            vertexBones[vertexId].push_back( BoneWeight( a, bone->mWeights[b].mWeight));
-            if (vertexBones[vertexId].size() > mMaxBoneCount)
-            {
-              throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
-            }
-          }
-        }
+        return;
     }
 
-    unsigned int numFacesHandled = 0;
-    std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
-    while( numFacesHandled < pMesh->mNumFaces )
-    {
-        // which bones are used in the current submesh
-        unsigned int numBones = 0;
-        std::vector<bool> isBoneUsed( pMesh->mNumBones, false);
-        // indices of the faces which are going to go into this submesh
-        std::vector<unsigned int> subMeshFaces;
-        subMeshFaces.reserve( pMesh->mNumFaces);
-        // accumulated vertex count of all the faces in this submesh
-        unsigned int numSubMeshVertices = 0;
-
-        // add faces to the new submesh as long as all bones affecting the faces' vertices fit in the limit
-        for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
-        {
-            // skip if the face is already stored in a submesh
-            if( isFaceHandled[a] )
-            {
-                continue;
-            }
-            // a small local set of new bones for the current face. State of all used bones for that face
-            // can only be updated AFTER the face is completely analysed. Thanks to imre for the fix.
-            std::set<unsigned int> newBonesAtCurrentFace;
-          
-            const aiFace& face = pMesh->mFaces[a];
-            // check every vertex if its bones would still fit into the current submesh
-            for( unsigned int b = 0; b < face.mNumIndices; ++b )
-            {
-              const std::vector<BoneWeight>& vb = vertexBones[face.mIndices[b]];
-              for( unsigned int c = 0; c < vb.size(); ++c)
-              {
-                unsigned int boneIndex = vb[c].first;
-                if( !isBoneUsed[boneIndex] )
-                {
-                  newBonesAtCurrentFace.insert(boneIndex);
-                }   
-              }
-            }
-
-            // leave out the face if the new bones required for this face don't fit the bone count limit anymore
-            if( numBones + newBonesAtCurrentFace.size() > mMaxBoneCount )
-            {
-                continue;
-            }
-
-            // mark all new bones as necessary
-            for (std::set<unsigned int>::iterator it = newBonesAtCurrentFace.begin(); it != newBonesAtCurrentFace.end(); ++it)
-            {
-              if (!isBoneUsed[*it])
-              {
-                isBoneUsed[*it] = true;
-                numBones++;
-              }
-            }
-
-            // store the face index and the vertex count
-            subMeshFaces.push_back( a);
-            numSubMeshVertices += face.mNumIndices;
-
-            // remember that this face is handled
-            isFaceHandled[a] = true;
-            numFacesHandled++;
-        }
-
-        // create a new mesh to hold this subset of the source mesh
-        aiMesh* newMesh = new aiMesh;
-        if( pMesh->mName.length > 0 )
-        {
-            newMesh->mName.Set( format() << pMesh->mName.data << "_sub" << poNewMeshes.size());
-        }
-        newMesh->mMaterialIndex = pMesh->mMaterialIndex;
-        newMesh->mPrimitiveTypes = pMesh->mPrimitiveTypes;
-        poNewMeshes.push_back( newMesh);
-
-        // create all the arrays for this mesh if the old mesh contained them
-        newMesh->mNumVertices = numSubMeshVertices;
-        newMesh->mNumFaces = static_cast<unsigned int>(subMeshFaces.size());
-        newMesh->mVertices = new aiVector3D[newMesh->mNumVertices];
-        if( pMesh->HasNormals() )
-        {
-            newMesh->mNormals = new aiVector3D[newMesh->mNumVertices];
-        }
-        if( pMesh->HasTangentsAndBitangents() )
-        {
-            newMesh->mTangents = new aiVector3D[newMesh->mNumVertices];
-            newMesh->mBitangents = new aiVector3D[newMesh->mNumVertices];
-        }
-        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a )
-        {
-            if( pMesh->HasTextureCoords( a) )
-            {
-                newMesh->mTextureCoords[a] = new aiVector3D[newMesh->mNumVertices];
-            }
-            newMesh->mNumUVComponents[a] = pMesh->mNumUVComponents[a];
-        }
-        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a )
-        {
-            if( pMesh->HasVertexColors( a) )
-            {
-                newMesh->mColors[a] = new aiColor4D[newMesh->mNumVertices];
-            }
-        }
-
-        // and copy over the data, generating faces with linear indices along the way
-        newMesh->mFaces = new aiFace[subMeshFaces.size()];
-        unsigned int nvi = 0; // next vertex index
-        std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
-        for( unsigned int a = 0; a < subMeshFaces.size(); ++a )
-        {
-            const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
-            aiFace& dstFace = newMesh->mFaces[a];
-            dstFace.mNumIndices = srcFace.mNumIndices;
-            dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
-
-            // accumulate linearly all the vertices of the source face
-            for( unsigned int b = 0; b < dstFace.mNumIndices; ++b )
-            {
-                unsigned int srcIndex = srcFace.mIndices[b];
-                dstFace.mIndices[b] = nvi;
-                previousVertexIndices[nvi] = srcIndex;
-
-                newMesh->mVertices[nvi] = pMesh->mVertices[srcIndex];
-                if( pMesh->HasNormals() )
-                {
-                    newMesh->mNormals[nvi] = pMesh->mNormals[srcIndex];
-                }
-                if( pMesh->HasTangentsAndBitangents() )
-                {
-                    newMesh->mTangents[nvi] = pMesh->mTangents[srcIndex];
-                    newMesh->mBitangents[nvi] = pMesh->mBitangents[srcIndex];
-                }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c )
-                {
-                    if( pMesh->HasTextureCoords( c) )
-                    {
-                        newMesh->mTextureCoords[c][nvi] = pMesh->mTextureCoords[c][srcIndex];
-                    }
-                }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c )
-                {
-                    if( pMesh->HasVertexColors( c) )
-                    {
-                        newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
-                    }
-                }
-
-                nvi++;
-            }
-        }
-
-        ai_assert( nvi == numSubMeshVertices );
-
-        // Create the bones for the new submesh: first create the bone array
-        newMesh->mNumBones = 0;
-        newMesh->mBones = new aiBone*[numBones];
-
-        std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
-        for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
-        {
-            if( !isBoneUsed[a] )
-            {
-                continue;
-            }
-
-            // create the new bone
-            const aiBone* srcBone = pMesh->mBones[a];
-            aiBone* dstBone = new aiBone;
-            mappedBoneIndex[a] = newMesh->mNumBones;
-            newMesh->mBones[newMesh->mNumBones++] = dstBone;
-            dstBone->mName = srcBone->mName;
-            dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
-            dstBone->mNumWeights = 0;
-        }
-
-        ai_assert( newMesh->mNumBones == numBones );
+    // the faces using the same bones go together, then the groups are merged into submeshes
+    const size_t numWords = (pMesh->mNumBones + BitsPerWord - 1) / BitsPerWord;
+    std::vector<FaceGroup> groups;
+    std::vector<BoneWord> groupMasks;
+    GroupFacesByBones( pMesh, *influences, numWords, mMaxBoneCount, groups, groupMasks);
 
-        // iterate over all new vertices and count which bones affected its old vertex in the source mesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a )
-        {
-            unsigned int oldIndex = previousVertexIndices[a];
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
+    std::vector< std::vector<unsigned int> > clusterFaces;
+    std::vector<BoneWord> clusterMasks;
+    ClusterFaceGroups( groups, groupMasks, numWords, mMaxBoneCount, clusterFaces, clusterMasks);
 
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b )
-            {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                if( newBoneIndex != std::numeric_limits<unsigned int>::max() )
-                {
-                    newMesh->mBones[newBoneIndex]->mNumWeights++;
-                }
-            }
-        }
-
-        // allocate all bone weight arrays accordingly
-        for( unsigned int a = 0; a < newMesh->mNumBones; ++a )
-        {
-            aiBone* bone = newMesh->mBones[a];
-            ai_assert( bone->mNumWeights > 0 );
-            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
-            bone->mNumWeights = 0; // for counting up in the next step
-        }
-
-        // now copy all the bone vertex weights for all the vertices which made it into the new submesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a)
-        {
-            // find the source vertex for it in the source mesh
-            unsigned int previousIndex = previousVertexIndices[a];
-            // these bones were affecting it
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[previousIndex];
-            // all of the bones affecting it should be present in the new submesh, or else
-            // the face it comprises shouldn't be present
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b)
-            {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                ai_assert( newBoneIndex != std::numeric_limits<unsigned int>::max() );
-                aiVertexWeight* dstWeight = newMesh->mBones[newBoneIndex]->mWeights + newMesh->mBones[newBoneIndex]->mNumWeights;
-                newMesh->mBones[newBoneIndex]->mNumWeights++;
-
-                dstWeight->mVertexId = a;
-                dstWeight->mWeight = bonesOnThisVertex[b].second;
-            }
-        }
-
-        // I have the strange feeling that this will break apart at some point in time...
+    poNewMeshes.reserve( clusterFaces.size());
+    for( size_t a = 0; a < clusterFaces.size(); ++a)
+    {
+        poNewMeshes.push_back( BuildSubMesh( pMesh, clusterFaces[a], &clusterMasks[a * numWords], *influences, a));
     }
 }
 
@@ -58,10 +58,12 @@ namespace Assimp
 /** Postprocessing filter to split meshes with many bones into submeshes
  * so that each submesh has a certain max bone count.
  *
- * Applied BEFORE the JoinVertices-Step occurs.
- * Returns NON-UNIQUE vertices, splits by bone count.
+ * Faces affected by the same bones are grouped, and the groups are merged
+ * greedily by bone set overlap so that as few submeshes as possible are
+ * created. Vertices shared by faces of one submesh stay shared, meshes are
+ * split in parallel.
 */
-class SplitByBoneCountProcess : public BaseProcess
+class ASSIMP_API SplitByBoneCountProcess : public BaseProcess
 {
 public:
 
@@ -77,13 +79,15 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "SplitByBoneCountProcess"; }
+
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
     * basing on the Importer's configuration property list.
     */
     virtual void SetupProperties(const Importer* pImp);
 
-protected:
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
     * @param pScene The imported data to work at.
@@ -95,6 +99,8 @@ protected:
     /// @param poNewMeshes Array of submeshes created in the process. Empty if splitting was not necessary.
     void SplitMesh( const aiMesh* pMesh, std::vector<aiMesh*>& poNewMeshes) const;
 
+protected:
+
     /// Recursively updates the node's mesh list to account for the changed mesh list
     void UpdateNode( aiNode* pNode) const;
 
@@ -102,6 +108,9 @@ public:
     /// Max bone count. Splitting occurs if a mesh has more than that number of bones.
     size_t mMaxBoneCount;
 
+    /// Number of threads used to split the meshes.
+    unsigned int mNumThreads;
+
     /// Per mesh index: Array of indices of the new submeshes.
     std::vector< std::vector<unsigned int> > mSubMeshIndices;
 };
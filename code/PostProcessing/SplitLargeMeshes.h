@@ -102,6 +102,9 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "SplitLargeMeshesProcess_Triangle"; }
+
 
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
@@ -167,6 +170,9 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "SplitLargeMeshesProcess_Vertex"; }
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -205,6 +205,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "TextureTransformStep"; }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -217,6 +217,16 @@ void ValidateDSProcess::Execute( aiScene* pScene) {
         ReportError("aiScene::mMeshes is non-null although there are no meshes");
     }
 
+    // validate the instance hierarchy
+    if (pScene->mBVH) {
+        Validate(pScene->mBVH, pScene->mNumBVHInstances, "aiScene::mBVH");
+        for (unsigned int i = 0; i < pScene->mNumBVHInstances; ++i) {
+            if (pScene->mBVHInstances[i].mMeshIndex >= pScene->mNumMeshes) {
+                ReportError("aiScene::mBVHInstances[%i].mMeshIndex is out of range", i);
+            }
+        }
+    }
+
     // validate all animations
     if (pScene->mNumAnimations) {
         DoValidation(pScene->mAnimations,pScene->mNumAnimations,
@@ -510,6 +520,122 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
     {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // validate all meshlets
+    if (pMesh->mNumMeshlets) {
+        if (!pMesh->mMeshlets) {
+            ReportError("aiMesh::mMeshlets is NULL (aiMesh::mNumMeshlets is %i)",
+                pMesh->mNumMeshlets);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+            const aiMeshlet &meshlet = pMesh->mMeshlets[i];
+            if (!meshlet.mNumVertices || !meshlet.mVertices || !meshlet.mNumTriangles || !meshlet.mTriangles) {
+                ReportError("aiMesh::mMeshlets[%i] is empty", i);
+            }
+            if (meshlet.mNumVertices > AI_MAX_MESHLET_VERTICES) {
+                ReportError("aiMesh::mMeshlets[%i] has too many vertices: %u, but the limit is %u",
+                    i, meshlet.mNumVertices, AI_MAX_MESHLET_VERTICES);
+            }
+            for (unsigned int a = 0; a < meshlet.mNumVertices; ++a) {
+                if (meshlet.mVertices[a] >= pMesh->mNumVertices) {
+                    ReportError("aiMesh::mMeshlets[%i]::mVertices[%i] is out of range", i, a);
+                }
+            }
+            for (unsigned int a = 0; a < meshlet.mNumTriangles * 3; ++a) {
+                if (meshlet.mTriangles[a] >= meshlet.mNumVertices) {
+                    ReportError("aiMesh::mMeshlets[%i]::mTriangles[%i] is out of range", i, a);
+                }
+            }
+        }
+    } else if (pMesh->mMeshlets) {
+        ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+    }
+
+    // validate all levels of detail
+    if (pMesh->mNumLODs) {
+        if (!pMesh->mLODs) {
+            ReportError("aiMesh::mLODs is NULL (aiMesh::mNumLODs is %i)",
+                pMesh->mNumLODs);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumLODs; ++i) {
+            if (!pMesh->mLODs[i]) {
+                ReportError("aiMesh::mLODs[%i] is NULL", i);
+            }
+            if (pMesh->mLODs[i]->mMaterialIndex != pMesh->mMaterialIndex) {
+                ReportError("aiMesh::mLODs[%i] doesn't use the material of its source mesh", i);
+            }
+            Validate(pMesh->mLODs[i]);
+        }
+    } else if (pMesh->mLODs) {
+        ReportError("aiMesh::mLODs is non-null although there are no levels of detail");
+    }
+
+    // validate the quantized vertex streams
+    if (pMesh->mQuantized) {
+        const aiQuantizedVertices *q = pMesh->mQuantized;
+        if (!q->mPositions) {
+            ReportError("aiMesh::mQuantized::mPositions is NULL");
+        }
+        if ((nullptr != q->mNormals) != pMesh->HasNormals()) {
+            ReportError("aiMesh::mQuantized::mNormals doesn't match aiMesh::mNormals");
+        }
+        if ((nullptr != q->mTangents) != pMesh->HasTangentsAndBitangents()) {
+            ReportError("aiMesh::mQuantized::mTangents doesn't match aiMesh::mTangents");
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            if ((nullptr != q->mTextureCoords[i]) != pMesh->HasTextureCoords(i)) {
+                ReportError("aiMesh::mQuantized::mTextureCoords[%i] doesn't match aiMesh::mTextureCoords", i);
+            }
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            if ((nullptr != q->mColors[i]) != pMesh->HasVertexColors(i)) {
+                ReportError("aiMesh::mQuantized::mColors[%i] doesn't match aiMesh::mColors", i);
+            }
+        }
+    }
+
+    if (pMesh->mBVH) {
+        Validate(pMesh->mBVH, pMesh->mNumFaces, "aiMesh::mBVH");
+    }
+
+    // validate the per-vertex bone influences
+    if (pMesh->mBoneInfluences) {
+        const aiBoneInfluences *b = pMesh->mBoneInfluences;
+        if (!pMesh->HasBones()) {
+            ReportError("aiMesh::mBoneInfluences is non-null although there are no bones");
+        }
+        if (!b->mNumInfluences || !b->mBoneIndices || !b->mWeights) {
+            ReportError("aiMesh::mBoneInfluences is empty");
+        }
+        const size_t size = static_cast<size_t>(pMesh->mNumVertices) * b->mNumInfluences;
+        for (size_t i = 0; i < size; ++i) {
+            if (b->mWeights[i] != 0.0 && b->mBoneIndices[i] >= pMesh->mNumBones) {
+                ReportError("aiMesh::mBoneInfluences::mBoneIndices[%u] is out of range", static_cast<unsigned int>(i));
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate( const aiBVH* pBVH, unsigned int pNumPrimitives, const char* pOwner) {
+    if (!pBVH->mNumNodes || !pBVH->mNodes) {
+        ReportError("%s has no nodes", pOwner);
+    }
+    for (unsigned int i = 0; i < pBVH->mNumPrimitives; ++i) {
+        if (pBVH->mPrimitives[i] >= pNumPrimitives) {
+            ReportError("%s::mPrimitives[%i] is out of range", pOwner, i);
+        }
+    }
+    for (unsigned int i = 0; i < pBVH->mNumNodes; ++i) {
+        const aiBVHNode &node = pBVH->mNodes[i];
+        if (node.IsLeaf()) {
+            if (node.mFirst + node.mCount > pBVH->mNumPrimitives) {
+                ReportError("%s::mNodes[%i] references primitives out of range", pOwner, i);
+            }
+        } else if (node.mFirst <= i || node.mFirst + 1 >= pBVH->mNumNodes) {
+            ReportError("%s::mNodes[%i] has invalid children", pOwner, i);
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -923,6 +1049,20 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
     {
         ReportError("A node animation channel must have at least one subtrack");
     }
+
+    if (pNodeAnim->mQuantized) {
+        const aiQuantizedNodeAnim *q = pNodeAnim->mQuantized;
+        if (q->mNumPositionKeys != pNodeAnim->mNumPositionKeys ||
+            q->mNumRotationKeys != pNodeAnim->mNumRotationKeys ||
+            q->mNumScalingKeys != pNodeAnim->mNumScalingKeys) {
+            ReportError("aiNodeAnim::mQuantized doesn't match the keys of the channel");
+        }
+        if ((q->mNumPositionKeys && (!q->mPositionTimes || !q->mPositions)) ||
+            (q->mNumRotationKeys && (!q->mRotationTimes || !q->mRotations)) ||
+            (q->mNumScalingKeys && (!q->mScalingTimes || !q->mScalings))) {
+            ReportError("aiNodeAnim::mQuantized is missing key data");
+        }
+    }
 }
 
 void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
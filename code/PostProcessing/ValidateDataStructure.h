@@ -62,6 +62,7 @@ struct aiNode;
 struct aiString;
 struct aiCamera;
 struct aiLight;
+struct aiBVH;
 
 namespace Assimp    {
 
@@ -80,6 +81,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    const char *GetName() const { return "ValidateDSProcess"; }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -163,6 +167,13 @@ protected:
      * @param Node Input node*/
     void Validate( const aiNode* pNode);
 
+    // -------------------------------------------------------------------
+    /** Validates a bounding volume hierarchy
+     * @param pBVH Input hierarchy
+     * @param pNumPrimitives Number of primitives it may reference
+     * @param pOwner Name of the member holding it, for error messages*/
+    void Validate( const aiBVH* pBVH, unsigned int pNumPrimitives, const char* pOwner);
+
     // -------------------------------------------------------------------
     /** Validates a string
      * @param pString Input string*/
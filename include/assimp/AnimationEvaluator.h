@@ -0,0 +1,206 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AnimationEvaluator.h
+ *  @brief Defines the #AnimationEvaluator class, which samples animations
+ *    and skins meshes on the CPU.
+ */
+#pragma once
+#ifndef AI_ANIMATIONEVALUATOR_H_INC
+#define AI_ANIMATIONEVALUATOR_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+#include <cstddef>
+#include <vector>
+
+struct aiScene;
+struct aiNode;
+
+namespace Assimp {
+
+class AnimationEvaluatorData;
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Samples the node and morph channels of an animation and
+ *  computes the resulting node transformations, bone matrices and skinned
+ *  vertices.
+ *
+ *  All per-scene data (the flattened node hierarchy, channel to node mapping
+ *  and per-vertex bone influences) is prepared by the constructor. The
+ *  results of an evaluation are written to a #State, so a single evaluator
+ *  can drive any number of animated instances, from any number of threads.
+ *  The scene must outlive the evaluator and must not be modified.
+ *
+ *  @code
+ *  AnimationEvaluator evaluator(scene, 0);
+ *  AnimationEvaluator::State state;
+ *  evaluator.Evaluate(seconds, state);
+ *  evaluator.SkinMesh(state, meshIndex, positions, normals);
+ *  @endcode
+ *
+ *  Keys are found through a cursor kept in the state, so evaluating at
+ *  increasing times costs O(1) per channel; other jumps fall back to a
+ *  binary search. Positions and scalings are interpolated linearly,
+ *  rotations spherically. Before the first and after the last key of a
+ *  channel its first or last key is used, #aiNodeAnim::mPreState and
+ *  #aiNodeAnim::mPostState are not evaluated. */
+class ASSIMP_API AnimationEvaluator
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    // -------------------------------------------------------------------
+    /** Result of an evaluation for one animated instance. */
+    struct State {
+        State() :
+                mTime(0.0), mLocalTransforms(), mGlobalTransforms(), mMorphWeights(), mKeyCursors() {
+            // empty
+        }
+
+        /// Time of the last evaluation, in ticks
+        double mTime;
+
+        /// Transformation of each node relative to its parent, indexed like
+        /// AnimationEvaluator::GetNode()
+        std::vector<aiMatrix4x4> mLocalTransforms;
+
+        /// Transformation of each node relative to the root node
+        std::vector<aiMatrix4x4> mGlobalTransforms;
+
+        /// Morph target weights of all meshes, see GetMorphWeights()
+        std::vector<float> mMorphWeights;
+
+        /// Last key found per channel, to speed up the next search
+        std::vector<unsigned int> mKeyCursors;
+    };
+
+    // -------------------------------------------------------------------
+    /** @brief Prepares the evaluation of an animation.
+     *  @param scene The scene, must outlive the evaluator.
+     *  @param animationIndex Index into aiScene::mAnimations. An index out of
+     *    range yields the bind pose for all times. */
+    AnimationEvaluator(const aiScene *scene, unsigned int animationIndex);
+
+    ~AnimationEvaluator();
+
+    // -------------------------------------------------------------------
+    /** @brief Samples the animation and updates the node transformations
+     *    and morph weights of a state.
+     *  @param seconds Time in seconds. It is converted to ticks with
+     *    aiAnimation::mTicksPerSecond, or 25 ticks per second if unset.
+     *  @param state Receives the results, resized as needed.
+     *  @param loop Wrap around at the end of the animation if true, hold
+     *    the last frame otherwise. */
+    void Evaluate(double seconds, State &state, bool loop = true) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Evaluates many instances in parallel.
+     *  @param seconds Time of each instance.
+     *  @param states State of each instance.
+     *  @param count Number of instances.
+     *  @param loop See Evaluate().
+     *  @param numThreads Number of threads, -1 for all hardware threads,
+     *    0 to evaluate in the calling thread only. */
+    void Evaluate(const double *seconds, State *states, size_t count, bool loop = true,
+            int numThreads = -1) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of nodes in the scene. */
+    unsigned int GetNumNodes() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns a node. Parents come before their children.
+     *  @param index Node index, as used by State::mLocalTransforms and
+     *    State::mGlobalTransforms. */
+    const aiNode *GetNode(unsigned int index) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the index of the first node with the given name,
+     *    UINT_MAX if there is none. */
+    unsigned int FindNode(const char *name) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Computes the skinning matrices of a mesh.
+     *
+     *  The matrices transform from the bind pose of the mesh into its
+     *  animated pose, both relative to the first node referencing the mesh.
+     *  @param state An evaluated state.
+     *  @param meshIndex Index into aiScene::mMeshes.
+     *  @param out Receives one matrix per aiMesh::mBones entry. */
+    void GetBoneMatrices(const State &state, unsigned int meshIndex, aiMatrix4x4 *out) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the morph target weights of a mesh, one per
+     *    aiMesh::mAnimMeshes entry, nullptr if the mesh has none.
+     *
+     *  Meshes without animated weights keep aiAnimMesh::mWeight. */
+    const float *GetMorphWeights(const State &state, unsigned int meshIndex) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Applies linear blend skinning to the vertices of a mesh.
+     *
+     *  Vertices without bone weights keep their bind pose. Normals are
+     *  renormalized. SSE2 is used where available.
+     *  @param state An evaluated state.
+     *  @param meshIndex Index into aiScene::mMeshes.
+     *  @param positions Receives aiMesh::mNumVertices positions.
+     *  @param normals Receives aiMesh::mNumVertices normals, may be nullptr.
+     *    Ignored if the mesh has no normals. */
+    void SkinMesh(const State &state, unsigned int meshIndex, aiVector3D *positions,
+            aiVector3D *normals = nullptr) const;
+
+private:
+    AnimationEvaluator(const AnimationEvaluator &) = delete;
+    AnimationEvaluator &operator=(const AnimationEvaluator &) = delete;
+
+    AnimationEvaluatorData *mData;
+};
+
+} // Namespace Assimp
+
+#endif // AI_ANIMATIONEVALUATOR_H_INC
@@ -68,6 +68,7 @@ class IOSystem;
 class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
+class MeshChunkSink;
 
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
@@ -148,6 +149,26 @@ public:
         IOSystem* pIOHandler
         );
 
+    // -------------------------------------------------------------------
+    /** Imports the given file chunk by chunk into the given sink, see
+     *  Importer::ReadFileStreamed().
+     *
+     * @param pImp #Importer object hosting this loader.
+     * @param pFile Path of the file to be imported.
+     * @param pIOHandler IO-Handler used to open this and possible other files.
+     * @param pSink Receives the geometry.
+     * @return false if the import failed, GetErrorText() has the details then.
+     *
+     * @note This function is not intended to be overridden. Implement
+     * InternReadStreamed() to do the import.
+     */
+    bool ReadFileStreamed(
+        Importer* pImp,
+        const std::string& pFile,
+        IOSystem* pIOHandler,
+        MeshChunkSink& pSink
+        );
+
     // -------------------------------------------------------------------
     /** Returns the error description of the last error that occurred.
      * @return A description of the last error that occurred. An empty
@@ -227,6 +248,12 @@ protected:
     double importerScale = 1.0;
     double fileScale = 1.0;
 
+    // -------------------------------------------------------------------
+    /** Polled by importers in their parse loops. Throws a
+     *  DeadlyImportError if the running import has been cancelled,
+     *  see Importer::RequestCancel(). */
+    void ThrowIfCancelled() const;
+
 
 
     // -------------------------------------------------------------------
@@ -279,6 +306,21 @@ protected:
         IOSystem* pIOHandler
         ) = 0;
 
+    // -------------------------------------------------------------------
+    /** Imports the given file and passes its geometry to the sink while
+     * reading, without building a scene. Only vertices and faces are
+     * of interest. Override this function for formats which can be read
+     * sequentially; the default implementation throws.
+     *
+     * @param pFile Path of the file to be imported.
+     * @param pIOHandler The IO handler to use for any file access.
+     * @param pSink Receives the vertices and faces. */
+    virtual void InternReadStreamed(
+        const std::string& pFile,
+        IOSystem* pIOHandler,
+        MeshChunkSink& pSink
+        );
+
 public: // static utilities
 
     // -------------------------------------------------------------------
@@ -411,6 +453,8 @@ protected:
     std::string m_ErrorText;
     /// Currently set progress handler.
     ProgressHandler* m_progress;
+    /// Importer running the current import, for cancellation polls.
+    const Importer* m_importer;
 };
 
 
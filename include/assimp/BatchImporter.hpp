@@ -0,0 +1,195 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file BatchImporter.hpp
+ *  @brief Defines the #BatchImporter class, which imports many files
+ *    concurrently.
+ */
+#pragma once
+#ifndef AI_BATCHIMPORTER_H_INC
+#define AI_BATCHIMPORTER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+#include <string>
+
+struct aiScene;
+
+namespace Assimp {
+
+class IOSystem;
+class BatchImporterPimpl;
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Receives the results of a #BatchImporter run.
+ *
+ *  OnImported() is called once per request, as soon as its import has
+ *  finished. Calls are serialized, but they come from the worker threads
+ *  and not in the order the requests were added. */
+class ASSIMP_API BatchImportHandler
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /// @brief  Virtual destructor.
+    virtual ~BatchImportHandler() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Called when an import has finished.
+     *
+     *  @param id The id returned by BatchImporter::AddRequest().
+     *  @param file The file name passed to BatchImporter::AddRequest().
+     *  @param scene The imported scene. The handler takes ownership and
+     *    must release it with delete. nullptr if the import failed.
+     *  @param error The error string of the import if it failed. */
+    virtual void OnImported(unsigned int id, const std::string &file,
+            aiScene *scene, const std::string &error) = 0;
+}; // !class BatchImportHandler
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Imports a list of files concurrently.
+ *
+ *  The requests are distributed over a pool of worker threads. Workers
+ *  which run out of requests steal them from the others, so a few large
+ *  files don't hold up the rest. Each worker owns one #Importer for all
+ *  of its files, so the importer and post-processing step instances are
+ *  set up once per thread instead of once per file.
+ *
+ *  All workers read through the same IOSystem, which must be safe to use
+ *  from several threads (the default one is). Files other than the
+ *  requested ones - material libraries, textures and the like - are read
+ *  only once per run and kept in memory for the other imports which
+ *  refer to them. The cache is bounded, see SetSharedFileCacheSize().
+ *
+ *  A logger attached to the DefaultLogger receives messages from all
+ *  worker threads at once, so it must be thread-safe, too. */
+class ASSIMP_API BatchImporter
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    // -------------------------------------------------------------------
+    /** @brief Constructs a batch importer.
+     *  @param pIOHandler IO system to read all files through. The batch
+     *    importer does not take ownership. nullptr to use the
+     *    default IO system. */
+    explicit BatchImporter(IOSystem *pIOHandler = nullptr);
+
+    /// @brief  The class destructor.
+    ~BatchImporter();
+
+    // -------------------------------------------------------------------
+    /** @brief Sets the number of worker threads.
+     *  @param numThreads -1 (default) for one per hardware thread, 0 or 1
+     *    to import on the calling thread only. */
+    void SetNumThreads(int numThreads);
+
+    // -------------------------------------------------------------------
+    /** @brief Sets the memory budget for files shared between imports.
+     *
+     *  Files which don't fit into the remaining budget are read directly
+     *  each time. The default is 64 MB.
+     *  @param bytes The budget in bytes, 0 disables the cache. */
+    void SetSharedFileCacheSize(size_t bytes);
+
+    // -------------------------------------------------------------------
+    /** @brief Sets an integer configuration property for all imports.
+     *  @see Importer::SetPropertyInteger() */
+    void SetPropertyInteger(const char *szName, int iValue);
+
+    // -------------------------------------------------------------------
+    /** @brief Sets a floating-point configuration property for all imports.
+     *  @see Importer::SetPropertyFloat() */
+    void SetPropertyFloat(const char *szName, ai_real fValue);
+
+    // -------------------------------------------------------------------
+    /** @brief Sets a string configuration property for all imports.
+     *  @see Importer::SetPropertyString() */
+    void SetPropertyString(const char *szName, const std::string &sValue);
+
+    // -------------------------------------------------------------------
+    /** @brief Adds a file to the list of files to be imported.
+     *
+     *  Adding the same file with the same flags again returns the id of
+     *  the existing request.
+     *  @param file File to be imported.
+     *  @param pFlags Post-processing steps to run on the file, see
+     *    Importer::ReadFile().
+     *  @return The id passed to BatchImportHandler::OnImported(). */
+    unsigned int AddRequest(const std::string &file, unsigned int pFlags = 0);
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the number of pending requests. */
+    size_t GetNumRequests() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Imports all pending requests and blocks until they are done.
+     *
+     *  The calling thread takes part in the work. Afterwards the request
+     *  list and the shared file cache are empty again.
+     *  @param handler Receives the imported scenes.
+     *  @return The number of successful imports. */
+    size_t Run(BatchImportHandler *handler);
+
+    // -------------------------------------------------------------------
+    /** @brief Returns how often the last Run() served a shared file from
+     *  memory instead of reading it again. */
+    size_t GetNumSharedFileHits() const;
+
+private:
+    BatchImporter(const BatchImporter &) = delete;
+    BatchImporter &operator=(const BatchImporter &) = delete;
+
+    BatchImporterPimpl *mPimpl;
+}; // !class BatchImporter
+
+} // Namespace Assimp
+
+#endif // AI_BATCHIMPORTER_H_INC
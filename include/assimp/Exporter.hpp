@@ -54,6 +54,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "cexport.h"
 #include <map>
+#include <string>
+#include <vector>
 
 namespace Assimp {
     
@@ -117,6 +119,31 @@ public:
         }
     };
 
+    /** One output of #ExportMultiple */
+    struct ExportTarget {
+        /// Format id, see #aiExportFormatDesc::id
+        std::string mFormatId;
+
+        /// Target file name
+        std::string mPath;
+
+        /// Preprocessing steps, see #Export
+        unsigned int mPreprocessing;
+
+        /// Set by #ExportMultiple: the result of this export and, if it failed, why
+        aiReturn mResult;
+        std::string mError;
+
+        ExportTarget(const std::string& pFormatId, const std::string& pPath, unsigned int pPreprocessing = 0u) :
+            mFormatId(pFormatId)
+          , mPath(pPath)
+          , mPreprocessing(pPreprocessing)
+          , mResult(aiReturn_FAILURE)
+          , mError()
+        {
+        }
+    };
+
     /**
      *  @brief  The class constructor.
      */
@@ -234,6 +261,30 @@ public:
     aiReturn Export( const aiScene* pScene, const std::string& pFormatId, const std::string& pPath,
         unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = nullptr);
 
+    // -------------------------------------------------------------------
+    /** Exports a scene to several files and formats at once.
+     *
+     * The preprocessing of each target is determined as for #Export. Targets
+     * which end up with the same preprocessing share one processed copy of the
+     * scene, and the distinct copies are prepared in parallel. Then the
+     * exporters run, those of different copies concurrently and those
+     * sharing a copy one after the other, as exporters may write to it.
+     *
+     * The IOSystem set with #SetIOHandler is used from several threads at
+     * once and must be thread-safe (the default IOSystem is, #ExportToBlob's
+     * is not). If a logger other than DefaultLogger is installed, everything
+     * runs on the calling thread. Exporters registered with #RegisterExporter
+     * must be safe to run concurrently with the other exporters.
+     * @param pScene The scene to export. Stays in possession of the caller.
+     * @param pTargets The files to write. mResult and mError of each entry
+     *   receive the outcome of the respective export.
+     * @param pProperties Properties passed to all exporters. The number of
+     *   threads is taken from #AI_CONFIG_GLOB_MULTITHREADING.
+     * @return AI_SUCCESS if all exports succeeded. #GetErrorString returns
+     *   the error of the first failed target otherwise. */
+    aiReturn ExportMultiple( const aiScene* pScene, std::vector<ExportTarget>& pTargets,
+        const ExportProperties* pProperties = nullptr);
+
     // -------------------------------------------------------------------
     /** Returns an error description of an error that occurred in #Export
      *    or #ExportToBlob
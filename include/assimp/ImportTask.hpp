@@ -0,0 +1,135 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ImportTask.hpp
+ *  @brief Handle and executor interface for asynchronous imports,
+ *    see Importer::ReadFileAsync().
+ */
+#pragma once
+#ifndef AI_IMPORTTASK_H_INC
+#define AI_IMPORTTASK_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/cimport.h>
+
+namespace Assimp {
+
+class Importer;
+class ImportTaskPimpl;
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Abstract interface for running asynchronous imports on a
+ *  thread pool or job system owned by the application.
+ *
+ *  Execute() receives the whole import as a single job. */
+class ASSIMP_API ImportExecutor
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /// @brief  Virtual destructor.
+    virtual ~ImportExecutor() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Schedules a job.
+     *
+     *  The implementation must arrange for task(taskData) to be called
+     *  exactly once, on any thread. It may also call it right away. */
+    virtual void Execute(aiImportTaskProc task, void *taskData) = 0;
+}; // !class ImportExecutor
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Handle to an import started by Importer::ReadFileAsync().
+ *
+ *  All methods may be called from any thread. Deleting the handle
+ *  cancels nothing, but waits until the import has finished. */
+class ASSIMP_API ImportTask
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /// @brief  Internal use only, see Importer::ReadFileAsync().
+    explicit ImportTask(ImportTaskPimpl *pimpl);
+
+    /// @brief  Waits for the import to finish.
+    ~ImportTask();
+
+    // -------------------------------------------------------------------
+    /** @brief Blocks until the import has finished.
+     *  @return The imported scene, owned by the Importer, or nullptr if the
+     *    import failed or was cancelled. Importer::GetErrorString() has
+     *    the details then. */
+    const aiScene *Wait();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns true if the import has finished. Never blocks. */
+    bool IsDone() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Requests cancellation, see Importer::RequestCancel(). */
+    void Cancel();
+
+    // -------------------------------------------------------------------
+    /** @brief Returns a snapshot of the current progress. */
+    aiImportProgress GetProgress() const;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the Importer the task runs on. */
+    Importer *GetImporter() const;
+
+private:
+    ImportTask(const ImportTask &) = delete;
+    ImportTask &operator=(const ImportTask &) = delete;
+
+    ImportTaskPimpl *mPimpl;
+}; // !class ImportTask
+
+} // Namespace Assimp
+
+#endif // AI_IMPORTTASK_H_INC
@@ -66,6 +66,9 @@ namespace Assimp {
     class IOStream;
     class IOSystem;
     class ProgressHandler;
+    class ImportExecutor;
+    class ImportTask;
+    class MeshChunkHandler;
 
     // =======================================================================
     // Plugin development
@@ -466,8 +469,82 @@ public:
      *    to the #Importer instance.  */
     const aiScene* ApplyPostProcessing(unsigned int pFlags);
 
+    // -------------------------------------------------------------------
+    /** Flags a mesh of the current scene as modified.
+     *
+     *  Only meaningful if #AI_CONFIG_PP_INCREMENTAL is enabled: the next
+     *  call to #ApplyPostProcessing() reruns the per-mesh steps on this
+     *  mesh, all other meshes keep their results from previous calls.
+     *  @param pMeshIndex Index of the mesh in aiScene::mMeshes. */
+    void MarkMeshModified(unsigned int pMeshIndex);
+
     const aiScene* ApplyCustomizedPostProcessing( BaseProcess *rootProcess, bool requestValidation );
 
+    // -------------------------------------------------------------------
+    /** Starts reading the given file in the background.
+     *
+     * The import runs exactly like #ReadFile() would, but on the given
+     * executor or on a thread of its own. The returned task reports
+     * structured progress, can be cancelled and yields the scene once
+     * finished. While it runs the Importer must not be used otherwise;
+     * the scene stays in possession of the Importer as usual.
+     * @param pFile Path and filename to the file to be imported.
+     * @param pFlags Optional post processing steps to be executed after
+     *   a successful import. Provide a bitwise combination of the
+     *   #aiPostProcessSteps flags.
+     * @param pExecutor Executor to run the import on. Pass nullptr to
+     *   have Assimp start a thread for it. Must stay valid until the
+     *   task has run.
+     * @return The task, owned by the caller. Include ImportTask.hpp
+     *   for its declaration. Deleting it waits for the import to finish.
+     */
+    ImportTask* ReadFileAsync(
+        const char* pFile,
+        unsigned int pFlags,
+        ImportExecutor* pExecutor = nullptr);
+
+    // -------------------------------------------------------------------
+    /** Reads the given file piece by piece, without ever holding all of
+     *  its geometry in memory.
+     *
+     * Instead of building a scene, the importer hands meshes of at most
+     * #AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES vertices to the handler
+     * while the file is being read. The post-processing steps which work
+     * on each mesh separately are applied to every chunk, all others are
+     * ignored. Steps looking at the neighbourhood of a vertex, such as
+     * smooth normals or vertex joining, see the vertices of one chunk
+     * only. Materials, nodes and all other scene data are not imported.
+     * Supported by the PLY, OBJ and STL importers.
+     * @param pFile Path and filename to the file to be imported.
+     * @param pFlags Optional post processing steps to be executed on each
+     *   chunk. Provide a bitwise combination of the #aiPostProcessSteps
+     *   flags.
+     * @param pHandler Receives the chunks. Include MeshChunkHandler.hpp
+     *   for its declaration.
+     * @return true if the file was read completely, false if the import
+     *   failed or was stopped. #GetErrorString() has the details then.
+     */
+    bool ReadFileStreamed(
+        const char* pFile,
+        unsigned int pFlags,
+        MeshChunkHandler* pHandler);
+
+    // -------------------------------------------------------------------
+    /** Asks the import running on this Importer to stop.
+     *
+     *  This is the only method which may be called while #ReadFile() or
+     *  a task from #ReadFileAsync() runs on another thread. Cancellation
+     *  is cooperative: importers and post-processing steps poll
+     *  #IsCancelRequested() and give up at the next opportunity, after
+     *  which the import fails with an error string telling so. The
+     *  request is reset when the import finishes, requests made while no
+     *  import runs are ignored. */
+    void RequestCancel();
+
+    // -------------------------------------------------------------------
+    /** Returns true if #RequestCancel() was called for the running import. */
+    bool IsCancelRequested() const;
+
     // -------------------------------------------------------------------
     /** @brief Reads the given file and returns its contents if successful.
      *
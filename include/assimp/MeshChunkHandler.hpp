@@ -0,0 +1,91 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MeshChunkHandler.hpp
+ *  @brief Receiver interface for streaming imports, see Importer::ReadFileStreamed().
+ */
+#pragma once
+#ifndef AI_MESHCHUNKHANDLER_H_INC
+#define AI_MESHCHUNKHANDLER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+struct aiScene;
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Receives the geometry of a streaming import piece by piece.
+ *
+ *  Each chunk is a small scene holding the mesh built from a bounded number
+ *  of vertices, after the post-processing steps which work locally have been
+ *  applied to it. Only steps like aiProcess_SortByPType split it into several
+ *  meshes. Faces only refer to vertices of their own mesh. */
+class ASSIMP_API MeshChunkHandler
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+public:
+    /// @brief  Virtual destructor.
+    virtual ~MeshChunkHandler() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** @brief Called for every chunk, in file order, on the importing thread.
+     *
+     *  @param pChunk The chunk. It is owned by the Importer and destroyed
+     *    once the call returns, copy what needs to be kept.
+     *  @param pChunkIndex Running number of the chunk, starting at 0.
+     *  @return false to stop the import. Importer::ReadFileStreamed()
+     *    then fails as if the import had been cancelled. */
+    virtual bool HandleChunk(const aiScene *pChunk, unsigned int pChunkIndex) = 0;
+}; // !class MeshChunkHandler
+
+} // Namespace Assimp
+
+#endif // AI_MESHCHUNKHANDLER_H_INC
@@ -74,6 +74,7 @@ struct aiAnimMesh;
 struct aiAnimation;
 struct aiNodeAnim;
 struct aiMeshMorphAnim;
+struct aiBVH;
 
 namespace Assimp    {
 
@@ -380,8 +381,9 @@ public:
     static void Copy  (aiNodeAnim** dest, const aiNodeAnim* src);
     static void Copy  (aiMeshMorphAnim** dest, const aiMeshMorphAnim* src);
     static void Copy  (aiMetadata** dest, const aiMetadata* src);
+    static void Copy  (aiBVH** dest, const aiBVH* src);
 
-    // recursive, of course
+    // deep copy of the whole subtree, walked without recursion
     static void Copy     (aiNode** dest, const aiNode* src);
 
 
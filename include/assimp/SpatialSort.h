@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <assimp/types.h>
+#include <cstdint>
 #include <vector>
 
 namespace Assimp {
@@ -141,33 +142,43 @@ public:
     unsigned int GenerateMappingTable(std::vector<unsigned int> &fill,
             ai_real pRadius) const;
 
+    // ------------------------------------------------------------------------------------
+    /** Finds the positions close to each of the positions in the SpatialSort in a single
+     *  sweep over the sorted data. This is equivalent to, but much faster than calling
+     *  #FindPositions() for every position added.
+     * @param pRadius Maximal distance from a position another one may have to be counted in.
+     * @param poOffsets Will be filled with numPositions+1 entries. The results for the
+     *   position with index i are poResults[poOffsets[i]] ... poResults[poOffsets[i+1]-1].
+     * @param poResults Receives the indices of the found positions of all queries.
+     * @param pMaxResults Maximum total number of results. Many coincident positions
+     *   make the results grow quadratically, use #FindPositions() for each position then.
+     * @return false, and both arrays empty, if there are more than pMaxResults results.*/
+    bool FindAllPositions(ai_real pRadius, std::vector<size_t> &poOffsets,
+            std::vector<unsigned int> &poResults, size_t pMaxResults = SIZE_MAX) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the maximum number of threads used to sort and search large data sets.
+     *  Defaults to 1.*/
+    void SetNumThreads(unsigned int pNumThreads) {
+        mNumThreads = pNumThreads ? pNumThreads : 1;
+    }
+
+    // ------------------------------------------------------------------------------------
+    /** Exchanges the contents with another SpatialSort without copying the data.*/
+    void Swap(SpatialSort &pOther);
+
 protected:
     /** Normal of the sorting plane, normalized. The center is always at (0, 0, 0) */
     aiVector3D mPlaneNormal;
 
-    /** An entry in a spatially sorted position array. Consists of a vertex index,
-     * its position and its pre-calculated distance from the reference plane */
-    struct Entry {
-        unsigned int mIndex; ///< The vertex referred by this entry
-        aiVector3D mPosition; ///< Position
-        ai_real mDistance; ///< Distance of this vertex to the sorting plane
-
-        Entry() AI_NO_EXCEPT
-                : mIndex(999999999),
-                  mPosition(),
-                  mDistance(99999.) {
-            // empty
-        }
-        Entry(unsigned int pIndex, const aiVector3D &pPosition, ai_real pDistance) :
-                mIndex(pIndex), mPosition(pPosition), mDistance(pDistance) {
-            // empty
-        }
-
-        bool operator<(const Entry &e) const { return mDistance < e.mDistance; }
-    };
-
-    // all positions, sorted by distance to the sorting plane
-    std::vector<Entry> mPositions;
+    /** Number of threads used by #Finalize() and #FindAllPositions() on large data sets */
+    unsigned int mNumThreads;
+
+    // All positions, sorted by distance to the sorting plane. The entries are stored as
+    // parallel arrays so the searches only need to touch the distances.
+    std::vector<ai_real> mDistances; ///< Distance of each position to the sorting plane
+    std::vector<unsigned int> mIndices; ///< Index of the vertex referred by each entry
+    std::vector<aiVector3D> mPositions; ///< Copy of each position
 };
 
 } // end of namespace Assimp
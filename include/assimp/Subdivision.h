@@ -120,8 +120,28 @@ public:
         unsigned int num,
         bool discard_input = false) = 0;
 
+    // ---------------------------------------------------------------
+    /** Set the maximum number of threads used for subdivision, see
+     *  #AI_CONFIG_GLOB_MULTITHREADING. The default is one thread.
+     *
+     *  @param numThreads Number of threads, 0 is treated as 1. */
+    void SetNumThreads(unsigned int numThreads) {
+        mNumThreads = numThreads ? numThreads : 1;
+    }
+
+protected:
+    Subdivider();
+
+    //! Maximum number of threads to use
+    unsigned int mNumThreads;
 };
 
+inline
+Subdivider::Subdivider()
+: mNumThreads(1) {
+    // empty
+}
+
 inline
 Subdivider::~Subdivider() {
     // empty
@@ -55,6 +55,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/quaternion.h>
 #include <assimp/types.h>
 
+#ifdef __cplusplus
+#   include <cmath>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -246,6 +250,133 @@ enum aiAnimBehaviour {
 #endif
 };
 
+// ---------------------------------------------------------------------------
+/** @brief Compact companion copy of the keys of a node animation channel.
+ *
+ *  Generated by the #aiProcessExt_OptimizeAnimations step if
+ *  #AI_CONFIG_PP_OA_QUANTIZE is enabled. The keys match those of the host
+ *  aiNodeAnim one by one, which are left untouched. Key times are stored as
+ *  single precision floats.
+ *
+ *  Positions and scalings are stored as unsigned 16 bit values relative to
+ *  the bounding box of the track and are decoded by
+ *  @code
+ *  p = mPositionOffset + mPositionScale * (q / 65535.0)
+ *  @endcode
+ *  Rotations use the "smallest three" encoding: the largest component of
+ *  the unit quaternion is dropped and restored from the other three, which
+ *  are stored with 15 bits each. The remaining high bits of the first two
+ *  values hold the index of the dropped component (w, x, y, z order).
+ *  Use the decoding helpers of the C++ API to restore the values.
+ */
+struct aiQuantizedNodeAnim {
+    //! Number of position keys, equals aiNodeAnim::mNumPositionKeys.
+    unsigned int mNumPositionKeys;
+
+    //! Times of the position keys.
+    float *mPositionTimes;
+
+    //! Quantized positions, three values per key.
+    uint16_t *mPositions;
+
+    //! Decoding offset of the positions (the minimum of the bounding box).
+    C_STRUCT aiVector3D mPositionOffset;
+
+    //! Decoding scale of the positions (the extents of the bounding box).
+    C_STRUCT aiVector3D mPositionScale;
+
+    //! Number of rotation keys, equals aiNodeAnim::mNumRotationKeys.
+    unsigned int mNumRotationKeys;
+
+    //! Times of the rotation keys.
+    float *mRotationTimes;
+
+    //! Rotations in smallest three encoding, three values per key.
+    uint16_t *mRotations;
+
+    //! Number of scaling keys, equals aiNodeAnim::mNumScalingKeys.
+    unsigned int mNumScalingKeys;
+
+    //! Times of the scaling keys.
+    float *mScalingTimes;
+
+    //! Quantized scalings, three values per key.
+    uint16_t *mScalings;
+
+    //! Decoding offset of the scalings.
+    C_STRUCT aiVector3D mScalingOffset;
+
+    //! Decoding scale of the scalings.
+    C_STRUCT aiVector3D mScalingScale;
+
+#ifdef __cplusplus
+    //! Default constructor
+    aiQuantizedNodeAnim() AI_NO_EXCEPT
+            : mNumPositionKeys(0),
+              mPositionTimes(nullptr),
+              mPositions(nullptr),
+              mPositionOffset(),
+              mPositionScale(),
+              mNumRotationKeys(0),
+              mRotationTimes(nullptr),
+              mRotations(nullptr),
+              mNumScalingKeys(0),
+              mScalingTimes(nullptr),
+              mScalings(nullptr),
+              mScalingOffset(),
+              mScalingScale() {
+        // empty
+    }
+
+    //! Destructor, deletes all buffers
+    ~aiQuantizedNodeAnim() {
+        delete[] mPositionTimes;
+        delete[] mPositions;
+        delete[] mRotationTimes;
+        delete[] mRotations;
+        delete[] mScalingTimes;
+        delete[] mScalings;
+    }
+
+    //! Decodes the position of a key
+    aiVector3D GetPosition(unsigned int pKey) const {
+        return DecodeVector(mPositions + pKey * 3, mPositionOffset, mPositionScale);
+    }
+
+    //! Decodes the scaling of a key
+    aiVector3D GetScaling(unsigned int pKey) const {
+        return DecodeVector(mScalings + pKey * 3, mScalingOffset, mScalingScale);
+    }
+
+    //! Decodes the rotation of a key
+    aiQuaternion GetRotation(unsigned int pKey) const {
+        const uint16_t *q = mRotations + pKey * 3;
+        const unsigned int largest = ((q[0] >> 14) & 0x2) | (q[1] >> 15);
+        ai_real c[4], sum = 0;
+        for (unsigned int i = 0, k = 0; i < 4; ++i) {
+            if (i == largest) {
+                continue;
+            }
+            const ai_real v = (q[k++] & 0x7fff) / ai_real(32767.0);
+            c[i] = (v * ai_real(2.0) - ai_real(1.0)) * ai_real(0.70710678118654752440);
+            sum += c[i] * c[i];
+        }
+        c[largest] = std::sqrt(sum < ai_real(1.0) ? ai_real(1.0) - sum : ai_real(0.0));
+        return aiQuaternion(c[0], c[1], c[2], c[3]);
+    }
+
+private:
+    static aiVector3D DecodeVector(const uint16_t *q, const aiVector3D &offset, const aiVector3D &scale) {
+        return aiVector3D(offset.x + scale.x * (q[0] / ai_real(65535.0)),
+                offset.y + scale.y * (q[1] / ai_real(65535.0)),
+                offset.z + scale.z * (q[2] / ai_real(65535.0)));
+    }
+
+    aiQuantizedNodeAnim(const aiQuantizedNodeAnim &) = delete;
+    aiQuantizedNodeAnim &operator=(const aiQuantizedNodeAnim &) = delete;
+#endif // __cplusplus
+}; // struct aiQuantizedNodeAnim
+
 // ---------------------------------------------------------------------------
 /** Describes the animation of a single node. The name specifies the
  *  bone/node which is affected by this animation channel. The keyframes
@@ -311,6 +442,11 @@ struct aiNodeAnim {
      *  transformation matrix of the affected node is taken).*/
     C_ENUM aiAnimBehaviour mPostState;
 
+    /** Compact companion copy of the keys.
+     *  Is nullptr unless the #aiProcessExt_OptimizeAnimations step was
+     *  applied with #AI_CONFIG_PP_OA_QUANTIZE enabled. */
+    C_STRUCT aiQuantizedNodeAnim *mQuantized;
+
 #ifdef __cplusplus
     aiNodeAnim() AI_NO_EXCEPT
             : mNumPositionKeys(0),
@@ -320,7 +456,8 @@ struct aiNodeAnim {
               mNumScalingKeys(0),
               mScalingKeys(nullptr),
               mPreState(aiAnimBehaviour_DEFAULT),
-              mPostState(aiAnimBehaviour_DEFAULT) {
+              mPostState(aiAnimBehaviour_DEFAULT),
+              mQuantized(nullptr) {
         // empty
     }
 
@@ -328,6 +465,7 @@ struct aiNodeAnim {
         delete[] mPositionKeys;
         delete[] mRotationKeys;
         delete[] mScalingKeys;
+        delete mQuantized;
     }
 #endif // __cplusplus
 };
@@ -61,6 +61,7 @@ extern "C" {
 
 struct aiScene;  // aiScene.h
 struct aiFileIO; // aiFileIO.h
+struct aiImportTask;
 typedef void (*aiLogStreamCallback)(const char* /* message */, char* /* user */);
 
 // --------------------------------------------------------------------------------
@@ -99,6 +100,81 @@ typedef int aiBool;
 #define AI_FALSE 0
 #define AI_TRUE 1
 
+// --------------------------------------------------------------------------------
+/** Stages of an asynchronous import, see #aiImportProgress. */
+// --------------------------------------------------------------------------------
+enum aiImportStage
+{
+    /** The task has been submitted but not yet started. */
+    aiImportStage_Pending = 0,
+
+    /** The file is being read by the importer. */
+    aiImportStage_Reading = 1,
+
+    /** Post-processing steps are being applied. */
+    aiImportStage_PostProcessing = 2,
+
+    /** The task has finished, successfully or not. */
+    aiImportStage_Done = 3,
+
+#ifndef SWIG
+    _aiImportStage_Force32Bit = INT_MAX
+#endif
+};
+
+// --------------------------------------------------------------------------------
+/** Snapshot of the progress of an asynchronous import.
+ *  @see aiGetImportTaskProgress
+ *  @see Assimp::ImportTask::GetProgress */
+// --------------------------------------------------------------------------------
+struct aiImportProgress
+{
+    /** Current stage of the import. */
+    C_ENUM aiImportStage mStage;
+
+    /** Name of the importer (while reading) or of the post-processing
+     *  step (while post-processing) currently running. */
+    C_STRUCT aiString mStep;
+
+    /** Index of the current post-processing step and the number of
+     *  candidate steps. Both are zero outside of post-processing. */
+    unsigned int mStepIndex;
+    unsigned int mNumSteps;
+
+    /** Bytes read so far through the IO system, from the model file
+     *  and all files it references. */
+    size_t mBytesRead;
+
+    /** Size of the model file itself, 0 if unknown. */
+    size_t mFileSize;
+
+    /** Overall estimate in [0,1] as reported to the progress handler. */
+    float mPercentage;
+
+    /** AI_TRUE once cancellation has been requested. */
+    aiBool mCancelled;
+};
+
+/** Function to run an import task, see #aiImportExecutor. */
+typedef void (*aiImportTaskProc)(void* /* task data */);
+
+// --------------------------------------------------------------------------------
+/** C-API: Caller-supplied executor for asynchronous imports.
+ *
+ *  ExecuteProc must arrange for task(taskData) to be called exactly once,
+ *  on any thread, e.g. by posting it to a thread pool.
+ *  @see aiImportFileAsync */
+// --------------------------------------------------------------------------------
+struct aiImportExecutor
+{
+    /** Schedules task(taskData). */
+    void (*ExecuteProc)(C_STRUCT aiImportExecutor* /* executor */,
+        aiImportTaskProc /* task */, void* /* taskData */);
+
+    /** User-defined, opaque data */
+    char* UserData;
+};
+
 // --------------------------------------------------------------------------------
 /** Reads the given file and returns its content.
  *
@@ -239,6 +315,72 @@ ASSIMP_API const C_STRUCT aiScene* aiImportFileFromMemoryWithProperties(
     const char* pHint,
     const C_STRUCT aiPropertyStore* pProps);
 
+// --------------------------------------------------------------------------------
+/** Starts reading the given file in the background.
+ *
+ * The call returns immediately. Use #aiWaitImportTask() to obtain the
+ * imported scene, #aiCancelImportTask() to abandon the import and
+ * #aiGetImportTaskProgress() to query how far it got. Every task must
+ * be released with #aiReleaseImportTask().
+ * @param pFile Path and filename of the file to be imported,
+ *   expected to be a null-terminated c-string. NULL is not a valid value.
+ * @param pFlags Optional post processing steps to be executed after
+ *   a successful import. Provide a bitwise combination of the
+ *   #aiPostProcessSteps flags.
+ * @param pFS aiFileIO structure, NULL to use the default implementation.
+ * @param pProps #aiPropertyStore instance containing import settings, or NULL.
+ *   The settings are copied, the store may be released right away.
+ * @param pExecutor Executor to run the import on. Pass NULL to have
+ *   Assimp start a thread for it. Must stay valid until the task ran.
+ * @return The import task, NULL if it could not be started.
+ */
+ASSIMP_API C_STRUCT aiImportTask* aiImportFileAsync(
+    const char* pFile,
+    unsigned int pFlags,
+    C_STRUCT aiFileIO* pFS,
+    const C_STRUCT aiPropertyStore* pProps,
+    C_STRUCT aiImportExecutor* pExecutor);
+
+// --------------------------------------------------------------------------------
+/** Blocks until the given task has finished and returns its result.
+ *
+ * On success the scene must be released with #aiReleaseImport() as usual,
+ * independently of the task. On failure NULL is returned and
+ * aiGetErrorString() describes the problem. Calling this repeatedly
+ * returns the same scene.
+ * @param pTask Task returned by #aiImportFileAsync().
+ */
+ASSIMP_API const C_STRUCT aiScene* aiWaitImportTask(
+    C_STRUCT aiImportTask* pTask);
+
+// --------------------------------------------------------------------------------
+/** Returns AI_TRUE if the given task has finished. Never blocks. */
+ASSIMP_API aiBool aiIsImportTaskDone(
+    const C_STRUCT aiImportTask* pTask);
+
+// --------------------------------------------------------------------------------
+/** Requests cancellation of the given task.
+ *
+ * Cancellation is cooperative: the importer and the post-processing
+ * steps check for it regularly and stop at the next opportunity, after
+ * which the task finishes without a scene.
+ */
+ASSIMP_API void aiCancelImportTask(
+    C_STRUCT aiImportTask* pTask);
+
+// --------------------------------------------------------------------------------
+/** Retrieves a snapshot of the progress of the given task. Never blocks
+ *  on the import itself and may be called from any thread. */
+ASSIMP_API void aiGetImportTaskProgress(
+    const C_STRUCT aiImportTask* pTask,
+    C_STRUCT aiImportProgress* pOut);
+
+// --------------------------------------------------------------------------------
+/** Releases the given task. If it is still running, it is cancelled
+ *  and waited for. A scene obtained by #aiWaitImportTask() is not affected. */
+ASSIMP_API void aiReleaseImportTask(
+    C_STRUCT aiImportTask* pTask);
+
 // --------------------------------------------------------------------------------
 /** Apply post-processing to an already-imported scene.
  *
@@ -258,6 +400,18 @@ ASSIMP_API const C_STRUCT aiScene* aiApplyPostProcessing(
     const C_STRUCT aiScene* pScene,
     unsigned int pFlags);
 
+// --------------------------------------------------------------------------------
+/** Flags a mesh as modified by the application.
+ *
+ * Only meaningful if #AI_CONFIG_PP_INCREMENTAL is enabled: the next call to
+ * #aiApplyPostProcessing() reruns the per-mesh steps on this mesh.
+ * @param pScene Scene the mesh belongs to.
+ * @param pMeshIndex Index of the mesh in aiScene::mMeshes.
+ */
+ASSIMP_API void aiMarkMeshModified(
+    const C_STRUCT aiScene* pScene,
+    unsigned int pMeshIndex);
+
 // --------------------------------------------------------------------------------
 /** Get one of the predefine log streams. This is the quick'n'easy solution to
  *  access Assimp's log system. Attaching a log stream can slightly reduce Assimp's
@@ -914,6 +914,13 @@ public:
 
      /** Storage allocated */
     unsigned int mNumAllocated;
+
+    /**  Internal data, do not touch */
+#ifdef __cplusplus
+    void* mPrivate;
+#else
+    char* mPrivate;
+#endif
 };
 
 // Go back to extern "C" again
@@ -553,6 +553,321 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+/** @def AI_MAX_MESHLET_VERTICES
+ *  Maximum number of vertices per meshlet. Local triangle indices are
+ *  stored as bytes, so this must not exceed 256. */
+
+#ifndef AI_MAX_MESHLET_VERTICES
+#define AI_MAX_MESHLET_VERTICES 0x100
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief A meshlet is a small cluster of triangles of a mesh with a
+ *  bounded number of vertices and triangles.
+ *
+ *  Meshlets are generated by the #aiProcessExt_GenerateMeshlets step and are
+ *  meant for GPU-driven rendering (mesh shaders, cluster culling). Each
+ *  meshlet references a subset of the vertices of its host mesh and stores
+ *  its triangles as byte-sized indices into this subset. The faces of the
+ *  host mesh are not modified, the meshlets are an additional view on them.
+ *
+ *  The bounding sphere and the normal cone allow rejecting a whole meshlet
+ *  before any of its triangles is processed: the meshlet is entirely
+ *  back-facing for a viewer located at @c eye if
+ *  @code
+ *  dot(normalize(mConeApex - eye), mConeAxis) > mConeCutoff
+ *  @endcode
+ */
+struct aiMeshlet {
+    //! Number of vertices referenced by this meshlet.
+    //! The maximum value for this member is #AI_MAX_MESHLET_VERTICES.
+    unsigned int mNumVertices;
+
+    //! Indices into the vertex streams of the host mesh.
+    //! The array is mNumVertices in size.
+    unsigned int *mVertices;
+
+    //! Number of triangles in this meshlet.
+    unsigned int mNumTriangles;
+
+    //! Triangle list, three indices into mVertices per triangle.
+    //! The array is 3 * mNumTriangles in size.
+    unsigned char *mTriangles;
+
+    //! Center of the bounding sphere of the meshlet.
+    C_STRUCT aiVector3D mCenter;
+
+    //! Radius of the bounding sphere of the meshlet.
+    ai_real mRadius;
+
+    //! Apex of the normal cone of the meshlet.
+    C_STRUCT aiVector3D mConeApex;
+
+    //! Normalized axis of the normal cone of the meshlet.
+    C_STRUCT aiVector3D mConeAxis;
+
+    //! Sine of the cone half-angle used in the culling test above.
+    //! 1 if the triangle normals span a hemisphere or more, i.e. the
+    //! meshlet can never be rejected.
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    //! Default constructor
+    aiMeshlet() AI_NO_EXCEPT
+            : mNumVertices(0),
+              mVertices(nullptr),
+              mNumTriangles(0),
+              mTriangles(nullptr),
+              mCenter(),
+              mRadius(0),
+              mConeApex(),
+              mConeAxis(),
+              mConeCutoff(1) {
+        // empty
+    }
+
+    //! Destructor. Delete the index arrays
+    ~aiMeshlet() {
+        delete[] mVertices;
+        delete[] mTriangles;
+    }
+
+    //! Copy constructor. Copy the index arrays
+    aiMeshlet(const aiMeshlet &o) :
+            mNumVertices(0), mVertices(nullptr), mNumTriangles(0), mTriangles(nullptr) {
+        *this = o;
+    }
+
+    //! Assignment operator. Copy the index arrays
+    aiMeshlet &operator=(const aiMeshlet &o) {
+        if (&o == this) {
+            return *this;
+        }
+
+        delete[] mVertices;
+        delete[] mTriangles;
+        mNumVertices = o.mNumVertices;
+        mNumTriangles = o.mNumTriangles;
+        mVertices = nullptr;
+        mTriangles = nullptr;
+        if (mNumVertices) {
+            mVertices = new unsigned int[mNumVertices];
+            ::memcpy(mVertices, o.mVertices, mNumVertices * sizeof(unsigned int));
+        }
+        if (mNumTriangles) {
+            mTriangles = new unsigned char[mNumTriangles * 3];
+            ::memcpy(mTriangles, o.mTriangles, mNumTriangles * 3);
+        }
+        mCenter = o.mCenter;
+        mRadius = o.mRadius;
+        mConeApex = o.mConeApex;
+        mConeAxis = o.mConeAxis;
+        mConeCutoff = o.mConeCutoff;
+
+        return *this;
+    }
+#endif // __cplusplus
+}; // struct aiMeshlet
+
+// ---------------------------------------------------------------------------
+/** @brief Compact companion copies of the vertex streams of a mesh.
+ *
+ *  Generated by the #aiProcessExt_QuantizeVertices step. Every buffer holds
+ *  the data of all aiMesh::mNumVertices vertices, in the same order as the
+ *  full precision streams of the host mesh, which are left untouched.
+ *  A buffer is nullptr if the corresponding stream is not present.
+ *
+ *  Positions are stored as unsigned 16 bit values relative to the bounding
+ *  box of the mesh and are decoded by
+ *  @code
+ *  p = mPositionOffset + mPositionScale * (q / 65535.0)
+ *  @endcode
+ *  Normals and tangents are unit vectors in octahedral encoding, i.e. two
+ *  signed normalized 16 bit values per vertex.
+ */
+struct aiQuantizedVertices {
+    //! Quantized positions, three values per vertex.
+    uint16_t *mPositions;
+
+    //! Decoding offset of the positions (the minimum of the bounding box).
+    C_STRUCT aiVector3D mPositionOffset;
+
+    //! Decoding scale of the positions (the extents of the bounding box).
+    C_STRUCT aiVector3D mPositionScale;
+
+    //! Octahedral encoded normals, two values per vertex.
+    int16_t *mNormals;
+
+    //! Octahedral encoded tangents, two values per vertex. The bitangent
+    //! can be restored as cross(normal, tangent).
+    int16_t *mTangents;
+
+    //! Texture coordinates as IEEE 754 half floats, two values (u,v) per
+    //! vertex. A third coordinate is not kept.
+    uint16_t *mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+    //! Vertex colors as normalized bytes, four values (RGBA) per vertex.
+    uint8_t *mColors[AI_MAX_NUMBER_OF_COLOR_SETS];
+
+#ifdef __cplusplus
+    //! Default constructor
+    aiQuantizedVertices() AI_NO_EXCEPT
+            : mPositions(nullptr),
+              mPositionOffset(),
+              mPositionScale(),
+              mNormals(nullptr),
+              mTangents(nullptr) {
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+            mTextureCoords[a] = nullptr;
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            mColors[a] = nullptr;
+        }
+    }
+
+    //! Destructor, deletes all buffers
+    ~aiQuantizedVertices() {
+        delete[] mPositions;
+        delete[] mNormals;
+        delete[] mTangents;
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+            delete[] mTextureCoords[a];
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            delete[] mColors[a];
+        }
+    }
+
+private:
+    aiQuantizedVertices(const aiQuantizedVertices &) = delete;
+    aiQuantizedVertices &operator=(const aiQuantizedVertices &) = delete;
+#endif // __cplusplus
+}; // struct aiQuantizedVertices
+
+// ---------------------------------------------------------------------------
+/** @brief Vertex-major copy of the bone weights of a mesh.
+ *
+ *  The bones of a mesh store their weights per bone (aiBone::mWeights).
+ *  This table holds the same data per vertex in two flat arrays with a
+ *  fixed number of mNumInfluences slots per vertex, the slots of vertex i
+ *  start at i * mNumInfluences. The slots of a vertex are ordered by
+ *  descending weight, unused slots have a bone index and a weight of 0.
+ *  Influences with a weight of zero are not stored.
+ *
+ *  The table is filled by importers reading vertex-major skin data and
+ *  kept up to date by the post processing steps changing bone weights.
+ */
+struct aiBoneInfluences {
+    //! Number of influence slots per vertex, at least 1.
+    unsigned int mNumInfluences;
+
+    //! Indices into aiMesh::mBones, mNumInfluences values per vertex.
+    unsigned int *mBoneIndices;
+
+    //! Bone weights, mNumInfluences values per vertex.
+    ai_real *mWeights;
+
+#ifdef __cplusplus
+    //! Default constructor
+    aiBoneInfluences() AI_NO_EXCEPT
+            : mNumInfluences(0),
+              mBoneIndices(nullptr),
+              mWeights(nullptr) {
+        // empty
+    }
+
+    //! Destructor, deletes both arrays
+    ~aiBoneInfluences() {
+        delete[] mBoneIndices;
+        delete[] mWeights;
+    }
+
+private:
+    aiBoneInfluences(const aiBoneInfluences &) = delete;
+    aiBoneInfluences &operator=(const aiBoneInfluences &) = delete;
+#endif // __cplusplus
+}; // struct aiBoneInfluences
+
+// ---------------------------------------------------------------------------
+/** @brief A node of a bounding volume hierarchy.
+ *
+ *  Inner nodes have exactly two children which are stored next to each
+ *  other in aiBVH::mNodes, the left one at mFirst and the right one at
+ *  mFirst + 1. Leaves reference the primitives aiBVH::mPrimitives[mFirst]
+ *  to aiBVH::mPrimitives[mFirst + mCount - 1].
+ */
+struct aiBVHNode {
+    //! Bounding box of all primitives below this node.
+    C_STRUCT aiAABB mAABB;
+
+    //! Index of the left child for inner nodes, index of the first
+    //! primitive reference for leaves.
+    unsigned int mFirst;
+
+    //! Number of primitives in a leaf, 0 for inner nodes.
+    unsigned int mCount;
+
+#ifdef __cplusplus
+    //! Default constructor
+    aiBVHNode() AI_NO_EXCEPT
+            : mAABB(),
+              mFirst(0),
+              mCount(0) {
+        // empty
+    }
+
+    //! Check whether the node is a leaf
+    bool IsLeaf() const {
+        return mCount > 0;
+    }
+#endif // __cplusplus
+}; // struct aiBVHNode
+
+// ---------------------------------------------------------------------------
+/** @brief A bounding volume hierarchy stored as a flat node array.
+ *
+ *  Generated by the #aiProcessExt_GenerateBVH step. The root is always
+ *  mNodes[0]. For the hierarchy of a mesh the primitives are indices into
+ *  aiMesh::mFaces, for the hierarchy of the scene they are indices into
+ *  aiScene::mBVHInstances.
+ */
+struct aiBVH {
+    //! Number of nodes in the hierarchy.
+    unsigned int mNumNodes;
+
+    //! The nodes, mNumNodes in size, mNodes[0] is the root.
+    C_STRUCT aiBVHNode *mNodes;
+
+    //! Number of primitive references.
+    unsigned int mNumPrimitives;
+
+    //! Primitive indices, ordered so that each leaf references a
+    //! contiguous range. The array is mNumPrimitives in size.
+    unsigned int *mPrimitives;
+
+#ifdef __cplusplus
+    //! Default constructor
+    aiBVH() AI_NO_EXCEPT
+            : mNumNodes(0),
+              mNodes(nullptr),
+              mNumPrimitives(0),
+              mPrimitives(nullptr) {
+        // empty
+    }
+
+    //! Destructor, deletes the node and primitive arrays
+    ~aiBVH() {
+        delete[] mNodes;
+        delete[] mPrimitives;
+    }
+
+private:
+    aiBVH(const aiBVH &) = delete;
+    aiBVH &operator=(const aiBVH &) = delete;
+#endif // __cplusplus
+}; // struct aiBVH
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -723,6 +1038,43 @@ struct aiMesh {
      */
     C_STRUCT aiAABB mAABB;
 
+    /** The number of meshlets in this mesh.
+     *  Is 0 unless the #aiProcessExt_GenerateMeshlets step was applied.
+     */
+    unsigned int mNumMeshlets;
+
+    /** The meshlets (bounded triangle clusters) this mesh is partitioned
+     *  into. The array is mNumMeshlets in size, nullptr if not present.
+     */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /** The number of simplified versions of this mesh.
+     *  Is 0 unless the #aiProcessExt_GenerateLODs step was applied.
+     */
+    unsigned int mNumLODs;
+
+    /** Simplified versions (levels of detail) of this mesh, ordered from
+     *  the most to the least detailed one. Each level is a complete mesh
+     *  with its own vertex data, using the same material and bone names as
+     *  this mesh. The array is mNumLODs in size, nullptr if not present.
+     */
+    C_STRUCT aiMesh **mLODs;
+
+    /** Compact companion copies of the vertex streams.
+     *  Is nullptr unless the #aiProcessExt_QuantizeVertices step was applied.
+     */
+    C_STRUCT aiQuantizedVertices *mQuantized;
+
+    /** Bounding volume hierarchy over the faces of this mesh.
+     *  Is nullptr unless the #aiProcessExt_GenerateBVH step was applied.
+     */
+    C_STRUCT aiBVH *mBVH;
+
+    /** Per-vertex copy of the bone weights, see #aiBoneInfluences.
+     *  Is nullptr unless the importer or a post processing step filled it.
+     */
+    C_STRUCT aiBoneInfluences *mBoneInfluences;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -744,7 +1096,14 @@ struct aiMesh {
               mNumAnimMeshes(0),
               mAnimMeshes(nullptr),
               mMethod(0),
-              mAABB() {
+              mAABB(),
+              mNumMeshlets(0),
+              mMeshlets(nullptr),
+              mNumLODs(0),
+              mLODs(nullptr),
+              mQuantized(nullptr),
+              mBVH(nullptr),
+              mBoneInfluences(nullptr) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -786,6 +1145,17 @@ struct aiMesh {
         }
 
         delete[] mFaces;
+        delete[] mMeshlets;
+
+        if (mNumLODs && mLODs) {
+            for (unsigned int a = 0; a < mNumLODs; a++) {
+                delete mLODs[a];
+            }
+            delete[] mLODs;
+        }
+        delete mQuantized;
+        delete mBVH;
+        delete mBoneInfluences;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -849,6 +1219,31 @@ struct aiMesh {
         return mBones != nullptr && mNumBones > 0;
     }
 
+    //! Check whether a per-vertex copy of the bone weights is attached
+    bool HasBoneInfluences() const {
+        return mBoneInfluences != nullptr && HasBones();
+    }
+
+    //! Check whether the mesh has been partitioned into meshlets
+    bool HasMeshlets() const {
+        return mMeshlets != nullptr && mNumMeshlets > 0;
+    }
+
+    //! Check whether simplified versions of the mesh are attached
+    bool HasLODs() const {
+        return mLODs != nullptr && mNumLODs > 0;
+    }
+
+    //! Check whether quantized copies of the vertex streams are attached
+    bool HasQuantizedVertices() const {
+        return mQuantized != nullptr;
+    }
+
+    //! Check whether a bounding volume hierarchy is attached
+    bool HasBVH() const {
+        return mBVH != nullptr && mBVH->mNumNodes > 0;
+    }
+
 #endif // __cplusplus
 };
 
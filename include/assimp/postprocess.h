@@ -600,6 +600,108 @@ enum aiPostProcessSteps
     aiProcess_GenBoundingBoxes = 0x80000000
 };
 
+// ---------------------------------------------------------------------------
+/** @enum  aiPostProcessStepsExt
+ *  @brief Defines the flags for all additional post processing steps.
+ *
+ *  All 32 bits of #aiPostProcessSteps are in use, so steps added later are
+ *  enabled through this second flag field. The flags are not passed to
+ *  ReadFile() but set as integer property #AI_CONFIG_PP_EXTENDED_STEPS:
+ *  @code
+ *  importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_GenerateMeshlets);
+ *  importer.ReadFile(path, aiProcess_Triangulate | aiProcess_ImproveCacheLocality);
+ *  @endcode
+ *  The steps are executed as part of the regular post processing pipeline,
+ *  together with the steps selected through #aiPostProcessSteps.
+ */
+enum aiPostProcessStepsExt
+{
+    // -------------------------------------------------------------------------
+    /** <hr>Partitions each triangle mesh into meshlets - small clusters with
+     *  a bounded number of vertices and triangles.
+     *
+     *  The meshlets are stored in #aiMesh::mMeshlets, each with a bounding
+     *  sphere and a normal cone for cluster culling. The vertex and face
+     *  arrays of the mesh are left unchanged. The step runs after
+     *  #aiProcess_ImproveCacheLocality so it picks up the optimized triangle
+     *  order if that step is enabled, too.
+     *  Use #AI_CONFIG_PP_GM_MAX_VERTICES and #AI_CONFIG_PP_GM_MAX_TRIANGLES
+     *  to configure the meshlet size.
+     *
+     *  @note This step expects triangulated input data.
+     */
+    aiProcessExt_GenerateMeshlets = 0x1,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Generates a chain of simplified meshes (levels of detail) for each
+     *  triangle mesh.
+     *
+     *  The levels are stored in #aiMesh::mLODs. Simplification uses quadric
+     *  error metrics and half-edge collapses, so the remaining vertices keep
+     *  their original attributes. Vertices on borders and attribute seams
+     *  (UVs, normals, ...) are preserved and collapses across bone
+     *  boundaries are rejected. Meshes are processed in parallel, see
+     *  #AI_CONFIG_GLOB_MULTITHREADING.
+     *  Use #AI_CONFIG_PP_LOD_COUNT, #AI_CONFIG_PP_LOD_REDUCTION and
+     *  #AI_CONFIG_PP_LOD_MAX_ERROR to configure the chain.
+     *
+     *  @note This step expects triangulated input data. Combine it with
+     *  #aiProcess_JoinIdenticalVertices, otherwise there is no connectivity
+     *  to simplify.
+     */
+    aiProcessExt_GenerateLODs = 0x2,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Attaches compact copies of the vertex streams to each mesh.
+     *
+     *  The copies are stored in #aiMesh::mQuantized: positions as 16 bit
+     *  values relative to the bounding box of the mesh, normals and tangents
+     *  in octahedral encoding, texture coordinates as half floats and
+     *  vertex colors as RGBA8. The full precision streams are kept.
+     *  Combine it with #aiProcess_GenBoundingBoxes to reuse its boxes.
+     *
+     *  The glTF 2.0 exporter writes the quantized streams using the
+     *  KHR_mesh_quantization extension.
+     */
+    aiProcessExt_QuantizeVertices = 0x4,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Builds bounding volume hierarchies for ray casts and collision
+     *  queries.
+     *
+     *  A hierarchy over the faces is attached to each mesh (#aiMesh::mBVH)
+     *  and a top-level hierarchy over all mesh instances, i.e. each mesh
+     *  reference of each node with its global transformation, is attached
+     *  to the scene (#aiScene::mBVH, #aiScene::mBVHInstances). Both use the
+     *  surface area heuristic evaluated over a fixed number of bins.
+     *  Construction runs in parallel, see #AI_CONFIG_GLOB_MULTITHREADING.
+     *  Use #AI_CONFIG_PP_BVH_MAX_LEAF_SIZE and #AI_CONFIG_PP_BVH_BINS to
+     *  configure the build.
+     *
+     *  @note Steps which alter the faces or the node graph invalidate the
+     *  hierarchies, so request this one together with them rather than
+     *  applying them later on.
+     */
+    aiProcessExt_GenerateBVH = 0x8,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Removes animation keys which are reconstructed by interpolating
+     *  their neighbours within an error bound.
+     *
+     *  Importers which sample animations, such as the FBX, BVH and Collada
+     *  loaders, emit a key for every frame. This step keeps only the keys
+     *  needed to reproduce each position, rotation and scaling track within
+     *  #AI_CONFIG_PP_OA_POSITION_ERROR, #AI_CONFIG_PP_OA_ROTATION_ERROR and
+     *  #AI_CONFIG_PP_OA_SCALE_ERROR, assuming linear interpolation of
+     *  positions and scalings and spherical interpolation of rotations.
+     *  Tracks with a constant value are reduced to a single key. If
+     *  #AI_CONFIG_PP_OA_QUANTIZE is set, a compact quantized copy of the
+     *  remaining keys is attached to each channel (#aiNodeAnim::mQuantized).
+     *  Channels are processed in parallel, see #AI_CONFIG_GLOB_MULTITHREADING.
+     */
+    aiProcessExt_OptimizeAnimations = 0x10
+};
+
 
 // ---------------------------------------------------------------------------------------
 /** @def aiProcess_ConvertToLeftHanded
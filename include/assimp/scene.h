@@ -141,7 +141,7 @@ struct ASSIMP_API aiNode
     /** Construction from a specific name */
     explicit aiNode(const std::string& name);
 
-    /** Destructor */
+    /** Destructor, deletes the subtree without recursing into it */
     ~aiNode();
 
     /** Searches for a node with a specific name, beginning at this
@@ -234,6 +234,28 @@ struct ASSIMP_API aiNode
  */
 #define AI_SCENE_FLAGS_ALLOW_SHARED			0x20
 
+// -------------------------------------------------------------------------------
+/** A mesh placed in the scene by a node, the primitive of the scene level
+ *  bounding volume hierarchy generated by #aiProcessExt_GenerateBVH.
+ */
+// -------------------------------------------------------------------------------
+struct aiBVHInstance {
+    /** Index of the mesh in aiScene::mMeshes. */
+    unsigned int mMeshIndex;
+
+    /** Transformation from mesh space to scene space, i.e. the
+     *  concatenated transformations of the node and all of its parents. */
+    C_STRUCT aiMatrix4x4 mTransformation;
+
+#ifdef __cplusplus
+    aiBVHInstance() AI_NO_EXCEPT
+            : mMeshIndex(0),
+              mTransformation() {
+        // empty
+    }
+#endif // __cplusplus
+};
+
 // -------------------------------------------------------------------------------
 /** The root structure of the imported data.
  *
@@ -341,6 +363,19 @@ struct aiScene
      */
     C_STRUCT aiMetadata* mMetaData;
 
+    /** Bounding volume hierarchy over all mesh instances of the scene.
+     *  Is nullptr unless the #aiProcessExt_GenerateBVH step was applied.
+     */
+    C_STRUCT aiBVH* mBVH;
+
+    /** The number of mesh instances referenced by mBVH. */
+    unsigned int mNumBVHInstances;
+
+    /** The mesh instances referenced by mBVH, one for each mesh reference
+     *  of each node. The array is mNumBVHInstances in size.
+     */
+    C_STRUCT aiBVHInstance* mBVHInstances;
+
 
 #ifdef __cplusplus
 
@@ -382,6 +417,11 @@ struct aiScene
         return mAnimations != nullptr && mNumAnimations > 0; 
     }
 
+    //! Check whether the scene contains a bounding volume hierarchy
+    inline bool HasBVH() const {
+        return mBVH != nullptr && mBVH->mNumNodes > 0;
+    }
+
     //! Returns a short filename from a full path
     static const char* GetShortFilename(const char* filename) {
         const char* lastSlash = strrchr(filename, '/');
@@ -0,0 +1,304 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Benchmark.cpp
+ *  @brief Measurement and reporting helpers of the assimp_bench tool.
+ */
+#include "Benchmark.h"
+
+#include <assimp/version.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#   include <fstream>
+#endif
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+std::string EscapeJson(const std::string &in) {
+    std::string out;
+    out.reserve(in.length());
+    for (char c : in) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                ::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+                out += buffer;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string FormatDouble(double value) {
+    char buffer[32];
+    ::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    return buffer;
+}
+
+// ------------------------------------------------------------------------------------------------
+double GetMedian(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+Options::Options() :
+        mIterations(5),
+        mFilter(),
+        mMaxVertices(1000000),
+        mModelsDir(),
+        mFiles(),
+        mListOnly(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+Result::Result() :
+        mName(),
+        mCategory(),
+        mSubject(),
+        mInput(),
+        mBytes(0),
+        mVertices(0),
+        mSeconds(),
+        mPeakRss(0),
+        mError() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+Runner::Runner(const Options &options) :
+        mOptions(options), mResults(), mPerBenchmarkPeakRss(ResetPeakRss()) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Runner::Select(const std::string &name) const {
+    if (!mOptions.mFilter.empty() && std::string::npos == name.find(mOptions.mFilter)) {
+        return false;
+    }
+    if (mOptions.mListOnly) {
+        std::cout << name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Runner::Run(Result result, const Callback &setup, const Callback &body, const Callback &teardown) {
+    std::cerr << result.mName << " ... " << std::flush;
+    ResetPeakRss();
+    try {
+        for (unsigned int i = 0; i < mOptions.mIterations; ++i) {
+            if (setup) {
+                setup();
+            }
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            body();
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            result.mSeconds.push_back(std::chrono::duration<double>(end - start).count());
+            if (teardown) {
+                teardown();
+            }
+        }
+    } catch (const std::exception &e) {
+        result.mError = e.what();
+    }
+    result.mPeakRss = GetPeakRss();
+
+    if (result.mError.empty()) {
+        std::cerr << FormatDouble(GetMedian(result.mSeconds) * 1000.0) << " ms" << std::endl;
+    } else {
+        std::cerr << "failed: " << result.mError << std::endl;
+    }
+    mResults.push_back(result);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Runner::Fail(Result result, const std::string &error) {
+    std::cerr << result.mName << " ... failed: " << error << std::endl;
+    result.mError = error;
+    mResults.push_back(result);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Runner::WriteJson(std::ostream &out) const {
+    out << "{\n";
+    out << "  \"version\": \"" << aiGetVersionMajor() << "." << aiGetVersionMinor() << "." << aiGetVersionPatch() << "\",\n";
+    char revision[16];
+    ::snprintf(revision, sizeof(revision), "%x", aiGetVersionRevision());
+    out << "  \"revision\": \"" << revision << "\",\n";
+    out << "  \"debug\": " << ((aiGetCompileFlags() & ASSIMP_CFLAGS_DEBUG) ? "true" : "false") << ",\n";
+    out << "  \"iterations\": " << mOptions.mIterations << ",\n";
+    out << "  \"max_vertices\": " << mOptions.mMaxVertices << ",\n";
+    out << "  \"per_benchmark_peak_rss\": " << (mPerBenchmarkPeakRss ? "true" : "false") << ",\n";
+    out << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < mResults.size(); ++i) {
+        const Result &result = mResults[i];
+        out << (i ? ",\n" : "\n") << "    {\n";
+        out << "      \"name\": \"" << EscapeJson(result.mName) << "\",\n";
+        out << "      \"category\": \"" << EscapeJson(result.mCategory) << "\",\n";
+        out << "      \"subject\": \"" << EscapeJson(result.mSubject) << "\",\n";
+        out << "      \"input\": \"" << EscapeJson(result.mInput) << "\",\n";
+        out << "      \"bytes\": " << result.mBytes << ",\n";
+        out << "      \"vertices\": " << result.mVertices << ",\n";
+        if (!result.mError.empty() || result.mSeconds.empty()) {
+            out << "      \"error\": \"" << EscapeJson(result.mError) << "\"\n";
+            out << "    }";
+            continue;
+        }
+
+        const double best = *std::min_element(result.mSeconds.begin(), result.mSeconds.end());
+        const double median = GetMedian(result.mSeconds);
+        out << "      \"runs\": " << result.mSeconds.size() << ",\n";
+        out << "      \"seconds_min\": " << FormatDouble(best) << ",\n";
+        out << "      \"seconds_median\": " << FormatDouble(median) << ",\n";
+        // Throughput is derived from the median, which is less noisy than the best run
+        if (result.mBytes && median > 0.0) {
+            out << "      \"mb_per_s\": " << FormatDouble(result.mBytes / median / (1024.0 * 1024.0)) << ",\n";
+        }
+        if (result.mVertices && median > 0.0) {
+            out << "      \"vertices_per_s\": " << FormatDouble(result.mVertices / median) << ",\n";
+        }
+        out << "      \"peak_rss_bytes\": " << result.mPeakRss << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ResetPeakRss() {
+#if defined(__linux__)
+    // Writing 5 resets the VmHWM counter, supported since Linux 4.0
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (!clearRefs) {
+        return false;
+    }
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+#else
+    return false;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t GetPeakRss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+#   if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (0 == line.compare(0, 6, "VmHWM:")) {
+            return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+        }
+    }
+#   endif
+    struct rusage usage;
+    if (0 != ::getrusage(RUSAGE_SELF, &usage)) {
+        return 0;
+    }
+#   ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#   else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<unsigned int> GetGeneratedSizes(const Options &options) {
+    static const unsigned int sizes[] = { 1000, 10000, 100000, 1000000, 10000000, 50000000 };
+    std::vector<unsigned int> result;
+    for (unsigned int size : sizes) {
+        if (size <= options.mMaxVertices) {
+            result.push_back(size);
+        }
+    }
+    return result;
+}
+
+} // namespace Bench
+} // namespace Assimp
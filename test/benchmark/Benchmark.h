@@ -0,0 +1,175 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Benchmark.h
+ *  @brief Measurement and reporting helpers of the assimp_bench tool.
+ */
+#pragma once
+#ifndef AI_BENCHMARK_H_INC
+#define AI_BENCHMARK_H_INC
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+namespace Bench {
+
+// ------------------------------------------------------------------------------------------------
+/** Command line settings shared by all benchmarks */
+struct Options {
+    Options();
+
+    /// Number of measured runs per benchmark
+    unsigned int mIterations;
+
+    /// Only benchmarks whose name contains this string are run
+    std::string mFilter;
+
+    /// Generated inputs larger than this are skipped
+    unsigned int mMaxVertices;
+
+    /// Directory holding the test models, usually test/models
+    std::string mModelsDir;
+
+    /// Additional model files to benchmark
+    std::vector<std::string> mFiles;
+
+    /// Print the benchmark names instead of running them
+    bool mListOnly;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Measurements of a single benchmark */
+struct Result {
+    Result();
+
+    /// Unique name, e.g. "import/obj/grid-100000"
+    std::string mName;
+
+    /// "import" or "postprocess"
+    std::string mCategory;
+
+    /// Importer format or post-processing step
+    std::string mSubject;
+
+    /// Description of the input data
+    std::string mInput;
+
+    /// Size of the input data in bytes, 0 if not applicable
+    uint64_t mBytes;
+
+    /// Number of vertices processed per run
+    uint64_t mVertices;
+
+    /// Wall clock times of the measured runs, in seconds
+    std::vector<double> mSeconds;
+
+    /// Peak resident set size during the benchmark, in bytes
+    uint64_t mPeakRss;
+
+    /// Set if the benchmark failed
+    std::string mError;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Runs benchmarks and collects their results.
+ *
+ *  Each benchmark consists of an untimed setup, the timed body and an untimed
+ *  teardown, which are invoked once per iteration. Exceptions abort the
+ *  benchmark and are recorded as its error. */
+class Runner {
+public:
+    typedef std::function<void()> Callback;
+
+    explicit Runner(const Options &options);
+
+    const Options &GetOptions() const { return mOptions; }
+
+    /// Returns true if the benchmark is to be prepared and run, false if it
+    /// is filtered out. In list mode the name is printed and false returned.
+    bool Select(const std::string &name) const;
+
+    /// Runs a benchmark accepted by Select(). The name, category, subject,
+    /// input, byte and vertex count of the result are set by the caller.
+    void Run(Result result, const Callback &setup, const Callback &body, const Callback &teardown);
+
+    /// Records a benchmark accepted by Select() which could not be prepared.
+    void Fail(Result result, const std::string &error);
+
+    const std::vector<Result> &GetResults() const { return mResults; }
+
+    /// Writes all results as JSON document.
+    void WriteJson(std::ostream &out) const;
+
+private:
+    Options mOptions;
+    std::vector<Result> mResults;
+
+    /// Whether the peak RSS can be reset between benchmarks, otherwise it
+    /// is the peak of the process so far.
+    bool mPerBenchmarkPeakRss;
+};
+
+// ------------------------------------------------------------------------------------------------
+/// Resets the peak resident set size of the process, returns false if the
+/// platform does not support this.
+bool ResetPeakRss();
+
+/// Returns the peak resident set size of the process in bytes.
+uint64_t GetPeakRss();
+
+// ------------------------------------------------------------------------------------------------
+/// Benchmarks the importers on generated, test and scaled test models.
+void RunImportBenchmarks(Runner &runner);
+
+/// Benchmarks the post-processing steps on generated meshes.
+void RunPostProcessBenchmarks(Runner &runner);
+
+/// Vertex counts of the generated meshes.
+std::vector<unsigned int> GetGeneratedSizes(const Options &options);
+
+} // namespace Bench
+} // namespace Assimp
+
+#endif // AI_BENCHMARK_H_INC
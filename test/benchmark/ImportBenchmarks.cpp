@@ -0,0 +1,273 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ImportBenchmarks.cpp
+ *  @brief Parse benchmarks of the importers.
+ */
+#include "Benchmark.h"
+#include "SceneGenerator.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Formats the generated meshes are written in, with the hint passed to the importer
+struct SyntheticFormat {
+    const char *mExportId;
+    const char *mHint;
+};
+
+const SyntheticFormat SyntheticFormats[] = {
+    { "obj", "obj" },
+    { "ply", "ply" },
+    { "plyb", "ply" },
+    { "stl", "stl" },
+    { "stlb", "stl" },
+    { "collada", "dae" },
+    { "x", "x" },
+    { "fbx", "fbx" },
+    { "glb2", "glb" },
+    { "assbin", "assbin" }
+};
+
+// Representative test models, relative to the models directory
+const char *DefaultModels[] = {
+    "OBJ/spider.obj",
+    "OBJ/WusonOBJ.obj",
+    "PLY/Wuson.ply",
+    "PLY/cube_binary.ply",
+    "STL/Spider_ascii.stl",
+    "STL/Spider_binary.stl",
+    "Collada/duck.dae",
+    "X/Testwuson.X",
+    "FBX/spider.fbx",
+    "glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb",
+    "3DS/fels.3ds"
+};
+
+// The test models are scaled up by these factors
+const unsigned int ScaleFactors[] = { 16, 256 };
+
+// ------------------------------------------------------------------------------------------------
+uint64_t CountVertices(const aiScene *scene) {
+    uint64_t count = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        count += scene->mMeshes[i]->mNumVertices;
+    }
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<char> ExportToMemory(const aiScene *scene, const std::string &formatId) {
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, formatId);
+    if (nullptr == blob) {
+        throw std::runtime_error(exporter.GetErrorString());
+    }
+
+    // only the main file, side files such as material libraries are not found on import
+    const char *data = static_cast<const char *>(blob->data);
+    return std::vector<char>(data, data + blob->size);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Times ReadFileFromMemory on a buffer. The buffer is imported once up front to verify it and
+// to count the vertices, which also warms up the caches.
+void RunMemoryImport(Runner &runner, Result result, const std::vector<char> &buffer, const std::string &hint) {
+    std::shared_ptr<Importer> importer = std::make_shared<Importer>();
+    const aiScene *scene = importer->ReadFileFromMemory(buffer.data(), buffer.size(), 0, hint.c_str());
+    if (nullptr == scene) {
+        runner.Fail(result, importer->GetErrorString());
+        return;
+    }
+    result.mBytes = buffer.size();
+    result.mVertices = CountVertices(scene);
+    importer->FreeScene();
+
+    runner.Run(result, Runner::Callback(),
+        [importer, &buffer, &hint]() {
+            if (nullptr == importer->ReadFileFromMemory(buffer.data(), buffer.size(), 0, hint.c_str())) {
+                throw std::runtime_error(importer->GetErrorString());
+            }
+        },
+        [importer]() { importer->FreeScene(); });
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunSyntheticBenchmarks(Runner &runner) {
+    for (unsigned int size : GetGeneratedSizes(runner.GetOptions())) {
+        std::unique_ptr<aiScene> scene;
+        for (const SyntheticFormat &format : SyntheticFormats) {
+            Result result;
+            result.mName = std::string("import/") + format.mExportId + "/grid-" + std::to_string(size);
+            result.mCategory = "import";
+            result.mSubject = format.mExportId;
+            result.mInput = "grid-" + std::to_string(size);
+            if (!runner.Select(result.mName)) {
+                continue;
+            }
+
+            try {
+                if (!scene) {
+                    scene.reset(CreateGridScene(size, GridLayout_IndexedTriangles, true));
+                }
+                const std::vector<char> buffer = ExportToMemory(scene.get(), format.mExportId);
+                RunMemoryImport(runner, result, buffer, format.mHint);
+            } catch (const std::exception &e) {
+                runner.Fail(result, e.what());
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string GetExtension(const std::string &path) {
+    const std::string::size_type pos = path.find_last_of('.');
+    if (std::string::npos == pos) {
+        return std::string();
+    }
+    std::string extension = path.substr(pos + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the id of an exporter writing files with the given extension, or an empty string
+std::string FindExportFormat(const std::string &extension) {
+    Exporter exporter;
+    for (size_t i = 0; i < exporter.GetExportFormatCount(); ++i) {
+        const aiExportFormatDesc *desc = exporter.GetExportFormatDescription(i);
+        if (extension == desc->fileExtension) {
+            return desc->id;
+        }
+    }
+    return std::string();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Imports the file from disk, and scaled copies written with the exporter for its format from memory
+void RunModelBenchmarks(Runner &runner, const std::string &path, const std::string &label) {
+    Result result;
+    result.mName = "import/model/" + label;
+    result.mCategory = "import";
+    result.mSubject = GetExtension(path);
+    result.mInput = label;
+
+    if (runner.Select(result.mName)) {
+        std::shared_ptr<Importer> importer = std::make_shared<Importer>();
+        std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+        const aiScene *scene = file ? importer->ReadFile(path, 0) : nullptr;
+        if (nullptr == scene) {
+            runner.Fail(result, file ? importer->GetErrorString() : "cannot open file");
+        } else {
+            result.mBytes = static_cast<uint64_t>(file.tellg());
+            result.mVertices = CountVertices(scene);
+            importer->FreeScene();
+            runner.Run(result, Runner::Callback(),
+                [importer, path]() {
+                    if (nullptr == importer->ReadFile(path, 0)) {
+                        throw std::runtime_error(importer->GetErrorString());
+                    }
+                },
+                [importer]() { importer->FreeScene(); });
+        }
+    }
+
+    const std::string exportId = FindExportFormat(result.mSubject);
+    if (exportId.empty()) {
+        return;
+    }
+    Importer source;
+    for (unsigned int copies : ScaleFactors) {
+        Result scaled = result;
+        scaled.mName += "/x" + std::to_string(copies);
+        scaled.mInput += " x" + std::to_string(copies);
+        if (!runner.Select(scaled.mName)) {
+            continue;
+        }
+
+        try {
+            if (nullptr == source.GetScene() && nullptr == source.ReadFile(path, 0)) {
+                throw std::runtime_error(source.GetErrorString());
+            }
+            if (CountVertices(source.GetScene()) * copies > runner.GetOptions().mMaxVertices) {
+                continue;
+            }
+            std::unique_ptr<aiScene> scene(CreateScaledScene(source.GetScene(), copies));
+            const std::vector<char> buffer = ExportToMemory(scene.get(), exportId);
+            RunMemoryImport(runner, scaled, buffer, result.mSubject);
+        } catch (const std::exception &e) {
+            runner.Fail(scaled, e.what());
+        }
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RunImportBenchmarks(Runner &runner) {
+    RunSyntheticBenchmarks(runner);
+
+    const Options &options = runner.GetOptions();
+    if (!options.mModelsDir.empty()) {
+        for (const char *model : DefaultModels) {
+            RunModelBenchmarks(runner, options.mModelsDir + "/" + model, model);
+        }
+    }
+    for (const std::string &file : options.mFiles) {
+        RunModelBenchmarks(runner, file, file);
+    }
+}
+
+} // namespace Bench
+} // namespace Assimp
@@ -0,0 +1,151 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Main.cpp
+ *  @brief main() function of assimp_bench
+ */
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace Assimp::Bench;
+
+static const char *AIBENCH_MSG_HELP =
+"assimp_bench [options]\n\n"
+" Runs the import and post-processing benchmarks and writes the results\n"
+" as JSON document.\n\n"
+" options:\n"
+" \t--output <file>       - Write the JSON results to <file> instead of stdout\n"
+" \t--filter <text>       - Only run benchmarks whose name contains <text>,\n"
+" \t                        e.g. 'import/' or 'postprocess/JoinIdenticalVertices'\n"
+" \t--iterations <n>      - Measured runs per benchmark (default: 5)\n"
+" \t--max-vertices <n>    - Skip generated and scaled inputs with more vertices,\n"
+" \t                        the generated meshes range from 1000 to 50000000\n"
+" \t                        vertices (default: 1000000)\n"
+" \t--models <dir>        - Directory of the test models (default: test/models\n"
+" \t                        of the source tree), empty to skip them\n"
+" \t--file <path>         - Benchmark an additional model file, may be repeated\n"
+" \t--list                - Print the names of the benchmarks and exit\n"
+"\n"
+" Peak RSS is measured per benchmark where the platform allows resetting it\n"
+" (Linux), otherwise it is the peak of the process so far. Run single\n"
+" benchmarks through --filter to isolate them.\n";
+
+// ------------------------------------------------------------------------------------------------
+static bool ParseUnsigned(const char *text, unsigned int &out) {
+    char *end = nullptr;
+    const unsigned long value = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || 0 == value) {
+        return false;
+    }
+    out = static_cast<unsigned int>(value);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+    Options options;
+#ifdef ASSIMP_TEST_MODELS_DIR
+    options.mModelsDir = ASSIMP_TEST_MODELS_DIR;
+#endif
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (0 == ::strcmp(arg, "--help") || 0 == ::strcmp(arg, "-h")) {
+            std::cout << AIBENCH_MSG_HELP;
+            return 0;
+        } else if (0 == ::strcmp(arg, "--list")) {
+            options.mListOnly = true;
+        } else if (0 == ::strcmp(arg, "--output") && hasValue) {
+            output = argv[++i];
+        } else if (0 == ::strcmp(arg, "--filter") && hasValue) {
+            options.mFilter = argv[++i];
+        } else if (0 == ::strcmp(arg, "--models") && hasValue) {
+            options.mModelsDir = argv[++i];
+        } else if (0 == ::strcmp(arg, "--file") && hasValue) {
+            options.mFiles.push_back(argv[++i]);
+        } else if (0 == ::strcmp(arg, "--iterations") && hasValue) {
+            if (!ParseUnsigned(argv[++i], options.mIterations)) {
+                std::cerr << "Invalid iteration count: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (0 == ::strcmp(arg, "--max-vertices") && hasValue) {
+            if (!ParseUnsigned(argv[++i], options.mMaxVertices)) {
+                std::cerr << "Invalid vertex count: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n\n" << AIBENCH_MSG_HELP;
+            return 1;
+        }
+    }
+
+    Runner runner(options);
+    RunImportBenchmarks(runner);
+    RunPostProcessBenchmarks(runner);
+    if (options.mListOnly) {
+        return 0;
+    }
+
+    if (output.empty()) {
+        runner.WriteJson(std::cout);
+    } else {
+        std::ofstream out(output.c_str());
+        runner.WriteJson(out);
+        if (!out) {
+            std::cerr << "Failed to write " << output << std::endl;
+            return 1;
+        }
+    }
+
+    // fail if any benchmark did, so broken inputs do not go unnoticed in automated runs
+    for (const Result &result : runner.GetResults()) {
+        if (!result.mError.empty()) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file PostProcessBenchmarks.cpp
+ *  @brief Benchmarks of the post-processing steps.
+ */
+#include "Benchmark.h"
+#include "SceneGenerator.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <stdexcept>
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// A post-processing step and the input it is measured on
+struct StepBenchmark {
+    const char *mName;
+    unsigned int mFlags;
+    unsigned int mExtendedFlags;
+    GridLayout mLayout;
+    bool mWithNormals;
+};
+
+const StepBenchmark StepBenchmarks[] = {
+    { "CalcTangentSpace", aiProcess_CalcTangentSpace, 0, GridLayout_IndexedTriangles, true },
+    { "JoinIdenticalVertices", aiProcess_JoinIdenticalVertices, 0, GridLayout_VerboseTriangles, true },
+    { "Triangulate", aiProcess_Triangulate, 0, GridLayout_IndexedQuads, true },
+    { "GenNormals", aiProcess_GenNormals, 0, GridLayout_VerboseTriangles, false },
+    { "GenSmoothNormals", aiProcess_GenSmoothNormals, 0, GridLayout_VerboseTriangles, false },
+    { "SplitLargeMeshes", aiProcess_SplitLargeMeshes, 0, GridLayout_IndexedTriangles, true },
+    { "ImproveCacheLocality", aiProcess_ImproveCacheLocality, 0, GridLayout_IndexedTriangles, true },
+    { "FixInfacingNormals", aiProcess_FixInfacingNormals, 0, GridLayout_IndexedTriangles, true },
+    { "SortByPType", aiProcess_SortByPType, 0, GridLayout_IndexedTriangles, true },
+    { "FindDegenerates", aiProcess_FindDegenerates, 0, GridLayout_IndexedTriangles, true },
+    { "FindInvalidData", aiProcess_FindInvalidData, 0, GridLayout_IndexedTriangles, true },
+    { "OptimizeMeshes", aiProcess_OptimizeMeshes, 0, GridLayout_IndexedTriangles, true },
+    { "MakeLeftHanded", aiProcess_MakeLeftHanded, 0, GridLayout_IndexedTriangles, true },
+    { "FlipWindingOrder", aiProcess_FlipWindingOrder, 0, GridLayout_IndexedTriangles, true },
+    { "GenBoundingBoxes", aiProcess_GenBoundingBoxes, 0, GridLayout_IndexedTriangles, true },
+    { "ValidateDataStructure", aiProcess_ValidateDataStructure, 0, GridLayout_IndexedTriangles, true },
+    { "GenerateMeshlets", 0, aiProcessExt_GenerateMeshlets, GridLayout_IndexedTriangles, true },
+    { "GenerateLODs", 0, aiProcessExt_GenerateLODs, GridLayout_IndexedTriangles, true },
+    { "QuantizeVertices", 0, aiProcessExt_QuantizeVertices, GridLayout_IndexedTriangles, true },
+    { "GenerateBVH", 0, aiProcessExt_GenerateBVH, GridLayout_IndexedTriangles, true }
+};
+
+// ------------------------------------------------------------------------------------------------
+// The importer owns the scenes the steps are applied to, so the generated scenes are passed
+// through an in-memory assbin file. Reading it back is part of the untimed setup.
+std::shared_ptr<std::vector<char>> CreateInput(unsigned int numVertices, GridLayout layout, bool withNormals) {
+    std::unique_ptr<aiScene> scene(CreateGridScene(numVertices, layout, withNormals));
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene.get(), "assbin");
+    if (nullptr == blob) {
+        throw std::runtime_error(exporter.GetErrorString());
+    }
+    const char *data = static_cast<const char *>(blob->data);
+    return std::make_shared<std::vector<char>>(data, data + blob->size);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void RunPostProcessBenchmarks(Runner &runner) {
+    for (unsigned int size : GetGeneratedSizes(runner.GetOptions())) {
+        // steps sharing an input layout reuse it
+        std::shared_ptr<std::vector<char>> inputs[3][2];
+
+        for (const StepBenchmark &step : StepBenchmarks) {
+            Result result;
+            result.mName = std::string("postprocess/") + step.mName + "/grid-" + std::to_string(size);
+            result.mCategory = "postprocess";
+            result.mSubject = step.mName;
+            result.mInput = "grid-" + std::to_string(size);
+            if (!runner.Select(result.mName)) {
+                continue;
+            }
+
+            try {
+                std::shared_ptr<std::vector<char>> &input = inputs[step.mLayout][step.mWithNormals ? 1 : 0];
+                if (!input) {
+                    input = CreateInput(size, step.mLayout, step.mWithNormals);
+                }
+
+                std::shared_ptr<Importer> importer = std::make_shared<Importer>();
+                const aiScene *scene = importer->ReadFileFromMemory(input->data(), input->size(), 0, "assbin");
+                if (nullptr == scene) {
+                    throw std::runtime_error(importer->GetErrorString());
+                }
+                for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+                    result.mVertices += scene->mMeshes[i]->mNumVertices;
+                }
+                importer->FreeScene();
+
+                const StepBenchmark *benchmark = &step;
+                runner.Run(result,
+                    [importer, input, benchmark]() {
+                        importer->SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, 0);
+                        if (nullptr == importer->ReadFileFromMemory(input->data(), input->size(), 0, "assbin")) {
+                            throw std::runtime_error(importer->GetErrorString());
+                        }
+                        importer->SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, benchmark->mExtendedFlags);
+                    },
+                    [importer, benchmark]() {
+                        if (nullptr == importer->ApplyPostProcessing(benchmark->mFlags)) {
+                            throw std::runtime_error(importer->GetErrorString());
+                        }
+                    },
+                    [importer]() { importer->FreeScene(); });
+            } catch (const std::exception &e) {
+                runner.Fail(result, e.what());
+            }
+        }
+    }
+}
+
+} // namespace Bench
+} // namespace Assimp
@@ -0,0 +1,265 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file SceneGenerator.cpp
+ *  @brief Creates the input scenes of the assimp_bench tool.
+ */
+#include "SceneGenerator.h"
+
+#include <assimp/SceneCombiner.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace Assimp {
+namespace Bench {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Samples the height field at a grid position
+void SampleGrid(unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+        aiVector3D &position, aiVector3D &normal, aiVector3D &uv) {
+    const ai_real fx = static_cast<ai_real>(x), fy = static_cast<ai_real>(y);
+    const ai_real s = std::sin(ai_real(0.3) * fx), c = std::cos(ai_real(0.2) * fy);
+    position = aiVector3D(fx, ai_real(2.0) * s * c, fy);
+
+    // the gradient of the height function gives the normal
+    const ai_real dx = ai_real(0.6) * std::cos(ai_real(0.3) * fx) * c;
+    const ai_real dz = ai_real(-0.4) * s * std::sin(ai_real(0.2) * fy);
+    normal = aiVector3D(-dx, ai_real(1.0), -dz).Normalize();
+
+    uv = aiVector3D(fx / (width - 1), fy / (height - 1), ai_real(0.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void AllocateVertices(aiMesh *mesh, unsigned int numVertices, bool withNormals) {
+    mesh->mNumVertices = numVertices;
+    mesh->mVertices = new aiVector3D[numVertices];
+    if (withNormals) {
+        mesh->mNormals = new aiVector3D[numVertices];
+    }
+    mesh->mTextureCoords[0] = new aiVector3D[numVertices];
+    mesh->mNumUVComponents[0] = 2;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SetVertex(aiMesh *mesh, unsigned int index, unsigned int x, unsigned int y, unsigned int width, unsigned int height) {
+    aiVector3D normal;
+    SampleGrid(x, y, width, height, mesh->mVertices[index], normal, mesh->mTextureCoords[0][index]);
+    if (mesh->mNormals) {
+        mesh->mNormals[index] = normal;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SetFace(aiFace &face, unsigned int a, unsigned int b, unsigned int c) {
+    face.mNumIndices = 3;
+    face.mIndices = new unsigned int[3];
+    face.mIndices[0] = a;
+    face.mIndices[1] = b;
+    face.mIndices[2] = c;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Shared vertices on a width x height grid
+aiMesh *CreateIndexedGrid(unsigned int numVertices, bool quads, bool withNormals) {
+    const unsigned int width = std::max(2u, static_cast<unsigned int>(std::sqrt(static_cast<double>(numVertices))));
+    const unsigned int height = std::max(2u, numVertices / width);
+
+    aiMesh *mesh = new aiMesh();
+    AllocateVertices(mesh, width * height, withNormals);
+    for (unsigned int y = 0; y < height; ++y) {
+        for (unsigned int x = 0; x < width; ++x) {
+            SetVertex(mesh, y * width + x, x, y, width, height);
+        }
+    }
+
+    const unsigned int numCells = (width - 1) * (height - 1);
+    mesh->mNumFaces = quads ? numCells : numCells * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    mesh->mPrimitiveTypes = quads ? aiPrimitiveType_POLYGON : aiPrimitiveType_TRIANGLE;
+
+    aiFace *face = mesh->mFaces;
+    for (unsigned int y = 0; y + 1 < height; ++y) {
+        for (unsigned int x = 0; x + 1 < width; ++x) {
+            const unsigned int i = y * width + x;
+            if (quads) {
+                face->mNumIndices = 4;
+                face->mIndices = new unsigned int[4];
+                face->mIndices[0] = i;
+                face->mIndices[1] = i + width;
+                face->mIndices[2] = i + width + 1;
+                face->mIndices[3] = i + 1;
+                ++face;
+            } else {
+                SetFace(*face++, i, i + width, i + 1);
+                SetFace(*face++, i + 1, i + width, i + width + 1);
+            }
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Triangle soup cut from a grid, neighbouring triangles have identical vertices
+aiMesh *CreateVerboseGrid(unsigned int numVertices, bool withNormals) {
+    const unsigned int numTriangles = std::max(1u, numVertices / 3);
+    const unsigned int numCells = (numTriangles + 1) / 2;
+    const unsigned int cellsX = std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(numCells)))));
+    const unsigned int width = cellsX + 1;
+    const unsigned int height = (numCells + cellsX - 1) / cellsX + 1;
+
+    aiMesh *mesh = new aiMesh();
+    AllocateVertices(mesh, numTriangles * 3, withNormals);
+    mesh->mNumFaces = numTriangles;
+    mesh->mFaces = new aiFace[numTriangles];
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+    for (unsigned int t = 0; t < numTriangles; ++t) {
+        const unsigned int cell = t / 2;
+        const unsigned int x = cell % cellsX, y = cell / cellsX;
+        const unsigned int v = t * 3;
+        if (t % 2) {
+            SetVertex(mesh, v, x + 1, y, width, height);
+            SetVertex(mesh, v + 1, x, y + 1, width, height);
+            SetVertex(mesh, v + 2, x + 1, y + 1, width, height);
+        } else {
+            SetVertex(mesh, v, x, y, width, height);
+            SetVertex(mesh, v + 1, x, y + 1, width, height);
+            SetVertex(mesh, v + 2, x + 1, y, width, height);
+        }
+        SetFace(mesh->mFaces[t], v, v + 1, v + 2);
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+void OffsetMeshIndices(aiNode *node, unsigned int offset, const std::string &suffix) {
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        node->mMeshes[i] += offset;
+    }
+    node->mName.Append(suffix.c_str());
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        OffsetMeshIndices(node->mChildren[i], offset, suffix);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+aiScene *CreateGridScene(unsigned int numVertices, GridLayout layout, bool withNormals) {
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    if (GridLayout_VerboseTriangles == layout) {
+        scene->mMeshes[0] = CreateVerboseGrid(numVertices, withNormals);
+    } else {
+        scene->mMeshes[0] = CreateIndexedGrid(numVertices, GridLayout_IndexedQuads == layout, withNormals);
+        scene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+    }
+    scene->mMeshes[0]->mName.Set("grid");
+
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial *[1];
+    scene->mMaterials[0] = new aiMaterial();
+    aiString name("grid_material");
+    scene->mMaterials[0]->AddProperty(&name, AI_MATKEY_NAME);
+
+    scene->mRootNode = new aiNode("root");
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene *CreateScaledScene(const aiScene *source, unsigned int copies) {
+    aiScene *scene = nullptr;
+    SceneCombiner::CopyScene(&scene, source);
+    if (copies < 2 || nullptr == scene->mRootNode) {
+        return scene;
+    }
+
+    // place the copies next to each other along the x axis
+    aiVector3D min(ai_real(0.0)), max(ai_real(0.0));
+    const unsigned int numMeshes = scene->mNumMeshes;
+    aiMesh **meshes = new aiMesh *[numMeshes * copies];
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        meshes[i] = scene->mMeshes[i];
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            min.x = std::min(min.x, mesh->mVertices[v].x);
+            max.x = std::max(max.x, mesh->mVertices[v].x);
+        }
+        for (unsigned int k = 1; k < copies; ++k) {
+            SceneCombiner::Copy(&meshes[k * numMeshes + i], mesh);
+        }
+    }
+    delete[] scene->mMeshes;
+    scene->mMeshes = meshes;
+    scene->mNumMeshes = numMeshes * copies;
+    const ai_real spacing = max.x > min.x ? ai_real(1.1) * (max.x - min.x) : ai_real(1.0);
+
+    aiNode *root = new aiNode("scaled_root");
+    root->mNumChildren = copies;
+    root->mChildren = new aiNode *[copies];
+    root->mChildren[0] = scene->mRootNode;
+    root->mChildren[0]->mParent = root;
+    for (unsigned int k = 1; k < copies; ++k) {
+        aiNode *node = nullptr;
+        SceneCombiner::Copy(&node, scene->mRootNode);
+        OffsetMeshIndices(node, k * numMeshes, "_" + std::to_string(k));
+
+        aiMatrix4x4 translation;
+        aiMatrix4x4::Translation(aiVector3D(spacing * k, ai_real(0.0), ai_real(0.0)), translation);
+        node->mTransformation = translation * node->mTransformation;
+        node->mParent = root;
+        root->mChildren[k] = node;
+    }
+    scene->mRootNode = root;
+    return scene;
+}
+
+} // namespace Bench
+} // namespace Assimp
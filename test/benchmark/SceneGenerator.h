@@ -0,0 +1,82 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file SceneGenerator.h
+ *  @brief Creates the input scenes of the assimp_bench tool.
+ */
+#pragma once
+#ifndef AI_BENCHMARK_SCENEGENERATOR_H_INC
+#define AI_BENCHMARK_SCENEGENERATOR_H_INC
+
+struct aiScene;
+
+namespace Assimp {
+namespace Bench {
+
+// ------------------------------------------------------------------------------------------------
+/** Topology of a generated grid mesh */
+enum GridLayout {
+    /// Shared vertices, two triangles per grid cell
+    GridLayout_IndexedTriangles,
+
+    /// Shared vertices, one quad per grid cell
+    GridLayout_IndexedQuads,
+
+    /// Every triangle has its own three vertices, as JoinIdenticalVertices expects
+    GridLayout_VerboseTriangles
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Creates a scene with a single height field mesh of about numVertices
+ *  vertices, with texture coordinates and optionally normals. The caller
+ *  owns the returned scene. */
+aiScene *CreateGridScene(unsigned int numVertices, GridLayout layout, bool withNormals);
+
+// ------------------------------------------------------------------------------------------------
+/** Creates a copy of a scene in which the node hierarchy and all meshes are
+ *  instantiated copies times, side by side. The caller owns the returned
+ *  scene. */
+aiScene *CreateScaledScene(const aiScene *source, unsigned int copies);
+
+} // namespace Bench
+} // namespace Assimp
+
+#endif // AI_BENCHMARK_SCENEGENERATOR_H_INC
@@ -0,0 +1,274 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "UnitTestPCH.h"
+
+#include "Common/Compression.h"
+
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/StreamReader.h>
+
+#include <cstdio>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// "assimp 0 assimp 1 ... assimp 9 " repeated, compressed with gzip and zlib
+static const unsigned char GzipData[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0xcc, 0xbb, 0x09, 0x80, 0x30,
+    0x00, 0x05, 0xc0, 0x55, 0x32, 0x82, 0x51, 0xe3, 0x67, 0x9c, 0x94, 0x16, 0x82, 0x90, 0xfd, 0xc1,
+    0x42, 0x5e, 0xef, 0x00, 0xd7, 0x5d, 0x75, 0x7d, 0x8c, 0xeb, 0x7e, 0xca, 0x54, 0xfa, 0x87, 0x1a,
+    0xcc, 0xc1, 0x12, 0xac, 0x41, 0x0b, 0xb6, 0x60, 0x0f, 0x8e, 0xe0, 0x0c, 0xcc, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0xfe,
+    0x31, 0xbf, 0xf3, 0xa1, 0x35, 0xd9, 0xb0, 0x1e, 0x04, 0x00,
+};
+
+static const unsigned char ZlibData[] = {
+    0x78, 0xda, 0xed, 0xcc, 0xbb, 0x09, 0x80, 0x30, 0x00, 0x05, 0xc0, 0x55, 0x32, 0x82, 0x51, 0xe3,
+    0x67, 0x9c, 0x94, 0x16, 0x82, 0x90, 0xfd, 0xc1, 0x42, 0x5e, 0xef, 0x00, 0xd7, 0x5d, 0x75, 0x7d,
+    0x8c, 0xeb, 0x7e, 0xca, 0x54, 0xfa, 0x87, 0x1a, 0xcc, 0xc1, 0x12, 0xac, 0x41, 0x0b, 0xb6, 0x60,
+    0x0f, 0x8e, 0xe0, 0x0c, 0xcc, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b,
+    0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66,
+    0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9,
+    0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36,
+    0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd,
+    0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3,
+    0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c,
+    0x36, 0x9b, 0xcd, 0x66, 0xb3, 0xd9, 0x6c, 0xfe, 0x31, 0xbf, 0x48, 0xdf, 0x54, 0x69,
+};
+
+std::string ExpectedData() {
+    std::string data;
+    for (int i = 0; i < 30000; ++i) {
+        char tmp[16];
+        ::snprintf(tmp, sizeof(tmp), "assimp %d ", i % 10);
+        data += tmp;
+    }
+    return data;
+}
+
+std::shared_ptr<IOStream> GzipStream() {
+    return std::shared_ptr<IOStream>(new MemoryIOStream(GzipData, sizeof(GzipData)));
+}
+
+} // namespace
+
+TEST(utCompression, inflateAllZlib) {
+    const std::string expected = ExpectedData();
+    std::vector<char> out(expected.size());
+
+    Inflater inflater(Inflater::Format_Zlib);
+    EXPECT_EQ(expected.size(), inflater.InflateAll(ZlibData, sizeof(ZlibData), out.data(), out.size()));
+    EXPECT_TRUE(inflater.IsFinished());
+    EXPECT_EQ(expected, std::string(out.begin(), out.end()));
+
+    // the same inflater can be used again
+    std::fill(out.begin(), out.end(), 0);
+    EXPECT_EQ(expected.size(), inflater.InflateAll(ZlibData, sizeof(ZlibData), out.data(), out.size()));
+    EXPECT_EQ(expected, std::string(out.begin(), out.end()));
+}
+
+TEST(utCompression, corruptDataThrows) {
+    std::vector<unsigned char> corrupt(ZlibData, ZlibData + sizeof(ZlibData));
+    corrupt[0] = 0xff;
+    char out[64];
+    Inflater inflater(Inflater::Format_Zlib);
+    EXPECT_THROW(inflater.InflateAll(corrupt.data(), corrupt.size(), out, sizeof(out)), DeadlyImportError);
+}
+
+TEST(utCompression, truncatedDataThrows) {
+    const std::string expected = ExpectedData();
+    std::vector<char> out(expected.size());
+    Inflater inflater(Inflater::Format_Zlib);
+    EXPECT_THROW(inflater.InflateAll(ZlibData, sizeof(ZlibData) / 2, out.data(), out.size()), DeadlyImportError);
+
+    std::shared_ptr<IOStream> source(new MemoryIOStream(GzipData, sizeof(GzipData) / 2));
+    InflateIOStream stream(source, Inflater::Format_Gzip, expected.size());
+    EXPECT_THROW(stream.Seek(expected.size() - 1, aiOrigin_SET), DeadlyImportError);
+}
+
+TEST(utCompression, gzipSizeFromTrailer) {
+    std::shared_ptr<IOStream> source = GzipStream();
+    source->Seek(3, aiOrigin_SET);
+    EXPECT_EQ(ExpectedData().size(), InflateIOStream::GetGzipSize(*source));
+    EXPECT_EQ(3u, source->Tell());
+}
+
+TEST(utCompression, streamReaderConsumesInflateStream) {
+    const std::string expected = ExpectedData();
+    std::shared_ptr<IOStream> source = GzipStream();
+    std::shared_ptr<IOStream> stream(new InflateIOStream(source, Inflater::Format_Gzip, InflateIOStream::GetGzipSize(*source)));
+    EXPECT_EQ(expected.size(), stream->FileSize());
+
+    StreamReaderLE reader(stream);
+    ASSERT_EQ(expected.size(), reader.GetRemainingSize());
+    EXPECT_EQ(0, ::memcmp(expected.data(), reader.GetPtr(), expected.size()));
+}
+
+TEST(utCompression, inflateStreamSeeks) {
+    const std::string expected = ExpectedData();
+    InflateIOStream stream(GzipStream(), Inflater::Format_Gzip, expected.size());
+
+    char buffer[8];
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(100003, aiOrigin_SET));
+    ASSERT_EQ(1u, stream.Read(buffer, sizeof(buffer), 1));
+    EXPECT_EQ(expected.substr(100003, sizeof(buffer)), std::string(buffer, sizeof(buffer)));
+
+    // going back restarts decompression
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(7, aiOrigin_SET));
+    EXPECT_EQ(7u, stream.Tell());
+    ASSERT_EQ(1u, stream.Read(buffer, sizeof(buffer), 1));
+    EXPECT_EQ(expected.substr(7, sizeof(buffer)), std::string(buffer, sizeof(buffer)));
+
+    // reads stop at the end
+    ASSERT_EQ(aiReturn_SUCCESS, stream.Seek(4, aiOrigin_END));
+    EXPECT_EQ(4u, stream.Read(buffer, 1, sizeof(buffer)));
+    EXPECT_EQ(aiReturn_FAILURE, stream.Seek(expected.size() + 1, aiOrigin_SET));
+}
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/SpatialSort.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 class utSpatialSort : public ::testing::Test {
@@ -82,3 +84,84 @@ TEST_F(utSpatialSort, findPositionsTest) {
     sSort.FindPositions(vecs[0], 0.01f, indices);
     EXPECT_EQ(1u, indices.size());
 }
+
+TEST_F(utSpatialSort, findAllPositionsTest) {
+    // a grid with every position present twice, plus some negative coordinates
+    std::vector<aiVector3D> positions;
+    for (int i = 0; i < 200; ++i) {
+        const aiVector3D p(static_cast<float>(i % 10) - 5.0f, static_cast<float>(i / 10) * 0.5f, -1.0f);
+        positions.push_back(p);
+        positions.push_back(p + aiVector3D(0.001f, 0.0f, 0.0f));
+    }
+    positions.insert(positions.end(), vecs, vecs + 100);
+
+    SpatialSort sSort;
+    sSort.Fill(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+
+    std::vector<size_t> offsets;
+    std::vector<unsigned int> results, expected, found;
+    EXPECT_TRUE(sSort.FindAllPositions(0.01f, offsets, results));
+    ASSERT_EQ(positions.size() + 1, offsets.size());
+    EXPECT_EQ(results.size(), offsets.back());
+    for (unsigned int i = 0; i < positions.size(); ++i) {
+        sSort.FindPositions(positions[i], 0.01f, expected);
+        found.assign(results.begin() + offsets[i], results.begin() + offsets[i + 1]);
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected, found);
+        EXPECT_TRUE(std::find(found.begin(), found.end(), i) != found.end());
+    }
+    EXPECT_EQ(2u, offsets[1] - offsets[0]);
+}
+
+TEST_F(utSpatialSort, findAllPositionsLimitTest) {
+    // a cluster of coincident positions, each finds all of them
+    std::vector<aiVector3D> positions(1000, aiVector3D(1.0f, 2.0f, 3.0f));
+    SpatialSort sSort;
+    sSort.SetNumThreads(4);
+    sSort.Fill(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+
+    std::vector<size_t> offsets;
+    std::vector<unsigned int> results;
+    EXPECT_FALSE(sSort.FindAllPositions(0.01f, offsets, results, 999999));
+    EXPECT_TRUE(offsets.empty());
+    EXPECT_TRUE(results.empty());
+
+    EXPECT_TRUE(sSort.FindAllPositions(0.01f, offsets, results, 1000000));
+    EXPECT_EQ(1000000u, offsets.back());
+    EXPECT_EQ(1000000u, results.size());
+}
+
+TEST_F(utSpatialSort, parallelSortTest) {
+    // enough positions for the parallel code paths, sorted by many threads and by one
+    std::vector<aiVector3D> positions(100000);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const float f = static_cast<float>((i * 7919) % positions.size());
+        positions[i] = aiVector3D(f * 0.01f - 300.0f, static_cast<float>(i % 3), 0.0f);
+    }
+
+    SpatialSort serial, parallel;
+    parallel.SetNumThreads(4);
+    serial.Fill(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+    parallel.Append(positions.data(), 50000, sizeof(aiVector3D), false);
+    parallel.Append(positions.data() + 50000, 50000, sizeof(aiVector3D));
+
+    std::vector<unsigned int> serialTable, parallelTable;
+    EXPECT_EQ(positions.size(), serial.GenerateMappingTable(serialTable, 0.001f));
+    EXPECT_EQ(positions.size(), parallel.GenerateMappingTable(parallelTable, 0.001f));
+    EXPECT_EQ(serialTable, parallelTable);
+
+    std::vector<size_t> serialOffsets, parallelOffsets;
+    std::vector<unsigned int> serialResults, parallelResults;
+    EXPECT_TRUE(serial.FindAllPositions(0.02f, serialOffsets, serialResults));
+    EXPECT_TRUE(parallel.FindAllPositions(0.02f, parallelOffsets, parallelResults));
+    EXPECT_EQ(serialOffsets, parallelOffsets);
+    EXPECT_EQ(serialResults, parallelResults);
+
+    std::vector<unsigned int> indices;
+    for (unsigned int i = 0; i < positions.size(); i += 997) {
+        parallel.FindIdenticalPositions(positions[i], indices);
+        ASSERT_EQ(1u, indices.size());
+        EXPECT_EQ(i, indices[0]);
+    }
+}
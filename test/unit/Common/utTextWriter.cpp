@@ -0,0 +1,160 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "UnitTestPCH.h"
+
+#include "Common/TextWriter.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using namespace Assimp;
+
+class utTextWriter : public ::testing::Test {
+protected:
+    static std::string Format(float f) {
+        char buffer[32];
+        return std::string(buffer, TextWriter::FormatFloat(f, buffer));
+    }
+};
+
+namespace {
+
+// Collects everything written to it, remembering the size of each write call
+class CollectingIOStream : public IOStream {
+public:
+    size_t Read(void *, size_t, size_t) override { return 0; }
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        mWrites.push_back(pSize * pCount);
+        mData.append(static_cast<const char *>(pvBuffer), pSize * pCount);
+        return pCount;
+    }
+    aiReturn Seek(size_t, aiOrigin) override { return aiReturn_FAILURE; }
+    size_t Tell() const override { return mData.length(); }
+    size_t FileSize() const override { return mData.length(); }
+    void Flush() override {}
+
+    std::string mData;
+    std::vector<size_t> mWrites;
+};
+
+} // namespace
+
+TEST_F(utTextWriter, formatsShortestFloats) {
+    EXPECT_EQ("0", Format(0.0f));
+    EXPECT_EQ("-0", Format(-0.0f));
+    EXPECT_EQ("1", Format(1.0f));
+    EXPECT_EQ("0.1", Format(0.1f));
+    EXPECT_EQ("-2.5", Format(-2.5f));
+    EXPECT_EQ("0.3", Format(0.3f));
+    EXPECT_EQ("100", Format(100.0f));
+    EXPECT_EQ("16777216", Format(16777216.0f));
+    EXPECT_EQ("0.0001", Format(0.0001f));
+    EXPECT_EQ("1e-05", Format(0.00001f));
+    EXPECT_EQ("1e+09", Format(1e9f));
+    EXPECT_EQ("3.4028235e+38", Format(std::numeric_limits<float>::max()));
+    EXPECT_EQ("1e-45", Format(std::numeric_limits<float>::denorm_min()));
+    EXPECT_EQ("inf", Format(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("nan", Format(std::numeric_limits<float>::quiet_NaN()));
+}
+
+TEST_F(utTextWriter, floatsRoundTrip) {
+    std::mt19937 rng(42);
+    for (unsigned int i = 0; i < 100000; ++i) {
+        const uint32_t bits = static_cast<uint32_t>(rng());
+        float f;
+        ::memcpy(&f, &bits, sizeof(f));
+        if (f != f || std::fabs(f) == std::numeric_limits<float>::infinity()) {
+            continue;
+        }
+        const std::string text = Format(f);
+        const float parsed = ::strtof(text.c_str(), nullptr);
+        ASSERT_EQ(0, ::memcmp(&f, &parsed, sizeof(f))) << text;
+    }
+}
+
+TEST_F(utTextWriter, doublesRoundTrip) {
+    const double values[] = { 0.1, 1.0 / 3.0, -1e-300, 6.02214076e23, 123456789.125 };
+    for (double d : values) {
+        char buffer[32];
+        const std::string text(buffer, TextWriter::FormatDouble(d, buffer));
+        EXPECT_EQ(d, ::strtod(text.c_str(), nullptr)) << text;
+    }
+}
+
+TEST_F(utTextWriter, formatsIntegers) {
+    TextWriter writer;
+    writer << 0 << ' ' << -17 << ' ' << 4294967295u << ' ' << std::numeric_limits<long long>::min()
+           << ' ' << std::numeric_limits<unsigned long long>::max();
+    EXPECT_EQ("0 -17 4294967295 -9223372036854775808 18446744073709551615", writer.GetBuffer());
+}
+
+TEST_F(utTextWriter, flushesInChunks) {
+    CollectingIOStream stream;
+    std::string expected;
+    {
+        TextWriter writer(&stream, 64);
+        for (int i = 0; i < 1000; ++i) {
+            writer << "v " << i << ' ' << 0.5f << '\n';
+            expected += "v " + std::to_string(i) + " 0.5\n";
+        }
+        writer.Flush();
+        EXPECT_EQ(expected.length(), writer.Tell());
+    }
+    EXPECT_EQ(expected, stream.mData);
+    EXPECT_GT(stream.mWrites.size(), 1u);
+    for (size_t size : stream.mWrites) {
+        EXPECT_LT(size, 128u);
+    }
+}
+
+TEST_F(utTextWriter, parallelFormattingKeepsOrder) {
+    const size_t count = 50000;
+    TextWriter serial, parallel;
+    auto format = [](TextWriter &out, size_t i) {
+        out << static_cast<unsigned int>(i) << ' ' << static_cast<float>(i) * 0.25f << '\n';
+    };
+    FormatParallel(serial, 1, count, format);
+    FormatParallel(parallel, 4, count, format);
+    EXPECT_EQ(serial.GetBuffer(), parallel.GetBuffer());
+}
@@ -41,7 +41,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
 #include <assimp/ProgressHandler.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
 
 using namespace Assimp;
 
@@ -101,3 +109,80 @@ TEST_F(ExporterTest, ExporterIdTest) {
     const aiExportFormatDesc *desc = exporter.GetExportFormatDescription(exportFormatCount);
     EXPECT_EQ(nullptr, desc) << "More exporters than claimed";
 }
+
+TEST_F(ExporterTest, ExportMultipleTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/X/test.x", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    std::vector<Exporter::ExportTarget> targets;
+    targets.emplace_back("collada", "unittest_multi_output.dae");
+    targets.emplace_back("obj", "unittest_multi_output.obj");
+    targets.emplace_back("stl", "unittest_multi_output.stl", aiProcess_Triangulate);
+    targets.emplace_back("glb2", "unittest_multi_output.glb");
+    targets.emplace_back("glb2", "unittest_multi_output_flipped.glb", aiProcess_FlipUVs);
+    Exporter exporter;
+    EXPECT_EQ(AI_SUCCESS, exporter.ExportMultiple(scene, targets));
+
+    Importer reader;
+    for (const Exporter::ExportTarget &target : targets) {
+        EXPECT_EQ(AI_SUCCESS, target.mResult) << target.mFormatId;
+        EXPECT_TRUE(target.mError.empty());
+        EXPECT_NE(nullptr, reader.ReadFile(target.mPath, aiProcess_ValidateDataStructure)) << target.mPath;
+    }
+
+    // same output as a single export, the file name ends up in the mtllib line
+    std::ifstream multi("unittest_multi_output.obj");
+    const std::string multiData((std::istreambuf_iterator<char>(multi)), std::istreambuf_iterator<char>());
+    multi.close();
+    ASSERT_EQ(AI_SUCCESS, exporter.Export(scene, "obj", "unittest_multi_output.obj"));
+    std::ifstream single("unittest_multi_output.obj");
+    const std::string singleData((std::istreambuf_iterator<char>(single)), std::istreambuf_iterator<char>());
+    EXPECT_FALSE(multiData.empty());
+    EXPECT_EQ(singleData, multiData);
+}
+
+TEST_F(ExporterTest, ExportMultipleLeavesSceneUnchanged) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_JoinIdenticalVertices |
+            aiProcess_Triangulate | aiProcess_SortByPType);
+    ASSERT_NE(nullptr, scene);
+    aiScene *reference = nullptr;
+    SceneCombiner::CopyScene(&reference, scene);
+    std::unique_ptr<aiScene> referenceGuard(reference);
+
+    // the glTF targets need no preprocessing and share the source meshes
+    std::vector<Exporter::ExportTarget> targets;
+    targets.emplace_back("glb", "unittest_multi_shared.glb");
+    targets.emplace_back("gltf", "unittest_multi_shared.gltf");
+    targets.emplace_back("glb2", "unittest_multi_shared2.glb");
+    targets.emplace_back("gltf2", "unittest_multi_shared2.gltf");
+    Exporter exporter;
+    EXPECT_EQ(AI_SUCCESS, exporter.ExportMultiple(scene, targets));
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        if (!mesh->HasTextureCoords(0)) {
+            continue;
+        }
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            ASSERT_EQ(reference->mMeshes[i]->mTextureCoords[0][v], mesh->mTextureCoords[0][v]);
+        }
+    }
+}
+
+TEST_F(ExporterTest, ExportMultipleErrorTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/X/test.x", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    std::vector<Exporter::ExportTarget> targets;
+    targets.emplace_back("no-such-format", "unittest_multi_output.xyz");
+    targets.emplace_back("stl", "unittest_multi_output.stl");
+    Exporter exporter;
+    EXPECT_EQ(AI_FAILURE, exporter.ExportMultiple(scene, targets));
+    EXPECT_EQ(AI_FAILURE, targets[0].mResult);
+    EXPECT_FALSE(targets[0].mError.empty());
+    EXPECT_STREQ(targets[0].mError.c_str(), exporter.GetErrorString());
+    EXPECT_EQ(AI_SUCCESS, targets[1].mResult);
+}
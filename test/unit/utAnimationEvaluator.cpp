@@ -0,0 +1,275 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "UnitTestPCH.h"
+
+#include <assimp/AnimationEvaluator.h>
+#include <assimp/scene.h>
+
+#include <memory>
+
+using namespace Assimp;
+
+class utAnimationEvaluator : public ::testing::Test {
+protected:
+    // root -> arm (animated, 10 ticks per second, 20 ticks long) -> hand, plus a skinned
+    // and morphed mesh attached to the root
+    void SetUp() override {
+        scene.reset(new aiScene());
+        scene->mRootNode = new aiNode("root");
+        aiMatrix4x4::Translation(aiVector3D(0, 1, 0), scene->mRootNode->mTransformation);
+        scene->mRootNode->mNumMeshes = 1;
+        scene->mRootNode->mMeshes = new unsigned int[1];
+        scene->mRootNode->mMeshes[0] = 0;
+
+        aiNode *arm = new aiNode("arm");
+        aiNode *hand = new aiNode("hand");
+        aiMatrix4x4::Translation(aiVector3D(2, 0, 0), hand->mTransformation);
+        scene->mRootNode->addChildren(1, &arm);
+        arm->addChildren(1, &hand);
+
+        aiNodeAnim *channel = new aiNodeAnim();
+        channel->mNodeName.Set("arm");
+        channel->mNumPositionKeys = 3;
+        channel->mPositionKeys = new aiVectorKey[3];
+        channel->mPositionKeys[0] = aiVectorKey(0.0, aiVector3D(0, 0, 0));
+        channel->mPositionKeys[1] = aiVectorKey(10.0, aiVector3D(10, 0, 0));
+        channel->mPositionKeys[2] = aiVectorKey(20.0, aiVector3D(10, 10, 0));
+        channel->mNumRotationKeys = 2;
+        channel->mRotationKeys = new aiQuatKey[2];
+        channel->mRotationKeys[0] = aiQuatKey(0.0, aiQuaternion());
+        channel->mRotationKeys[1] = aiQuatKey(20.0, aiQuaternion(aiVector3D(0, 0, 1), static_cast<ai_real>(AI_MATH_PI)));
+
+        aiMeshMorphAnim *morph = new aiMeshMorphAnim();
+        morph->mName.Set("root");
+        morph->mNumKeys = 2;
+        morph->mKeys = new aiMeshMorphKey[2];
+        for (unsigned int i = 0; i < 2; ++i) {
+            morph->mKeys[i].mTime = i * 20.0;
+            morph->mKeys[i].mNumValuesAndWeights = 1;
+            morph->mKeys[i].mValues = new unsigned int[1];
+            morph->mKeys[i].mValues[0] = i;
+            morph->mKeys[i].mWeights = new double[1];
+            morph->mKeys[i].mWeights[0] = 1.0;
+        }
+
+        aiAnimation *animation = new aiAnimation();
+        animation->mTicksPerSecond = 10.0;
+        animation->mDuration = 20.0;
+        animation->mNumChannels = 1;
+        animation->mChannels = new aiNodeAnim *[1];
+        animation->mChannels[0] = channel;
+        animation->mNumMorphMeshChannels = 1;
+        animation->mMorphMeshChannels = new aiMeshMorphAnim *[1];
+        animation->mMorphMeshChannels[0] = morph;
+        scene->mNumAnimations = 1;
+        scene->mAnimations = new aiAnimation *[1];
+        scene->mAnimations[0] = animation;
+
+        // vertex 0 follows the arm, vertex 1 the hand, vertex 2 both halves, vertex 3 none
+        aiMesh *mesh = new aiMesh();
+        mesh->mNumVertices = 4;
+        mesh->mVertices = new aiVector3D[4];
+        mesh->mNormals = new aiVector3D[4];
+        for (unsigned int i = 0; i < 4; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i), 1, 0);
+            mesh->mNormals[i] = aiVector3D(0, 1, 0);
+        }
+        mesh->mNumBones = 2;
+        mesh->mBones = new aiBone *[2];
+        const char *boneNames[] = { "arm", "hand" };
+        for (unsigned int b = 0; b < 2; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone();
+            bone->mName.Set(boneNames[b]);
+            bone->mNumWeights = 2;
+            bone->mWeights = new aiVertexWeight[2];
+            bone->mWeights[0] = aiVertexWeight(b, 1.0f);
+            bone->mWeights[1] = aiVertexWeight(2, 0.5f);
+        }
+        // bind pose: arm at the root, hand 2 units along x
+        aiMatrix4x4::Translation(aiVector3D(-2, 0, 0), mesh->mBones[1]->mOffsetMatrix);
+        mesh->mNumAnimMeshes = 2;
+        mesh->mAnimMeshes = new aiAnimMesh *[2];
+        for (unsigned int i = 0; i < 2; ++i) {
+            mesh->mAnimMeshes[i] = new aiAnimMesh();
+            mesh->mAnimMeshes[i]->mWeight = 0.25f;
+        }
+        scene->mNumMeshes = 1;
+        scene->mMeshes = new aiMesh *[1];
+        scene->mMeshes[0] = mesh;
+    }
+
+    std::unique_ptr<aiScene> scene;
+};
+
+namespace {
+
+void ExpectNear(const aiVector3D &expected, const aiVector3D &actual) {
+    EXPECT_NEAR(expected.x, actual.x, 1e-4);
+    EXPECT_NEAR(expected.y, actual.y, 1e-4);
+    EXPECT_NEAR(expected.z, actual.z, 1e-4);
+}
+
+aiVector3D GetTranslation(const aiMatrix4x4 &m) {
+    return aiVector3D(m.a4, m.b4, m.c4);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, flattensHierarchy) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    ASSERT_EQ(3u, evaluator.GetNumNodes());
+    EXPECT_EQ(scene->mRootNode, evaluator.GetNode(0));
+    EXPECT_EQ(1u, evaluator.FindNode("arm"));
+    EXPECT_EQ(2u, evaluator.FindNode("hand"));
+    EXPECT_EQ(UINT_MAX, evaluator.FindNode("foot"));
+    EXPECT_EQ(nullptr, evaluator.GetNode(3));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, interpolatesChannels) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    AnimationEvaluator::State state;
+
+    // 0.5 s = 5 ticks, halfway between the first two position keys
+    evaluator.Evaluate(0.5, state);
+    EXPECT_DOUBLE_EQ(5.0, state.mTime);
+    ExpectNear(aiVector3D(5, 0, 0), GetTranslation(state.mLocalTransforms[1]));
+    ExpectNear(aiVector3D(5, 1, 0), GetTranslation(state.mGlobalTransforms[1]));
+
+    // at 20 ticks the arm is turned by 180 degrees, so the hand points along -x
+    evaluator.Evaluate(2.0, state, false);
+    ExpectNear(aiVector3D(10, 11, 0), GetTranslation(state.mGlobalTransforms[1]));
+    ExpectNear(aiVector3D(8, 11, 0), GetTranslation(state.mGlobalTransforms[2]));
+
+    // looping wraps around to the start, and the key search has to go backwards
+    evaluator.Evaluate(2.5, state);
+    EXPECT_DOUBLE_EQ(5.0, state.mTime);
+    ExpectNear(aiVector3D(5, 1, 0), GetTranslation(state.mGlobalTransforms[1]));
+
+    // without animation the bind pose is used
+    AnimationEvaluator bindPose(scene.get(), 1);
+    bindPose.Evaluate(1.0, state);
+    ExpectNear(aiVector3D(2, 1, 0), GetTranslation(state.mGlobalTransforms[2]));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, sequentialAndRandomAccessAgree) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    AnimationEvaluator::State sequential;
+    for (int i = 0; i <= 40; ++i) {
+        const double seconds = i * 0.05 + ((i * 7) % 5) * 0.01;
+        evaluator.Evaluate(seconds, sequential);
+
+        AnimationEvaluator::State fresh;
+        evaluator.Evaluate(seconds, fresh);
+        for (unsigned int n = 0; n < evaluator.GetNumNodes(); ++n) {
+            EXPECT_TRUE(fresh.mGlobalTransforms[n].Equal(sequential.mGlobalTransforms[n], 1e-5f));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, evaluatesMorphWeights) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    AnimationEvaluator::State state;
+    evaluator.Evaluate(0.5, state);
+    const float *weights = evaluator.GetMorphWeights(state, 0);
+    ASSERT_NE(nullptr, weights);
+    EXPECT_NEAR(0.75f, weights[0], 1e-5f);
+    EXPECT_NEAR(0.25f, weights[1], 1e-5f);
+
+    AnimationEvaluator bindPose(scene.get(), 1);
+    bindPose.Evaluate(0.5, state);
+    weights = bindPose.GetMorphWeights(state, 0);
+    ASSERT_NE(nullptr, weights);
+    EXPECT_FLOAT_EQ(0.25f, weights[0]);
+    EXPECT_FLOAT_EQ(0.25f, weights[1]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, skinsMesh) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    AnimationEvaluator::State state;
+
+    // in the bind pose the skinned mesh equals the input
+    AnimationEvaluator bindPose(scene.get(), 1);
+    bindPose.Evaluate(0.0, state);
+    aiVector3D positions[4], normals[4];
+    bindPose.SkinMesh(state, 0, positions, normals);
+    for (unsigned int i = 0; i < 4; ++i) {
+        ExpectNear(scene->mMeshes[0]->mVertices[i], positions[i]);
+        ExpectNear(aiVector3D(0, 1, 0), normals[i]);
+    }
+
+    // at 20 ticks the arm moved by (10, 10, 0) relative to the root and is turned by 180 degrees
+    evaluator.Evaluate(2.0, state, false);
+    aiMatrix4x4 bones[2];
+    evaluator.GetBoneMatrices(state, 0, bones);
+    evaluator.SkinMesh(state, 0, positions, normals);
+    ExpectNear(aiVector3D(10, 9, 0), positions[0]);
+    ExpectNear(aiVector3D(9, 9, 0), positions[1]);
+    ExpectNear(bones[0] * scene->mMeshes[0]->mVertices[2] * 0.5f + bones[1] * scene->mMeshes[0]->mVertices[2] * 0.5f, positions[2]);
+    ExpectNear(scene->mMeshes[0]->mVertices[3], positions[3]);
+    ExpectNear(aiVector3D(0, -1, 0), normals[0]);
+    ExpectNear(aiVector3D(0, 1, 0), normals[3]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utAnimationEvaluator, evaluatesInstancesInParallel) {
+    AnimationEvaluator evaluator(scene.get(), 0);
+    const size_t count = 64;
+    std::vector<double> seconds(count);
+    for (size_t i = 0; i < count; ++i) {
+        seconds[i] = i * 0.037;
+    }
+    std::vector<AnimationEvaluator::State> states(count);
+    evaluator.Evaluate(seconds.data(), states.data(), count, true, 4);
+
+    for (size_t i = 0; i < count; ++i) {
+        AnimationEvaluator::State expected;
+        evaluator.Evaluate(seconds[i], expected);
+        for (unsigned int n = 0; n < evaluator.GetNumNodes(); ++n) {
+            EXPECT_TRUE(expected.mGlobalTransforms[n].Equal(states[i].mGlobalTransforms[n]));
+        }
+    }
+}
@@ -0,0 +1,218 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/BatchImporter.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/material.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+static const char *SharedMtl =
+        "newmtl red\n"
+        "Kd 1 0 0\n";
+
+static const char *TriangleObj =
+        "mtllib shared.mtl\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        "usemtl red\n"
+        "f 1 2 3\n";
+
+// Thread-safe in-memory file system counting how often each file is opened
+class CountingMemoryIOSystem : public IOSystem {
+public:
+    void AddFile(const std::string &name, const char *data) {
+        mFiles[name] = data;
+    }
+
+    bool Exists(const char *pFile) const override {
+        return mFiles.count(pFile) > 0;
+    }
+
+    char getOsSeparator() const override {
+        return '/';
+    }
+
+    IOStream *Open(const char *pFile, const char *) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mOpenCount[pFile];
+        std::map<std::string, std::string>::const_iterator it = mFiles.find(pFile);
+        if (it == mFiles.end()) {
+            return nullptr;
+        }
+        return new MemoryIOStream(reinterpret_cast<const uint8_t *>(it->second.data()), it->second.size());
+    }
+
+    void Close(IOStream *pFile) override {
+        delete pFile;
+    }
+
+    unsigned int GetOpenCount(const std::string &name) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mOpenCount[name];
+    }
+
+private:
+    std::map<std::string, std::string> mFiles;
+    std::mutex mMutex;
+    std::map<std::string, unsigned int> mOpenCount;
+};
+
+// Collects the results, takes ownership of the scenes
+class CollectingHandler : public BatchImportHandler {
+public:
+    ~CollectingHandler() {
+        for (std::map<unsigned int, aiScene *>::iterator it = mScenes.begin(); it != mScenes.end(); ++it) {
+            delete it->second;
+        }
+    }
+
+    void OnImported(unsigned int id, const std::string &, aiScene *scene, const std::string &error) override {
+        // calls are serialized, no lock needed
+        EXPECT_EQ(0u, mScenes.count(id));
+        mScenes[id] = scene;
+        mErrors[id] = error;
+    }
+
+    std::map<unsigned int, aiScene *> mScenes;
+    std::map<unsigned int, std::string> mErrors;
+};
+
+} // namespace
+
+class utBatchImporter : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mIO.AddFile("shared.mtl", SharedMtl);
+        for (unsigned int i = 0; i < NumFiles; ++i) {
+            mIO.AddFile(FileName(i), TriangleObj);
+        }
+    }
+
+    static std::string FileName(unsigned int i) {
+        return "triangle" + std::to_string(i) + ".obj";
+    }
+
+    static const unsigned int NumFiles = 16;
+    CountingMemoryIOSystem mIO;
+};
+
+const unsigned int utBatchImporter::NumFiles;
+
+TEST_F(utBatchImporter, importsAllFilesAndSharesMaterialLibrary) {
+    BatchImporter batch(&mIO);
+    batch.SetNumThreads(4);
+    for (unsigned int i = 0; i < NumFiles; ++i) {
+        EXPECT_EQ(i, batch.AddRequest(FileName(i)));
+    }
+    EXPECT_EQ(NumFiles, batch.GetNumRequests());
+
+    CollectingHandler handler;
+    EXPECT_EQ(NumFiles, batch.Run(&handler));
+    EXPECT_EQ(0u, batch.GetNumRequests());
+    ASSERT_EQ(NumFiles, handler.mScenes.size());
+    for (std::map<unsigned int, aiScene *>::iterator it = handler.mScenes.begin(); it != handler.mScenes.end(); ++it) {
+        const aiScene *scene = it->second;
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(1u, scene->mNumMeshes);
+        const aiMaterial *mat = scene->mMaterials[scene->mMeshes[0]->mMaterialIndex];
+        aiString name;
+        ASSERT_EQ(AI_SUCCESS, mat->Get(AI_MATKEY_NAME, name));
+        EXPECT_STREQ("red", name.C_Str());
+    }
+
+    // the material library is read once, all other imports get it from memory
+    EXPECT_EQ(1u, mIO.GetOpenCount("shared.mtl"));
+    EXPECT_EQ(NumFiles - 1, batch.GetNumSharedFileHits());
+}
+
+TEST_F(utBatchImporter, disabledCacheReadsEachTime) {
+    BatchImporter batch(&mIO);
+    batch.SetNumThreads(2);
+    batch.SetSharedFileCacheSize(0);
+    for (unsigned int i = 0; i < NumFiles; ++i) {
+        batch.AddRequest(FileName(i));
+    }
+
+    CollectingHandler handler;
+    EXPECT_EQ(NumFiles, batch.Run(&handler));
+    EXPECT_EQ(NumFiles, mIO.GetOpenCount("shared.mtl"));
+    EXPECT_EQ(0u, batch.GetNumSharedFileHits());
+}
+
+TEST_F(utBatchImporter, duplicateRequestsAreImportedOnce) {
+    BatchImporter batch(&mIO);
+    const unsigned int first = batch.AddRequest(FileName(0));
+    EXPECT_EQ(first, batch.AddRequest(FileName(0)));
+    EXPECT_NE(first, batch.AddRequest(FileName(0), aiProcess_Triangulate));
+    EXPECT_EQ(2u, batch.GetNumRequests());
+
+    CollectingHandler handler;
+    EXPECT_EQ(2u, batch.Run(&handler));
+    EXPECT_EQ(2u, handler.mScenes.size());
+}
+
+TEST_F(utBatchImporter, reportsFailedImports) {
+    BatchImporter batch(&mIO);
+    batch.SetNumThreads(2);
+    const unsigned int good = batch.AddRequest(FileName(0));
+    const unsigned int missing = batch.AddRequest("missing.obj");
+
+    CollectingHandler handler;
+    EXPECT_EQ(1u, batch.Run(&handler));
+    ASSERT_EQ(2u, handler.mScenes.size());
+    EXPECT_NE(nullptr, handler.mScenes[good]);
+    EXPECT_TRUE(handler.mErrors[good].empty());
+    EXPECT_EQ(nullptr, handler.mScenes[missing]);
+    EXPECT_FALSE(handler.mErrors[missing].empty());
+}
@@ -0,0 +1,167 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/CopyOnWriteScene.h"
+
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <memory>
+
+using namespace Assimp;
+
+class utCopyOnWriteScene : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // the steps glTF2 enforces, so exporting it needs no preprocessing
+        mScene = mImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_GenNormals |
+                aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_SortByPType);
+        ASSERT_NE(nullptr, mScene);
+        ASSERT_LT(1u, mScene->mNumMeshes);
+    }
+
+    Importer mImporter;
+    const aiScene *mScene;
+};
+
+TEST_F(utCopyOnWriteScene, sharesAllDataInitially) {
+    CopyOnWriteScene copy(mScene);
+    const aiScene *scene = copy.GetScene();
+    ASSERT_NE(mScene, scene);
+    EXPECT_EQ(mScene->mRootNode, scene->mRootNode);
+    ASSERT_EQ(mScene->mNumMeshes, scene->mNumMeshes);
+    EXPECT_NE(mScene->mMeshes, scene->mMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_EQ(mScene->mMeshes[i], scene->mMeshes[i]);
+        EXPECT_TRUE(copy.IsMeshShared(i));
+    }
+    ASSERT_EQ(mScene->mNumMaterials, scene->mNumMaterials);
+    EXPECT_EQ(mScene->mMaterials[0], scene->mMaterials[0]);
+    EXPECT_EQ(0u, copy.GetNumDetached());
+}
+
+TEST_F(utCopyOnWriteScene, destructionLeavesSourceIntact) {
+    {
+        CopyOnWriteScene copy(mScene);
+    }
+    // the shared meshes must still be alive
+    EXPECT_LT(0u, mScene->mMeshes[0]->mNumVertices);
+    EXPECT_NE(nullptr, mScene->mRootNode);
+}
+
+TEST_F(utCopyOnWriteScene, detachMeshesCopiesOnlyMeshes) {
+    CopyOnWriteScene copy(mScene);
+    copy.DetachMeshes();
+    aiScene *scene = copy.GetScene();
+    EXPECT_EQ(mScene->mNumMeshes, copy.GetNumDetached());
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_FALSE(copy.IsMeshShared(i));
+        ASSERT_NE(mScene->mMeshes[i], scene->mMeshes[i]);
+        ASSERT_EQ(mScene->mMeshes[i]->mNumVertices, scene->mMeshes[i]->mNumVertices);
+        EXPECT_NE(mScene->mMeshes[i]->mVertices, scene->mMeshes[i]->mVertices);
+    }
+    EXPECT_EQ(mScene->mRootNode, scene->mRootNode);
+    EXPECT_EQ(mScene->mMaterials[0], scene->mMaterials[0]);
+
+    // writing to the copy doesn't change the source
+    const aiVector3D original = mScene->mMeshes[0]->mVertices[0];
+    scene->mMeshes[0]->mVertices[0] += aiVector3D(1.f, 2.f, 3.f);
+    EXPECT_EQ(original, mScene->mMeshes[0]->mVertices[0]);
+
+    // detaching twice copies nothing
+    copy.DetachMeshes();
+    EXPECT_EQ(mScene->mNumMeshes, copy.GetNumDetached());
+}
+
+TEST_F(utCopyOnWriteScene, detachAllCopiesEverything) {
+    CopyOnWriteScene copy(mScene);
+    copy.DetachAll();
+    const aiScene *scene = copy.GetScene();
+    EXPECT_NE(mScene->mRootNode, scene->mRootNode);
+    EXPECT_EQ(mScene->mRootNode->mNumChildren, scene->mRootNode->mNumChildren);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_NE(mScene->mMeshes[i], scene->mMeshes[i]);
+    }
+    for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+        EXPECT_NE(mScene->mMaterials[i], scene->mMaterials[i]);
+    }
+    EXPECT_EQ(mScene->mNumMeshes + mScene->mNumMaterials, copy.GetNumDetached());
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+#if !defined(ASSIMP_BUILD_NO_GLTF_EXPORTER) && !defined(ASSIMP_BUILD_NO_X_EXPORTER)
+
+TEST_F(utCopyOnWriteScene, exportLeavesSourceUnchanged) {
+    // With all steps glTF2 enforces applied and the verbose format flag cleared,
+    // nothing is preprocessed and the exporter sees the source meshes. The glTF
+    // exporters flip texture coordinates and glTF2 normalizes normals while
+    // writing, the X exporter makes up names for unnamed nodes.
+    std::unique_ptr<aiScene> scene(mImporter.GetOrphanedScene());
+    scene->mFlags &= ~AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+    scene->mRootNode->mName.Clear();
+
+    aiScene *reference = nullptr;
+    SceneCombiner::CopyScene(&reference, scene.get());
+    std::unique_ptr<aiScene> referenceGuard(reference);
+
+    Exporter exporter;
+    for (const char *format : { "glb2", "glb", "x" }) {
+        ASSERT_NE(nullptr, exporter.ExportToBlob(scene.get(), format)) << format;
+        EXPECT_EQ(0u, scene->mRootNode->mName.length) << format;
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *mesh = scene->mMeshes[i];
+            const aiMesh *expected = reference->mMeshes[i];
+            for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+                ASSERT_EQ(expected->mNormals[v], mesh->mNormals[v]) << format;
+                if (mesh->HasTextureCoords(0)) {
+                    ASSERT_EQ(expected->mTextureCoords[0][v], mesh->mTextureCoords[0][v]) << format;
+                }
+            }
+        }
+    }
+}
+
+#endif // !ASSIMP_BUILD_NO_GLTF_EXPORTER && !ASSIMP_BUILD_NO_X_EXPORTER
+#endif // ASSIMP_BUILD_NO_EXPORT
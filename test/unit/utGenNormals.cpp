@@ -84,3 +84,34 @@ TEST_F(GenNormalsTest, testSimpleTriangle) {
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != NULL);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testCoincidentVerticesWithSmoothingAngle) {
+    // a fan of triangles, each with its own copy of the center. With that many
+    // copies the vertices sharing a position are searched one by one.
+    const unsigned int numFaces = 300;
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    mesh->mNumVertices = numFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        const float a = static_cast<float>(i), b = static_cast<float>(i + 1);
+        mesh->mVertices[i * 3] = aiVector3D(0.0f, 0.0f, 0.0f);
+        mesh->mVertices[i * 3 + 1] = aiVector3D(std::cos(a * 0.02f), std::sin(a * 0.02f), 0.0f);
+        mesh->mVertices[i * 3 + 2] = aiVector3D(std::cos(b * 0.02f), std::sin(b * 0.02f), 0.0f);
+        mesh->mFaces[i].mIndices = new unsigned int[mesh->mFaces[i].mNumIndices = 3];
+        for (unsigned int k = 0; k < 3; ++k) {
+            mesh->mFaces[i].mIndices[k] = i * 3 + k;
+        }
+    }
+
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(80.f));
+    piProcess->GenMeshVertexNormals(mesh, 0);
+    ASSERT_TRUE(mesh->mNormals != nullptr);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_NEAR(1.0f, mesh->mNormals[i].z, 1e-5f);
+    }
+    delete mesh;
+}
@@ -0,0 +1,197 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenerateBVHProcess.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <vector>
+
+using namespace Assimp;
+
+class utGenerateBVH : public ::testing::Test {
+    // empty
+};
+
+static bool Contains(const aiAABB &outer, const aiAABB &inner) {
+    return outer.mMin.x <= inner.mMin.x && outer.mMin.y <= inner.mMin.y && outer.mMin.z <= inner.mMin.z &&
+           outer.mMax.x >= inner.mMax.x && outer.mMax.y >= inner.mMax.y && outer.mMax.z >= inner.mMax.z;
+}
+
+// checks the bounds and the primitive references of all nodes
+static void CheckHierarchy(const aiBVH *bvh, const std::vector<aiAABB> &boxes, unsigned int maxLeafSize) {
+    ASSERT_NE(nullptr, bvh);
+    ASSERT_LT(0u, bvh->mNumNodes);
+    ASSERT_EQ(boxes.size(), bvh->mNumPrimitives);
+
+    std::vector<unsigned int> referenced(boxes.size(), 0);
+    unsigned int numLeaves = 0;
+    for (unsigned int i = 0; i < bvh->mNumNodes; ++i) {
+        const aiBVHNode &node = bvh->mNodes[i];
+        if (node.IsLeaf()) {
+            ++numLeaves;
+            EXPECT_LE(node.mCount, maxLeafSize);
+            ASSERT_LE(node.mFirst + node.mCount, bvh->mNumPrimitives);
+            for (unsigned int p = node.mFirst; p < node.mFirst + node.mCount; ++p) {
+                ASSERT_LT(bvh->mPrimitives[p], boxes.size());
+                ++referenced[bvh->mPrimitives[p]];
+                EXPECT_TRUE(Contains(node.mAABB, boxes[bvh->mPrimitives[p]]));
+            }
+        } else {
+            ASSERT_GT(node.mFirst, i);
+            ASSERT_LT(node.mFirst + 1, bvh->mNumNodes);
+            EXPECT_TRUE(Contains(node.mAABB, bvh->mNodes[node.mFirst].mAABB));
+            EXPECT_TRUE(Contains(node.mAABB, bvh->mNodes[node.mFirst + 1].mAABB));
+        }
+    }
+
+    // a binary tree, every primitive sits in exactly one leaf
+    EXPECT_EQ(bvh->mNumNodes, 2 * numLeaves - 1);
+    for (unsigned int count : referenced) {
+        EXPECT_EQ(1u, count);
+    }
+}
+
+TEST_F(utGenerateBVH, activeOnlyByExtendedFlag) {
+    GenerateBVHProcess process;
+    EXPECT_FALSE(process.IsActive(0xffffffff));
+    EXPECT_TRUE(process.IsExtActive(aiProcessExt_GenerateBVH));
+    EXPECT_FALSE(process.IsExtActive(aiProcessExt_QuantizeVertices));
+}
+
+TEST_F(utGenerateBVH, buildOverBoxes) {
+    // pseudo random boxes
+    std::vector<aiAABB> boxes;
+    unsigned int seed = 12345;
+    for (unsigned int i = 0; i < 5000; ++i) {
+        aiVector3D p;
+        for (unsigned int c = 0; c < 3; ++c) {
+            seed = seed * 1664525u + 1013904223u;
+            p[c] = (seed >> 8) / static_cast<ai_real>(1 << 24) * 100;
+        }
+        boxes.push_back(aiAABB(p, p + aiVector3D(1, 0.5, 0.25)));
+    }
+
+    aiBVH *serial = GenerateBVHProcess::Build(boxes, 4, 16, 1);
+    CheckHierarchy(serial, boxes, 4);
+
+    aiBVH *parallel = GenerateBVHProcess::Build(boxes, 2, 8, 4);
+    CheckHierarchy(parallel, boxes, 2);
+
+    EXPECT_EQ(nullptr, GenerateBVHProcess::Build(std::vector<aiAABB>(), 4, 16, 1));
+    delete serial;
+    delete parallel;
+}
+
+TEST_F(utGenerateBVH, coincidentBoxesAreSplitByCount) {
+    std::vector<aiAABB> boxes(10, aiAABB(aiVector3D(0, 0, 0), aiVector3D(1, 1, 1)));
+    aiBVH *bvh = GenerateBVHProcess::Build(boxes, 4, 16, 1);
+    CheckHierarchy(bvh, boxes, 4);
+    delete bvh;
+}
+
+TEST_F(utGenerateBVH, meshAndInstanceHierarchies) {
+    // a grid of 16x16 quads, split into triangles
+    const unsigned int n = 16;
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = (n + 1) * (n + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int y = 0; y <= n; ++y) {
+        for (unsigned int x = 0; x <= n; ++x) {
+            mesh->mVertices[y * (n + 1) + x] = aiVector3D(static_cast<ai_real>(x), static_cast<ai_real>(y), 0);
+        }
+    }
+    mesh->mNumFaces = n * n * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int y = 0; y < n; ++y) {
+        for (unsigned int x = 0; x < n; ++x) {
+            const unsigned int v = y * (n + 1) + x;
+            const unsigned int corners[2][3] = { { v, v + 1, v + n + 2 }, { v, v + n + 2, v + n + 1 } };
+            for (unsigned int t = 0; t < 2; ++t) {
+                aiFace &face = mesh->mFaces[(y * n + x) * 2 + t];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                std::copy(corners[t], corners[t] + 3, face.mIndices);
+            }
+        }
+    }
+
+    // the grid is placed twice, once moved along z
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh *[1];
+    scene.mMeshes[0] = mesh;
+    scene.mRootNode = new aiNode("root");
+    aiNode *children[2] = { new aiNode("a"), new aiNode("b") };
+    for (aiNode *child : children) {
+        child->mNumMeshes = 1;
+        child->mMeshes = new unsigned int[1];
+        child->mMeshes[0] = 0;
+    }
+    aiMatrix4x4::Translation(aiVector3D(0, 0, 10), children[1]->mTransformation);
+    scene.mRootNode->addChildren(2, children);
+
+    GenerateBVHProcess process;
+    process.Execute(&scene);
+
+    std::vector<aiAABB> faceBoxes;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiAABB box(mesh->mVertices[mesh->mFaces[f].mIndices[0]], mesh->mVertices[mesh->mFaces[f].mIndices[0]]);
+        for (unsigned int i = 1; i < 3; ++i) {
+            const aiVector3D &p = mesh->mVertices[mesh->mFaces[f].mIndices[i]];
+            box.mMin = aiVector3D(std::min(box.mMin.x, p.x), std::min(box.mMin.y, p.y), std::min(box.mMin.z, p.z));
+            box.mMax = aiVector3D(std::max(box.mMax.x, p.x), std::max(box.mMax.y, p.y), std::max(box.mMax.z, p.z));
+        }
+        faceBoxes.push_back(box);
+    }
+    ASSERT_TRUE(mesh->HasBVH());
+    CheckHierarchy(mesh->mBVH, faceBoxes, AI_BVH_DEFAULT_MAX_LEAF_SIZE);
+
+    ASSERT_TRUE(scene.HasBVH());
+    ASSERT_EQ(2u, scene.mNumBVHInstances);
+    EXPECT_EQ(0u, scene.mBVHInstances[1].mMeshIndex);
+    EXPECT_EQ(children[1]->mTransformation, scene.mBVHInstances[1].mTransformation);
+    const aiAABB &root = scene.mBVH->mNodes[0].mAABB;
+    EXPECT_EQ(aiVector3D(0, 0, 0), root.mMin);
+    EXPECT_EQ(aiVector3D(16, 16, 10), root.mMax);
+}
@@ -0,0 +1,217 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenerateLODsProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+
+using namespace Assimp;
+
+class utGenerateLODs : public ::testing::Test {
+public:
+    utGenerateLODs() :
+            Test(), mProcess(nullptr), mMesh(nullptr) {
+        // empty
+    }
+
+    void SetUp() override {
+        mProcess = new GenerateLODsProcess;
+
+        // a planar grid of GridSize x GridSize quads, two triangles each
+        const unsigned int side = GridSize + 1;
+        mMesh = new aiMesh();
+        mMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mMesh->mNumVertices = side * side;
+        mMesh->mVertices = new aiVector3D[mMesh->mNumVertices];
+        mMesh->mNormals = new aiVector3D[mMesh->mNumVertices];
+        for (unsigned int y = 0; y < side; ++y) {
+            for (unsigned int x = 0; x < side; ++x) {
+                mMesh->mVertices[y * side + x] = aiVector3D((ai_real)x, (ai_real)y, 0);
+                mMesh->mNormals[y * side + x] = aiVector3D(0, 0, 1);
+            }
+        }
+        mMesh->mNumFaces = GridSize * GridSize * 2;
+        mMesh->mFaces = new aiFace[mMesh->mNumFaces];
+        unsigned int f = 0;
+        for (unsigned int y = 0; y < GridSize; ++y) {
+            for (unsigned int x = 0; x < GridSize; ++x) {
+                const unsigned int i = y * side + x;
+                const unsigned int quad[2][3] = { { i, i + 1, i + side + 1 }, { i, i + side + 1, i + side } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    aiFace &face = mMesh->mFaces[f];
+                    face.mNumIndices = 3;
+                    face.mIndices = new unsigned int[3];
+                    std::copy(quad[t], quad[t] + 3, face.mIndices);
+                }
+            }
+        }
+    }
+
+    void TearDown() override {
+        delete mProcess;
+        delete mMesh;
+    }
+
+    static bool IsOnBorder(const aiVector3D &v) {
+        return v.x == 0 || v.y == 0 || v.x == GridSize || v.y == GridSize;
+    }
+
+protected:
+    static const unsigned int GridSize = 16;
+
+    GenerateLODsProcess *mProcess;
+    aiMesh *mMesh;
+};
+
+TEST_F(utGenerateLODs, activeOnlyByExtendedFlag) {
+    EXPECT_FALSE(mProcess->IsActive(0xffffffff));
+    EXPECT_TRUE(mProcess->IsExtActive(aiProcessExt_GenerateLODs));
+    EXPECT_FALSE(mProcess->IsExtActive(aiProcessExt_GenerateMeshlets));
+}
+
+TEST_F(utGenerateLODs, chainReducesTriangles) {
+    mProcess->SetConfig(3, 0.5f, 0.01f);
+    ASSERT_TRUE(mProcess->ProcessMesh(mMesh));
+    ASSERT_TRUE(mMesh->HasLODs());
+
+    unsigned int previous = mMesh->mNumFaces;
+    for (unsigned int i = 0; i < mMesh->mNumLODs; ++i) {
+        const aiMesh *lod = mMesh->mLODs[i];
+        ASSERT_NE(nullptr, lod);
+        EXPECT_LT(lod->mNumFaces, previous);
+        EXPECT_LE(lod->mNumFaces, static_cast<unsigned int>(mMesh->mNumFaces * std::pow(0.5, i + 1)) + 2);
+        EXPECT_TRUE(lod->HasNormals());
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            ASSERT_EQ(3u, lod->mFaces[f].mNumIndices);
+            for (unsigned int k = 0; k < 3; ++k) {
+                ASSERT_LT(lod->mFaces[f].mIndices[k], lod->mNumVertices);
+            }
+        }
+        previous = lod->mNumFaces;
+    }
+}
+
+TEST_F(utGenerateLODs, bordersArePreserved) {
+    mProcess->SetConfig(1, 0.1f, 0.01f);
+    ASSERT_TRUE(mProcess->ProcessMesh(mMesh));
+    ASSERT_EQ(1u, mMesh->mNumLODs);
+
+    unsigned int numBorder = 0;
+    const aiMesh *lod = mMesh->mLODs[0];
+    for (unsigned int i = 0; i < lod->mNumVertices; ++i) {
+        if (IsOnBorder(lod->mVertices[i])) {
+            ++numBorder;
+        }
+    }
+    EXPECT_EQ(GridSize * 4, numBorder);
+}
+
+TEST_F(utGenerateLODs, boneWeightsAreKept) {
+    // left half bound to the first bone, right half to the second one
+    const unsigned int side = GridSize + 1;
+    mMesh->mNumBones = 2;
+    mMesh->mBones = new aiBone *[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone *bone = mMesh->mBones[b] = new aiBone();
+        bone->mName.Set(b ? "right" : "left");
+        std::vector<aiVertexWeight> weights;
+        for (unsigned int i = 0; i < mMesh->mNumVertices; ++i) {
+            if ((i % side <= GridSize / 2) == (b == 0)) {
+                weights.push_back(aiVertexWeight(i, 1.0f));
+            }
+        }
+        bone->mNumWeights = static_cast<unsigned int>(weights.size());
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        std::copy(weights.begin(), weights.end(), bone->mWeights);
+    }
+
+    mProcess->SetConfig(1, 0.25f, 0.01f);
+    ASSERT_TRUE(mProcess->ProcessMesh(mMesh));
+    const aiMesh *lod = mMesh->mLODs[0];
+    ASSERT_EQ(2u, lod->mNumBones);
+
+    std::vector<unsigned int> owner(lod->mNumVertices, 0);
+    for (unsigned int b = 0; b < lod->mNumBones; ++b) {
+        for (unsigned int w = 0; w < lod->mBones[b]->mNumWeights; ++w) {
+            const aiVertexWeight &weight = lod->mBones[b]->mWeights[w];
+            ASSERT_LT(weight.mVertexId, lod->mNumVertices);
+            const bool left = lod->mVertices[weight.mVertexId].x <= GridSize / 2;
+            EXPECT_EQ(left, std::string("left") == lod->mBones[b]->mName.C_Str());
+            ++owner[weight.mVertexId];
+        }
+    }
+    for (unsigned int i = 0; i < lod->mNumVertices; ++i) {
+        EXPECT_EQ(1u, owner[i]);
+    }
+}
+
+TEST_F(utGenerateLODs, skipNonTriangleMeshes) {
+    mMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE | aiPrimitiveType_LINE;
+    EXPECT_FALSE(mProcess->ProcessMesh(mMesh));
+    EXPECT_FALSE(mMesh->HasLODs());
+}
+
+TEST_F(utGenerateLODs, importWithExtendedStep) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_GenerateLODs);
+    importer.SetPropertyInteger(AI_CONFIG_PP_LOD_COUNT, 2);
+    importer.SetPropertyFloat(AI_CONFIG_PP_LOD_MAX_ERROR, 0.05f);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType |
+                    aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    unsigned int numLODs = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        EXPECT_LE(mesh->mNumLODs, 2u);
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            EXPECT_LT(mesh->mLODs[l]->mNumFaces, mesh->mNumFaces);
+            EXPECT_EQ(mesh->mMaterialIndex, mesh->mLODs[l]->mMaterialIndex);
+        }
+        numLODs += mesh->mNumLODs;
+    }
+    EXPECT_GT(numLODs, 0u);
+}
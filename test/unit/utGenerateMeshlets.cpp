@@ -0,0 +1,176 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenerateMeshletsProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <set>
+
+using namespace Assimp;
+
+class utGenerateMeshlets : public ::testing::Test {
+public:
+    utGenerateMeshlets() :
+            Test(), mProcess(nullptr), mMesh(nullptr) {
+        // empty
+    }
+
+    void SetUp() override {
+        mProcess = new GenerateMeshletsProcess;
+
+        // a planar grid of GridSize x GridSize quads, two triangles each
+        const unsigned int side = GridSize + 1;
+        mMesh = new aiMesh();
+        mMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mMesh->mNumVertices = side * side;
+        mMesh->mVertices = new aiVector3D[mMesh->mNumVertices];
+        for (unsigned int y = 0; y < side; ++y) {
+            for (unsigned int x = 0; x < side; ++x) {
+                mMesh->mVertices[y * side + x] = aiVector3D((ai_real)x, (ai_real)y, 0);
+            }
+        }
+        mMesh->mNumFaces = GridSize * GridSize * 2;
+        mMesh->mFaces = new aiFace[mMesh->mNumFaces];
+        unsigned int f = 0;
+        for (unsigned int y = 0; y < GridSize; ++y) {
+            for (unsigned int x = 0; x < GridSize; ++x) {
+                const unsigned int i = y * side + x;
+                const unsigned int quad[2][3] = { { i, i + 1, i + side + 1 }, { i, i + side + 1, i + side } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    aiFace &face = mMesh->mFaces[f];
+                    face.mNumIndices = 3;
+                    face.mIndices = new unsigned int[3];
+                    std::copy(quad[t], quad[t] + 3, face.mIndices);
+                }
+            }
+        }
+    }
+
+    void TearDown() override {
+        delete mProcess;
+        delete mMesh;
+    }
+
+protected:
+    static const unsigned int GridSize = 32;
+
+    GenerateMeshletsProcess *mProcess;
+    aiMesh *mMesh;
+};
+
+TEST_F(utGenerateMeshlets, activeOnlyByExtendedFlag) {
+    EXPECT_FALSE(mProcess->IsActive(0xffffffff));
+    EXPECT_TRUE(mProcess->IsExtActive(aiProcessExt_GenerateMeshlets));
+    EXPECT_FALSE(mProcess->IsExtActive(0));
+}
+
+TEST_F(utGenerateMeshlets, meshletsCoverAllTrianglesWithinLimits) {
+    mProcess->SetLimits(64, 124);
+    ASSERT_TRUE(mProcess->ProcessMesh(mMesh));
+    ASSERT_TRUE(mMesh->HasMeshlets());
+
+    std::multiset<std::array<unsigned int, 3>> expected, found;
+    for (unsigned int i = 0; i < mMesh->mNumFaces; ++i) {
+        const aiFace &face = mMesh->mFaces[i];
+        expected.insert({ { face.mIndices[0], face.mIndices[1], face.mIndices[2] } });
+    }
+
+    for (unsigned int i = 0; i < mMesh->mNumMeshlets; ++i) {
+        const aiMeshlet &meshlet = mMesh->mMeshlets[i];
+        EXPECT_LE(meshlet.mNumVertices, 64u);
+        EXPECT_LE(meshlet.mNumTriangles, 124u);
+        for (unsigned int t = 0; t < meshlet.mNumTriangles; ++t) {
+            std::array<unsigned int, 3> tri;
+            for (unsigned int k = 0; k < 3; ++k) {
+                ASSERT_LT(meshlet.mTriangles[t * 3 + k], meshlet.mNumVertices);
+                tri[k] = meshlet.mVertices[meshlet.mTriangles[t * 3 + k]];
+            }
+            found.insert(tri);
+        }
+
+        // all vertices are enclosed by the bounding sphere
+        for (unsigned int v = 0; v < meshlet.mNumVertices; ++v) {
+            const ai_real d = (mMesh->mVertices[meshlet.mVertices[v]] - meshlet.mCenter).Length();
+            EXPECT_LE(d, meshlet.mRadius * 1.0001f);
+        }
+
+        // the grid is planar and faces +Z, so the normal cone is degenerate
+        EXPECT_NEAR(1.0f, meshlet.mConeAxis.z, 1e-4f);
+        EXPECT_NEAR(0.0f, meshlet.mConeCutoff, 1e-3f);
+    }
+    EXPECT_EQ(expected, found);
+
+    // greedy growth on a regular grid must not degenerate into tiny clusters
+    EXPECT_LE(mMesh->mNumMeshlets, (mMesh->mNumFaces / 124) * 2 + 2);
+}
+
+TEST_F(utGenerateMeshlets, smallLimits) {
+    mProcess->SetLimits(3, 1);
+    ASSERT_TRUE(mProcess->ProcessMesh(mMesh));
+    EXPECT_EQ(mMesh->mNumFaces, mMesh->mNumMeshlets);
+}
+
+TEST_F(utGenerateMeshlets, skipNonTriangleMeshes) {
+    mMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE | aiPrimitiveType_LINE;
+    EXPECT_FALSE(mProcess->ProcessMesh(mMesh));
+    EXPECT_FALSE(mMesh->HasMeshlets());
+}
+
+TEST_F(utGenerateMeshlets, importWithExtendedStep) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_GenerateMeshlets);
+    importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, 32);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_SortByPType | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        ASSERT_TRUE(mesh->HasMeshlets());
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            EXPECT_LE(mesh->mMeshlets[m].mNumVertices, 32u);
+        }
+    }
+}
@@ -0,0 +1,199 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/ImportTask.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/cimport.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Collects the jobs instead of running them, so tests control when an import starts
+class DeferredExecutor : public ImportExecutor {
+public:
+    void Execute(aiImportTaskProc task, void *taskData) override {
+        mJobs.push_back(std::make_pair(task, taskData));
+    }
+
+    void RunAll() {
+        for (size_t i = 0; i < mJobs.size(); ++i) {
+            mJobs[i].first(mJobs[i].second);
+        }
+        mJobs.clear();
+    }
+
+    std::vector<std::pair<aiImportTaskProc, void *>> mJobs;
+};
+
+// Cancels the import as soon as a given post-processing step is reached
+class CancellingProgressHandler : public ProgressHandler {
+public:
+    CancellingProgressHandler(Importer &importer, int step) :
+            mImporter(importer), mStep(step), mLastStep(-1) {}
+
+    bool Update(float) override {
+        return true;
+    }
+
+    void UpdatePostProcess(int currentStep, int numberOfSteps) override {
+        mLastStep = currentStep;
+        if (currentStep == mStep && currentStep < numberOfSteps) {
+            mImporter.RequestCancel();
+        }
+    }
+
+    Importer &mImporter;
+    int mStep;
+    int mLastStep;
+};
+
+const char *const ModelFile = ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj";
+
+} // namespace
+
+TEST(ImportTaskTest, readsOnOwnThread) {
+    Importer importer;
+    ImportTask *task = importer.ReadFileAsync(ModelFile, aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, task);
+
+    const aiScene *scene = task->Wait();
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(scene, importer.GetScene());
+    EXPECT_TRUE(task->IsDone());
+    EXPECT_GT(scene->mNumMeshes, 0u);
+
+    const aiImportProgress progress = task->GetProgress();
+    EXPECT_EQ(aiImportStage_Done, progress.mStage);
+    EXPECT_GT(progress.mFileSize, 0u);
+    EXPECT_GE(progress.mBytesRead, progress.mFileSize);
+    EXPECT_EQ(AI_FALSE, progress.mCancelled);
+    delete task;
+
+    // the importer works as usual afterwards
+    EXPECT_NE(nullptr, importer.ReadFile(ModelFile, 0));
+}
+
+TEST(ImportTaskTest, runsOnExecutor) {
+    Importer importer;
+    DeferredExecutor executor;
+    ImportTask *task = importer.ReadFileAsync(ModelFile, aiProcess_Triangulate, &executor);
+    ASSERT_EQ(1u, executor.mJobs.size());
+    EXPECT_FALSE(task->IsDone());
+    EXPECT_EQ(aiImportStage_Pending, task->GetProgress().mStage);
+
+    executor.RunAll();
+    EXPECT_TRUE(task->IsDone());
+    EXPECT_NE(nullptr, task->Wait());
+    delete task;
+}
+
+TEST(ImportTaskTest, cancelBeforeStart) {
+    Importer importer;
+    DeferredExecutor executor;
+    ImportTask *task = importer.ReadFileAsync(ModelFile, aiProcess_Triangulate, &executor);
+    task->Cancel();
+    EXPECT_EQ(AI_TRUE, task->GetProgress().mCancelled);
+
+    executor.RunAll();
+    EXPECT_EQ(nullptr, task->Wait());
+    EXPECT_EQ(nullptr, importer.GetScene());
+    EXPECT_STREQ("Import cancelled", importer.GetErrorString());
+    delete task;
+
+    // the request does not leak into the next import
+    EXPECT_FALSE(importer.IsCancelRequested());
+    EXPECT_NE(nullptr, importer.ReadFile(ModelFile, 0));
+}
+
+TEST(ImportTaskTest, cancelWhileIdleIsIgnored) {
+    Importer importer;
+    importer.RequestCancel();
+    EXPECT_FALSE(importer.IsCancelRequested());
+    EXPECT_NE(nullptr, importer.ReadFile(ModelFile, 0));
+}
+
+TEST(ImportTaskTest, cancelDuringPostProcessing) {
+    Importer importer;
+    CancellingProgressHandler *handler = new CancellingProgressHandler(importer, 3);
+    importer.SetProgressHandler(handler);
+
+    DeferredExecutor executor;
+    ImportTask *task = importer.ReadFileAsync(ModelFile, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices, &executor);
+    executor.RunAll();
+
+    EXPECT_EQ(nullptr, task->Wait());
+    EXPECT_STREQ("Import cancelled", importer.GetErrorString());
+
+    // stopped right away, the remaining steps are not even considered
+    const aiImportProgress progress = task->GetProgress();
+    EXPECT_EQ(aiImportStage_Done, progress.mStage);
+    EXPECT_GT(progress.mNumSteps, 3u);
+    EXPECT_EQ(3u, progress.mStepIndex);
+    EXPECT_EQ(3, handler->mLastStep);
+    EXPECT_GT(progress.mStep.length, 0u);
+    delete task;
+}
+
+TEST(ImportTaskTest, cApi) {
+    aiImportTask *task = aiImportFileAsync(ModelFile, aiProcess_Triangulate, nullptr, nullptr, nullptr);
+    ASSERT_NE(nullptr, task);
+
+    const aiScene *scene = aiWaitImportTask(task);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(AI_TRUE, aiIsImportTaskDone(task));
+
+    aiImportProgress progress;
+    aiGetImportTaskProgress(task, &progress);
+    EXPECT_EQ(aiImportStage_Done, progress.mStage);
+
+    // the scene outlives the task
+    aiReleaseImportTask(task);
+    EXPECT_GT(scene->mNumMeshes, 0u);
+    aiReleaseImport(scene);
+}
@@ -279,3 +279,74 @@ TEST_F(ImporterTest, SearchFileHeaderForTokenTest) {
     //DefaultIOSystem ioSystem;
     //    BaseImporter::SearchFileHeaderForToken( &ioSystem, assetPath, Token, 2 )
 }
+
+// ------------------------------------------------------------------------------------------------
+static void ZeroNormals(aiMesh *mesh) {
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mNormals[i] = aiVector3D();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, incrementalPostProcessing) {
+    const aiScene *scene = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_GenSmoothNormals);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_LT(1u, scene->mNumMeshes);
+    aiMesh *first = scene->mMeshes[0];
+    aiMesh *second = scene->mMeshes[1];
+
+    // only the mesh flagged as modified gets its normals regenerated
+    pImp->SetPropertyBool(AI_CONFIG_PP_INCREMENTAL, true);
+    ZeroNormals(first);
+    ZeroNormals(second);
+    pImp->MarkMeshModified(0);
+    scene = pImp->ApplyPostProcessing(aiProcess_GenSmoothNormals | aiProcess_ForceGenNormals);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_NEAR(1.0f, first->mNormals[0].Length(), 1e-3f);
+    EXPECT_EQ(0.0f, second->mNormals[0].Length());
+
+    // without incremental mode all meshes are processed again
+    pImp->SetPropertyBool(AI_CONFIG_PP_INCREMENTAL, false);
+    scene = pImp->ApplyPostProcessing(aiProcess_GenSmoothNormals | aiProcess_ForceGenNormals);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_NEAR(1.0f, second->mNormals[0].Length(), 1e-3f);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void ScalePositions(const aiScene *scene) {
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        aiMesh *mesh = scene->mMeshes[m];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] *= 2.0f;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, incrementalSpatialSortFollowsInPlaceEdits) {
+    // the cached spatial sort of the first run must not be reused after the
+    // positions have been changed in place
+    const aiScene *scene = pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+    pImp->SetPropertyBool(AI_CONFIG_PP_INCREMENTAL, true);
+    scene = pImp->ApplyPostProcessing(aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace);
+    ASSERT_NE(nullptr, scene);
+    ScalePositions(scene);
+    scene = pImp->ApplyPostProcessing(aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Importer reference;
+    const aiScene *expected = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, expected);
+    expected = reference.ApplyPostProcessing(aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace);
+    ASSERT_NE(nullptr, expected);
+    ScalePositions(expected);
+    expected = reference.ApplyPostProcessing(aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, expected);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        EXPECT_EQ(expected->mMeshes[i]->mNumVertices, scene->mMeshes[i]->mNumVertices);
+    }
+}
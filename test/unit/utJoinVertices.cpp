@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 
 #include "PostProcessing/JoinVerticesProcess.h"
+#include "PostProcessing/ProcessHelper.h"
 
 using namespace std;
 using namespace Assimp;
@@ -140,3 +141,40 @@ TEST_F(utJoinVertices, testProcess) {
     }
     EXPECT_EQ(150.f * 299.f * 3.f, fSum); // gaussian sum equation
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testBoneInfluences) {
+    // two bones splitting each vertex by its position
+    pcMesh->mNumBones = 2;
+    pcMesh->mBones = new aiBone *[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone *bone = pcMesh->mBones[b] = new aiBone();
+        bone->mNumWeights = 900;
+        bone->mWeights = new aiVertexWeight[900];
+        for (unsigned int i = 0; i < 900; ++i) {
+            const float weight = (i % 300) / 300.f;
+            bone->mWeights[i] = aiVertexWeight(i, b ? weight : 1.f - weight);
+        }
+    }
+    pcMesh->mBoneInfluences = ComputeBoneInfluences(pcMesh);
+
+    piProcess->ProcessMesh(pcMesh, 0);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+
+    const aiBoneInfluences *influences = pcMesh->mBoneInfluences;
+    ASSERT_NE(nullptr, influences);
+    ASSERT_EQ(2U, influences->mNumInfluences);
+    for (unsigned int b = 0; b < 2; ++b) {
+        const aiBone *bone = pcMesh->mBones[b];
+        EXPECT_EQ(b ? 299U : 300U, bone->mNumWeights);
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight &weight = bone->mWeights[w];
+            const float expected = pcMesh->mVertices[weight.mVertexId].x / 300.f;
+            EXPECT_FLOAT_EQ(b ? expected : 1.f - expected, weight.mWeight);
+
+            const unsigned int *bones = influences->mBoneIndices + weight.mVertexId * 2;
+            const ai_real *weights = influences->mWeights + weight.mVertexId * 2;
+            EXPECT_TRUE((bones[0] == b && weights[0] == weight.mWeight) || (bones[1] == b && weights[1] == weight.mWeight));
+        }
+    }
+}
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include "PostProcessing/LimitBoneWeightsProcess.h"
+#include "PostProcessing/ProcessHelper.h"
 #include <assimp/scene.h>
 
 using namespace std;
@@ -134,3 +135,46 @@ TEST_F(LimitBoneWeightsTest, testProcess) {
 
     // everything seems to be OK
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testInfluencesKeptInSync) {
+    mMesh->mBoneInfluences = ComputeBoneInfluences(mMesh);
+    ASSERT_NE(nullptr, mMesh->mBoneInfluences);
+    EXPECT_EQ(15u, mMesh->mBoneInfluences->mNumInfluences);
+
+    mProcess->ProcessMesh(mMesh);
+
+    // the table is cut to the limit and matches the rebuilt bones
+    const aiBoneInfluences *influences = mMesh->mBoneInfluences;
+    ASSERT_NE(nullptr, influences);
+    ASSERT_EQ(4u, influences->mNumInfluences);
+
+    unsigned int numWeights = 0;
+    for (unsigned int i = 0; i < mMesh->mNumBones; ++i) {
+        const aiBone *bone = mMesh->mBones[i];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w, ++numWeights) {
+            const aiVertexWeight &weight = bone->mWeights[w];
+            bool found = false;
+            for (unsigned int s = 0; s < 4; ++s) {
+                const size_t slot = weight.mVertexId * 4 + s;
+                found = found || (influences->mBoneIndices[slot] == i && influences->mWeights[slot] == weight.mWeight);
+            }
+            EXPECT_TRUE(found);
+        }
+    }
+    EXPECT_EQ(mMesh->mNumVertices * 4, numWeights);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testInfluencesSkipInvalidVertices) {
+    // a weight of a vertex the mesh doesn't have
+    mMesh->mBones[0]->mWeights[0].mVertexId = mMesh->mNumVertices;
+
+    std::unique_ptr<aiBoneInfluences> influences(ComputeBoneInfluences(mMesh));
+    ASSERT_NE(nullptr, influences);
+    EXPECT_EQ(15u, influences->mNumInfluences);
+
+    // vertex 0 keeps only its other 14 weights, the first now comes from bone 2
+    EXPECT_EQ(2u, influences->mBoneIndices[0]);
+    EXPECT_EQ(0.0f, influences->mWeights[influences->mNumInfluences - 1]);
+}
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include "Material/MaterialSystem.h"
+#include <assimp/SceneCombiner.h>
 #include <assimp/scene.h>
 
 using namespace ::std;
@@ -135,3 +136,89 @@ TEST_F(MaterialSystemTest, testMaterialNameAccess) {
 
     delete mat;
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testLookupInLargeMaterial) {
+    char key[32];
+    for (int i = 0; i < 100; ++i) {
+        ::snprintf(key, sizeof(key), "$large.key%i", i);
+        pcMat->AddProperty(&i, 1, key, i % 3, i % 2);
+    }
+    EXPECT_EQ(100u, pcMat->mNumProperties);
+
+    for (int i = 0; i < 100; ++i) {
+        ::snprintf(key, sizeof(key), "$large.key%i", i);
+        int value = -1;
+        EXPECT_EQ(AI_SUCCESS, pcMat->Get(key, i % 3, i % 2, value));
+        EXPECT_EQ(i, value);
+        EXPECT_EQ(AI_FAILURE, pcMat->Get(key, i % 3 + 1, i % 2, value));
+    }
+    int value = 0;
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$large.key100", 0, 0, value));
+
+    // UINT_MAX matches any type and index
+    const aiMaterialProperty *prop = nullptr;
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialProperty(pcMat, "$large.key42", UINT_MAX, UINT_MAX, &prop));
+    ASSERT_NE(nullptr, prop);
+    EXPECT_EQ(0u, prop->mSemantic);
+    EXPECT_EQ(0u, prop->mIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testReplaceAndRemoveInLargeMaterial) {
+    char key[32];
+    for (int i = 0; i < 50; ++i) {
+        ::snprintf(key, sizeof(key), "$large.key%i", i);
+        pcMat->AddProperty(&i, 1, key);
+    }
+
+    int value = 1000;
+    pcMat->AddProperty(&value, 1, "$large.key10");
+    EXPECT_EQ(50u, pcMat->mNumProperties);
+    value = 0;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$large.key10", 0, 0, value));
+    EXPECT_EQ(1000, value);
+
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty("$large.key20", 0, 0));
+    EXPECT_EQ(AI_FAILURE, pcMat->RemoveProperty("$large.key20", 0, 0));
+    EXPECT_EQ(49u, pcMat->mNumProperties);
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$large.key20", 0, 0, value));
+    for (int i = 21; i < 50; ++i) {
+        ::snprintf(key, sizeof(key), "$large.key%i", i);
+        EXPECT_EQ(AI_SUCCESS, pcMat->Get(key, 0, 0, value));
+        EXPECT_EQ(i, value);
+    }
+
+    // properties dropped without going through the material are noticed as well
+    delete pcMat->mProperties[--pcMat->mNumProperties];
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$large.key49", 0, 0, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$large.key48", 0, 0, value));
+    EXPECT_EQ(48, value);
+
+    pcMat->Clear();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$large.key0", 0, 0, value));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testIndexKeptByMaterial) {
+    char key[32];
+    for (int i = 0; i < 50; ++i) {
+        ::snprintf(key, sizeof(key), "$large.key%i", i);
+        pcMat->AddProperty(&i, 1, key);
+    }
+    EXPECT_NE(nullptr, pcMat->mPrivate);
+
+    // copies write their property list directly and get an index of their own
+    aiMaterial *copy = nullptr;
+    SceneCombiner::Copy(&copy, pcMat);
+    ASSERT_NE(nullptr, copy);
+    EXPECT_NE(nullptr, copy->mPrivate);
+    EXPECT_NE(pcMat->mPrivate, copy->mPrivate);
+    int value = 0;
+    EXPECT_EQ(AI_SUCCESS, copy->Get("$large.key33", 0, 0, value));
+    EXPECT_EQ(33, value);
+    delete copy;
+
+    pcMat->Clear();
+    EXPECT_EQ(nullptr, pcMat->mPrivate);
+}
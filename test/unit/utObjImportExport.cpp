@@ -477,3 +477,38 @@ TEST_F(utObjImportExport, import_with_line_continuations) {
     EXPECT_NEAR(vertices[2].y, 0.5f, threshold);
     EXPECT_NEAR(vertices[2].z, -0.5f, threshold);
 }
+
+TEST_F(utObjImportExport, share_vertices) {
+    static const char *curObjModel =
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 1 1 0\n"
+            "v 0 1 0\n"
+            "vt 0 0\n"
+            "vt 1 1\n"
+            "vn 0 0 1\n"
+            "f 1/1/1 2/1/1 3/1/1\n"
+            "f 1/1/1 3/1/1 4/1/1\n"
+            "f 1/2/1 3/1/1 4/1/1\n";
+
+    Assimp::Importer myImporter;
+    const aiScene *scene = myImporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(9U, scene->mMeshes[0]->mNumVertices);
+
+    // only the corners with equal (v,vt,vn) triplets are merged
+    myImporter.SetPropertyBool(AI_CONFIG_IMPORT_OBJ_SHARE_VERTICES, true);
+    scene = myImporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_EQ(5U, mesh->mNumVertices);
+    EXPECT_EQ(3U, mesh->mNumFaces);
+    EXPECT_EQ(mesh->mFaces[0].mIndices[0], mesh->mFaces[1].mIndices[0]);
+    EXPECT_EQ(mesh->mFaces[0].mIndices[2], mesh->mFaces[1].mIndices[1]);
+    EXPECT_NE(mesh->mFaces[1].mIndices[0], mesh->mFaces[2].mIndices[0]);
+    EXPECT_EQ(mesh->mFaces[1].mIndices[2], mesh->mFaces[2].mIndices[2]);
+    const aiVector3D &uv = mesh->mTextureCoords[0][mesh->mFaces[2].mIndices[0]];
+    EXPECT_FLOAT_EQ(1.0f, uv.x);
+    ASSERT_NE(nullptr, mesh->mNormals);
+    EXPECT_FLOAT_EQ(1.0f, mesh->mNormals[mesh->mFaces[2].mIndices[0]].z);
+}
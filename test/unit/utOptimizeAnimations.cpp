@@ -0,0 +1,208 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/OptimizeAnimationsProcess.h"
+#include <assimp/AnimationEvaluator.h>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utOptimizeAnimations : public ::testing::Test {
+    // empty
+};
+
+// angle between two rotations, from the chord length to stay precise for small angles
+static float GetAngle(aiQuaternion a, const aiQuaternion &b) {
+    a.Normalize();
+    if (a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z < 0.0f) {
+        a = aiQuaternion(-a.w, -a.x, -a.y, -a.z);
+    }
+    const aiQuaternion d(a.w - b.w, a.x - b.x, a.y - b.y, a.z - b.z);
+    return 4.0f * std::asin(std::min(0.5f * std::sqrt(d.w * d.w + d.x * d.x + d.y * d.y + d.z * d.z), 1.0f));
+}
+
+// a channel for node "node" with numKeys keys, one per tick
+static aiNodeAnim *CreateChannel(unsigned int numKeys) {
+    aiNodeAnim *channel = new aiNodeAnim();
+    channel->mNodeName.Set("node");
+    channel->mNumPositionKeys = channel->mNumRotationKeys = channel->mNumScalingKeys = numKeys;
+    channel->mPositionKeys = new aiVectorKey[numKeys];
+    channel->mRotationKeys = new aiQuatKey[numKeys];
+    channel->mScalingKeys = new aiVectorKey[numKeys];
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        channel->mPositionKeys[i].mTime = channel->mRotationKeys[i].mTime = channel->mScalingKeys[i].mTime = i;
+    }
+    return channel;
+}
+
+// a scene with a single node animated by channel
+static aiScene *CreateScene(aiNodeAnim *channel) {
+    aiScene *scene = new aiScene();
+    scene->mRootNode = new aiNode("node");
+    scene->mNumAnimations = 1;
+    scene->mAnimations = new aiAnimation *[1];
+    aiAnimation *animation = scene->mAnimations[0] = new aiAnimation();
+    animation->mTicksPerSecond = 1.0;
+    animation->mDuration = channel->mPositionKeys[channel->mNumPositionKeys - 1].mTime;
+    animation->mNumChannels = 1;
+    animation->mChannels = new aiNodeAnim *[1];
+    animation->mChannels[0] = channel;
+    return scene;
+}
+
+TEST_F(utOptimizeAnimations, activeOnlyByExtendedFlag) {
+    OptimizeAnimationsProcess process;
+    EXPECT_FALSE(process.IsActive(0xffffffff));
+    EXPECT_TRUE(process.IsExtActive(aiProcessExt_OptimizeAnimations));
+    EXPECT_FALSE(process.IsExtActive(aiProcessExt_GenerateBVH));
+}
+
+TEST_F(utOptimizeAnimations, reduceLinearAndConstantTracks) {
+    std::unique_ptr<aiNodeAnim> channel(CreateChannel(100));
+    for (unsigned int i = 0; i < 100; ++i) {
+        channel->mPositionKeys[i].mValue = aiVector3D(i * 0.5f, 1.0f, -2.0f * i);
+        channel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0, 0, 1), i * 0.01f);
+        channel->mScalingKeys[i].mValue = aiVector3D(2.0f, 2.0f, 2.0f);
+    }
+
+    EXPECT_EQ(295u, OptimizeAnimationsProcess::ReduceKeys(channel.get(), 1e-4f, 1e-4f, 1e-4f));
+    ASSERT_EQ(2u, channel->mNumPositionKeys);
+    EXPECT_DOUBLE_EQ(0.0, channel->mPositionKeys[0].mTime);
+    EXPECT_DOUBLE_EQ(99.0, channel->mPositionKeys[1].mTime);
+    EXPECT_EQ(2u, channel->mNumRotationKeys);
+    ASSERT_EQ(1u, channel->mNumScalingKeys);
+    EXPECT_EQ(aiVector3D(2.0f, 2.0f, 2.0f), channel->mScalingKeys[0].mValue);
+
+    // nothing left to remove
+    EXPECT_EQ(0u, OptimizeAnimationsProcess::ReduceKeys(channel.get(), 1e-4f, 1e-4f, 1e-4f));
+}
+
+TEST_F(utOptimizeAnimations, sampledMotionStaysWithinBounds) {
+    const unsigned int numKeys = 300;
+    aiNodeAnim *channel = CreateChannel(numKeys);
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        const float t = i * 0.01f;
+        channel->mPositionKeys[i].mValue = aiVector3D(std::sin(t) * 10.0f, t, std::cos(t * 0.3f));
+        channel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0, 1, 0), std::sin(t) * 2.0f);
+        channel->mScalingKeys[i].mValue = aiVector3D(1.0f + 0.2f * std::sin(t * 2.0f));
+    }
+    std::vector<aiVectorKey> positions(channel->mPositionKeys, channel->mPositionKeys + numKeys);
+    std::vector<aiQuatKey> rotations(channel->mRotationKeys, channel->mRotationKeys + numKeys);
+
+    const float positionError = 1e-2f, rotationError = 1e-2f;
+    std::unique_ptr<aiScene> scene(CreateScene(channel));
+    OptimizeAnimationsProcess::ReduceKeys(channel, positionError, rotationError, 1e-3f);
+    EXPECT_LT(channel->mNumPositionKeys, numKeys / 4);
+    EXPECT_LT(channel->mNumRotationKeys, numKeys / 4);
+    EXPECT_LT(channel->mNumScalingKeys, numKeys / 4);
+
+    // sampling the reduced channel at the times of the removed keys restores them
+    AnimationEvaluator evaluator(scene.get(), 0);
+    AnimationEvaluator::State state;
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        evaluator.Evaluate(positions[i].mTime, state, false);
+        aiVector3D scaling, position;
+        aiQuaternion rotation;
+        state.mLocalTransforms[0].Decompose(scaling, rotation, position);
+        EXPECT_LE((position - positions[i].mValue).Length(), positionError + 1e-4f);
+
+        EXPECT_LE(GetAngle(rotation, rotations[i].mValue), rotationError + 1e-4f);
+    }
+}
+
+TEST_F(utOptimizeAnimations, quantizedKeys) {
+    std::unique_ptr<aiNodeAnim> channel(CreateChannel(50));
+    for (unsigned int i = 0; i < 50; ++i) {
+        channel->mPositionKeys[i].mValue = aiVector3D(i * 3.0f, -i * 0.1f, 5.0f);
+        channel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(1, 2, 3).Normalize(), i * 0.2f - 4.0f);
+        channel->mScalingKeys[i].mValue = aiVector3D(1.0f, 1.0f + i, 0.5f);
+    }
+    OptimizeAnimationsProcess::QuantizeKeys(channel.get());
+
+    const aiQuantizedNodeAnim *q = channel->mQuantized;
+    ASSERT_NE(nullptr, q);
+    ASSERT_EQ(50u, q->mNumPositionKeys);
+    ASSERT_EQ(50u, q->mNumRotationKeys);
+    ASSERT_EQ(50u, q->mNumScalingKeys);
+    for (unsigned int i = 0; i < 50; ++i) {
+        EXPECT_FLOAT_EQ(static_cast<float>(i), q->mPositionTimes[i]);
+        EXPECT_LE((q->GetPosition(i) - channel->mPositionKeys[i].mValue).Length(), 147.0f / 65535.0f);
+        EXPECT_LE((q->GetScaling(i) - channel->mScalingKeys[i].mValue).Length(), 49.0f / 65535.0f);
+
+        EXPECT_LE(GetAngle(q->GetRotation(i), channel->mRotationKeys[i].mValue), 2e-4f);
+    }
+
+    // copies keep their own buffers
+    aiNodeAnim *copy = nullptr;
+    SceneCombiner::Copy(&copy, channel.get());
+    ASSERT_NE(nullptr, copy->mQuantized);
+    EXPECT_NE(q->mRotations, copy->mQuantized->mRotations);
+    EXPECT_EQ(q->mRotations[7], copy->mQuantized->mRotations[7]);
+    delete copy;
+
+    // removing keys drops the outdated quantized copy
+    OptimizeAnimationsProcess::ReduceKeys(channel.get(), 1e-4f, 1e-4f, 1e-4f);
+    EXPECT_EQ(nullptr, channel->mQuantized);
+}
+
+TEST_F(utOptimizeAnimations, executeOnScene) {
+    aiNodeAnim *channel = CreateChannel(20);
+    for (unsigned int i = 0; i < 20; ++i) {
+        channel->mPositionKeys[i].mValue = aiVector3D(static_cast<float>(i), 0, 0);
+        channel->mScalingKeys[i].mValue = aiVector3D(1.0f);
+    }
+    std::unique_ptr<aiScene> scene(CreateScene(channel));
+
+    OptimizeAnimationsProcess process;
+    process.Execute(scene.get());
+    EXPECT_EQ(2u, channel->mNumPositionKeys);
+    EXPECT_EQ(1u, channel->mNumRotationKeys);
+    EXPECT_EQ(1u, channel->mNumScalingKeys);
+    EXPECT_EQ(nullptr, channel->mQuantized);
+}
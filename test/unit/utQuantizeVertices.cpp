@@ -0,0 +1,130 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/QuantizeVerticesProcess.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cmath>
+
+using namespace Assimp;
+
+class utQuantizeVertices : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utQuantizeVertices, activeOnlyByExtendedFlag) {
+    QuantizeVerticesProcess process;
+    EXPECT_FALSE(process.IsActive(0xffffffff));
+    EXPECT_TRUE(process.IsExtActive(aiProcessExt_QuantizeVertices));
+    EXPECT_FALSE(process.IsExtActive(aiProcessExt_GenerateLODs));
+}
+
+TEST_F(utQuantizeVertices, halfFloatConversion) {
+    EXPECT_EQ(0x0000, QuantizeVerticesProcess::FloatToHalf(0.0f));
+    EXPECT_EQ(0x3c00, QuantizeVerticesProcess::FloatToHalf(1.0f));
+    EXPECT_EQ(0xc000, QuantizeVerticesProcess::FloatToHalf(-2.0f));
+    EXPECT_EQ(0x7bff, QuantizeVerticesProcess::FloatToHalf(65504.0f));
+    EXPECT_EQ(0x7c00, QuantizeVerticesProcess::FloatToHalf(1e6f));
+    EXPECT_EQ(0x0001, QuantizeVerticesProcess::FloatToHalf(std::ldexp(1.0f, -24)));
+
+    // every finite half float survives a round trip
+    for (unsigned int h = 0; h < 0x10000; ++h) {
+        if ((h & 0x7c00) == 0x7c00) {
+            continue;
+        }
+        const float f = QuantizeVerticesProcess::HalfToFloat(static_cast<uint16_t>(h));
+        EXPECT_EQ(h, QuantizeVerticesProcess::FloatToHalf(f));
+    }
+}
+
+TEST_F(utQuantizeVertices, octahedralRoundTrip) {
+    for (int i = 0; i < 200; ++i) {
+        // points on a spiral around the whole sphere
+        const float z = 1.0f - (i + 0.5f) / 100.0f;
+        const float r = std::sqrt(1.0f - z * z), phi = i * 2.4f;
+        const aiVector3D n(r * std::cos(phi), r * std::sin(phi), z);
+
+        int16_t encoded[2];
+        QuantizeVerticesProcess::EncodeOctahedral(n, encoded);
+        const aiVector3D decoded = QuantizeVerticesProcess::DecodeOctahedral(encoded);
+        EXPECT_NEAR(1.0f, decoded * n, 1e-6f);
+    }
+}
+
+TEST_F(utQuantizeVertices, quantizeMesh) {
+    aiMesh mesh;
+    mesh.mNumVertices = 3;
+    mesh.mVertices = new aiVector3D[3];
+    mesh.mVertices[0] = aiVector3D(-1, 2, 5);
+    mesh.mVertices[1] = aiVector3D(3, 2, 5);
+    mesh.mVertices[2] = aiVector3D(0.5, 4, 5);
+    mesh.mNormals = new aiVector3D[3];
+    mesh.mColors[0] = new aiColor4D[3];
+    mesh.mTextureCoords[0] = new aiVector3D[3];
+    mesh.mNumUVComponents[0] = 2;
+    for (unsigned int i = 0; i < 3; ++i) {
+        mesh.mNormals[i] = aiVector3D(0, 0, -1);
+        mesh.mColors[0][i] = aiColor4D(1, 0.5f, 0, 1);
+        mesh.mTextureCoords[0][i] = aiVector3D(0.25f * i, 0.5f, 0);
+    }
+
+    ASSERT_TRUE(QuantizeVerticesProcess::ProcessMesh(&mesh));
+    const aiQuantizedVertices *q = mesh.mQuantized;
+    ASSERT_NE(nullptr, q);
+    EXPECT_EQ(aiVector3D(-1, 2, 5), q->mPositionOffset);
+
+    // the flat axis keeps a scale of one
+    EXPECT_EQ(aiVector3D(4, 2, 1), q->mPositionScale);
+    for (unsigned int i = 0; i < 3; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const ai_real decoded = q->mPositionOffset[c] + q->mPositionScale[c] * (q->mPositions[i * 3 + c] / static_cast<ai_real>(65535));
+            EXPECT_NEAR(mesh.mVertices[i][c], decoded, 1e-4);
+        }
+        EXPECT_NEAR(-1.0f, QuantizeVerticesProcess::DecodeOctahedral(q->mNormals + i * 2).z, 1e-6f);
+        EXPECT_EQ(0.25f * i, QuantizeVerticesProcess::HalfToFloat(q->mTextureCoords[0][i * 2]));
+        EXPECT_EQ(255, q->mColors[0][i * 4]);
+        EXPECT_EQ(128, q->mColors[0][i * 4 + 1]);
+    }
+    EXPECT_EQ(nullptr, q->mTangents);
+    EXPECT_EQ(nullptr, q->mColors[1]);
+}
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
 
+#include <cstdio>
 #include <vector>
 
 using namespace Assimp;
@@ -99,6 +100,31 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+TEST_F(utSTLImporterExporter, weldBinaryVertices) {
+    Assimp::Importer plain;
+    const aiScene *reference = plain.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, reference);
+
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    const aiMesh *expected = reference->mMeshes[0];
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(expected->mNumFaces, mesh->mNumFaces);
+    EXPECT_LT(mesh->mNumVertices, expected->mNumVertices);
+    EXPECT_EQ(nullptr, mesh->mNormals);
+
+    // every corner keeps its position
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        ASSERT_EQ(3u, mesh->mFaces[i].mNumIndices);
+        for (unsigned int v = 0; v < 3; ++v) {
+            EXPECT_EQ(expected->mVertices[expected->mFaces[i].mIndices[v]], mesh->mVertices[mesh->mFaces[i].mIndices[v]]);
+        }
+    }
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utSTLImporterExporter, exporterTest) {
@@ -167,4 +193,23 @@ TEST_F(utSTLImporterExporter, test_export_pointclouds) {
     delete properties;
 }
 
+TEST_F(utSTLImporterExporter, failedExportLeavesNoFile) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    // point clouds are not supported by the binary writer, the export fails half way
+    std::remove("failedExport.stl");
+    Assimp::Exporter exporter;
+    ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS, true);
+    EXPECT_EQ(AI_FAILURE, exporter.Export(scene, "stlb", "failedExport.stl", 0, &properties));
+
+    std::FILE *file = std::fopen("failedExport.stl", "rb");
+    EXPECT_EQ(nullptr, file);
+    if (nullptr != file) {
+        std::fclose(file);
+    }
+}
+
 #endif
@@ -41,7 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/mesh.h>
+#include <assimp/scene.h>
 #include <memory>
+#include <string>
 
 using namespace ::Assimp;
 
@@ -75,3 +77,29 @@ TEST_F(utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion) {
     EXPECT_NO_THROW(SceneCombiner::CopyScene(nullptr, nullptr));
     EXPECT_NO_THROW(SceneCombiner::CopySceneFlat(nullptr, nullptr));
 }
+
+TEST_F(utSceneCombiner, CopyAndDeleteDeepHierarchyWithoutRecursion) {
+    const unsigned int depth = 200000;
+
+    aiScene scene;
+    scene.mRootNode = new aiNode("root");
+    aiNode *parent = scene.mRootNode;
+    for (unsigned int i = 0; i < depth; ++i) {
+        aiNode *child = new aiNode(std::to_string(i));
+        child->mParent = parent;
+        parent->addChildren(1, &child);
+        parent = child;
+    }
+
+    aiNode *copy = nullptr;
+    SceneCombiner::Copy(&copy, scene.mRootNode);
+    ASSERT_NE(nullptr, copy);
+
+    unsigned int copied = 0;
+    for (const aiNode *node = copy; node->mNumChildren; node = node->mChildren[0]) {
+        EXPECT_EQ(node, node->mChildren[0]->mParent);
+        ++copied;
+    }
+    EXPECT_EQ(depth, copied);
+    delete copy;
+}
@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/SplitByBoneCountProcess.h"
+#include <assimp/Exceptional.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace Assimp;
+
+static const unsigned int NumBones = 100;
+static const unsigned int MaxBones = 10;
+
+class SplitByBoneCountTest : public ::testing::Test {
+protected:
+    // A strip of quads, quad k is skinned to bones k and k+1. The faces are shuffled so that
+    // packing them in face order would need many more submeshes than necessary.
+    static aiMesh *CreateStrip();
+};
+
+// ------------------------------------------------------------------------------------------------
+aiMesh *SplitByBoneCountTest::CreateStrip() {
+    const unsigned int numQuads = NumBones - 1;
+    aiMesh *mesh = new aiMesh();
+    mesh->mName.Set("strip");
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = NumBones * 2;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i / 2), static_cast<ai_real>(i % 2), 0);
+    }
+
+    std::vector<unsigned int> order(numQuads);
+    for (unsigned int i = 0; i < numQuads; ++i) {
+        order[i] = (i * 37) % numQuads;
+    }
+    mesh->mNumFaces = numQuads * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int i = 0; i < numQuads; ++i) {
+        const unsigned int k = order[i];
+        const unsigned int quad[2][3] = { { 2 * k, 2 * k + 2, 2 * k + 1 }, { 2 * k + 1, 2 * k + 2, 2 * k + 3 } };
+        for (unsigned int f = 0; f < 2; ++f) {
+            aiFace &face = mesh->mFaces[2 * i + f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            std::copy(quad[f], quad[f] + 3, face.mIndices);
+        }
+    }
+
+    // both vertices of column k are fully weighted to bone k
+    mesh->mNumBones = NumBones;
+    mesh->mBones = new aiBone *[NumBones];
+    for (unsigned int b = 0; b < NumBones; ++b) {
+        aiBone *bone = mesh->mBones[b] = new aiBone();
+        bone->mName.Set("bone" + std::to_string(b));
+        bone->mNumWeights = 2;
+        bone->mWeights = new aiVertexWeight[2];
+        bone->mWeights[0] = aiVertexWeight(2 * b, 1.0f);
+        bone->mWeights[1] = aiVertexWeight(2 * b + 1, 1.0f);
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, splitStrip) {
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh *[1];
+    scene.mMeshes[0] = CreateStrip();
+    scene.mRootNode = new aiNode();
+    scene.mRootNode->mNumMeshes = 1;
+    scene.mRootNode->mMeshes = new unsigned int[1];
+    scene.mRootNode->mMeshes[0] = 0;
+
+    SplitByBoneCountProcess process;
+    process.mMaxBoneCount = MaxBones;
+    process.Execute(&scene);
+
+    // a submesh covers at most MaxBones - 1 quads, face order packing would need twice as many
+    const unsigned int minMeshes = (NumBones - 1 + MaxBones - 2) / (MaxBones - 1);
+    EXPECT_GE(scene.mNumMeshes, minMeshes);
+    EXPECT_LE(scene.mNumMeshes, minMeshes + 1);
+    ASSERT_EQ(scene.mNumMeshes, scene.mRootNode->mNumMeshes);
+
+    unsigned int numFaces = 0;
+    for (unsigned int m = 0; m < scene.mNumMeshes; ++m) {
+        const aiMesh *mesh = scene.mMeshes[m];
+        EXPECT_EQ(m, scene.mRootNode->mMeshes[m]);
+        EXPECT_LE(mesh->mNumBones, MaxBones);
+        numFaces += mesh->mNumFaces;
+
+        // shared vertices stay shared within a submesh
+        EXPECT_LT(mesh->mNumVertices, mesh->mNumFaces * 3);
+
+        // every vertex is still fully weighted to the bone of its column
+        std::vector<float> weights(mesh->mNumVertices, 0.0f);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone *bone = mesh->mBones[b];
+            const unsigned int column = static_cast<unsigned int>(std::stoul(bone->mName.C_Str() + 4));
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                const aiVertexWeight &weight = bone->mWeights[w];
+                ASSERT_LT(weight.mVertexId, mesh->mNumVertices);
+                EXPECT_EQ(static_cast<ai_real>(column), mesh->mVertices[weight.mVertexId].x);
+                weights[weight.mVertexId] += weight.mWeight;
+            }
+        }
+        for (float w : weights) {
+            EXPECT_FLOAT_EQ(1.0f, w);
+        }
+    }
+    EXPECT_EQ((NumBones - 1) * 2, numFaces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, keepSmallMesh) {
+    std::unique_ptr<aiMesh> mesh(CreateStrip());
+    SplitByBoneCountProcess process;
+    process.mMaxBoneCount = NumBones;
+
+    std::vector<aiMesh *> newMeshes;
+    process.SplitMesh(mesh.get(), newMeshes);
+    EXPECT_TRUE(newMeshes.empty());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, faceExceedsMaxBones) {
+    std::unique_ptr<aiMesh> mesh(CreateStrip());
+    SplitByBoneCountProcess process;
+    process.mMaxBoneCount = 1;
+
+    std::vector<aiMesh *> newMeshes;
+    EXPECT_THROW(process.SplitMesh(mesh.get(), newMeshes), DeadlyImportError);
+}
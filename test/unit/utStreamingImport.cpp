@@ -0,0 +1,212 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/MeshChunkSink.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/MeshChunkHandler.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+const unsigned int ChunkVertices = 300;
+
+// Sums up the chunks and checks their size
+class CountingHandler : public MeshChunkHandler {
+public:
+    explicit CountingHandler(unsigned int stopAfter = ~0u) :
+            mStopAfter(stopAfter), mNumChunks(0), mNumFaces(0), mNumVertices(0), mMaxVertices(0) {}
+
+    bool HandleChunk(const aiScene *pChunk, unsigned int pChunkIndex) override {
+        EXPECT_EQ(mNumChunks, pChunkIndex);
+        EXPECT_EQ(1u, pChunk->mNumMeshes);
+        const aiMesh *mesh = pChunk->mMeshes[0];
+        mNumFaces += mesh->mNumFaces;
+        mNumVertices += mesh->mNumVertices;
+        mMaxVertices = std::max(mMaxVertices, mesh->mNumVertices);
+        return ++mNumChunks < mStopAfter;
+    }
+
+    unsigned int mStopAfter;
+    unsigned int mNumChunks;
+    unsigned int mNumFaces;
+    unsigned int mNumVertices;
+    unsigned int mMaxVertices;
+};
+
+unsigned int CountFaces(const aiScene *scene) {
+    unsigned int numFaces = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        numFaces += scene->mMeshes[i]->mNumFaces;
+    }
+    return numFaces;
+}
+
+} // namespace
+
+class utStreamingImport : public ::testing::Test {
+protected:
+    // Streams the file and compares the result to a regular import
+    void checkAgainstReadFile(const std::string &file) {
+        Importer regular;
+        const aiScene *scene = regular.ReadFile(file, 0);
+        ASSERT_NE(nullptr, scene);
+
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES, ChunkVertices);
+        CountingHandler handler;
+        ASSERT_TRUE(importer.ReadFileStreamed(file.c_str(), 0, &handler)) << importer.GetErrorString();
+        EXPECT_EQ(CountFaces(scene), handler.mNumFaces);
+        EXPECT_LE(handler.mMaxVertices, ChunkVertices);
+        EXPECT_GT(handler.mNumChunks, 1u);
+        EXPECT_EQ(nullptr, importer.GetScene());
+    }
+};
+
+TEST_F(utStreamingImport, binarySTL) {
+    checkAgainstReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl");
+}
+
+TEST_F(utStreamingImport, asciiSTL) {
+    checkAgainstReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl");
+}
+
+TEST_F(utStreamingImport, indexedPLY) {
+    checkAgainstReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/Wuson.ply");
+}
+
+TEST_F(utStreamingImport, pointCloudPLY) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES, 3);
+    CountingHandler handler;
+    ASSERT_TRUE(importer.ReadFileStreamed(ASSIMP_TEST_MODELS_DIR "/PLY/points.ply", 0, &handler));
+    EXPECT_EQ(handler.mNumVertices, handler.mNumFaces);
+    EXPECT_LE(handler.mMaxVertices, 3u);
+}
+
+TEST_F(utStreamingImport, OBJ) {
+    checkAgainstReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj");
+}
+
+TEST_F(utStreamingImport, pointCloudOBJ) {
+    // a point cloud with interleaved vertices and normals, passed on while parsing
+    class PointHandler : public MeshChunkHandler {
+    public:
+        bool HandleChunk(const aiScene *pChunk, unsigned int) override {
+            const aiMesh *mesh = pChunk->mMeshes[0];
+            EXPECT_EQ(aiPrimitiveType_POINT, mesh->mPrimitiveTypes);
+            EXPECT_TRUE(mesh->HasNormals());
+            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+                mVertices.push_back(mesh->mVertices[i]);
+                mNormals.push_back(mesh->HasNormals() ? mesh->mNormals[i] : aiVector3D());
+            }
+            return true;
+        }
+        std::vector<aiVector3D> mVertices, mNormals;
+    } handler;
+
+    const char *file = ASSIMP_TEST_MODELS_DIR "/OBJ/point_cloud.obj";
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES, 3);
+    ASSERT_TRUE(importer.ReadFileStreamed(file, 0, &handler)) << importer.GetErrorString();
+
+    Importer regular;
+    const aiScene *scene = regular.ReadFile(file, 0);
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(mesh->mNumVertices, handler.mVertices.size());
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(mesh->mVertices[i], handler.mVertices[i]);
+        EXPECT_EQ(mesh->mNormals[i], handler.mNormals[i]);
+    }
+}
+
+TEST_F(utStreamingImport, postProcessingIsChunkLocal) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES, ChunkVertices);
+    CountingHandler handler;
+    ASSERT_TRUE(importer.ReadFileStreamed(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_ValidateDataStructure, &handler));
+    EXPECT_LE(handler.mMaxVertices, ChunkVertices);
+}
+
+TEST_F(utStreamingImport, handlerStopsImport) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_STREAM_CHUNK_VERTICES, ChunkVertices);
+    CountingHandler handler(2);
+    EXPECT_FALSE(importer.ReadFileStreamed(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0, &handler));
+    EXPECT_EQ(2u, handler.mNumChunks);
+    EXPECT_STRNE("", importer.GetErrorString());
+}
+
+TEST_F(utStreamingImport, unsupportedFormatFails) {
+    Importer importer;
+    CountingHandler handler;
+    EXPECT_FALSE(importer.ReadFileStreamed(ASSIMP_TEST_MODELS_DIR "/3DS/fels.3ds", 0, &handler));
+    EXPECT_EQ(0u, handler.mNumChunks);
+    EXPECT_FALSE(importer.ReadFileStreamed(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", 0, nullptr));
+}
+
+TEST_F(utStreamingImport, unreferencedVerticesBecomePoints) {
+    aiMesh *chunk = nullptr;
+    MeshChunkSink sink(3, [&chunk](aiMesh *mesh) { chunk = mesh; });
+    sink.Reserve(3);
+    const unsigned int line[2] = { sink.AddVertex(aiVector3D(0, 0, 0)), sink.AddVertex(aiVector3D(1, 0, 0)) };
+    sink.AddVertex(aiVector3D(2, 0, 0));
+    sink.AddFace(line, 2);
+    sink.Finish();
+
+    ASSERT_NE(nullptr, chunk);
+    ASSERT_EQ(2u, chunk->mNumFaces);
+    EXPECT_EQ(2u, chunk->mFaces[0].mNumIndices);
+    ASSERT_EQ(1u, chunk->mFaces[1].mNumIndices);
+    EXPECT_EQ(2u, chunk->mFaces[1].mIndices[0]);
+    delete chunk;
+}
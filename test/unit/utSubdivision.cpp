@@ -0,0 +1,158 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Subdivision.h>
+#include <assimp/mesh.h>
+
+#include <memory>
+
+using namespace Assimp;
+
+class utSubdivision : public ::testing::Test {
+protected:
+    // A cube from -1 to 1 in verbose format, faces [first, first+count) of the six quads
+    static aiMesh *CreateCube(unsigned int first = 0, unsigned int count = 6) {
+        static const ai_real corners[8][3] = {
+            { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+            { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 }
+        };
+        static const unsigned int quads[6][4] = {
+            { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+            { 2, 3, 7, 6 }, { 1, 2, 6, 5 }, { 0, 4, 7, 3 }
+        };
+
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mNumFaces = count;
+        mesh->mFaces = new aiFace[count];
+        mesh->mNumVertices = count * 4;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int f = 0; f < count; ++f) {
+            aiFace &face = mesh->mFaces[f];
+            face.mNumIndices = 4;
+            face.mIndices = new unsigned int[4];
+            for (unsigned int a = 0; a < 4; ++a) {
+                const ai_real *c = corners[quads[first + f][a]];
+                face.mIndices[a] = f * 4 + a;
+                mesh->mVertices[f * 4 + a] = aiVector3D(c[0], c[1], c[2]);
+            }
+        }
+        return mesh;
+    }
+
+    static aiMesh *Subdivide(aiMesh *mesh, unsigned int levels, unsigned int threads = 1) {
+        std::unique_ptr<Subdivider> subd(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+        subd->SetNumThreads(threads);
+        aiMesh *out = nullptr;
+        subd->Subdivide(mesh, out, levels, false);
+        return out;
+    }
+};
+
+TEST_F(utSubdivision, cubeCornersMoveToLimitPositions) {
+    std::unique_ptr<aiMesh> cube(CreateCube());
+    std::unique_ptr<aiMesh> out(Subdivide(cube.get(), 1));
+
+    ASSERT_EQ(24u, out->mNumFaces);
+    ASSERT_EQ(96u, out->mNumVertices);
+
+    // the original corner of valence 3 moves to (F + 2R + (n-3)P)/n = 5/9
+    const ai_real expected = 5.f / 9.f;
+    unsigned int found = 0;
+    for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+        const aiVector3D &v = out->mVertices[i];
+        EXPECT_LE(std::fabs(v.x), 1.f);
+        if (std::fabs(v.x - expected) < 1e-5f && std::fabs(v.y - expected) < 1e-5f && std::fabs(v.z - expected) < 1e-5f) {
+            ++found;
+        }
+    }
+    EXPECT_EQ(3u, found);
+}
+
+TEST_F(utSubdivision, multipleLevelsMatchRepeatedSubdivision) {
+    std::unique_ptr<aiMesh> cube(CreateCube());
+    std::unique_ptr<aiMesh> direct(Subdivide(cube.get(), 2));
+    std::unique_ptr<aiMesh> first(Subdivide(cube.get(), 1));
+    std::unique_ptr<aiMesh> repeated(Subdivide(first.get(), 1));
+
+    ASSERT_EQ(96u, direct->mNumFaces);
+    ASSERT_EQ(repeated->mNumVertices, direct->mNumVertices);
+    for (unsigned int i = 0; i < direct->mNumVertices; ++i) {
+        EXPECT_NEAR(repeated->mVertices[i].x, direct->mVertices[i].x, 1e-5f);
+        EXPECT_NEAR(repeated->mVertices[i].y, direct->mVertices[i].y, 1e-5f);
+        EXPECT_NEAR(repeated->mVertices[i].z, direct->mVertices[i].z, 1e-5f);
+    }
+}
+
+TEST_F(utSubdivision, meshesAreWeldedAcrossSplits) {
+    std::unique_ptr<aiMesh> whole(CreateCube());
+    aiMesh *halves[2] = { CreateCube(0, 3), CreateCube(3, 3) };
+    aiMesh *out[2] = { nullptr, nullptr };
+
+    std::unique_ptr<Subdivider> subd(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+    subd->Subdivide(halves, 2, out, 2, true);
+    std::unique_ptr<aiMesh> reference(Subdivide(whole.get(), 2));
+
+    // splitting the cube into two meshes must not open seams
+    ASSERT_EQ(48u, out[0]->mNumFaces);
+    ASSERT_EQ(48u, out[1]->mNumFaces);
+    for (unsigned int m = 0, n = 0; m < 2; ++m) {
+        for (unsigned int i = 0; i < out[m]->mNumVertices; ++i, ++n) {
+            EXPECT_NEAR(reference->mVertices[n].x, out[m]->mVertices[i].x, 1e-5f);
+            EXPECT_NEAR(reference->mVertices[n].y, out[m]->mVertices[i].y, 1e-5f);
+            EXPECT_NEAR(reference->mVertices[n].z, out[m]->mVertices[i].z, 1e-5f);
+        }
+        delete out[m];
+    }
+}
+
+TEST_F(utSubdivision, parallelResultMatchesSerial) {
+    std::unique_ptr<aiMesh> cube(CreateCube());
+    std::unique_ptr<aiMesh> serial(Subdivide(cube.get(), 4, 1));
+    std::unique_ptr<aiMesh> parallel(Subdivide(cube.get(), 4, 4));
+
+    ASSERT_EQ(6u * 256u, serial->mNumFaces);
+    ASSERT_EQ(serial->mNumVertices, parallel->mNumVertices);
+    for (unsigned int i = 0; i < serial->mNumVertices; ++i) {
+        EXPECT_EQ(serial->mVertices[i], parallel->mVertices[i]);
+    }
+}
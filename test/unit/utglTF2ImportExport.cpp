@@ -376,6 +376,45 @@ TEST_F(utglTF2ImportExport, bug_import_simple_skin) {
     EXPECT_NE(nullptr, scene);
 }
 
+TEST_F(utglTF2ImportExport, import_skin_influences) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/simple_skin/simple_skin.gltf",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        if (!mesh->HasBones()) {
+            continue;
+        }
+
+        // the per-vertex table holds the same weights as the bones
+        ASSERT_TRUE(mesh->HasBoneInfluences());
+        const aiBoneInfluences *influences = mesh->mBoneInfluences;
+        ASSERT_EQ(4u, influences->mNumInfluences);
+        unsigned int numInfluences = 0;
+        for (unsigned int i = 0; i < mesh->mNumVertices * 4; ++i) {
+            numInfluences += influences->mWeights[i] != 0.0f;
+            if (i % 4) {
+                EXPECT_LE(influences->mWeights[i], influences->mWeights[i - 1]);
+            }
+        }
+        unsigned int numWeights = 0;
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone *bone = mesh->mBones[b];
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w, ++numWeights) {
+                const aiVertexWeight &weight = bone->mWeights[w];
+                bool found = false;
+                for (unsigned int s = 0; s < 4; ++s) {
+                    const unsigned int slot = weight.mVertexId * 4 + s;
+                    found = found || (influences->mBoneIndices[slot] == b && influences->mWeights[slot] == weight.mWeight);
+                }
+                EXPECT_TRUE(found);
+            }
+        }
+        EXPECT_EQ(numWeights, numInfluences);
+    }
+}
+
 TEST_F(utglTF2ImportExport, import_cameras) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/cameras/Cameras.gltf",
@@ -461,6 +500,84 @@ TEST_F(utglTF2ImportExport, export_normalized_normals) {
     }
 }
 
+static const aiNode *FindMeshNode(const aiNode *node, unsigned int meshIndex, aiMatrix4x4 &transform) {
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        if (node->mMeshes[i] == meshIndex) {
+            transform = node->mTransformation;
+            return node;
+        }
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        if (FindMeshNode(node->mChildren[i], meshIndex, transform)) {
+            transform = node->mTransformation * transform;
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+TEST_F(utglTF2ImportExport, export_quantized_vertices) {
+    Assimp::Importer importer;
+    Assimp::Exporter exporter;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_QuantizeVertices);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+            aiProcess_GenBoundingBoxes | aiProcess_ValidateDataStructure);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_TRUE(scene->mMeshes[0]->HasQuantizedVertices());
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "glb2", "BoxTextured_quantized_out.glb"));
+
+    Assimp::Importer reimporter;
+    const aiScene *quantized = reimporter.ReadFile("BoxTextured_quantized_out.glb",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(quantized, nullptr);
+    ASSERT_EQ(scene->mNumMeshes, quantized->mNumMeshes);
+
+    // the dequantization transform restores the original positions
+    aiMatrix4x4 original, restored;
+    ASSERT_NE(nullptr, FindMeshNode(scene->mRootNode, 0, original));
+    ASSERT_NE(nullptr, FindMeshNode(quantized->mRootNode, 0, restored));
+    const aiMesh *a = scene->mMeshes[0], *b = quantized->mMeshes[0];
+    ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+    const aiMatrix3x3 normalMatrix = aiMatrix3x3(restored).Inverse().Transpose();
+    for (unsigned int i = 0; i < a->mNumVertices; ++i) {
+        const aiVector3D expected = original * a->mVertices[i], actual = restored * b->mVertices[i];
+        EXPECT_NEAR(expected.x, actual.x, 1e-3);
+        EXPECT_NEAR(expected.y, actual.y, 1e-3);
+        EXPECT_NEAR(expected.z, actual.z, 1e-3);
+
+        const aiVector3D expectedNormal = (aiMatrix3x3(original) * a->mNormals[i]).Normalize();
+        const aiVector3D actualNormal = (normalMatrix * b->mNormals[i]).Normalize();
+        EXPECT_NEAR(1.0, expectedNormal * actualNormal, 1e-3);
+    }
+}
+
+TEST_F(utglTF2ImportExport, export_skin_roundtrip) {
+    Assimp::Importer importer;
+    Assimp::Exporter exporter;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/simple_skin/simple_skin.gltf",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(scene, nullptr);
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "glb2", "simple_skin_out.glb"));
+
+    Assimp::Importer reimporter;
+    const aiScene *reimported = reimporter.ReadFile("simple_skin_out.glb",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(reimported, nullptr);
+    ASSERT_EQ(scene->mNumMeshes, reimported->mNumMeshes);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *a = scene->mMeshes[m], *b = reimported->mMeshes[m];
+        ASSERT_EQ(a->mNumBones, b->mNumBones);
+        for (unsigned int i = 0; i < a->mNumBones; ++i) {
+            EXPECT_EQ(a->mBones[i]->mName, b->mBones[i]->mName);
+            ASSERT_EQ(a->mBones[i]->mNumWeights, b->mBones[i]->mNumWeights);
+            for (unsigned int w = 0; w < a->mBones[i]->mNumWeights; ++w) {
+                EXPECT_EQ(a->mBones[i]->mWeights[w].mVertexId, b->mBones[i]->mWeights[w].mVertexId);
+                EXPECT_FLOAT_EQ(a->mBones[i]->mWeights[w].mWeight, b->mBones[i]->mWeights[w].mWeight);
+            }
+        }
+    }
+}
+
 #endif // ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utglTF2ImportExport, sceneMetadata) {
@@ -513,9 +513,19 @@ int Assimp_TestBatchLoad (
 	const char* const* params, 
 	unsigned int num)
 {
+	// files are spread over all cores, each worker imports its share
+	// through the same importer instance.
+	Assimp::BatchImporter batch;
 	for(unsigned int i = 0; i < num; ++i) {
-		globalImporter->ReadFile(params[i],aiProcessPreset_TargetRealtime_MaxQuality);
-		// we're totally silent. scene destructs automatically.
+		batch.AddRequest(params[i],aiProcessPreset_TargetRealtime_MaxQuality);
 	}
+
+	// we're totally silent.
+	struct DiscardingHandler : public Assimp::BatchImportHandler {
+		void OnImported(unsigned int, const std::string&, aiScene* scene, const std::string&) override {
+			delete scene;
+		}
+	} handler;
+	batch.Run(&handler);
 	return AssimpCmdError::Success;
 }
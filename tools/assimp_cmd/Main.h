@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/version.h>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
+#include <assimp/BatchImporter.hpp>
 #include <assimp/DefaultLogger.hpp>
 
 #ifndef ASSIMP_BUILD_NO_EXPORT